@@ -47,32 +47,34 @@ public:
 } base64_chars;
 
 std::string base64_encode(bytes_view in) {
+    // The output size is known exactly up front, so size the string once
+    // and write through a raw pointer - appending character by character
+    // costs a size check and a capacity check per output byte.
     std::string ret;
-    ret.reserve(((4 * in.size() / 3) + 3) & ~3);
-    int i = 0;
-    unsigned char chunk3[3]; // chunk of input
-    for (auto byte : in) {
-        chunk3[i++] = byte;
-        if (i == 3) {
-            ret += base64_chars.to[ (chunk3[0] & 0xfc) >> 2 ];
-            ret += base64_chars.to[ ((chunk3[0] & 0x03) << 4) + ((chunk3[1] & 0xf0) >> 4) ];
-            ret += base64_chars.to[ ((chunk3[1] & 0x0f) << 2) + ((chunk3[2] & 0xc0) >> 6) ];
-            ret += base64_chars.to[ chunk3[2] & 0x3f ];
-            i = 0;
-        }
+    ret.resize((in.size() + 2) / 3 * 4);
+    char* out = ret.data();
+    const auto* p = reinterpret_cast<const unsigned char*>(in.data());
+    size_t n = in.size();
+    while (n >= 3) {
+        out[0] = base64_chars.to[ p[0] >> 2 ];
+        out[1] = base64_chars.to[ ((p[0] & 0x03) << 4) | (p[1] >> 4) ];
+        out[2] = base64_chars.to[ ((p[1] & 0x0f) << 2) | (p[2] >> 6) ];
+        out[3] = base64_chars.to[ p[2] & 0x3f ];
+        p += 3;
+        n -= 3;
+        out += 4;
     }
-    if (i) {
-        // i can be 1 or 2.
-        for(int j = i; j < 3; j++)
-            chunk3[j] = '\0';
-        ret += base64_chars.to[ ( chunk3[0] & 0xfc) >> 2 ];
-        ret += base64_chars.to[ ((chunk3[0] & 0x03) << 4) + ((chunk3[1] & 0xf0) >> 4) ];
-        if (i == 2) {
-            ret += base64_chars.to[ ((chunk3[1] & 0x0f) << 2) + ((chunk3[2] & 0xc0) >> 6) ];
+    if (n) {
+        // n can be 1 or 2.
+        out[0] = base64_chars.to[ p[0] >> 2 ];
+        if (n == 2) {
+            out[1] = base64_chars.to[ ((p[0] & 0x03) << 4) | (p[1] >> 4) ];
+            out[2] = base64_chars.to[ (p[1] & 0x0f) << 2 ];
         } else {
-            ret += '=';
+            out[1] = base64_chars.to[ (p[0] & 0x03) << 4 ];
+            out[2] = '=';
         }
-        ret += '=';
+        out[3] = '=';
     }
     return ret;
 }
@@ -108,11 +110,41 @@ static std::string base64_decode_string(std::string_view in) {
 }
 
 bytes base64_decode(std::string_view in) {
-    // FIXME: This copy is sad. The problem is we need back "bytes"
-    // but "bytes" doesn't have efficient append and std::string.
-    // To fix this we need to use bytes' "uninitialized" feature.
-    std::string ret = base64_decode_string(in);
-    return bytes(ret.begin(), ret.end());
+    // in.size() * 3 / 4 is an exact bound on the decoded length: every
+    // full group of 4 input characters yields 3 bytes, and a trailing
+    // group of 2 or 3 characters yields 1 or 2. We decode into an
+    // uninitialized bytes of that size and trim in the (rare) case the
+    // input ended early at padding or an unexpected character.
+    bytes ret(bytes::initialized_later(), in.size() * 3 / 4);
+    int8_t* out = ret.data();
+    int i = 0;
+    int8_t chunk4[4]; // chunk of input, each byte converted to 0..63;
+    for (unsigned char c : in) {
+        int8_t dc = base64_chars.from[c];
+        if (dc == -1) {
+            // Any unexpected character, include the "=" character usually
+            // used for padding, signals the end of the decode.
+            break;
+        }
+        chunk4[i++] = dc;
+        if (i == 4) {
+            *out++ = (chunk4[0] << 2) | ((chunk4[1] & 0x30) >> 4);
+            *out++ = ((chunk4[1] & 0xf) << 4) | ((chunk4[2] & 0x3c) >> 2);
+            *out++ = ((chunk4[2] & 0x3) << 6) | chunk4[3];
+            i = 0;
+        }
+    }
+    if (i) {
+        // i can be 2 or 3, meaning 1 or 2 more output bytes
+        if (i >= 2) {
+            *out++ = (chunk4[0] << 2) | ((chunk4[1] & 0x30) >> 4);
+        }
+        if (i == 3) {
+            *out++ = ((chunk4[1] & 0xf) << 4) | ((chunk4[2] & 0x3c) >> 2);
+        }
+    }
+    ret.resize(out - ret.data());
+    return ret;
 }
 
 static size_t base64_padding_len(std::string_view str) {
@@ -82,6 +82,24 @@ std::string make_jsonable::to_json() const {
     return rjson::print(_value);
 }
 
+// A variant of make_jsonable for the potentially large item-carrying
+// responses (GetItem, BatchGetItem, Query, Scan): instead of printing the
+// JSON into one contiguous string and copying it into the reply, serialize
+// it in chunks straight into the HTTP response stream, keeping memory use
+// bounded and yielding while a large response is written.
+static json::json_return_type make_streamed(rjson::value&& value) {
+    auto rs = ::make_shared<rjson::value>(std::move(value));
+    std::function<future<>(output_stream<char>&&)> body_writer =
+            [rs = std::move(rs)] (output_stream<char>&& os) -> future<> {
+        return do_with(std::move(os), [rs] (output_stream<char>& os) {
+            return rjson::print(*rs, os).finally([&os] {
+                return os.close();
+            }).finally([rs] {});
+        });
+    };
+    return json::json_return_type(std::move(body_writer));
+}
+
 json_string::json_string(std::string&& value)
     : _value(std::move(value))
 {}
@@ -1770,8 +1788,20 @@ static future<> do_batch_write(service::storage_proxy& proxy,
         std::vector<mutation> mutations;
         mutations.reserve(mutation_builders.size());
         api::timestamp_type now = api::new_timestamp();
+        // A batch may contain several items of the same partition (the
+        // duplicate check above is on full primary keys). Merge those into
+        // one mutation per partition, so each replica applies them in one
+        // commitlog entry and memtable pass instead of one per item.
+        std::unordered_map<schema_decorated_key, size_t, schema_decorated_key_hash, schema_decorated_key_equal>
+            partition_index(1, schema_decorated_key_hash{}, schema_decorated_key_equal{});
         for (auto& b : mutation_builders) {
-            mutations.push_back(b.second.build(b.first, now));
+            auto mut = b.second.build(b.first, now);
+            auto [it, added] = partition_index.try_emplace(schema_decorated_key{b.first, mut.decorated_key()}, mutations.size());
+            if (added) {
+                mutations.push_back(std::move(mut));
+            } else {
+                mutations[it->second].apply(std::move(mut));
+            }
         }
         return proxy.mutate(std::move(mutations),
                 db::consistency_level::LOCAL_QUORUM,
@@ -2800,7 +2830,7 @@ future<executor::request_return_type> executor::get_item(client_state& client_st
             service::storage_proxy::coordinator_query_options(executor::default_timeout(), std::move(permit), client_state, trace_state)).then(
             [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = std::move(attrs_to_get), start_time = std::move(start_time)] (service::storage_proxy::coordinator_query_result qr) mutable {
         _stats.api_operations.get_item_latency.add(std::chrono::steady_clock::now() - start_time);
-        return make_ready_future<executor::request_return_type>(make_jsonable(describe_item(schema, partition_slice, *selection, *qr.query_result, std::move(attrs_to_get))));
+        return make_ready_future<executor::request_return_type>(make_streamed(describe_item(schema, partition_slice, *selection, *qr.query_result, std::move(attrs_to_get))));
     });
 }
 
@@ -2892,7 +2922,7 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
                 rjson::push_back(response["Responses"][std::get<0>(t)], std::move(*std::get<1>(t)));
             }
         }
-        return make_ready_future<executor::request_return_type>(make_jsonable(std::move(response)));
+        return make_ready_future<executor::request_return_type>(make_streamed(std::move(response)));
     });
 }
 
@@ -3240,7 +3270,7 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
             // update our "filtered_row_matched_total" for all the rows matched, despited the filter
             cql_stats.filtered_rows_matched_total += items["Items"].Size();
         }
-        return make_ready_future<executor::request_return_type>(make_jsonable(std::move(items)));
+        return make_ready_future<executor::request_return_type>(make_streamed(std::move(items)));
     });
 }
 
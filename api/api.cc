@@ -129,6 +129,14 @@ future<> unset_server_snapshot(http_context& ctx) {
     return ctx.http_server.set_routes([&ctx] (routes& r) { unset_snapshot(ctx, r); });
 }
 
+future<> set_server_stall_recorder(http_context& ctx, sharded<utils::stall_flight_recorder>& recorder) {
+    return ctx.http_server.set_routes([&ctx, &recorder] (routes& r) { set_stall_recorder(ctx, r, recorder); });
+}
+
+future<> unset_server_stall_recorder(http_context& ctx) {
+    return ctx.http_server.set_routes([&ctx] (routes& r) { unset_stall_recorder(ctx, r); });
+}
+
 future<> set_server_snitch(http_context& ctx) {
     return register_api(ctx, "endpoint_snitch_info", "The endpoint snitch info API", set_endpoint_snitch);
 }
@@ -44,6 +44,7 @@ namespace cql_transport { class controller; }
 class thrift_controller;
 namespace db { class snapshot_ctl; }
 namespace netw { class messaging_service; }
+namespace utils { class stall_flight_recorder; }
 class repair_service;
 
 namespace api {
@@ -78,6 +79,8 @@ future<> set_rpc_controller(http_context& ctx, thrift_controller& ctl);
 future<> unset_rpc_controller(http_context& ctx);
 future<> set_server_snapshot(http_context& ctx, sharded<db::snapshot_ctl>& snap_ctl);
 future<> unset_server_snapshot(http_context& ctx);
+future<> set_server_stall_recorder(http_context& ctx, sharded<utils::stall_flight_recorder>& recorder);
+future<> unset_server_stall_recorder(http_context& ctx);
 future<> set_server_gossip(http_context& ctx);
 future<> set_server_load_sstable(http_context& ctx);
 future<> set_server_messaging_service(http_context& ctx, sharded<netw::messaging_service>& ms);
@@ -268,6 +268,12 @@ void set_cache_service(http_context& ctx, routes& r) {
         });
     });
 
+    cs::get_row_working_set.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return map_reduce_cf(ctx, uint64_t(0), [](const column_family& cf) {
+            return cf.get_row_cache().working_set_bytes();
+        }, std::plus<uint64_t>());
+    });
+
     cs::get_counter_capacity.set(r, [] (std::unique_ptr<request> req) {
         // TBD
         // FIXME
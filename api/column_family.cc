@@ -1001,6 +1001,49 @@ void set_column_family(http_context& ctx, routes& r) {
         });
     });
 
+    cf::get_hot_partitions.set(r, [&ctx] (std::unique_ptr<request> req) {
+        api::req_param<unsigned> list_size(*req, "list_size", 10);
+
+        using merged_results = db::toppartitions_query::results;
+        using top_t = db::toppartitions_data_listener::global_top_k::results;
+        auto map = [list_size = list_size.value] (database& db) {
+            top_t rd, wr;
+            if (auto* tracker = db.hot_partitions_tracker()) {
+                rd = db::toppartitions_data_listener::globalize(tracker->read_sketch().top(list_size));
+                wr = db::toppartitions_data_listener::globalize(tracker->write_sketch().top(list_size));
+            }
+            return make_foreign(std::make_unique<std::tuple<top_t, top_t>>(std::move(rd), std::move(wr)));
+        };
+        auto reduce = [] (merged_results res, foreign_ptr<std::unique_ptr<std::tuple<top_t, top_t>>> rd_wr) {
+            res.read.append(db::toppartitions_data_listener::localize(std::get<0>(*rd_wr)));
+            res.write.append(db::toppartitions_data_listener::localize(std::get<1>(*rd_wr)));
+            return std::move(res);
+        };
+        return ctx.db.map_reduce0(map, merged_results{list_size.value * smp::count}, reduce)
+                .then([list_size = list_size.value] (merged_results merged) {
+            cf::toppartitions_query_results results;
+
+            results.read_cardinality = merged.read.size();
+            results.write_cardinality = merged.write.size();
+
+            for (auto& d: merged.read.top(list_size)) {
+                cf::toppartitions_record r;
+                r.partition = "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") " + sstring(d.item);
+                r.count = d.count;
+                r.error = d.error;
+                results.read.push(r);
+            }
+            for (auto& d: merged.write.top(list_size)) {
+                cf::toppartitions_record r;
+                r.partition = "(" + d.item.schema->ks_name() + ":" + d.item.schema->cf_name() + ") " + sstring(d.item);
+                r.count = d.count;
+                r.error = d.error;
+                results.write.push(r);
+            }
+            return make_ready_future<json::json_return_type>(results);
+        });
+    });
+
     cf::force_major_compaction.set(r, [&ctx](std::unique_ptr<request> req) {
         if (req->get_query_param("split_output") != "") {
             fail(unimplemented::cause::API);
@@ -41,6 +41,29 @@ void set_lsa(http_context& ctx, routes& r) {
             return json::json_return_type(json::json_void());
         });
     });
+
+    httpd::lsa_json::lsa_occupancy.set(r, [&ctx](std::unique_ptr<request> req) {
+        using label_map = std::unordered_map<sstring, logalloc::occupancy_stats>;
+        return ctx.db.map_reduce0([] (database&) {
+            return logalloc::shard_tracker().region_occupancy_by_label();
+        }, label_map(), [] (label_map a, label_map b) {
+            for (auto& [label, occ] : b) {
+                a[label] += occ;
+            }
+            return a;
+        }).then([] (label_map all) {
+            std::vector<httpd::lsa_json::region_occupancy> res;
+            res.reserve(all.size());
+            for (auto& [label, occ] : all) {
+                httpd::lsa_json::region_occupancy ro;
+                ro.label = label;
+                ro.used_space = occ.used_space();
+                ro.total_space = occ.total_space();
+                res.push_back(std::move(ro));
+            }
+            return make_ready_future<json::json_return_type>(std::move(res));
+        });
+    });
 }
 
 }
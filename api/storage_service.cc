@@ -453,6 +453,47 @@ void set_storage_service(http_context& ctx, routes& r) {
         return make_ready_future<json::json_return_type>(stream_range_as_array(service::get_local_storage_service().describe_ring(keyspace), token_range_endpoints_to_json));
     });
 
+    ss::describe_splits.set(r, [&ctx](std::unique_ptr<request> req) {
+        auto keyspace = validate_keyspace(ctx, req->param);
+        auto cf = req->get_query_param("cf");
+        utils::UUID uuid;
+        try {
+            uuid = ctx.db.local().find_uuid(keyspace, cf);
+        } catch (std::out_of_range&) {
+            throw bad_param_exception(format("Column family '{}:{}' not found", keyspace, cf));
+        }
+        std::optional<dht::token_range::bound> start;
+        if (auto start_token = req->get_query_param("start_token"); start_token != "") {
+            start = dht::token_range::bound(dht::token::from_sstring(start_token), false);
+        }
+        std::optional<dht::token_range::bound> end;
+        if (auto end_token = req->get_query_param("end_token"); end_token != "") {
+            end = dht::token_range::bound(dht::token::from_sstring(end_token), true);
+        }
+        auto range = dht::token_range(std::move(start), std::move(end));
+        auto split_size_param = req->get_query_param("split_size_mb");
+        uint64_t split_size = (split_size_param.empty() ? 64 : boost::lexical_cast<uint64_t>(split_size_param)) << 20;
+        if (!split_size) {
+            throw bad_param_exception("split_size_mb must be positive");
+        }
+        return ctx.db.map_reduce0([uuid] (database& db) {
+            return db.find_column_family(uuid).get_sstable_set().size_histogram();
+        }, sstables::token_range_size_histogram(), [] (sstables::token_range_size_histogram a, const sstables::token_range_size_histogram& b) {
+            a.merge(b);
+            return a;
+        }).then([range = std::move(range), split_size] (const sstables::token_range_size_histogram& hist) {
+            std::vector<ss::token_range_split> res;
+            for (auto& subrange : hist.split_ranges(range, split_size)) {
+                ss::token_range_split split;
+                split.start_token = subrange.start() ? subrange.start()->value().to_sstring() : "";
+                split.end_token = subrange.end() ? subrange.end()->value().to_sstring() : "";
+                split.estimated_size = hist.estimate_for(subrange).data_size;
+                res.push_back(std::move(split));
+            }
+            return make_ready_future<json::json_return_type>(std::move(res));
+        });
+    });
+
     ss::get_host_id_map.set(r, [&ctx](const_req req) {
         std::vector<ss::mapper> res;
         return map_to_key_value(ctx.get_token_metadata().get_endpoint_to_host_id_map_for_reading(), res);
@@ -22,10 +22,13 @@
 #include "api/api-doc/system.json.hh"
 #include "api/api.hh"
 
+#include <algorithm>
+
 #include <seastar/core/reactor.hh>
 #include <seastar/http/exception.hh>
 #include "log.hh"
 #include "database.hh"
+#include "utils/stall_flight_recorder.hh"
 
 extern logging::logger apilog;
 
@@ -85,4 +88,54 @@ void set_system(http_context& ctx, routes& r) {
     });
 }
 
+void set_stall_recorder(http_context& ctx, routes& r, sharded<utils::stall_flight_recorder>& recorder) {
+    hs::get_reactor_stalls.set(r, [&recorder](std::unique_ptr<request> req) {
+        // The json objects are built on this shard, from plain data brought
+        // over from the others.
+        struct stall {
+            unsigned shard;
+            int64_t at;
+            sstring scheduling_group;
+            sstring backtrace;
+        };
+        auto map = [] (utils::stall_flight_recorder& recorder) {
+            std::vector<stall> res;
+            for (auto& e : recorder.entries()) {
+                sstring bt;
+                for (size_t i = 0; i < e.nr_frames; ++i) {
+                    bt += format(" 0x{:x}", e.frames[i]);
+                }
+                res.push_back(stall{
+                    this_shard_id(),
+                    std::chrono::duration_cast<std::chrono::milliseconds>(e.when.time_since_epoch()).count(),
+                    e.sg.name(),
+                    std::move(bt)});
+            }
+            return res;
+        };
+        auto reduce = [] (std::vector<stall> a, std::vector<stall>&& b) {
+            a.insert(a.end(), std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
+            return a;
+        };
+        return recorder.map_reduce0(map, std::vector<stall>(), reduce).then([] (std::vector<stall> stalls) {
+            std::sort(stalls.begin(), stalls.end(), [] (const stall& a, const stall& b) { return a.at > b.at; });
+            std::vector<hs::reactor_stall> res;
+            res.reserve(stalls.size());
+            for (auto& s : stalls) {
+                hs::reactor_stall r;
+                r.shard = s.shard;
+                r.at = s.at;
+                r.scheduling_group = s.scheduling_group;
+                r.backtrace = s.backtrace;
+                res.push_back(std::move(r));
+            }
+            return make_ready_future<json::json_return_type>(res);
+        });
+    });
+}
+
+void unset_stall_recorder(http_context& ctx, routes& r) {
+    hs::get_reactor_stalls.unset(r);
+}
+
 }
@@ -21,10 +21,15 @@
 
 #pragma once
 
+#include <seastar/core/sharded.hh>
 #include "api.hh"
 
+namespace utils { class stall_flight_recorder; }
+
 namespace api {
 
 void set_system(http_context& ctx, routes& r);
+void set_stall_recorder(http_context& ctx, routes& r, sharded<utils::stall_flight_recorder>& recorder);
+void unset_stall_recorder(http_context& ctx, routes& r);
 
 }
@@ -86,7 +86,16 @@ password_authenticator::~password_authenticator() {
 password_authenticator::password_authenticator(cql3::query_processor& qp, ::service::migration_manager& mm)
     : _qp(qp)
     , _migration_manager(mm)
-    , _stopped(make_ready_future<>()) {
+    , _stopped(make_ready_future<>())
+    , _hash_cache(
+              qp.db().get_config().permissions_cache_max_entries(),
+              std::chrono::milliseconds(qp.db().get_config().permissions_validity_in_ms()),
+              std::chrono::milliseconds(qp.db().get_config().permissions_update_interval_in_ms()),
+              plogger,
+              [this](const sstring& role_name) {
+                  plogger.debug("Refreshing password hash for {}", role_name);
+                  return query_salted_hash(role_name);
+              }) {
 }
 
 static bool has_salted_hash(const cql3::untyped_result_set_row& row) {
@@ -184,7 +193,9 @@ future<> password_authenticator::start() {
 
 future<> password_authenticator::stop() {
     _as.request_abort();
-    return _stopped.handle_exception_type([] (const sleep_aborted&) { }).handle_exception_type([](const abort_requested_exception&) {});
+    return _hash_cache.stop().then([this] {
+        return _stopped.handle_exception_type([] (const sleep_aborted&) { }).handle_exception_type([](const abort_requested_exception&) {});
+    });
 }
 
 db::consistency_level password_authenticator::consistency_for_user(std::string_view role_name) {
@@ -222,30 +233,11 @@ future<authenticated_user> password_authenticator::authenticate(
     auto& username = credentials.at(USERNAME_KEY);
     auto& password = credentials.at(PASSWORD_KEY);
 
-    // Here was a thread local, explicit cache of prepared statement. In normal execution this is
-    // fine, but since we in testing set up and tear down system over and over, we'd start using
-    // obsolete prepared statements pretty quickly.
-    // Rely on query processing caching statements instead, and lets assume
-    // that a map lookup string->statement is not gonna kill us much.
-    return futurize_invoke([this, username, password] {
-        static const sstring query = format("SELECT {} FROM {} WHERE {} = ?",
-                SALTED_HASH,
-                meta::roles_table::qualified_name,
-                meta::roles_table::role_col_name);
-
-        return _qp.execute_internal(
-                query,
-                consistency_for_user(username),
-                internal_distributed_query_state(),
-                {username},
-                true);
-    }).then_wrapped([=](future<::shared_ptr<cql3::untyped_result_set>> f) {
+    return futurize_invoke([this, username] {
+        return _hash_cache.get(username);
+    }).then_wrapped([=](future<std::optional<sstring>> f) {
         try {
-            auto res = f.get0();
-            auto salted_hash = std::optional<sstring>();
-            if (!res->empty()) {
-                salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
-            }
+            auto salted_hash = f.get0();
             if (!salted_hash || !passwords::check(password, *salted_hash)) {
                 throw exceptions::authentication_exception("Username and/or password are incorrect");
             }
@@ -262,6 +254,31 @@ future<authenticated_user> password_authenticator::authenticate(
     });
 }
 
+future<std::optional<sstring>> password_authenticator::query_salted_hash(const sstring& username) const {
+    // Here was a thread local, explicit cache of prepared statement. In normal execution this is
+    // fine, but since we in testing set up and tear down system over and over, we'd start using
+    // obsolete prepared statements pretty quickly.
+    // Rely on query processing caching statements instead, and lets assume
+    // that a map lookup string->statement is not gonna kill us much.
+    static const sstring query = format("SELECT {} FROM {} WHERE {} = ?",
+            SALTED_HASH,
+            meta::roles_table::qualified_name,
+            meta::roles_table::role_col_name);
+
+    return _qp.execute_internal(
+            query,
+            consistency_for_user(username),
+            internal_distributed_query_state(),
+            {username},
+            true).then([](::shared_ptr<cql3::untyped_result_set> res) {
+        auto salted_hash = std::optional<sstring>();
+        if (!res->empty()) {
+            salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
+        }
+        return make_ready_future<std::optional<sstring>>(std::move(salted_hash));
+    });
+}
+
 future<> password_authenticator::create(std::string_view role_name, const authentication_options& options) const {
     if (!options.password) {
         return make_ready_future<>();
@@ -271,7 +288,12 @@ future<> password_authenticator::create(std::string_view role_name, const authen
             update_row_query(),
             consistency_for_user(role_name),
             internal_distributed_query_state(),
-            {passwords::hash(*options.password, rng_for_salt), sstring(role_name)}).discard_result();
+            {passwords::hash(*options.password, rng_for_salt), sstring(role_name)}).discard_result().then([this, role_name = sstring(role_name)] {
+        // Only drops the entry on this shard; the other shards (and the
+        // other nodes) pick up the change when their entries refresh,
+        // just like the permissions cache.
+        _hash_cache.remove(role_name);
+    });
 }
 
 future<> password_authenticator::alter(std::string_view role_name, const authentication_options& options) const {
@@ -288,7 +310,9 @@ future<> password_authenticator::alter(std::string_view role_name, const authent
             query,
             consistency_for_user(role_name),
             internal_distributed_query_state(),
-            {passwords::hash(*options.password, rng_for_salt), sstring(role_name)}).discard_result();
+            {passwords::hash(*options.password, rng_for_salt), sstring(role_name)}).discard_result().then([this, role_name = sstring(role_name)] {
+        _hash_cache.remove(role_name);
+    });
 }
 
 future<> password_authenticator::drop(std::string_view name) const {
@@ -300,7 +324,9 @@ future<> password_authenticator::drop(std::string_view name) const {
     return _qp.execute_internal(
             query, consistency_for_user(name),
             internal_distributed_query_state(),
-            {sstring(name)}).discard_result();
+            {sstring(name)}).discard_result().then([this, name = sstring(name)] {
+        _hash_cache.remove(name);
+    });
 }
 
 future<custom_options> password_authenticator::query_custom_options(std::string_view role_name) const {
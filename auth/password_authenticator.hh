@@ -45,6 +45,7 @@
 
 #include "auth/authenticator.hh"
 #include "cql3/query_processor.hh"
+#include "utils/loading_cache.hh"
 
 namespace service {
 class migration_manager;
@@ -55,10 +56,23 @@ namespace auth {
 extern const std::string_view password_authenticator_name;
 
 class password_authenticator : public authenticator {
+    // Salted password hashes by role name, so that in steady state
+    // authenticating a connection does not read system_auth at all.
+    // An engaged entry holding std::nullopt means the role has no hash
+    // (or does not exist) - failed logins are cached too, so a storm of
+    // bad credentials does not turn into a storm of reads either.
+    // Entries expire and refresh on the same schedule as the
+    // permissions cache.
+    using hash_cache_type = utils::loading_cache<
+            sstring,
+            std::optional<sstring>,
+            utils::loading_cache_reload_enabled::yes>;
+
     cql3::query_processor& _qp;
     ::service::migration_manager& _migration_manager;
     future<> _stopped;
     seastar::abort_source _as;
+    mutable hash_cache_type _hash_cache;
 
 public:
     static db::consistency_level consistency_for_user(std::string_view role_name);
@@ -99,6 +113,8 @@ private:
     future<> migrate_legacy_metadata() const;
 
     future<> create_default_if_missing() const;
+
+    future<std::optional<sstring>> query_salted_hash(const sstring& role_name) const;
 };
 
 }
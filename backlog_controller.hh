@@ -26,6 +26,7 @@
 #include <seastar/core/file.hh>
 #include <chrono>
 #include <cmath>
+#include <optional>
 
 #include "seastarx.hh"
 
@@ -68,6 +69,23 @@ protected:
     std::vector<control_point> _control_points;
 
     std::function<float()> _current_backlog;
+    // How far ahead the control curve is evaluated: the backlog is projected
+    // along its measured growth rate by this much before interpolation, so the
+    // controller reacts to the balance between ingest and drain rates instead
+    // of only to the accumulated backlog. Zero keeps the controller purely
+    // proportional.
+    std::chrono::milliseconds _lookahead = std::chrono::milliseconds(0);
+    // Share updates that deviate from the currently applied value by less than
+    // this fraction of it are suppressed, so measurement noise around a stable
+    // operating point doesn't cause continuous small quota changes.
+    float _hysteresis_threshold = 0.0f;
+    // Backlog seen by the previous adjust() round, to measure the growth rate.
+    std::optional<float> _previous_backlog;
+    // Exponential moving average of the backlog's growth rate; the raw
+    // per-interval derivative is too noisy to act on directly.
+    float _smoothed_rate = 0.0f;
+    // Last shares value applied by update_controller().
+    float _current_shares = 0.0f;
     // updating shares for an I/O class may contact another shard and returns a future.
     future<> _inflight_update;
 
@@ -76,13 +94,16 @@ protected:
     void adjust();
 
     backlog_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, std::chrono::milliseconds interval,
-                       std::vector<control_point> control_points, std::function<float()> backlog)
+                       std::vector<control_point> control_points, std::function<float()> backlog,
+                       std::chrono::milliseconds lookahead = std::chrono::milliseconds(0), float hysteresis_threshold = 0.0f)
         : _scheduling_group(sg)
         , _io_priority(iop)
         , _interval(interval)
         , _update_timer([this] { adjust(); })
         , _control_points()
         , _current_backlog(std::move(backlog))
+        , _lookahead(lookahead)
+        , _hysteresis_threshold(hysteresis_threshold)
         , _inflight_update(make_ready_future<>())
     {
         _control_points.insert(_control_points.end(), control_points.begin(), control_points.end());
@@ -106,6 +127,16 @@ public:
     seastar::scheduling_group sg() {
         return _scheduling_group;
     }
+
+    // Re-applies a static shares value after a configuration reload. Only
+    // meaningful for controllers created in static-shares mode; a no-op while
+    // the backlog-driven controller is active, since it would be overwritten
+    // on the next adjust() anyway.
+    void update_static_shares(float shares) {
+        if (!_update_timer.armed()) {
+            update_controller(shares);
+        }
+    }
 };
 
 // memtable flush CPU controller.
@@ -140,11 +171,22 @@ public:
     static constexpr unsigned normalization_factor = 30;
     static constexpr float disable_backlog = std::numeric_limits<double>::infinity();
     static constexpr float backlog_disabled(float backlog) { return std::isinf(backlog); }
+    // The backlog's growth rate is the difference between the ingest rate and
+    // the compaction drain rate, so evaluating the curve this far ahead of the
+    // measured backlog closes the loop over the two rates: shares rise while
+    // writes outpace compaction and fall back as soon as draining overtakes
+    // ingest, instead of waiting for the backlog itself to cross the control
+    // points in either direction.
+    static constexpr std::chrono::seconds lookahead = std::chrono::seconds(100);
+    // Suppress share updates within 5% of the current value; they wouldn't
+    // change throughput measurably but would make the quota flap.
+    static constexpr float hysteresis_threshold = 0.05f;
     compaction_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, float static_shares) : backlog_controller(sg, iop, static_shares) {}
     compaction_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, std::chrono::milliseconds interval, std::function<float()> current_backlog)
         : backlog_controller(sg, iop, std::move(interval),
           std::vector<backlog_controller::control_point>({{0.0, 50}, {1.5, 100} , {normalization_factor, 1000}}),
-          std::move(current_backlog)
+          std::move(current_backlog),
+          lookahead, hysteresis_threshold
         )
     {}
 };
@@ -66,10 +66,12 @@ public:
         { }
         int operator()(const clustering_key_prefix& p1, int32_t w1, const clustering_key_prefix& p2, int32_t w2) const {
             auto type = _s.get().clustering_key_prefix_type();
-            auto res = prefix_equality_tri_compare(type->types().begin(),
+            auto res = prefix_equality_tri_compare(type->compare_fns().begin(),
                 type->begin(p1.representation()), type->end(p1.representation()),
                 type->begin(p2.representation()), type->end(p2.representation()),
-                ::tri_compare);
+                [] (const auto& cmp, managed_bytes_view v1, managed_bytes_view v2) -> int {
+                    return cmp(v1, v2);
+                });
             if (res) {
                 return res;
             }
@@ -34,11 +34,34 @@ enum class allow_prefixes { no, yes };
 
 template<allow_prefixes AllowPrefixes = allow_prefixes::no>
 class compound_type final {
+public:
+    // One entry of the flat comparison plan: a component's type together with
+    // its compare routine resolved to a plain function, so that comparing a
+    // component doesn't dispatch on the type kind.
+    class component_compare {
+        const abstract_type* _type;
+        abstract_type::tri_compare_fn _fn;
+    public:
+        component_compare(const data_type& t) : _type(t.get()), _fn(t->compare_fn()) {}
+        int operator()(managed_bytes_view v1, managed_bytes_view v2) const {
+            return _fn(*_type, v1, v2);
+        }
+    };
 private:
     const std::vector<data_type> _types;
+    const std::vector<component_compare> _compare_fns;
     const bool _byte_order_equal;
     const bool _byte_order_comparable;
     const bool _is_reversed;
+
+    static std::vector<component_compare> make_compare_fns(const std::vector<data_type>& types) {
+        std::vector<component_compare> fns;
+        fns.reserve(types.size());
+        for (auto&& t : types) {
+            fns.emplace_back(t);
+        }
+        return fns;
+    }
 public:
     static constexpr bool is_prefixable = AllowPrefixes == allow_prefixes::yes;
     using prefix_type = compound_type<allow_prefixes::yes>;
@@ -47,6 +70,7 @@ public:
 
     compound_type(std::vector<data_type> types)
         : _types(std::move(types))
+        , _compare_fns(make_compare_fns(_types))
         , _byte_order_equal(std::all_of(_types.begin(), _types.end(), [] (const auto& t) {
                 return t->is_byte_order_equal();
             }))
@@ -60,6 +84,11 @@ public:
         return _types;
     }
 
+    // The flat comparison plan, one entry per component, in component order.
+    const std::vector<component_compare>& compare_fns() const {
+        return _compare_fns;
+    }
+
     bool is_singular() const {
         return _types.size() == 1;
     }
@@ -221,23 +250,14 @@ public:
         return result;
     }
     bool less(managed_bytes_view b1, managed_bytes_view b2) const {
-        return with_linearized(b1, [&] (bytes_view bv1) {
-            return with_linearized(b2, [&] (bytes_view bv2) {
-                return less(bv1, bv2);
-            });
-        });
+        return compare(b1, b2) < 0;
     }
     bool less(bytes_view b1, bytes_view b2) const {
         return compare(b1, b2) < 0;
     }
-    size_t hash(managed_bytes_view v) const{
-        return with_linearized(v, [&] (bytes_view v) {
-            return hash(v);
-        });
-    }
-    size_t hash(bytes_view v) const {
+    size_t hash(managed_bytes_view v) const {
         if (_byte_order_equal) {
-            return std::hash<bytes_view>()(v);
+            return std::hash<managed_bytes_view>()(v);
         }
         auto t = _types.begin();
         size_t h = 0;
@@ -247,14 +267,12 @@ public:
         }
         return h;
     }
-    int compare(managed_bytes_view b1, managed_bytes_view b2) const {
-        return with_linearized(b1, [&] (bytes_view bv1) {
-            return with_linearized(b2, [&] (bytes_view bv2) {
-                return compare(bv1, bv2);
-            });
-        });
+    size_t hash(bytes_view v) const {
+        // Produces the same digest as the fragmented overload above --
+        // both feed the size and then the content into bytes_view_hasher.
+        return hash(managed_bytes_view(v));
     }
-    int compare(bytes_view b1, bytes_view b2) const {
+    int compare(managed_bytes_view b1, managed_bytes_view b2) const {
         if (_byte_order_comparable) {
             if (_is_reversed) {
                 return compare_unsigned(b2, b1);
@@ -262,11 +280,14 @@ public:
                 return compare_unsigned(b1, b2);
             }
         }
-        return lexicographical_tri_compare(_types.begin(), _types.end(),
-            begin(b1), end(b1), begin(b2), end(b2), [] (auto&& type, auto&& v1, auto&& v2) {
-                return type->compare(v1, v2);
+        return lexicographical_tri_compare(_compare_fns.begin(), _compare_fns.end(),
+            begin(b1), end(b1), begin(b2), end(b2), [] (const component_compare& cmp, auto&& v1, auto&& v2) -> int {
+                return cmp(v1, v2);
             });
     }
+    int compare(bytes_view b1, bytes_view b2) const {
+        return compare(managed_bytes_view(b1), managed_bytes_view(b2));
+    }
     // Retruns true iff given prefix has no missing components
     bool is_full(managed_bytes_view v) const {
         assert(AllowPrefixes == allow_prefixes::yes);
@@ -296,19 +317,15 @@ public:
         }
     }
     bool equal(managed_bytes_view v1, managed_bytes_view v2) const {
-        return with_linearized(v1, [&] (bytes_view bv1) {
-            return with_linearized(v2, [&] (bytes_view bv2) {
-                return equal(bv1, bv2);
-            });
-        });
-    }
-    bool equal(bytes_view v1, bytes_view v2) const {
         if (_byte_order_equal) {
-            return compare_unsigned(v1, v2) == 0;
+            return equal_unsigned(v1, v2);
         }
         // FIXME: call equal() on each component
         return compare(v1, v2) == 0;
     }
+    bool equal(bytes_view v1, bytes_view v2) const {
+        return equal(managed_bytes_view(v1), managed_bytes_view(v2));
+    }
 };
 
 using compound_prefix = compound_type<allow_prefixes::yes>;
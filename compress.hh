@@ -23,12 +23,14 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 
 #include "exceptions/exceptions.hh"
+#include "bytes.hh"
 
 
 class compressor {
@@ -55,6 +57,48 @@ public:
      */
     virtual size_t compress_max_size(size_t input_len) const = 0;
 
+    /**
+     * A digested compression dictionary, ready to be passed to the
+     * dictionary-aware compress()/uncompress() overloads. Opaque to callers;
+     * the concrete type belongs to the compressor which created it.
+     */
+    class dict {
+    public:
+        virtual ~dict() = default;
+    };
+    using dict_ptr = shared_ptr<dict>;
+
+    /**
+     * Whether this compressor can compress chunks against a shared,
+     * pre-trained dictionary. Compressors which can, override the four
+     * methods below; the defaults report no support.
+     */
+    virtual bool supports_dictionaries() const {
+        return false;
+    }
+    /**
+     * Trains a dictionary of at most max_dict_size bytes from sample chunks.
+     * Returns an empty buffer if training failed (e.g. too few samples).
+     */
+    virtual bytes train_dictionary(const std::vector<bytes>& samples, size_t max_dict_size) const {
+        return {};
+    }
+    /**
+     * Digests a raw dictionary for use with the dictionary-aware
+     * compress()/uncompress() overloads.
+     */
+    virtual dict_ptr make_dictionary(bytes_view raw) const {
+        return nullptr;
+    }
+    virtual size_t uncompress(const char* input, size_t input_len, char* output,
+                    size_t output_len, const dict&) const {
+        throw std::runtime_error("compressor " + _name + " does not support dictionaries");
+    }
+    virtual size_t compress(const char* input, size_t input_len, char* output,
+                    size_t output_len, const dict&) const {
+        throw std::runtime_error("compressor " + _name + " does not support dictionaries");
+    }
+
     /**
      * Returns accepted option names for this compressor
      */
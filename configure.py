@@ -378,6 +378,7 @@ scylla_tests = set([
     'test/boost/auth_test',
     'test/boost/batchlog_manager_test',
     'test/boost/big_decimal_test',
+    'test/boost/bloom_filter_test',
     'test/boost/broken_sstable_test',
     'test/boost/bytes_ostream_test',
     'test/boost/cache_flat_mutation_reader_test',
@@ -526,8 +527,11 @@ scylla_tests = set([
     'test/perf/perf_collection',
     'test/perf/perf_row_cache_update',
     'test/perf/perf_row_cache_reads',
+    'test/perf/perf_row_cache_stress',
+    'test/perf/perf_read_amplification',
     'test/perf/perf_simple_query',
     'test/perf/perf_sstable',
+    'test/perf/perf_write_pipeline',
     'test/unit/lsa_async_eviction_test',
     'test/unit/lsa_sync_eviction_test',
     'test/unit/row_cache_alloc_stress_test',
@@ -561,6 +565,7 @@ apps = set([
     'test/tools/cql_repl',
     'tools/scylla-types',
     'tools/scylla-sstable-index',
+    'tools/scylla-sstable',
 ])
 
 tests = scylla_tests | perf_tests | raft_tests
@@ -683,6 +688,9 @@ scylla_core = (['database.cc',
                 'utils/buffer_input_stream.cc',
                 'utils/limiting_data_source.cc',
                 'utils/updateable_value.cc',
+                'utils/linux-perf-event.cc',
+                'utils/cpu_counter_metrics.cc',
+                'utils/stall_flight_recorder.cc',
                 'utils/directories.cc',
                 'utils/generation-number.cc',
                 'utils/rjson.cc',
@@ -1126,6 +1134,7 @@ deps = {
     #FIXME: we don't need all of scylla_core here, only the types module, need to modularize scylla_core.
     'tools/scylla-types': idls + ['tools/scylla-types.cc'] + scylla_core,
     'tools/scylla-sstable-index': idls + ['tools/scylla-sstable-index.cc'] + scylla_core,
+    'tools/scylla-sstable': idls + ['tools/scylla-sstable.cc'] + scylla_core,
 }
 
 pure_boost_tests = set([
@@ -1207,7 +1216,7 @@ perf_tests_seastar_deps = [
 
 for t in perf_tests:
     deps[t] = [t + '.cc'] + scylla_tests_dependencies + perf_tests_seastar_deps
-    deps[t] += ['test/perf/perf.cc', 'test/perf/linux-perf-event.cc']
+    deps[t] += ['test/perf/perf.cc', 'utils/linux-perf-event.cc']
 
 deps['test/boost/sstable_test'] += ['test/lib/normalizing_reader.cc']
 deps['test/boost/sstable_datafile_test'] += ['test/lib/normalizing_reader.cc']
@@ -1229,10 +1238,12 @@ deps['test/boost/allocation_strategy_test'] = ['test/boost/allocation_strategy_t
 deps['test/boost/log_heap_test'] = ['test/boost/log_heap_test.cc']
 deps['test/boost/estimated_histogram_test'] = ['test/boost/estimated_histogram_test.cc']
 deps['test/boost/anchorless_list_test'] = ['test/boost/anchorless_list_test.cc']
-deps['test/perf/perf_fast_forward'] += ['release.cc', 'test/perf/linux-perf-event.cc']
-deps['test/perf/perf_simple_query'] += ['release.cc', 'test/perf/perf.cc', 'test/perf/linux-perf-event.cc', 'test/lib/alternator_test_env.cc'] + alternator
-deps['test/perf/perf_row_cache_reads'] += ['test/perf/perf.cc', 'test/perf/linux-perf-event.cc']
-deps['test/perf/perf_row_cache_update'] += ['test/perf/perf.cc', 'test/perf/linux-perf-event.cc']
+deps['test/perf/perf_fast_forward'] += ['release.cc', 'utils/linux-perf-event.cc']
+deps['test/perf/perf_simple_query'] += ['release.cc', 'test/perf/perf.cc', 'utils/linux-perf-event.cc', 'test/lib/alternator_test_env.cc'] + alternator
+deps['test/perf/perf_row_cache_reads'] += ['test/perf/perf.cc', 'utils/linux-perf-event.cc']
+deps['test/perf/perf_row_cache_update'] += ['test/perf/perf.cc', 'utils/linux-perf-event.cc']
+deps['test/perf/perf_row_cache_stress'] += ['test/perf/perf.cc', 'utils/linux-perf-event.cc']
+deps['test/perf/perf_write_pipeline'] += ['test/perf/perf.cc', 'utils/linux-perf-event.cc']
 deps['test/boost/reusable_buffer_test'] = [
     "test/boost/reusable_buffer_test.cc",
     "test/lib/log.cc",
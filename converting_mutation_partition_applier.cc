@@ -104,6 +104,20 @@ converting_mutation_partition_applier::accept_cell(row& dst, column_kind kind, c
   });
 }
 
+static std::vector<const column_definition*>
+make_column_translation(const column_mapping& visited_column_mapping, const schema& s, column_kind kind) {
+    auto& columns = visited_column_mapping.columns();
+    auto n_static = visited_column_mapping.n_static();
+    auto first = kind == column_kind::static_column ? 0 : n_static;
+    auto count = kind == column_kind::static_column ? n_static : columns.size() - n_static;
+    std::vector<const column_definition*> translation;
+    translation.reserve(count);
+    for (auto i = first; i != first + count; ++i) {
+        translation.push_back(s.get_column_definition(columns[i].name()));
+    }
+    return translation;
+}
+
 converting_mutation_partition_applier::converting_mutation_partition_applier(
         const column_mapping& visited_column_mapping,
         const schema& target_schema,
@@ -111,6 +125,8 @@ converting_mutation_partition_applier::converting_mutation_partition_applier(
     : _p_schema(target_schema)
     , _p(target)
     , _visited_column_mapping(visited_column_mapping)
+    , _static_translation(make_column_translation(visited_column_mapping, target_schema, column_kind::static_column))
+    , _regular_translation(make_column_translation(visited_column_mapping, target_schema, column_kind::regular_column))
 { }
 
 
@@ -127,7 +143,7 @@ converting_mutation_partition_applier::accept_static_cell(column_id id, atomic_c
 void
 converting_mutation_partition_applier::accept_static_cell(column_id id, atomic_cell_view cell) {
     const column_mapping_entry& col = _visited_column_mapping.static_column_at(id);
-    const column_definition* def = _p_schema.get_column_definition(col.name());
+    const column_definition* def = _static_translation[id];
     if (def) {
         accept_cell(_p._static_row.maybe_create(), column_kind::static_column, *def, *col.type(), cell);
     }
@@ -136,7 +152,7 @@ converting_mutation_partition_applier::accept_static_cell(column_id id, atomic_c
 void
 converting_mutation_partition_applier::accept_static_cell(column_id id, collection_mutation_view collection) {
     const column_mapping_entry& col = _visited_column_mapping.static_column_at(id);
-    const column_definition* def = _p_schema.get_column_definition(col.name());
+    const column_definition* def = _static_translation[id];
     if (def) {
         accept_cell(_p._static_row.maybe_create(), column_kind::static_column, *def, *col.type(), collection);
     }
@@ -163,7 +179,7 @@ converting_mutation_partition_applier::accept_row_cell(column_id id, atomic_cell
 void
 converting_mutation_partition_applier::accept_row_cell(column_id id, atomic_cell_view cell) {
     const column_mapping_entry& col = _visited_column_mapping.regular_column_at(id);
-    const column_definition* def = _p_schema.get_column_definition(col.name());
+    const column_definition* def = _regular_translation[id];
     if (def) {
         accept_cell(_current_row->cells(), column_kind::regular_column, *def, *col.type(), cell);
     }
@@ -172,7 +188,7 @@ converting_mutation_partition_applier::accept_row_cell(column_id id, atomic_cell
 void
 converting_mutation_partition_applier::accept_row_cell(column_id id, collection_mutation_view collection) {
     const column_mapping_entry& col = _visited_column_mapping.regular_column_at(id);
-    const column_definition* def = _p_schema.get_column_definition(col.name());
+    const column_definition* def = _regular_translation[id];
     if (def) {
         accept_cell(_current_row->cells(), column_kind::regular_column, *def, *col.type(), collection);
     }
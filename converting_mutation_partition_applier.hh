@@ -23,10 +23,13 @@
 
 #include "mutation_partition_visitor.hh"
 
+#include <vector>
+
 class schema;
 class row;
 class mutation_partition;
 class column_mapping;
+class column_definition;
 class deletable_row;
 
 // Mutation partition visitor which applies visited data into
@@ -37,6 +40,13 @@ class converting_mutation_partition_applier : public mutation_partition_visitor
     const schema& _p_schema;
     mutation_partition& _p;
     const column_mapping& _visited_column_mapping;
+    // Resolves visited column ids to _p_schema definitions positionally,
+    // built once per partition so that accepting a cell is an array lookup
+    // rather than a name-based search in _p_schema (cf. sstables::column_translation,
+    // which plays the same role on the read path). nullptr means the column
+    // is not present in _p_schema and its cells are dropped.
+    std::vector<const column_definition*> _static_translation;
+    std::vector<const column_definition*> _regular_translation;
     deletable_row* _current_row;
 private:
     static bool is_compatible(const column_definition& new_def, const abstract_type& old_type, column_kind kind);
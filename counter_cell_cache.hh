@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <boost/intrusive/list.hpp>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "counters.hh"
+#include "keys.hh"
+
+namespace bi = boost::intrusive;
+
+// Write-through cache of this node's own counter shards, used to elide the
+// replica-side read-before-write on the counter update path.
+//
+// Applying a counter update requires the current value and logical clock of
+// the local shard of every modified cell, which normally means a read from
+// the memtables and sstables. However, the local shard is only ever advanced
+// by this node, under the counter cell locks, so once we have seen (or
+// created) it we can keep the latest version in memory and skip the read
+// entirely for subsequent updates of the same cell. Entries never lag behind
+// the on-disk state within a single process lifetime; writes that may reset
+// cell state out-of-band (truncation, schema changes, failed memtable
+// applies) must invalidate the cache.
+//
+// The cache is per-table and per-shard and bounded; least recently updated
+// entries are evicted first. A miss simply falls back to the regular
+// read-before-write path, which then repopulates the cache.
+class counter_cell_cache {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    static constexpr size_t max_entries = 100'000;
+private:
+    struct entry : public bi::list_base_hook<bi::link_mode<bi::auto_unlink>> {
+        bytes key;
+        counter_shard shard;
+
+        entry(bytes k, counter_shard cs) noexcept
+            : key(std::move(k))
+            , shard(cs)
+        { }
+    };
+
+    using lru_type = bi::list<entry, bi::constant_time_size<false>>;
+
+    // Keys of _entries are views of entry::key, which is stable since entries
+    // are individually allocated.
+    std::unordered_map<bytes_view, std::unique_ptr<entry>> _entries;
+    lru_type _lru; // most recently updated first
+    stats _stats;
+private:
+    // Builds an unambiguous per-cell key. Both key representations are
+    // sequences of length-prefixed components with a component count fixed
+    // by the schema, so plain concatenation cannot collide. ck is nullptr
+    // for static row cells. The cache has to be invalidated on schema
+    // changes since column ids are not stable across them.
+    static bytes make_key(const partition_key& pk, const clustering_key* ck, column_id id) {
+        auto pk_rep = pk.representation();
+        auto ck_rep = ck ? ck->representation() : managed_bytes_view();
+        bytes b(bytes::initialized_later(), pk_rep.size() + 1 + ck_rep.size() + sizeof(column_id));
+        auto out = b.begin();
+        for (bytes_view frag : fragment_range(pk_rep)) {
+            out = std::copy(frag.begin(), frag.end(), out);
+        }
+        *out++ = ck ? 1 : 0;
+        for (bytes_view frag : fragment_range(ck_rep)) {
+            out = std::copy(frag.begin(), frag.end(), out);
+        }
+        out = std::copy_n(reinterpret_cast<const int8_t*>(&id), sizeof(column_id), out);
+        return b;
+    }
+public:
+    counter_cell_cache() = default;
+    counter_cell_cache(const counter_cell_cache&) = delete;
+    counter_cell_cache& operator=(const counter_cell_cache&) = delete;
+
+    ~counter_cell_cache() {
+        clear();
+    }
+
+    // Returns the cached local shard of the given cell, or disengaged if the
+    // caller needs to fall back to reading the current cell state.
+    std::optional<counter_shard> find(const partition_key& pk, const clustering_key* ck, column_id id) {
+        auto it = _entries.find(bytes_view(make_key(pk, ck, id)));
+        if (it == _entries.end()) {
+            _stats.misses++;
+            return { };
+        }
+        _stats.hits++;
+        return it->second->shard;
+    }
+
+    // Stores the latest local shard of the given cell. Must only be called
+    // with shards that have been durably applied to the memtables.
+    void put(const partition_key& pk, const clustering_key* ck, column_id id, const counter_shard& cs) {
+        auto key = make_key(pk, ck, id);
+        auto it = _entries.find(bytes_view(key));
+        if (it != _entries.end()) {
+            auto& e = *it->second;
+            e.shard = cs;
+            _lru.erase(_lru.iterator_to(e));
+            _lru.push_front(e);
+            return;
+        }
+        while (_entries.size() >= max_entries) {
+            auto& victim = _lru.back();
+            _entries.erase(bytes_view(victim.key)); // unlinks from _lru as well
+        }
+        auto e = std::make_unique<entry>(std::move(key), cs);
+        _lru.push_front(*e);
+        _entries.emplace(bytes_view(e->key), std::move(e));
+    }
+
+    void clear() {
+        _lru.clear();
+        _entries.clear();
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    const stats& get_stats() const {
+        return _stats;
+    }
+};
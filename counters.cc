@@ -20,6 +20,7 @@
  */
 
 #include "counters.hh"
+#include "counter_cell_cache.hh"
 #include "mutation.hh"
 #include "combine.hh"
 
@@ -270,3 +271,73 @@ void transform_counter_updates_to_shards(mutation& m, const mutation* current_st
         transform_row_to_shards(column_kind::regular_column, cr.row().cells(), it->row().cells());
     }
 }
+
+std::optional<mutation> counter_state_from_cache(counter_cell_cache& cache, const mutation& m) {
+    auto& s = *m.schema();
+    mutation state(m.schema(), m.decorated_key());
+    bool complete = true;
+
+    auto gather_row = [&] (column_kind kind, const auto& cells, const clustering_key* ck) {
+        cells.for_each_cell([&] (column_id id, const atomic_cell_or_collection& ac_o_c) {
+            if (!complete) {
+                return; // continue -- we are in lambda
+            }
+            auto& cdef = s.column_at(kind, id);
+            auto acv = ac_o_c.as_atomic_cell(cdef);
+            if (!acv.is_live()) {
+                return; // continue
+            }
+            auto cs = cache.find(m.key(), ck, id);
+            if (!cs) {
+                complete = false;
+                return; // continue
+            }
+            // Only value and logical clock of the shard matter to the
+            // transform, the timestamp of the cell is irrelevant.
+            auto cell = counter_cell_builder::from_single_shard(acv.timestamp(), *cs);
+            if (ck) {
+                state.set_clustered_cell(*ck, cdef, atomic_cell_or_collection(std::move(cell)));
+            } else {
+                state.set_static_cell(cdef, atomic_cell_or_collection(std::move(cell)));
+            }
+        });
+    };
+
+    gather_row(column_kind::static_column, m.partition().static_row(), nullptr);
+    for (auto& cr : m.partition().clustered_rows()) {
+        if (!complete) {
+            break;
+        }
+        gather_row(column_kind::regular_column, cr.row().cells(), &cr.key());
+    }
+
+    if (!complete) {
+        return { };
+    }
+    return state;
+}
+
+void update_counter_cache(counter_cell_cache& cache, const mutation& m, utils::UUID local_id) {
+    auto& s = *m.schema();
+
+    auto update_row = [&] (column_kind kind, const auto& cells, const clustering_key* ck) {
+        cells.for_each_cell([&] (column_id id, const atomic_cell_or_collection& ac_o_c) {
+            auto& cdef = s.column_at(kind, id);
+            auto acv = ac_o_c.as_atomic_cell(cdef);
+            if (!acv.is_live()) {
+                return; // continue -- we are in lambda
+            }
+            auto ccv = counter_cell_view(acv);
+            auto cs = ccv.get_shard(counter_id(local_id));
+            if (!cs) {
+                return; // continue
+            }
+            cache.put(m.key(), ck, id, counter_shard(*cs));
+        });
+    };
+
+    update_row(column_kind::static_column, m.partition().static_row(), nullptr);
+    for (auto& cr : m.partition().clustered_rows()) {
+        update_row(column_kind::regular_column, cr.row().cells(), &cr.key());
+    }
+}
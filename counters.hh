@@ -422,6 +422,20 @@ struct counter_cell_mutable_view : basic_counter_cell_view<mutable_view::yes> {
 // If current_state is present it has to be in the same schema as dst.
 void transform_counter_updates_to_shards(mutation& dst, const mutation* current_state, uint64_t clock_offset, utils::UUID local_id);
 
+class counter_cell_cache;
+
+// Attempts to reconstruct the current state of all counter cells modified by
+// the update m from the counter cell cache, so that the read-before-write can
+// be skipped. Returns a mutation suitable for passing as current_state to
+// transform_counter_updates_to_shards(), or disengaged optional if any of the
+// modified cells is not in the cache.
+std::optional<mutation> counter_state_from_cache(counter_cell_cache& cache, const mutation& m);
+
+// Stores the local shards of all counter cells of m in the counter cell
+// cache. m is expected to contain transformed counter cells that have been
+// successfully applied to the memtables.
+void update_counter_cache(counter_cell_cache& cache, const mutation& m, utils::UUID local_id);
+
 template<>
 struct appending_hash<counter_shard_view> {
     template<typename Hasher>
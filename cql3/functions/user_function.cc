@@ -65,7 +65,7 @@ bytes_opt user_function::execute(cql_serialization_format sf, const std::vector<
     if (!seastar::thread::running_in_thread()) {
         on_internal_error(log, "User function cannot be executed in this context");
     }
-    return lua::run_script(lua::bitcode_view{_bitcode}, values, return_type(), _cfg).get0();
+    return lua::run_script(lua::bitcode_view{_bitcode}, values, return_type(), _cfg, _reusable_state).get0();
 }
 }
 }
@@ -46,6 +46,12 @@ class user_function final : public abstract_function, public scalar_function {
     // global.
     lua::runtime_config _cfg;
 
+    // A lua interpreter kept between invocations of this function, so that
+    // each call doesn't have to rebuild one and reload the bytecode. Function
+    // instances are per-shard (the functions registry is thread_local), so no
+    // synchronization is needed.
+    lua::reusable_state _reusable_state;
+
 public:
     user_function(function_name name, std::vector<data_type> arg_types, std::vector<sstring> arg_names, sstring body,
             sstring language, data_type return_type, bool called_on_null_input, sstring bitcode,
@@ -172,6 +172,10 @@ public:
     virtual bool is_aggregate() const override {
         return _factories->does_aggregation();
     }
+
+    virtual bool is_count() const override {
+        return _factories->contains_only_count_rows_selector_factories();
+    }
 protected:
     class selectors_with_processing : public selectors {
     private:
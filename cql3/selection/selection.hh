@@ -198,6 +198,16 @@ public:
 
     virtual bool is_aggregate() const = 0;
 
+    /**
+     * Checks if this selection consists solely of row-counting aggregates (<code>COUNT(*)</code>),
+     * in which case its output can be computed from row counts alone, without looking at any cell.
+     *
+     * @return <code>true</code> if this selection only counts rows, <code>false</code> otherwise;
+     */
+    virtual bool is_count() const {
+        return false;
+    }
+
     /**
      * Checks that selectors are either all aggregates or that none of them is.
      *
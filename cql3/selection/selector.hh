@@ -177,6 +177,17 @@ public:
         return false;
     }
 
+    /**
+     * Checks if this factory creates selectors instances that count rows, i.e. the <code>COUNT(*)</code>
+     * aggregate, whose output depends only on the number of input rows.
+     *
+     * @return <code>true</code> if this factory creates selectors instances that count rows,
+     * <code>false</code> otherwise
+     */
+    virtual bool is_count_rows_selector_factory() const {
+        return false;
+    }
+
     /**
      * Returns the name of the column corresponding to the output value of the selector instances created by
      * this factory.
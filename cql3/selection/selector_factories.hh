@@ -41,6 +41,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include "cql3/selection/selector.hh"
 #include "cql3/selection/selectable.hh"
@@ -127,6 +128,18 @@ public:
         return _number_of_aggregate_factories > 0;
     }
 
+    /**
+     * Checks if this <code>SelectorFactories</code> contains only factories for row-counting aggregates.
+     *
+     * @return <code>true</code> if this <code>SelectorFactories</code> contains only factories for
+     * row-counting aggregates, <code>false</code> otherwise.
+     */
+    bool contains_only_count_rows_selector_factories() const {
+        return !_factories.empty() && std::all_of(_factories.begin(), _factories.end(), [] (auto&& factory) {
+            return factory->is_count_rows_selector_factory();
+        });
+    }
+
     /**
      * Checks if this <code>SelectorFactories</code> contains at least one factory for writetime selectors.
      *
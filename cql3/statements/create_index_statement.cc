@@ -186,14 +186,14 @@ void create_index_statement::validate_for_local_index(const schema& schema) cons
                 auto remaining_base_pk_columns = schema.partition_key_columns();
                 auto next_expected_base_column = remaining_base_pk_columns.begin();
                 for (const auto& ident : base_pk_identifiers) {
-                    auto it = schema.columns_by_name().find(ident->name());
-                    if (it == schema.columns_by_name().end() || !it->second->is_partition_key()) {
+                    const column_definition* cdef = schema.get_column_definition(ident->name());
+                    if (!cdef || !cdef->is_partition_key()) {
                         throw exceptions::invalid_request_exception(format("Local index definition must contain full partition key only. Redundant column: {}", ident->to_string()));
                     }
                     if (next_expected_base_column == remaining_base_pk_columns.end()) {
-                        throw exceptions::invalid_request_exception(format("Duplicate column definition in local index: {}", it->first));
+                        throw exceptions::invalid_request_exception(format("Duplicate column definition in local index: {}", cdef->name()));
                     }
-                    if (&*next_expected_base_column != it->second) {
+                    if (&*next_expected_base_column != cdef) {
                         break;
                     }
                     ++next_expected_base_column;
@@ -160,6 +160,18 @@ select_statement::select_statement(schema_ptr schema,
     _opts.set_if<query::partition_slice::option::bypass_cache>(_parameters->bypass_cache());
     _opts.set_if<query::partition_slice::option::distinct>(_parameters->is_distinct());
     _opts.set_if<query::partition_slice::option::reversed>(_is_reversed);
+
+    if (_selection->contains_static_columns()) {
+        _queried_static_columns.reserve(_selection->get_column_count());
+    }
+    _queried_regular_columns.reserve(_selection->get_column_count());
+    for (auto&& col : _selection->get_columns()) {
+        if (col->is_static()) {
+            _queried_static_columns.push_back(col->id);
+        } else if (col->is_regular()) {
+            _queried_regular_columns.push_back(col->id);
+        }
+    }
 }
 
 db::timeout_clock::duration select_statement::get_timeout(const service::client_state& state, const query_options& options) const {
@@ -210,26 +222,9 @@ const sstring& select_statement::column_family() const {
 query::partition_slice
 select_statement::make_partition_slice(const query_options& options) const
 {
-    query::column_id_vector static_columns;
-    query::column_id_vector regular_columns;
-
-    if (_selection->contains_static_columns()) {
-        static_columns.reserve(_selection->get_column_count());
-    }
-
-    regular_columns.reserve(_selection->get_column_count());
-
-    for (auto&& col : _selection->get_columns()) {
-        if (col->is_static()) {
-            static_columns.push_back(col->id);
-        } else if (col->is_regular()) {
-            regular_columns.push_back(col->id);
-        }
-    }
-
     if (_parameters->is_distinct()) {
         return query::partition_slice({ query::clustering_range::make_open_ended_both_sides() },
-            std::move(static_columns), {}, _opts, nullptr, options.get_cql_serialization_format());
+            _queried_static_columns, {}, _opts, nullptr, options.get_cql_serialization_format());
     }
 
     auto bounds =_restrictions->get_clustering_bounds(options);
@@ -245,7 +240,7 @@ select_statement::make_partition_slice(const query_options& options) const
         ++_stats.reverse_queries;
     }
     return query::partition_slice(std::move(bounds),
-        std::move(static_columns), std::move(regular_columns), _opts, nullptr, options.get_cql_serialization_format(), get_per_partition_limit(options));
+        _queried_static_columns, _queried_regular_columns, _opts, nullptr, options.get_cql_serialization_format(), get_per_partition_limit(options));
 }
 
 uint64_t select_statement::do_get_limit(const query_options& options, ::shared_ptr<term> limit, uint64_t default_limit) const {
@@ -378,6 +373,26 @@ select_statement::do_execute(service::storage_proxy& proxy,
             state, options, command, std::move(key_ranges), restrictions_need_filtering ? _restrictions : nullptr);
 
     if (aggregate || nonpaged_filtering) {
+        if (aggregate && _selection->is_count() && !has_group_by() && !restrictions_need_filtering && !_per_partition_limit) {
+            // A pure COUNT(*) doesn't look at any cell, so instead of feeding
+            // every fetched row through the selectors we can add up the row
+            // counts the replicas already attach to each page.
+            return do_with(uint64_t(0), std::move(p), [this, page_size, now, timeout] (uint64_t& row_count, std::unique_ptr<service::pager::query_pager>& p) {
+                return do_until([&p] { return p->is_exhausted(); },
+                        [&p, &row_count, page_size, now, timeout] {
+                            return p->fetch_page_row_count(page_size, now, timeout).then([&row_count] (uint64_t fetched) {
+                                row_count += fetched;
+                            });
+                        }
+                ).then([this, &row_count] {
+                    auto rs = std::make_unique<result_set>(::make_shared<metadata>(*_selection->get_result_metadata()));
+                    rs->add_row(std::vector<bytes_opt>(rs->get_metadata().value_count(), long_type->decompose(int64_t(row_count))));
+                    update_stats_rows_read(rs->size());
+                    auto msg = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+                    return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(std::move(msg));
+                });
+            });
+        }
         return do_with(
                 cql3::selection::result_set_builder(*_selection, now,
                         options.get_cql_serialization_format(), *_group_by_cell_indices), std::move(p),
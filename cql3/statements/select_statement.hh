@@ -94,6 +94,11 @@ protected:
     ordering_comparator_type _ordering_comparator;
 
     query::partition_slice::option_set _opts;
+    // The set of queried columns is fixed at prepare time, so it is computed
+    // once here and copied into the slice on each execution rather than
+    // re-derived from the selection.
+    query::column_id_vector _queried_static_columns;
+    query::column_id_vector _queried_regular_columns;
     cql_stats& _stats;
     const ks_selector _ks_sel;
     bool _range_scan = false;
@@ -41,6 +41,7 @@
 #include "sstables/sstables_manager.hh"
 #include "sstables/compaction.hh"
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/numeric.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/algorithm/find_if.hpp>
 #include <boost/range/algorithm/sort.hpp>
@@ -51,6 +52,7 @@
 #include "service/migration_manager.hh"
 #include "message/messaging_service.hh"
 #include "cell_locking.hh"
+#include "counter_cell_cache.hh"
 #include "view_info.hh"
 #include "db/schema_tables.hh"
 #include "sstables/compaction_manager.hh"
@@ -62,6 +64,8 @@
 #include "db/timeout_clock.hh"
 #include "db/large_data_handler.hh"
 #include "db/data_listeners.hh"
+#include "db/query_context.hh"
+#include "service/priority_manager.hh"
 
 #include "user_types_metadata.hh"
 #include <seastar/core/shared_ptr_incomplete.hh>
@@ -220,8 +224,15 @@ void database::setup_scylla_memory_diagnostics_producer() {
         writeln("  used:  {}\n", utils::to_hr_size(row_cache_occupancy_stats.used_space()));
         writeln("  free:  {}\n\n", utils::to_hr_size(row_cache_occupancy_stats.free_space()));
 
+        const auto system_cache_occupancy_stats = _system_row_cache_tracker.region().occupancy();
+        writeln("System cache:\n");
+        writeln("  total: {}\n", utils::to_hr_size(system_cache_occupancy_stats.total_space()));
+        writeln("  used:  {}\n", utils::to_hr_size(system_cache_occupancy_stats.used_space()));
+        writeln("  free:  {}\n\n", utils::to_hr_size(system_cache_occupancy_stats.free_space()));
+
         writeln("Memtables:\n");
-        writeln(" total: {}\n", utils::to_hr_size(lsa_occupancy_stats.total_space() - row_cache_occupancy_stats.total_space()));
+        writeln(" total: {}\n", utils::to_hr_size(lsa_occupancy_stats.total_space()
+                - row_cache_occupancy_stats.total_space() - system_cache_occupancy_stats.total_space()));
 
         writeln(" Regular:\n");
         writeln("  real dirty: {}\n", utils::to_hr_size(_dirty_memory_manager.real_dirty_memory()));
@@ -307,6 +318,11 @@ void database::setup_scylla_memory_diagnostics_producer() {
     });
 }
 
+// A few thousand partitions per table is enough to take the edge off a cold
+// cache without making the snapshot rows large or the warmup reads long.
+static constexpr size_t cache_warmup_max_keys_per_table = 1024;
+static constexpr std::chrono::minutes cache_warmup_save_interval{10};
+
 database::database(const db::config& cfg, database_config dbcfg, service::migration_notifier& mn, gms::feature_service& feat, const locator::shared_token_metadata& stm, abort_source& as, sharded<semaphore>& sst_dir_sem)
     : _stats(make_lw_shared<db_stats>())
     , _cl_stats(std::make_unique<cell_locker_stats>())
@@ -342,6 +358,7 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
             max_count_concurrent_reads,
             max_memory_system_concurrent_reads(),
             "_system_read_concurrency_sem")
+    , _system_row_cache_tracker("system_cache")
     , _data_query_stage("data_query", &column_family::query)
     , _mutation_query_stage("mutation_query", &column_family::mutation_query)
     , _apply_stage("db_apply", &database::do_apply)
@@ -351,7 +368,8 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _large_data_handler(std::make_unique<db::cql_table_large_data_handler>(_cfg.compaction_large_partition_warning_threshold_mb()*1024*1024,
               _cfg.compaction_large_row_warning_threshold_mb()*1024*1024,
               _cfg.compaction_large_cell_warning_threshold_mb()*1024*1024,
-              _cfg.compaction_rows_count_warning_threshold()))
+              _cfg.compaction_rows_count_warning_threshold(),
+              _cfg.large_read_tombstone_threshold()))
     , _nop_large_data_handler(std::make_unique<db::nop_large_data_handler>())
     , _user_sstables_manager(std::make_unique<sstables::sstables_manager>(*_large_data_handler, _cfg, feat))
     , _system_sstables_manager(std::make_unique<sstables::sstables_manager>(*_nop_large_data_handler, _cfg, feat))
@@ -368,13 +386,36 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _system_row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _system_row_cache_tracker.set_evict_reserve(size_t(_cfg.system_cache_reserve_size_in_mb()) << 20);
+
+    _querier_cache.set_entry_ttl(std::chrono::seconds(_cfg.querier_cache_entry_ttl_in_seconds()));
 
     _infinite_bound_range_deletions_reg = _feat.cluster_supports_unbounded_range_tombstones().when_enabled([this] {
         dblog.debug("Enabling infinite bound range deletions");
         _supports_infinite_bound_range_deletions = true;
     });
 
+    if (_cfg.hot_partition_tracking_capacity()) {
+        _hot_partitions_tracker = std::make_unique<db::hot_partitions_tracker>(*this, _cfg.hot_partition_tracking_capacity());
+    }
+
+    if (_cfg.large_read_sampling_frequency()) {
+        _large_read_sampler = std::make_unique<db::large_read_sampler>(*this, _cfg.large_read_sampling_frequency());
+    }
+
     setup_scylla_memory_diagnostics_producer();
+
+    if (_cfg.enable_cache_warmup()) {
+        _cache_warmup_timer.set_callback([this] {
+            _cache_warmup_done = _cache_warmup_done.then([this] {
+                return snapshot_cache_warmup_keys();
+            }).handle_exception([] (auto ep) {
+                dblog.warn("Periodic cache warmup snapshot failed: {}", ep);
+            });
+        });
+        _cache_warmup_timer.arm_periodic(cache_warmup_save_interval);
+    }
 }
 
 const db::extensions& database::extensions() const {
@@ -384,21 +425,41 @@ const db::extensions& database::extensions() const {
 void backlog_controller::adjust() {
     auto backlog = _current_backlog();
 
+    if (_lookahead.count()) {
+        // The backlog's first derivative is the ingest rate minus the drain rate, so
+        // projecting the backlog along it and evaluating the curve at the projected
+        // point reacts to an imbalance between the two before the backlog itself has
+        // moved much. The raw per-interval derivative is noisy - every compaction that
+        // completes drops the backlog in a step - so it's smoothed with an exponential
+        // moving average before being applied.
+        constexpr auto smoothing_time_constant = std::chrono::seconds(30);
+        auto interval = std::chrono::duration_cast<std::chrono::duration<float>>(_interval).count();
+        auto alpha = interval / (std::chrono::duration_cast<std::chrono::duration<float>>(smoothing_time_constant).count() + interval);
+        auto rate = (backlog - _previous_backlog.value_or(backlog)) / interval;
+        _previous_backlog = backlog;
+        _smoothed_rate += alpha * (rate - _smoothed_rate);
+        backlog = std::max(backlog + _smoothed_rate * std::chrono::duration_cast<std::chrono::duration<float>>(_lookahead).count(), 0.0f);
+    }
+
+    float result;
     if (backlog >= _control_points.back().input) {
-        update_controller(_control_points.back().output);
-        return;
-    }
+        result = _control_points.back().output;
+    } else {
+        // interpolate to find out which region we are. This run infrequently and there are a fixed
+        // number of points so a simple loop will do.
+        size_t idx = 1;
+        while ((idx < _control_points.size() - 1) && (_control_points[idx].input < backlog)) {
+            idx++;
+        }
 
-    // interpolate to find out which region we are. This run infrequently and there are a fixed
-    // number of points so a simple loop will do.
-    size_t idx = 1;
-    while ((idx < _control_points.size() - 1) && (_control_points[idx].input < backlog)) {
-        idx++;
+        control_point& cp = _control_points[idx];
+        control_point& last = _control_points[idx - 1];
+        result = last.output + (backlog - last.input) * (cp.output - last.output)/(cp.input - last.input);
     }
 
-    control_point& cp = _control_points[idx];
-    control_point& last = _control_points[idx - 1];
-    float result = last.output + (backlog - last.input) * (cp.output - last.output)/(cp.input - last.input);
+    if (std::abs(result - _current_shares) < _hysteresis_threshold * _current_shares) {
+        return;
+    }
     update_controller(result);
 }
 
@@ -423,6 +484,7 @@ float backlog_controller::backlog_of_shares(float shares) const {
 }
 
 void backlog_controller::update_controller(float shares) {
+    _current_shares = shares;
     _scheduling_group.set_shares(shares);
     if (!_inflight_update.available()) {
         return; // next timer will fix it
@@ -482,12 +544,19 @@ database::setup_metrics() {
     });
 
     _metrics.add_group("database", {
-        sm::make_gauge("requests_blocked_memory_current", [this] { return _dirty_memory_manager.region_group().blocked_requests(); },
+        sm::make_gauge("requests_blocked_memory_current", [this] {
+                           // Requests queue in the per-table region groups.
+                           return boost::accumulate(_column_families | boost::adaptors::map_values, _dirty_memory_manager.region_group().blocked_requests(),
+                                   [] (size_t sum, const lw_shared_ptr<column_family>& cf) { return sum + cf->dirty_memory_region_group().blocked_requests(); });
+                       },
                        sm::description(
                            seastar::format("Holds the current number of requests blocked due to reaching the memory quota ({}B). "
                                            "Non-zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"database\" component.", _dirty_memory_manager.throttle_threshold()))),
 
-        sm::make_derive("requests_blocked_memory", [this] { return _dirty_memory_manager.region_group().blocked_requests_counter(); },
+        sm::make_derive("requests_blocked_memory", [this] {
+                           return boost::accumulate(_column_families | boost::adaptors::map_values, _dirty_memory_manager.region_group().blocked_requests_counter(),
+                                   [] (uint64_t sum, const lw_shared_ptr<column_family>& cf) { return sum + cf->dirty_memory_region_group().blocked_requests_counter(); });
+                       },
                        sm::description(seastar::format("Holds the current number of requests blocked due to reaching the memory quota ({}B). "
                                        "Non-zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"database\" component.", _dirty_memory_manager.throttle_threshold()))),
 
@@ -684,6 +753,24 @@ database::setup_metrics() {
         sm::make_queue_length("counter_cell_lock_pending", _cl_stats->operations_waiting_for_lock,
                              sm::description("The number of counter updates waiting for a lock.")),
 
+        sm::make_total_operations("counter_cell_cache_hits", [this] {
+                                    return boost::accumulate(_column_families | boost::adaptors::map_values, uint64_t(0),
+                                            [] (uint64_t sum, const lw_shared_ptr<column_family>& cf) {
+                                        auto* cache = cf->get_counter_cell_cache();
+                                        return sum + (cache ? cache->get_stats().hits : 0);
+                                    });
+                                 },
+                                 sm::description("The number of counter cell lookups served from the counter cell cache, avoiding the read-before-write.")),
+
+        sm::make_total_operations("counter_cell_cache_misses", [this] {
+                                    return boost::accumulate(_column_families | boost::adaptors::map_values, uint64_t(0),
+                                            [] (uint64_t sum, const lw_shared_ptr<column_family>& cf) {
+                                        auto* cache = cf->get_counter_cell_cache();
+                                        return sum + (cache ? cache->get_stats().misses : 0);
+                                    });
+                                 },
+                                 sm::description("The number of counter cell lookups that missed the counter cell cache and fell back to reading the current state.")),
+
         sm::make_counter("large_partition_exceeding_threshold", [this] { return _large_data_handler->stats().partitions_bigger_than_threshold; },
             sm::description("Number of large partitions exceeding compaction_large_partition_warning_threshold_mb. "
                 "Large partitions have performance impact and should be avoided, check the documentation for details.")),
@@ -706,6 +793,64 @@ database::setup_metrics() {
                         sm::description("The number of times the schema changed")),
         });
     }
+
+    if (!_cfg.enable_keyspace_column_family_metrics()) {
+        // With per-table metrics disabled (the default), still publish the
+        // sums across all tables under the names the per-table series would
+        // use, minus the ks/cf labels. Dashboards keep working either way,
+        // and a scrape pays for one walk over the table list instead of a
+        // series per table per shard.
+        _metrics.add_group("column_family", {
+            sm::make_derive("memtable_switch", sm::description("Number of times flush has resulted in the memtable being switched out"),
+                    [this] { return aggregated_table_stats().memtable_switch_count; }),
+            sm::make_counter("memtable_partition_writes", [this] { return aggregated_table_stats().memtable_partition_writes; },
+                    sm::description("Number of write operations performed on partitions in memtables")),
+            sm::make_counter("memtable_partition_hits", [this] { return aggregated_table_stats().memtable_partition_hits; },
+                    sm::description("Number of times a write operation was issued on an existing partition in memtables")),
+            sm::make_counter("memtable_row_writes", [this] { return aggregated_table_stats().memtable_row_writes; },
+                    sm::description("Number of row writes performed in memtables")),
+            sm::make_counter("memtable_row_hits", [this] { return aggregated_table_stats().memtable_row_hits; },
+                    sm::description("Number of rows overwritten by write operations in memtables")),
+            sm::make_gauge("pending_tasks", sm::description("Estimated number of tasks pending across all column families"),
+                    [this] { return aggregated_table_stats().pending_flushes; }),
+            sm::make_gauge("live_disk_space", sm::description("Live disk space used"),
+                    [this] { return aggregated_table_stats().live_disk_space_used; }),
+            sm::make_gauge("total_disk_space", sm::description("Total disk space used"),
+                    [this] { return aggregated_table_stats().total_disk_space_used; }),
+            sm::make_gauge("live_sstable", sm::description("Live sstable count"),
+                    [this] { return aggregated_table_stats().live_sstable_count; }),
+            sm::make_gauge("pending_compaction", sm::description("Estimated number of compactions pending across all column families"),
+                    [this] { return aggregated_table_stats().pending_compactions; }),
+        });
+    }
+}
+
+const database::table_stats_snapshot& database::aggregated_table_stats() {
+    // The aggregated gauges are scraped back to back, so the first one to
+    // run refreshes the snapshot and the others reuse it. The refresh
+    // interval only has to be shorter than the scrape interval; one second
+    // keeps consecutive scrapes from ever observing the same sums.
+    auto now = lowres_clock::now();
+    if (_table_stats_snapshot_taken_at != lowres_clock::time_point() && now - _table_stats_snapshot_taken_at < std::chrono::seconds(1)) {
+        return _table_stats_snapshot;
+    }
+    _table_stats_snapshot_taken_at = now;
+    table_stats_snapshot s;
+    for (auto& cf : _column_families | boost::adaptors::map_values) {
+        auto& st = cf->get_stats();
+        s.memtable_switch_count += st.memtable_switch_count;
+        s.memtable_partition_writes += st.memtable_partition_insertions + st.memtable_partition_hits;
+        s.memtable_partition_hits += st.memtable_partition_hits;
+        s.memtable_row_writes += st.memtable_app_stats.row_writes;
+        s.memtable_row_hits += st.memtable_app_stats.row_hits;
+        s.pending_flushes += st.pending_flushes;
+        s.live_disk_space_used += st.live_disk_space_used;
+        s.total_disk_space_used += st.total_disk_space_used;
+        s.live_sstable_count += st.live_sstable_count;
+        s.pending_compactions += st.pending_compactions;
+    }
+    _table_stats_snapshot = s;
+    return _table_stats_snapshot;
 }
 
 void database::set_format(sstables::sstable_version_types format) {
@@ -891,11 +1036,14 @@ void database::add_column_family(keyspace& ks, schema_ptr schema, column_family:
     schema = local_schema_registry().learn(schema);
     schema->registry_entry()->mark_synced();
 
+    // Internal tables are small and critical (auth, schema), so they get
+    // their own cache which bulk reads of user tables cannot evict from.
+    auto& tracker = is_internal_keyspace(schema->ks_name()) ? _system_row_cache_tracker : _row_cache_tracker;
     lw_shared_ptr<column_family> cf;
     if (cfg.enable_commitlog && _commitlog) {
-       cf = make_lw_shared<column_family>(schema, std::move(cfg), *_commitlog, *_compaction_manager, *_cl_stats, _row_cache_tracker);
+       cf = make_lw_shared<column_family>(schema, std::move(cfg), *_commitlog, *_compaction_manager, *_cl_stats, tracker);
     } else {
-       cf = make_lw_shared<column_family>(schema, std::move(cfg), column_family::no_commitlog(), *_compaction_manager, *_cl_stats, _row_cache_tracker);
+       cf = make_lw_shared<column_family>(schema, std::move(cfg), column_family::no_commitlog(), *_compaction_manager, *_cl_stats, tracker);
     }
     cf->set_durable_writes(ks.metadata()->durable_writes());
 
@@ -1336,6 +1484,84 @@ database::drop_caches() const {
     co_return;
 }
 
+static std::vector<lw_shared_ptr<column_family>> cache_warmup_tables(const std::unordered_map<utils::UUID, lw_shared_ptr<column_family>>& column_families) {
+    std::vector<lw_shared_ptr<column_family>> tables;
+    for (auto& [uuid, cf] : column_families) {
+        if (!is_internal_keyspace(cf->schema()->ks_name())) {
+            tables.push_back(cf);
+        }
+    }
+    return tables;
+}
+
+future<> database::snapshot_cache_warmup_keys() {
+    if (!db::qctx) {
+        co_return;
+    }
+    for (auto& cf : cache_warmup_tables(_column_families)) {
+        if (_cache_warmup_stopping) {
+            co_return;
+        }
+        schema_ptr s = cf->schema();
+        auto keys = cf->get_row_cache().resident_keys(cache_warmup_max_keys_per_table);
+        std::vector<bytes> serialized;
+        serialized.reserve(keys.size());
+        for (const auto& dk : keys) {
+            serialized.push_back(to_bytes(dk.key().representation()));
+        }
+        // An empty snapshot is saved too, overwriting keys which are no
+        // longer resident.
+        co_await db::system_keyspace::save_cache_warmup_keys(s->ks_name(), s->cf_name(), serialized);
+    }
+}
+
+future<> database::do_warm_up_row_cache() {
+    if (!db::qctx) {
+        co_return;
+    }
+    for (auto& cf : cache_warmup_tables(_column_families)) {
+        schema_ptr s = cf->schema();
+        std::vector<bytes> keys;
+        try {
+            keys = co_await db::system_keyspace::get_cache_warmup_keys(s->ks_name(), s->cf_name());
+        } catch (...) {
+            dblog.warn("Reading cache warmup keys of {}.{} failed: {}", s->ks_name(), s->cf_name(), std::current_exception());
+            continue;
+        }
+        if (keys.empty()) {
+            continue;
+        }
+        dblog.info("Warming up cache of {}.{} with {} partitions", s->ks_name(), s->cf_name(), keys.size());
+        for (const auto& b : keys) {
+            if (_cache_warmup_stopping) {
+                co_return;
+            }
+            try {
+                auto pr = dht::partition_range::make_singular(dht::decorate_key(*s, partition_key::from_bytes(managed_bytes_view(bytes_view(b)))));
+                auto reader = cf->make_reader(s, _streaming_concurrency_sem.make_permit(s.get(), "cache-warmup"), pr, s->full_slice(),
+                        service::get_local_streaming_priority(), nullptr, streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+                // Reading the partition through the regular read path is what
+                // populates the cache; the data itself is not needed.
+                co_await reader.consume_pausable([] (mutation_fragment) { return stop_iteration::no; }, db::no_timeout);
+            } catch (...) {
+                dblog.warn("Warming up cache of {}.{} failed: {}", s->ks_name(), s->cf_name(), std::current_exception());
+                break;
+            }
+        }
+    }
+}
+
+void database::warm_up_row_cache() {
+    if (!_cfg.enable_cache_warmup()) {
+        return;
+    }
+    _cache_warmup_done = _cache_warmup_done.then([this] {
+        return do_warm_up_row_cache();
+    }).handle_exception([] (auto ep) {
+        dblog.warn("Cache warmup failed: {}", ep);
+    });
+}
+
 std::set<sstring>
 database::existing_index_names(const sstring& ks_name, const sstring& cf_to_exclude) const {
     std::set<sstring> names;
@@ -1388,9 +1614,33 @@ compare_atomic_cell_for_merge(atomic_cell_view left, atomic_cell_view right) {
     return 0;
 }
 
+std::optional<seastar::scheduling_group>
+database::query_scheduling_group(const schema& s) const {
+    auto it = _dbcfg.keyspace_scheduling_groups.find(s.ks_name());
+    if (it == _dbcfg.keyspace_scheduling_groups.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
 future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
 database::query(schema_ptr s, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
                 tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
+    // The data query stage inherits the caller's scheduling group, so hopping
+    // to the keyspace's dedicated group here is what buys the isolation.
+    // cmd and ranges are captured by reference; the caller keeps them alive
+    // until the returned future resolves, just as the stage itself assumes.
+    if (auto sg = query_scheduling_group(*s)) {
+        return with_scheduling_group(*sg, [this, s = std::move(s), &cmd, opts, &ranges, trace_state = std::move(trace_state), timeout] () mutable {
+            return do_query(std::move(s), cmd, opts, ranges, std::move(trace_state), timeout);
+        });
+    }
+    return do_query(std::move(s), cmd, opts, ranges, std::move(trace_state), timeout);
+}
+
+future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
+database::do_query(schema_ptr s, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
+                tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
     column_family& cf = find_column_family(cmd.cf_id);
     auto& semaphore = get_reader_concurrency_semaphore();
     auto class_config = query::query_class_config{.semaphore = semaphore, .max_memory_for_unlimited_query = *cmd.max_result_size};
@@ -1420,6 +1670,18 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
 future<std::tuple<reconcilable_result, cache_temperature>>
 database::query_mutations(schema_ptr s, const query::read_command& cmd, const dht::partition_range& range,
                           tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
+    // See database::query() for why hopping scheduling group here is enough.
+    if (auto sg = query_scheduling_group(*s)) {
+        return with_scheduling_group(*sg, [this, s = std::move(s), &cmd, &range, trace_state = std::move(trace_state), timeout] () mutable {
+            return do_query_mutations(std::move(s), cmd, range, std::move(trace_state), timeout);
+        });
+    }
+    return do_query_mutations(std::move(s), cmd, range, std::move(trace_state), timeout);
+}
+
+future<std::tuple<reconcilable_result, cache_temperature>>
+database::do_query_mutations(schema_ptr s, const query::read_command& cmd, const dht::partition_range& range,
+                          tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
     const auto short_read_allwoed = query::short_read(cmd.slice.options.contains<query::partition_slice::option::allow_short_read>());
   return get_result_memory_limiter().new_mutation_read(*cmd.max_result_size, short_read_allwoed).then(
           [&, s = std::move(s), trace_state = std::move(trace_state), timeout] (query::result_memory_accounter accounter) {
@@ -1602,16 +1864,33 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
             // deltas to counter shards. To do that, we need to read the current
             // counter state for each modified cell...
 
+            auto apply_update = [this, &cf, &m, timeout] (const mutation* current_state) {
+                transform_counter_updates_to_shards(m, current_state, cf.failed_counter_applies_to_memtable(), _local_host_id);
+                return this->apply_with_commitlog(cf, m, timeout).then([this, &cf, &m] {
+                    // Remember the new values of our shards so that the next
+                    // update of the same cells can skip the read entirely.
+                    update_counter_cache(*cf.get_counter_cell_cache(), m, _local_host_id);
+                });
+            };
+
+            // ...unless the local shard of every modified cell is in the
+            // counter cell cache, in which case the read can be skipped.
+            if (auto cached_state = counter_state_from_cache(*cf.get_counter_cell_cache(), m)) {
+                tracing::trace(trace_state, "Applying counter update using cached shards");
+                return apply_update(&*cached_state).then([&m] {
+                    return std::move(m);
+                });
+            }
+
             tracing::trace(trace_state, "Reading counter values from the CF");
             auto permit = get_reader_concurrency_semaphore().make_permit(m_schema.get(), "counter-read-before-write");
             return counter_write_query(m_schema, cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state, timeout)
-                    .then([this, &cf, &m, m_schema, timeout, trace_state] (auto mopt) {
+                    .then([&m, trace_state, apply_update] (auto mopt) {
                 // ...now, that we got existing state of all affected counter
                 // cells we can look for our shard in each of them, increment
                 // its clock and apply the delta.
-                transform_counter_updates_to_shards(m, mopt ? &*mopt : nullptr, cf.failed_counter_applies_to_memtable(), _local_host_id);
                 tracing::trace(trace_state, "Applying counter update");
-                return this->apply_with_commitlog(cf, m, timeout);
+                return apply_update(mopt ? &*mopt : nullptr);
             }).then([&m] {
                 return std::move(m);
             });
@@ -1654,7 +1933,7 @@ future<> memtable_list::request_flush() {
 }
 
 lw_shared_ptr<memtable> memtable_list::new_memtable() {
-    return make_lw_shared<memtable>(_current_schema(), *_dirty_memory_manager, _table_stats, this, _compaction_scheduling_group);
+    return make_lw_shared<memtable>(_current_schema(), *_dirty_memory_manager, _table_stats, this, _compaction_scheduling_group, _dirty_memory_group);
 }
 
 future<flush_permit> flush_permit::reacquire_sstable_write_permit() && {
@@ -1725,9 +2004,7 @@ void dirty_memory_manager::start_reclaiming() noexcept {
     _should_flush.signal();
 }
 
-future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
-    auto& cf = find_column_family(m.column_family_id());
-
+future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, column_family& cf, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
     data_listeners().on_write(m_schema, m);
 
     return cf.dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h), &cf]() mutable {
@@ -1789,11 +2066,11 @@ future<> database::apply_with_commitlog(schema_ptr s, column_family& cf, utils::
     auto cl = cf.commitlog();
     if (cl != nullptr && cf.durable_writes()) {
         commitlog_entry_writer cew(s, m, sync);
-        return cf.commitlog()->add_entry(uuid, cew, timeout).then([&m, this, s, timeout, cl](db::rp_handle h) {
-            return this->apply_in_memory(m, s, std::move(h), timeout).handle_exception(maybe_handle_reorder);
+        return cf.commitlog()->add_entry(uuid, cew, timeout).then([&m, this, s, timeout, &cf](db::rp_handle h) {
+            return this->apply_in_memory(m, s, cf, std::move(h), timeout).handle_exception(maybe_handle_reorder);
         });
     }
-    return apply_in_memory(m, std::move(s), {}, timeout);
+    return apply_in_memory(m, std::move(s), cf, {}, timeout);
 }
 
 future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::trace_state_ptr tr_state, db::timeout_clock::time_point timeout, db::commitlog::force_sync sync) {
@@ -2026,9 +2303,14 @@ future<>
 database::stop() {
     assert(!_large_data_handler->running());
 
+    _cache_warmup_stopping = true;
+    _cache_warmup_timer.cancel();
+
     // try to ensure that CL has done disk flushing
     future<> maybe_shutdown_commitlog = _commitlog != nullptr ? _commitlog->shutdown() : make_ready_future<>();
     return maybe_shutdown_commitlog.then([this] {
+        return std::exchange(_cache_warmup_done, make_ready_future<>());
+    }).then([this] {
         return _view_update_concurrency_sem.wait(max_memory_pending_view_updates());
     }).then([this] {
         if (_commitlog != nullptr) {
@@ -79,6 +79,7 @@
 class cell_locker;
 class cell_locker_stats;
 class locked_cell;
+class counter_cell_cache;
 class mutation;
 
 class frozen_mutation;
@@ -122,6 +123,8 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class hot_partitions_tracker;
+class large_read_sampler;
 class large_data_handler;
 
 namespace system_keyspace {
@@ -162,6 +165,7 @@ private:
     seal_delayed_fn_type _seal_delayed_fn;
     std::function<schema_ptr()> _current_schema;
     dirty_memory_manager* _dirty_memory_manager;
+    logalloc::region_group* _dirty_memory_group;
     std::optional<shared_promise<>> _flush_coalescing;
     seastar::scheduling_group _compaction_scheduling_group;
     table_stats& _table_stats;
@@ -172,12 +176,14 @@ public:
             std::function<schema_ptr()> cs,
             dirty_memory_manager* dirty_memory_manager,
             table_stats& table_stats,
-            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group())
+            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group(),
+            logalloc::region_group* dirty_memory_group = nullptr)
         : _memtables({})
         , _seal_immediate_fn(seal_immediate_fn)
         , _seal_delayed_fn(seal_delayed_fn)
         , _current_schema(cs)
         , _dirty_memory_manager(dirty_memory_manager)
+        , _dirty_memory_group(dirty_memory_group)
         , _compaction_scheduling_group(compaction_scheduling_group)
         , _table_stats(table_stats) {
         add_memtable();
@@ -188,14 +194,16 @@ public:
             std::function<schema_ptr()> cs,
             dirty_memory_manager* dirty_memory_manager,
             table_stats& table_stats,
-            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group())
-        : memtable_list(std::move(seal_immediate_fn), {}, std::move(cs), dirty_memory_manager, table_stats, compaction_scheduling_group) {
+            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group(),
+            logalloc::region_group* dirty_memory_group = nullptr)
+        : memtable_list(std::move(seal_immediate_fn), {}, std::move(cs), dirty_memory_manager, table_stats, compaction_scheduling_group, dirty_memory_group) {
     }
 
     memtable_list(std::function<schema_ptr()> cs, dirty_memory_manager* dirty_memory_manager,
             table_stats& table_stats,
-            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group())
-        : memtable_list({}, {}, std::move(cs), dirty_memory_manager, table_stats, compaction_scheduling_group) {
+            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group(),
+            logalloc::region_group* dirty_memory_group = nullptr)
+        : memtable_list({}, {}, std::move(cs), dirty_memory_manager, table_stats, compaction_scheduling_group, dirty_memory_group) {
     }
 
     bool may_flush() const {
@@ -357,6 +365,9 @@ struct table_stats {
     utils::timed_rate_moving_average_and_histogram tombstone_scanned;
     utils::timed_rate_moving_average_and_histogram live_scanned;
     utils::estimated_histogram estimated_coordinator_read;
+    /** Exponentially-decayed average size of data query results, in bytes.
+     *  Used to pre-size result buffers for subsequent reads. */
+    uint64_t average_query_result_size = 0;
 };
 
 class table : public enable_lw_shared_from_this<table> {
@@ -409,6 +420,15 @@ private:
     template<typename... Args>
     void do_apply(db::rp_handle&&, Args&&... args);
 
+    // Writes throttled on dirty memory queue in this table's own region
+    // group, a child of the shard-wide one, so a table whose flushes are slow
+    // (huge cells, heavy compression) waits behind its own unflushed data
+    // instead of holding up writes to unrelated tables in a shared FIFO. The
+    // reclaimer additionally caps a single table's share of the real dirty
+    // limit; the shard-wide limits still apply through the parent group.
+    logalloc::region_group_reclaimer _dirty_group_reclaimer;
+    logalloc::region_group _dirty_region_group;
+
     lw_shared_ptr<memtable_list> _memtables;
 
     lw_shared_ptr<memtable_list> make_memory_only_memtable_list();
@@ -460,6 +480,7 @@ private:
     std::vector<view_ptr> _views;
 
     std::unique_ptr<cell_locker> _counter_cell_locks; // Memory-intensive; allocate only when needed.
+    std::unique_ptr<counter_cell_cache> _counter_cell_cache; // Only for counter tables.
     void set_metrics();
     seastar::metrics::metric_groups _metrics;
 
@@ -499,6 +520,10 @@ private:
     // The master resides in system.truncated table
     db_clock::time_point _truncated_at = db_clock::time_point::min();
 
+    // When this table's activity was last persisted to
+    // system.table_activity; throttles maybe_update_activity().
+    db_clock::time_point _last_activity_update = db_clock::time_point::min();
+
     bool _is_bootstrap_or_replace = false;
 public:
     future<> add_sstable_and_update_cache(sstables::shared_sstable sst,
@@ -513,6 +538,9 @@ public:
     sstables::shared_sstable make_sstable(sstring dir, int64_t generation, sstables::sstable_version_types v, sstables::sstable_format_types f);
     sstables::shared_sstable make_sstable(sstring dir);
     sstables::shared_sstable make_sstable();
+    // Directory new compaction output should be written to; cold output goes
+    // to the capacity tier when more than one data directory is configured.
+    const sstring& sstable_dir_for_compaction(bool cold_tier) const;
     void cache_truncation_record(db_clock::time_point truncated_at) {
         _truncated_at = truncated_at;
     }
@@ -523,6 +551,10 @@ public:
     void notify_bootstrap_or_replace_start();
 
     void notify_bootstrap_or_replace_end();
+
+    // Persist this table's access recency (at most once an hour). Used at
+    // the next boot to populate recently-used tables before archival ones.
+    void maybe_update_activity();
 private:
     bool cache_enabled() const {
         return _config.enable_cache && _schema->caching_options().enabled();
@@ -614,8 +646,8 @@ public:
         return _config.datadir;
     }
 
-    logalloc::region_group& dirty_memory_region_group() const {
-        return _config.dirty_memory_manager->region_group();
+    logalloc::region_group& dirty_memory_region_group() {
+        return _dirty_region_group;
     }
 
     // Used for asynchronous operations that may defer and need to guarantee that the column
@@ -731,6 +763,11 @@ public:
 
     future<std::vector<locked_cell>> lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout);
 
+    // nullptr for non-counter tables.
+    counter_cell_cache* get_counter_cell_cache() const {
+        return _counter_cell_cache.get();
+    }
+
     logalloc::occupancy_stats occupancy() const;
 private:
     table(schema_ptr schema, config cfg, db::commitlog* cl, compaction_manager&, cell_locker_stats& cl_stats, cache_tracker& row_cache_tracker);
@@ -799,6 +836,9 @@ public:
     future<> compact_all_sstables();
     // Compact all sstables provided in the vector.
     future<> compact_sstables(sstables::compaction_descriptor descriptor);
+    // Runs one compaction job as token-range sub-compactions executing
+    // concurrently on this shard; see compaction_descriptor::sub_compactions.
+    future<> compact_sstables_in_parallel(sstables::compaction_descriptor descriptor);
 
     future<bool> snapshot_exists(sstring name);
 
@@ -1059,6 +1099,11 @@ private:
     timer<> _off_strategy_trigger;
     void do_update_off_strategy_trigger();
 
+    // True while a cache continuity promotion read is in flight, see
+    // promote_cache_continuity().
+    bool _cache_promotion_running = false;
+    void promote_cache_continuity(dht::token_range range);
+
 public:
     void update_off_strategy_trigger();
     void enable_off_strategy_trigger();
@@ -1225,6 +1270,10 @@ struct database_config {
     seastar::scheduling_group statement_scheduling_group;
     seastar::scheduling_group streaming_scheduling_group;
     seastar::scheduling_group gossip_scheduling_group;
+    // Dedicated statement scheduling groups for keyspaces listed in the
+    // keyspace_scheduling_shares config option. Queries of other keyspaces
+    // run in statement_scheduling_group as usual.
+    std::unordered_map<sstring, seastar::scheduling_group> keyspace_scheduling_groups;
     size_t available_memory;
 };
 
@@ -1296,6 +1345,10 @@ private:
     db::timeout_semaphore _view_update_concurrency_sem{max_memory_pending_view_updates()};
 
     cache_tracker _row_cache_tracker;
+    // Tables of internal keyspaces (system, schema, auth, tracing) are cached
+    // separately so that bulk reads of user tables cannot evict them.
+    // See config::system_cache_reserve_size_in_mb.
+    cache_tracker _system_row_cache_tracker;
 
     inheriting_concrete_execution_stage<future<lw_shared_ptr<query::result>>,
         column_family*,
@@ -1340,6 +1393,24 @@ private:
     // compaction_manager object is referenced by all column families of a database.
     std::unique_ptr<compaction_manager> _compaction_manager;
     seastar::metrics::metric_groups _metrics;
+    // Sums of per-table statistics, refreshed at most once a second. All the
+    // aggregated gauges registered by setup_metrics() read from this
+    // snapshot, so a metrics scrape walks the table list once instead of
+    // once per series.
+    struct table_stats_snapshot {
+        int64_t memtable_switch_count = 0;
+        int64_t memtable_partition_writes = 0;
+        int64_t memtable_partition_hits = 0;
+        int64_t memtable_row_writes = 0;
+        int64_t memtable_row_hits = 0;
+        int64_t pending_flushes = 0;
+        int64_t live_disk_space_used = 0;
+        int64_t total_disk_space_used = 0;
+        int64_t live_sstable_count = 0;
+        int64_t pending_compactions = 0;
+    };
+    table_stats_snapshot _table_stats_snapshot;
+    lowres_clock::time_point _table_stats_snapshot_taken_at;
     bool _enable_incremental_backups = false;
     utils::UUID _local_host_id;
 
@@ -1355,6 +1426,8 @@ private:
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    std::unique_ptr<db::hot_partitions_tracker> _hot_partitions_tracker;
+    std::unique_ptr<db::large_read_sampler> _large_read_sampler;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1365,10 +1438,18 @@ private:
     bool _supports_infinite_bound_range_deletions = false;
     gms::feature::listener_registration _infinite_bound_range_deletions_reg;
 
+    // Periodically snapshots each table's cache-resident partition keys into
+    // the system keyspace, so the cache can be warmed back up after a restart.
+    // Snapshot and warmup rounds are serialized behind _cache_warmup_done,
+    // which stop() waits for.
+    timer<> _cache_warmup_timer;
+    future<> _cache_warmup_done = make_ready_future<>();
+    bool _cache_warmup_stopping = false;
+
     future<> init_commitlog();
 public:
     const gms::feature_service& features() const { return _feat; }
-    future<> apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&&, db::timeout_clock::time_point timeout);
+    future<> apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, column_family& cf, db::rp_handle&&, db::timeout_clock::time_point timeout);
     future<> apply_in_memory(const mutation& m, column_family& cf, db::rp_handle&&, db::timeout_clock::time_point timeout);
 
     void set_local_id(utils::UUID uuid) noexcept { _local_host_id = std::move(uuid); }
@@ -1378,8 +1459,14 @@ private:
     void create_in_memory_keyspace(const lw_shared_ptr<keyspace_metadata>& ksm, system_keyspace system);
     friend future<> db::system_keyspace::make(database& db);
     void setup_metrics();
+    const table_stats_snapshot& aggregated_table_stats();
     void setup_scylla_memory_diagnostics_producer();
 
+    // One round of saving each user table's cache-resident keys.
+    future<> snapshot_cache_warmup_keys();
+    // Reads the previous run's key snapshots back through the cache.
+    future<> do_warm_up_row_cache();
+
     friend class db_apply_executor;
     future<> do_apply(schema_ptr, const frozen_mutation&, tracing::trace_state_ptr tr_state, db::timeout_clock::time_point timeout, db::commitlog::force_sync sync);
     future<> apply_with_commitlog(schema_ptr, column_family&, utils::UUID, const frozen_mutation&, db::timeout_clock::time_point timeout, db::commitlog::force_sync sync);
@@ -1407,8 +1494,14 @@ public:
     ~database();
 
     cache_tracker& row_cache_tracker() { return _row_cache_tracker; }
+    cache_tracker& system_row_cache_tracker() { return _system_row_cache_tracker; }
     future<> drop_caches() const;
 
+    // Repopulates row caches from the hot-set snapshot taken by the previous
+    // run, in the background at streaming I/O priority. Returns immediately;
+    // the work is tracked internally and waited for by stop().
+    void warm_up_row_cache();
+
     void update_version(const utils::UUID& version);
 
     const utils::UUID& get_version() const;
@@ -1477,6 +1570,13 @@ public:
     /// reads, to speed up startup. After startup this should be reverted to
     /// the normal concurrency.
     void revert_initial_system_read_concurrency_boost();
+
+    // Re-applies the memtable_flush_static_shares setting after a
+    // configuration reload. A no-op unless static shares are in use.
+    void update_memtable_flush_static_shares(float shares) {
+        _memtable_controller.update_static_shares(shares);
+    }
+
     future<> stop();
     future<> close_tables(table_kind kind_to_close);
 
@@ -1488,6 +1588,16 @@ public:
                                                                   db::timeout_clock::time_point timeout);
     future<std::tuple<reconcilable_result, cache_temperature>> query_mutations(schema_ptr, const query::read_command& cmd, const dht::partition_range& range,
                                                 tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout);
+private:
+    // The scheduling group configured for queries of the table's keyspace,
+    // if any (see database_config::keyspace_scheduling_groups).
+    std::optional<seastar::scheduling_group> query_scheduling_group(const schema& s) const;
+    future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>> do_query(schema_ptr, const query::read_command& cmd, query::result_options opts,
+                                                                  const dht::partition_range_vector& ranges, tracing::trace_state_ptr trace_state,
+                                                                  db::timeout_clock::time_point timeout);
+    future<std::tuple<reconcilable_result, cache_temperature>> do_query_mutations(schema_ptr, const query::read_command& cmd, const dht::partition_range& range,
+                                                tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout);
+public:
     // Apply the mutation atomically.
     // Throws timed_out_error when timeout is reached.
     future<> apply(schema_ptr, const frozen_mutation&, tracing::trace_state_ptr tr_state, db::commitlog::force_sync sync, db::timeout_clock::time_point timeout);
@@ -1612,6 +1722,11 @@ public:
         return *_data_listeners;
     }
 
+    // nullptr when hot partition tracking is disabled in the config.
+    db::hot_partitions_tracker* hot_partitions_tracker() const {
+        return _hot_partitions_tracker.get();
+    }
+
     bool supports_infinite_bound_range_deletions() {
         return _supports_infinite_bound_range_deletions;
     }
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2021 ScyllaDB
+ */
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "serializer.hh"
+#include "schema.hh"
+#include "utils/i_filter.hh"
+
+extern logging::logger dblog;
+
+namespace db {
+
+/**
+ * \brief Schema extension which makes a table use cache-line-blocked bloom
+ * filters (utils::bloom_filter_mode::blocked) for newly written sstables.
+ *
+ * With the blocked layout all probed bits of a key live in one 64-byte
+ * block, so a negative filter lookup costs a single cache miss instead of
+ * one per hash, at the price of a slightly higher false positive rate for
+ * the same space budget.
+ *
+ * Note that sstables written with blocked filters are not readable by
+ * versions which predate this extension, so it should only be enabled
+ * once a downgrade is no longer on the table.
+ */
+class blocked_bloom_filter_extension : public schema_extension {
+    bool _enabled = false;
+public:
+    static constexpr auto NAME = "blocked_bloom_filter";
+
+    blocked_bloom_filter_extension() = default;
+
+    explicit blocked_bloom_filter_extension(bool enabled)
+        : _enabled(enabled)
+    {}
+
+    explicit blocked_bloom_filter_extension(const std::map<sstring, sstring>& map) {
+        on_internal_error(dblog, "Cannot create blocked_bloom_filter_extension from map");
+    }
+
+    explicit blocked_bloom_filter_extension(bytes b) : _enabled(deserialize(b))
+    {}
+
+    explicit blocked_bloom_filter_extension(const sstring& s)
+        : _enabled(s == "true")
+    {}
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(_enabled);
+    }
+
+    static bool deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, boost::type<bool>());
+    }
+
+    bool is_enabled() const {
+        return _enabled;
+    }
+
+    /**
+     * \brief Returns the filter mode to use for new sstables of the given schema.
+     */
+    static utils::bloom_filter_mode filter_mode(const schema& s) {
+        auto& exts = s.extensions();
+        auto it = exts.find(NAME);
+        if (it != exts.end()) {
+            auto ext = dynamic_pointer_cast<blocked_bloom_filter_extension>(it->second);
+            if (ext && ext->is_enabled()) {
+                return utils::bloom_filter_mode::blocked;
+            }
+        }
+        return utils::bloom_filter_mode::partitioned;
+    }
+};
+
+} // namespace db
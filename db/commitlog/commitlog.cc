@@ -79,6 +79,7 @@
 #include "log.hh"
 #include "commitlog_entry.hh"
 #include "commitlog_extensions.hh"
+#include "compress.hh"
 #include "service/priority_manager.hh"
 #include "serializer.hh"
 
@@ -136,6 +137,7 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.extensions = &cfg.extensions();
     c.reuse_segments = cfg.commitlog_reuse_segments();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.compression = cfg.commitlog_compression();
 
     return c;
 }
@@ -237,6 +239,11 @@ struct db::commitlog::entry_writer {
     /* write nth entry */
     virtual void write(segment&, output&, size_t) const = 0;
 
+    /** whether the n:th entry payload is compressed (see compressing_entry_writer) */
+    virtual bool is_compressed(size_t) const {
+        return false;
+    }
+
     /** the resulting rp_handle for writing a given entry */
     virtual void result(size_t, rp_handle) = 0;
 };
@@ -256,6 +263,8 @@ public:
     // we distribute stuff more or less equally across shards.
     const uint64_t max_disk_size; // per-shard
     const uint64_t disk_usage_threshold;
+    // Compressor applied to individual entries (cfg.compression), or null.
+    const compressor_ptr entry_compressor;
 
     bool _shutdown = false;
     std::optional<shared_promise<>> _shutdown_promise = {};
@@ -556,6 +565,11 @@ public:
     static constexpr size_t descriptor_header_size = 5 * sizeof(uint32_t);
     static constexpr uint32_t segment_magic = ('S'<<24) |('C'<< 16) | ('L' << 8) | 'C';
     static constexpr uint32_t multi_entry_size_magic = 0xffffffff;
+    // Top bit of the entry size field, marking the entry payload as
+    // compressed (segment_version_3 and up). A real entry size can never
+    // set it, since mutations are bounded by half the segment size
+    // (verified in the segment_manager constructor).
+    static constexpr uint32_t entry_compressed_flag = 1u << 31;
 
     // The commit log (chained) sync marker/header size in bytes (int: length + int: checksum [segmentId, position])
     static constexpr size_t sync_marker_size = 2 * sizeof(uint32_t);
@@ -981,7 +995,10 @@ public:
             replay_position rp(_desc.id, position());
             auto id = writer->id(entry);
             auto entry_size = writer->num_entries == 1 ? size : writer->size(*this, entry);
-            auto es = entry_size + entry_overhead_size;
+            auto es = uint32_t(entry_size + entry_overhead_size);
+            if (writer->is_compressed(entry)) {
+                es |= entry_compressed_flag;
+            }
 
             _cf_dirty[id]++; // increase use count for cf.
 
@@ -1092,8 +1109,100 @@ public:
     }
 };
 
+/**
+ * Wraps another entry_writer, compressing each entry payload and keeping
+ * entries that would not shrink as-is. A compressed payload is prefixed
+ * with its uncompressed size and marked by the top bit of the on-disk
+ * entry size field, so the read side can restore the original bytes
+ * before handing them to the subscriber. Framing, crc:s and replay
+ * positions are unaffected and refer to the on-disk (compressed) bytes.
+ *
+ * The wrapped writer is serialized eagerly in size(segment&), since the
+ * resulting sizes go into entry headers written before the payloads.
+ * Note that the inner write() can have segment-bound side effects
+ * (schema version marking); doing them here is fine, because allocate()
+ * always calls size(segment&) on the segment actually written to before
+ * emitting any data, and a segment abandoned after a size() call is
+ * closed to further allocation.
+ */
+class db::commitlog::compressing_entry_writer final : public entry_writer {
+    shared_ptr<entry_writer> _writer;
+    const compressor& _compressor;
+    const segment* _segment = nullptr;
+    std::vector<temporary_buffer<char>> _payloads;
+    std::vector<uint32_t> _uncompressed_size; // non-zero iff n:th payload is compressed
+    size_t _size = 0;
+
+    void maybe_serialize(segment& seg) {
+        if (_segment == &seg) {
+            return;
+        }
+        _segment = &seg;
+        _payloads.clear();
+        _uncompressed_size.clear();
+        _size = 0;
+        auto total = _writer->size(seg);
+        for (size_t i = 0; i < num_entries; ++i) {
+            auto size = num_entries == 1 ? total : _writer->size(seg, i);
+            temporary_buffer<char> buf(size);
+            auto out = output::simple(buf.get_write(), buf.size());
+            _writer->write(seg, out, i);
+            auto max = _compressor.compress_max_size(size);
+            temporary_buffer<char> cbuf(max);
+            auto clen = _compressor.compress(buf.get(), size, cbuf.get_write(), max);
+            if (clen + sizeof(uint32_t) < size) {
+                cbuf.trim(clen);
+                _payloads.emplace_back(std::move(cbuf));
+                _uncompressed_size.emplace_back(uint32_t(size));
+                _size += clen + sizeof(uint32_t);
+            } else {
+                _payloads.emplace_back(std::move(buf));
+                _uncompressed_size.emplace_back(0);
+                _size += size;
+            }
+        }
+    }
+public:
+    compressing_entry_writer(shared_ptr<entry_writer> writer, const compressor& c)
+        : entry_writer(writer->sync, writer->num_entries)
+        , _writer(std::move(writer))
+        , _compressor(c)
+    {}
+    const cf_id_type& id(size_t i) const override {
+        return _writer->id(i);
+    }
+    size_t size() const override {
+        // worst case is the uncompressed one; we never grow an entry.
+        return _writer->size();
+    }
+    size_t size(segment& seg) override {
+        maybe_serialize(seg);
+        return _size;
+    }
+    size_t size(segment& seg, size_t i) override {
+        maybe_serialize(seg);
+        return _payloads[i].size() + (_uncompressed_size[i] ? sizeof(uint32_t) : 0);
+    }
+    bool is_compressed(size_t i) const override {
+        return _uncompressed_size[i] != 0;
+    }
+    void write(segment& seg, output& out, size_t i) const override {
+        assert(_segment == &seg);
+        if (_uncompressed_size[i]) {
+            ::write<uint32_t>(out, _uncompressed_size[i]);
+        }
+        out.write(_payloads[i].get(), _payloads[i].size());
+    }
+    void result(size_t i, rp_handle h) override {
+        _writer->result(i, std::move(h));
+    }
+};
+
 future<>
 db::commitlog::segment_manager::allocate_when_possible(shared_ptr<entry_writer> writer, db::timeout_clock::time_point timeout) {
+    if (entry_compressor) {
+        writer = ::make_shared<compressing_entry_writer>(std::move(writer), *entry_compressor);
+    }
     auto size = writer->size();
     // If this is already too big now, we should throw early. It's also a correctness issue, since
     // if we are too big at this moment we'll never reach allocate() to actually throw at that
@@ -1144,6 +1253,7 @@ db::commitlog::segment_manager::segment_manager(config c)
     , disk_usage_threshold(cfg.commitlog_flush_threshold_in_mb.has_value() 
         ? size_t(std::ceil(*cfg.commitlog_flush_threshold_in_mb / double(smp::count))) * 1024 * 1024 
         : (max_disk_size - (max_disk_size > (max_size/2) ? (max_size/2) : 0)))
+    , entry_compressor(compressor::create(cfg.compression, [](const sstring&) -> compressor::opt_string { return std::nullopt; }))
     , _flush_semaphore(cfg.max_active_flushes)
     // That is enough concurrency to allow for our largest mutation (max_mutation_size), plus
     // an existing in-flight buffer. Since we'll force the cycling() of any buffer that is bigger
@@ -1157,6 +1267,16 @@ db::commitlog::segment_manager::segment_manager(config c)
     assert(max_size > 0);
     assert(max_mutation_size < segment::multi_entry_size_magic);
 
+    if (entry_compressor) {
+        // The read side assumes lz4 when it sees a compressed entry; the
+        // on-disk format has no room for naming the algorithm per entry.
+        if (entry_compressor != compressor::lz4) {
+            throw std::invalid_argument(format("commitlog: unsupported compression class {} (only LZ4Compressor is supported)", cfg.compression));
+        }
+        // compression steals the top bit of the on-disk entry size field.
+        assert(max_mutation_size < segment::entry_compressed_flag);
+    }
+
     clogger.trace("Commitlog {} maximum disk size: {} MB / cpu ({} cpus)",
             cfg.commit_log_location, max_disk_size / (1024 * 1024),
             smp::count);
@@ -1492,7 +1612,7 @@ future<> db::commitlog::segment_manager::rename_file(sstring from, sstring to) c
 }
 
 future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::allocate_segment() {
-    descriptor d(next_id(), cfg.fname_prefix);
+    descriptor d(next_id(), cfg.fname_prefix, entry_compressor ? descriptor::segment_version_3 : descriptor::segment_version_2);
     auto dst = filename(d);
     auto flags = open_flags::wo;
     if (cfg.use_o_dsync) {
@@ -2151,6 +2271,27 @@ const db::commitlog::config& db::commitlog::active_config() const {
     return _segment_manager->cfg;
 }
 
+// Restores the original bytes of a compressed entry payload (see
+// compressing_entry_writer): a prefix with the uncompressed size,
+// followed by an lz4 block.
+static fragmented_temporary_buffer uncompress_entry(const fragmented_temporary_buffer& buf, uint32_t uncompressed_size) {
+    auto view = fragmented_temporary_buffer::view(buf);
+    view.remove_prefix(sizeof(uint32_t));
+    // the compressor wants contiguous input and output.
+    temporary_buffer<char> src(view.size_bytes());
+    auto* p = src.get_write();
+    for (bytes_view frag : view) {
+        p = std::copy_n(reinterpret_cast<const char*>(frag.data()), frag.size(), p);
+    }
+    std::vector<temporary_buffer<char>> res;
+    res.emplace_back(uncompressed_size);
+    auto n = compressor::lz4->uncompress(src.get(), src.size(), res.back().get_write(), uncompressed_size);
+    if (n != uncompressed_size) {
+        throw std::runtime_error(format("decompressed entry size mismatch: {} != {}", n, uncompressed_size));
+    }
+    return fragmented_temporary_buffer(std::move(res), uncompressed_size);
+}
+
 // No commit_io_check needed in the log reader since the database will fail
 // on error at startup if required
 future<>
@@ -2398,6 +2539,13 @@ db::commitlog::read_log_file(const sstring& filename, const sstring& pfx, seasta
                 co_return;
             }
 
+            bool compressed = false;
+            if (d.ver >= descriptor::segment_version_3 && (size & segment::entry_compressed_flag)) {
+                // entry payload is compressed; "size" counts the on-disk bytes.
+                compressed = true;
+                size &= ~segment::entry_compressed_flag;
+            }
+
             if (size < 3 * sizeof(uint32_t) || checksum != crc.checksum()) {
                 auto slack = next - pos;
                 if (size != 0) {
@@ -2430,6 +2578,18 @@ db::commitlog::read_log_file(const sstring& filename, const sstring& pfx, seasta
                 co_return;
             }
 
+            if (compressed) {
+                in = buf.get_istream();
+                auto uncompressed_size = read<uint32_t>(in);
+                try {
+                    buf = uncompress_entry(buf, uncompressed_size);
+                } catch (...) {
+                    clogger.debug("Segment entry at {} failed to decompress ({}). Skipping {} bytes", rp, std::current_exception(), size);
+                    corrupt_size += size;
+                    co_return;
+                }
+            }
+
             co_await pf({std::move(buf), rp}, checksum);
         }
 
@@ -136,6 +136,10 @@ public:
 
         sync_mode mode = sync_mode::PERIODIC;
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
+        // Optional compressor class for individual log entries, using the
+        // same class names as sstable compression (currently LZ4Compressor
+        // only). Empty string (the default) disables compression.
+        sstring compression;
 
         bool reuse_segments = true;
         bool use_o_dsync = false;
@@ -155,6 +159,8 @@ public:
 
         static inline constexpr uint32_t segment_version_1 = 1u;
         static inline constexpr uint32_t segment_version_2 = 2u;
+        // adds optional per-entry compression, marked in the entry size field.
+        static inline constexpr uint32_t segment_version_3 = 3u;
 
         descriptor(descriptor&&) noexcept = default;
         descriptor(const descriptor&) = default;
@@ -416,6 +422,7 @@ private:
     commitlog(config);
 
     struct entry_writer;
+    class compressing_entry_writer;
 };
 
 }
@@ -46,6 +46,7 @@
 #include <boost/range/adaptor/map.hpp>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
 
 #include "commitlog.hh"
@@ -369,14 +370,21 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
             return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
                 return smp::submit_to(id, [this, id, map, &fname_prefix] () {
                     auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
+                    // Replay a few segments in parallel, to keep the disk busy while
+                    // mutations of earlier reads are being applied. The bound keeps
+                    // memtable/memory congestion manageable. Order between segments
+                    // does not matter for correctness: mutation application is
+                    // commutative (cell timestamps decide), and the replay position
+                    // filtering in process() is per entry.
+                    static constexpr size_t max_concurrent_replays = 4;
+                    auto limit = ::make_lw_shared<semaphore>(max_concurrent_replays);
                     auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
+                    return parallel_for_each(range.first, range.second, [this, total, limit, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
                         auto&f = p.second;
-                        rlogger.debug("Replaying {}", f);
-                        return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
+                        return with_semaphore(*limit, 1, [this, &f, &fname_prefix] {
+                            rlogger.debug("Replaying {}", f);
+                            return _impl->recover(f, fname_prefix);
+                        }).then([&f, total, limit](impl::stats stats) {
                             if (stats.corrupt_bytes != 0) {
                                 rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
                             }
@@ -215,9 +215,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "max cpu usage ratio (between 0 and 1) for compaction process. Not intended for setting in normal operations. Setting it to 1 or higher will disable it, recommended operational setting is 0.5.")
     , auto_adjust_flush_quota(this, "auto_adjust_flush_quota", value_status::Unused, false,
         "true: auto-adjust memtable shares for flush processes")
-    , memtable_flush_static_shares(this, "memtable_flush_static_shares", value_status::Used, 0,
+    , memtable_flush_static_shares(this, "memtable_flush_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
-    , compaction_static_shares(this, "compaction_static_shares", value_status::Used, 0,
+    , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
         "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold")
@@ -320,6 +320,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Log a warning when writing cells larger than this value")
     , compaction_rows_count_warning_threshold(this, "compaction_rows_count_warning_threshold", value_status::Used, 100000,
         "Log a warning when writing a number of rows larger than this value")
+    , hot_partition_tracking_capacity(this, "hot_partition_tracking_capacity", value_status::Used, 256,
+        "Number of partitions tracked per shard by the always-on hot partition sampler, queryable via the /column_family/hot_partitions REST endpoint. Larger values improve accuracy at a small memory cost. Set to 0 to disable the sampler.")
+    , large_read_sampling_frequency(this, "large_read_sampling_frequency", value_status::Used, 32,
+        "Instrument one in this many reads of user tables, recording those that merge a large partition, scan many tombstones or merge many fragments to the system.large_reads table. Set to 0 to disable read sampling.")
+    , large_read_tombstone_threshold(this, "large_read_tombstone_threshold", value_status::Used, 10000,
+        "Record a sampled read when it scans more tombstones than this value in one partition")
     /* Common memtable settings */
     , memtable_total_space_in_mb(this, "memtable_total_space_in_mb", value_status::Invalid, 0,
         "Specifies the total memory used for all memtables on a node. This replaces the per-table storage settings memtable_operations_in_millions and memtable_throughput_in_mb.")
@@ -367,6 +373,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Whether or not to re-use commitlog segments when finished instead of deleting them. Can improve commitlog latency on some file systems.\n")
     , commitlog_use_o_dsync(this, "commitlog_use_o_dsync", value_status::Used, true,
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
+    , commitlog_compression(this, "commitlog_compression", value_status::Used, "",
+        "Compressor class to apply to individual commitlog entries, using the same class names as sstable compression. Currently only LZ4Compressor is supported. Empty (the default) disables compression. Trades CPU on the write path for less commitlog bandwidth and disk space; entries that do not shrink are stored uncompressed. Segments written with compression enabled use a newer on-disk format that older versions cannot replay.\n")
     /* Compaction settings */
     /* Related information: Configuring compaction */
     , compaction_preheat_key_cache(this, "compaction_preheat_key_cache", value_status::Unused, true,
@@ -411,7 +419,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , reduce_cache_sizes_at(this, "reduce_cache_sizes_at", value_status::Invalid, .85,
         "When Java heap usage (after a full concurrent mark sweep (CMS) garbage collection) exceeds this percentage, Cassandra reduces the cache capacity to the fraction of the current size as specified by reduce_cache_capacity_to. To disable, set the value to 1.0.")
     /* Disks settings */
-    , stream_throughput_outbound_megabits_per_sec(this, "stream_throughput_outbound_megabits_per_sec", value_status::Unused, 400,
+    , stream_throughput_outbound_megabits_per_sec(this, "stream_throughput_outbound_megabits_per_sec", value_status::Used, 400,
         "Throttles all outbound streaming file transfers on a node to the specified throughput. Cassandra does mostly sequential I/O when streaming data during bootstrap or repair, which can lead to saturating the network connection and degrading client (RPC) performance.")
     , inter_dc_stream_throughput_outbound_megabits_per_sec(this, "inter_dc_stream_throughput_outbound_megabits_per_sec", value_status::Unused, 0,
         "Throttles all streaming file transfer between the data centers. This setting allows throttles streaming throughput betweens data centers in addition to throttling all network stream traffic as configured with stream_throughput_outbound_megabits_per_sec.")
@@ -491,20 +499,20 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , tombstone_failure_threshold(this, "tombstone_failure_threshold", value_status::Unused, 100000,
         "The maximum number of tombstones a query can scan before aborting.")
     /* Network timeout settings */
-    , range_request_timeout_in_ms(this, "range_request_timeout_in_ms", value_status::Used, 10000,
+    , range_request_timeout_in_ms(this, "range_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 10000,
         "The time in milliseconds that the coordinator waits for sequential or index scans to complete.")
-    , read_request_timeout_in_ms(this, "read_request_timeout_in_ms", value_status::Used, 5000,
+    , read_request_timeout_in_ms(this, "read_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 5000,
         "The time that the coordinator waits for read operations to complete")
-    , counter_write_request_timeout_in_ms(this, "counter_write_request_timeout_in_ms", value_status::Used, 5000,
+    , counter_write_request_timeout_in_ms(this, "counter_write_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 5000,
         "The time that the coordinator waits for counter writes to complete.")
-    , cas_contention_timeout_in_ms(this, "cas_contention_timeout_in_ms", value_status::Used, 1000,
+    , cas_contention_timeout_in_ms(this, "cas_contention_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 1000,
         "The time that the coordinator continues to retry a CAS (compare and set) operation that contends with other proposals for the same row.")
-    , truncate_request_timeout_in_ms(this, "truncate_request_timeout_in_ms", value_status::Used, 60000,
+    , truncate_request_timeout_in_ms(this, "truncate_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 60000,
         "The time that the coordinator waits for truncates (remove all data from a table) to complete. The long default value allows for a snapshot to be taken before removing the data. If auto_snapshot is disabled (not recommended), you can reduce this time.")
-    , write_request_timeout_in_ms(this, "write_request_timeout_in_ms", value_status::Used, 2000,
+    , write_request_timeout_in_ms(this, "write_request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 2000,
         "The time in milliseconds that the coordinator waits for write operations to complete.\n"
         "Related information: About hinted handoff writes")
-    , request_timeout_in_ms(this, "request_timeout_in_ms", value_status::Used, 10000,
+    , request_timeout_in_ms(this, "request_timeout_in_ms", liveness::LiveUpdate, value_status::Used, 10000,
         "The default timeout for other, miscellaneous operations.\n"
         "Related information: About hinted handoff writes")
     /* Inter-node settings */
@@ -592,7 +600,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , hinted_handoff_enabled(this, "hinted_handoff_enabled", value_status::Used, db::config::hinted_handoff_enabled_type(db::config::hinted_handoff_enabled_type::enabled_for_all_tag()),
         "Enable or disable hinted handoff. To enable per data center, add data center list. For example: hinted_handoff_enabled: DC1,DC2. A hint indicates that the write needs to be replayed to an unavailable node. "
         "Related information: About hinted handoff writes")
-    , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Unused, 1024,
+    , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Used, 1024,
         "Maximum throttle per delivery thread in kilobytes per second. This rate reduces proportionally to the number of nodes in the cluster. For example, if there are two nodes in the cluster, each delivery thread will use the maximum rate. If there are three, each node will throttle to half of the maximum, since the two nodes are expected to deliver hints simultaneously.")
     , max_hint_window_in_ms(this, "max_hint_window_in_ms", value_status::Used, 10800000,
         "Maximum amount of time that hints are generates hints for an unresponsive node. After this interval, new hints are no longer generated until the node is back up and responsive. If the node goes down again, a new interval begins. This setting can prevent a sudden demand for resources when a node is brought back online and the rest of the cluster attempts to replay a large volume of hinted writes.\n"
@@ -618,6 +626,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tthrottle_limit: The number of in-flight requests per client. Requests beyond this limit are queued up until running requests complete. Recommended value is ((concurrent_reads + concurrent_writes) × 2)\n"
         "\tdefault_weight: (Default: 1 **)  How many requests are handled during each turn of the RoundRobin.\n"
         "\tweights: (Default: Keyspace: 1)  Takes a list of keyspaces. It sets how many requests are handled during each turn of the RoundRobin, based on the request_scheduler_id.")
+    , keyspace_scheduling_shares(this, "keyspace_scheduling_shares", value_status::Used, {/* disabled */},
+        "Map of keyspace name to CPU scheduler shares. Data and mutation queries of a listed keyspace run in a dedicated scheduling group with the given shares instead of the shared statement group, bounding the CPU the keyspace can take from other workloads on the same shards. Groups are created at startup; takes effect only when the cpu_scheduler option is enabled.")
     /* Thrift interface properties */
     /* Legacy API for older clients. CQL is a simpler and better API for Scylla. */
     , thrift_framed_transport_size_in_mb(this, "thrift_framed_transport_size_in_mb", value_status::Unused, 15,
@@ -699,6 +709,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The SSL port for encrypted communication. Unused unless enabled in encryption_options.")
     , enable_in_memory_data_store(this, "enable_in_memory_data_store", value_status::Used, false, "Enable in memory mode (system tables are always persisted)")
     , enable_cache(this, "enable_cache", value_status::Used, true, "Enable cache")
+    , enable_cache_warmup(this, "enable_cache_warmup", value_status::Used, true,
+        "Periodically record each table's cache-resident partition keys and read them back after a restart to warm the cache up")
+    , system_cache_reserve_size_in_mb(this, "system_cache_reserve_size_in_mb", value_status::Used, 10,
+        "Amount of memory per shard, in MB, below which the cache of internal tables (system, schema, auth, tracing keyspaces) is protected from eviction, so that bulk reads of user tables don't flush e.g. authentication data out of memory")
     , enable_commitlog(this, "enable_commitlog", value_status::Used, true, "Enable commitlog")
     , volatile_system_keyspace_for_testing(this, "volatile_system_keyspace_for_testing", value_status::Used, false, "Don't persist system keyspace - testing only!")
     , api_port(this, "api_port", value_status::Used, 10000, "Http Rest API port")
@@ -735,6 +749,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , virtual_dirty_soft_limit(this, "virtual_dirty_soft_limit", value_status::Used, 0.6, "Soft limit of virtual dirty memory expressed as a portion of the hard limit")
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default) "
         "bytes written to data file. Value must be between 0 and 1.")
+    , sstable_filter_memory_fraction(this, "sstable_filter_memory_fraction", value_status::Used, 0.0, "Maximum fraction of memory, per shard, that may be spent on "
+        "sstable bloom filters. Filters of sstables opened past the limit are not loaded, trading extra reads from disk for memory. Set to 0 (the default) to disable the limit.")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting")
@@ -763,6 +779,11 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , max_memory_for_unlimited_query_hard_limit(this, "max_memory_for_unlimited_query_hard_limit", "max_memory_for_unlimited_query", liveness::LiveUpdate, value_status::Used, (uint64_t(100) << 20),
             "Maximum amount of memory a query, whose memory consumption is not naturally limited, is allowed to consume, e.g. non-paged and reverse queries. "
             "This is the hard limit, queries violating this limit will be aborted.")
+    , querier_cache_entry_ttl_in_seconds(this, "querier_cache_entry_ttl_in_seconds", value_status::Used, 10,
+            "How long to keep a suspended reader around between two pages of the same query. As long as the next page arrives within "
+            "this period, paging resumes the suspended reader instead of re-opening sstable readers and re-seeking their indexes. "
+            "Raising it helps clients that page slowly over large partitions, at the cost of holding reader resources for longer; "
+            "suspended readers are evicted early anyway if the reader concurrency semaphore needs their resources.")
     , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 4u,
             "Maximum amount of sstables to load in parallel during initialization. A higher number can lead to more memory consumption. You should not need to touch this")
     , enable_3_1_0_compatibility_mode(this, "enable_3_1_0_compatibility_mode", value_status::Used, false,
@@ -777,6 +798,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Time period in seconds after which unused schema versions will be evicted from the local schema registry cache. Default is 1 second.")
     , max_concurrent_requests_per_shard(this, "max_concurrent_requests_per_shard",liveness::LiveUpdate, value_status::Used, std::numeric_limits<uint32_t>::max(),
         "Maximum number of concurrent requests a single shard can handle before it starts shedding extra load. By default, no requests will be shed.")
+    , batch_workload_admission_fraction(this, "batch_workload_admission_fraction", liveness::LiveUpdate, value_status::Used, 1.0,
+        "Fraction of a shard's concurrent CQL request slots and request memory that connections whose service level declares a batch workload type may hold at once. Requests over the cap are shed with an Overloaded error before being parsed, so a misbehaving batch tenant queues against its own budget instead of starving interactive co-tenants. The default of 1.0 disables the cap.")
     , cdc_dont_rewrite_streams(this, "cdc_dont_rewrite_streams", value_status::Used, false,
             "Disable rewriting streams from cdc_streams_descriptions to cdc_streams_descriptions_v2. Should not be necessary, but the procedure is expensive and prone to failures; this config option is left as a backdoor in case some user requires manual intervention.")
     , alternator_port(this, "alternator_port", value_status::Used, 0, "Alternator API port")
@@ -20,6 +20,7 @@
  */
 
 #include "db/data_listeners.hh"
+#include "db/large_data_handler.hh"
 #include "database.hh"
 #include "db_clock.hh"
 
@@ -27,6 +28,8 @@
 
 extern logging::logger dblog;
 
+bool is_system_keyspace(std::string_view name);
+
 namespace db {
 
 void data_listeners::install(data_listener* listener) {
@@ -126,6 +129,161 @@ toppartitions_data_listener::localize(const global_top_k::results& r) {
     return n;
 }
 
+hot_partitions_tracker::hot_partitions_tracker(database& db, size_t capacity)
+        : _db(db)
+        , _top_k_read(capacity)
+        , _top_k_write(capacity) {
+    dblog.debug("hot_partitions_tracker: installing with capacity {}", capacity);
+    _db.data_listeners().install(this);
+    _decay_timer.set_callback([this] {
+        _top_k_read.decay();
+        _top_k_write.decay();
+    });
+    _decay_timer.arm_periodic(decay_period);
+}
+
+hot_partitions_tracker::~hot_partitions_tracker() {
+    dblog.debug("hot_partitions_tracker: uninstalling");
+    _db.data_listeners().uninstall(this);
+}
+
+flat_mutation_reader hot_partitions_tracker::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader&& rd) {
+    // System tables see constant internal traffic which would crowd user
+    // partitions out of the sketch.
+    if (is_system_keyspace(s->ks_name())) {
+        return std::move(rd);
+    }
+    return make_filtering_reader(std::move(rd), [zis = this->weak_from_this(), s = s] (const dht::decorated_key& dk) {
+        // The data query may be executing after the tracker has been destroyed on shutdown, so check
+        if (zis) {
+            zis->_top_k_read.append(toppartitions_item_key{s, dk});
+        }
+        return true;
+    });
+}
+
+void hot_partitions_tracker::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    if (is_system_keyspace(s->ks_name())) {
+        return;
+    }
+    _top_k_write.append(toppartitions_item_key{s, m.decorated_key(*s)});
+}
+
+namespace {
+
+// Passes the stream through untouched while accumulating per-partition large
+// data statistics, handing qualifying partitions over to the
+// large_data_handler at partition end.
+class large_read_counting_reader : public flat_mutation_reader::impl {
+    flat_mutation_reader _rd;
+    weak_ptr<large_read_sampler> _sampler;
+    std::optional<dht::decorated_key> _key;
+    uint64_t _bytes = 0;
+    uint64_t _fragments = 0;
+    uint64_t _tombstones = 0;
+
+    void account(const mutation_fragment& mf) {
+        if (mf.is_partition_start()) {
+            _key = mf.as_partition_start().key();
+            _bytes = 0;
+            _fragments = 0;
+            _tombstones = 0;
+            if (mf.as_partition_start().partition_tombstone()) {
+                ++_tombstones;
+            }
+        } else if (mf.is_clustering_row()) {
+            if (mf.as_clustering_row().tomb()) {
+                ++_tombstones;
+            }
+        } else if (mf.is_range_tombstone()) {
+            ++_tombstones;
+        }
+        ++_fragments;
+        _bytes += mf.memory_usage();
+        if (mf.is_end_of_partition() && _key) {
+            if (_sampler) {
+                // Purposefully not waited for - the handler itself limits how
+                // far behind the recording can get, and a sampled read should
+                // not pay the recording latency.
+                (void)_sampler->handler().maybe_record_large_read(
+                        large_data_handler::read_info{_schema, *std::exchange(_key, std::nullopt), _bytes, _fragments, _tombstones});
+            } else {
+                _key = std::nullopt;
+            }
+        }
+    }
+
+public:
+    large_read_counting_reader(flat_mutation_reader rd, weak_ptr<large_read_sampler> sampler)
+        : impl(rd.schema(), rd.permit())
+        , _rd(std::move(rd))
+        , _sampler(std::move(sampler)) {
+    }
+    virtual future<> fill_buffer(db::timeout_clock::time_point timeout) override {
+        return do_until([this] { return is_buffer_full() || is_end_of_stream(); }, [this, timeout] {
+            return _rd.fill_buffer(timeout).then([this] {
+                while (!_rd.is_buffer_empty()) {
+                    auto mf = _rd.pop_mutation_fragment();
+                    account(mf);
+                    push_mutation_fragment(std::move(mf));
+                }
+                _end_of_stream = _rd.is_end_of_stream();
+            });
+        });
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        _key = std::nullopt; // the partition was abandoned, do not record it
+        if (is_buffer_empty()) {
+            _end_of_stream = false;
+            return _rd.next_partition();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr, db::timeout_clock::time_point timeout) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(pr, timeout);
+    }
+    virtual future<> fast_forward_to(position_range pr, db::timeout_clock::time_point timeout) override {
+        forward_buffer_to(pr.start());
+        _end_of_stream = false;
+        return _rd.fast_forward_to(std::move(pr), timeout);
+    }
+    virtual future<> close() noexcept {
+        return _rd.close();
+    }
+};
+
+} // anonymous namespace
+
+large_read_sampler::large_read_sampler(database& db, uint32_t frequency)
+        : _db(db)
+        , _frequency(frequency) {
+    dblog.debug("large_read_sampler: installing with frequency {}", frequency);
+    _db.data_listeners().install(this);
+}
+
+large_read_sampler::~large_read_sampler() {
+    dblog.debug("large_read_sampler: uninstalling");
+    _db.data_listeners().uninstall(this);
+}
+
+large_data_handler& large_read_sampler::handler() const {
+    return *_db.get_large_data_handler();
+}
+
+flat_mutation_reader large_read_sampler::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader&& rd) {
+    // Reads of system tables are never sampled - recording them to a system
+    // table would feed the sampler its own output.
+    if (is_system_keyspace(s->ks_name()) || _reads++ % _frequency != 0) {
+        return std::move(rd);
+    }
+    return make_flat_mutation_reader<large_read_counting_reader>(std::move(rd), this->weak_from_this());
+}
+
 toppartitions_query::toppartitions_query(distributed<database>& xdb, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash>&& table_filters,
         std::unordered_set<sstring>&& keyspace_filters, std::chrono::milliseconds duration, size_t list_size, size_t capacity)
         : _xdb(xdb), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)), _duration(duration), _list_size(list_size), _capacity(capacity),
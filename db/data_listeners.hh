@@ -24,6 +24,8 @@
 #include <seastar/core/distributed.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/distributed.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/core/weak_ptr.hh>
 
 #include "utils/hash.hh"
@@ -39,6 +41,8 @@
 
 namespace db {
 
+class large_data_handler;
+
 class data_listener {
 public:
     // Invoked for each write, with partition granularity.
@@ -151,6 +155,68 @@ public:
     future<> stop();
 };
 
+// Always-on, per-shard sampler of hot partitions.
+//
+// Unlike toppartitions_data_listener, which is installed only for the duration
+// of an explicit sampling session, one of these lives as long as the database
+// does, so a hot partition can be identified after the fact instead of having
+// to be caught in the act by a sampling session. A single space-saving sketch
+// covers all tables - the sketch keys carry the schema, so results can be told
+// apart per table. The counts are halved once a minute, making the sketch an
+// exponentially decayed view of recent traffic rather than all-time totals.
+//
+// Owned by the database and enabled by the hot_partition_tracking_capacity
+// config option; the results are served by the /column_family/hot_partitions
+// REST endpoint.
+class hot_partitions_tracker : public data_listener, public weakly_referencable<hot_partitions_tracker> {
+public:
+    using top_k = toppartitions_data_listener::top_k;
+
+private:
+    database& _db;
+    top_k _top_k_read;
+    top_k _top_k_write;
+    timer<lowres_clock> _decay_timer;
+
+    static constexpr std::chrono::minutes decay_period{1};
+
+public:
+    hot_partitions_tracker(database& db, size_t capacity);
+    ~hot_partitions_tracker();
+
+    virtual flat_mutation_reader on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader&& rd) override;
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+
+    top_k& read_sketch() { return _top_k_read; }
+    top_k& write_sketch() { return _top_k_write; }
+};
+
+// Samples reads and records the ones that hit large data.
+//
+// One in every large_read_sampling_frequency reads of a user table has its
+// mutation stream wrapped with a counting reader that accumulates, per
+// partition, the bytes merged, the fragments merged and the tombstones
+// scanned. A partition that crosses one of the large-data thresholds is
+// handed to the large_data_handler, which records it in system.large_reads
+// the same way the write path records large partitions at sstable write time.
+// Installed by the database when large_read_sampling_frequency is non-zero.
+class large_read_sampler : public data_listener, public weakly_referencable<large_read_sampler> {
+    database& _db;
+    uint32_t _frequency;
+    uint64_t _reads = 0;
+
+public:
+    large_read_sampler(database& db, uint32_t frequency);
+    ~large_read_sampler();
+
+    large_data_handler& handler() const;
+
+    virtual flat_mutation_reader on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader&& rd) override;
+};
+
 class toppartitions_query {
     distributed<database>& _xdb;
     std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> _table_filters;
@@ -56,7 +56,11 @@ future<semaphore_units<named_semaphore::exception_factory>> resource_manager::ge
     // Allow a very big mutation to be sent out by consuming the whole shard budget
     hint_memory_budget = std::min(hint_memory_budget, _max_send_in_flight_memory);
     resource_manager_logger.trace("memory budget: need {} have {}", hint_memory_budget, _send_limiter.available_units());
-    return get_units(_send_limiter, hint_memory_budget);
+    // Pace the hint sending bandwidth before taking memory units, so a
+    // throttled hint doesn't hold a share of the memory budget while waiting.
+    return _send_throughput.reserve(buf_size).then([this, hint_memory_budget] {
+        return get_units(_send_limiter, hint_memory_budget);
+    });
 }
 
 size_t resource_manager::sending_queue_length() const {
@@ -30,6 +30,7 @@
 #include "seastarx.hh"
 #include <unordered_set>
 #include "gms/gossiper.hh"
+#include "utils/rate_limiter.hh"
 #include "utils/small_vector.hh"
 #include "lister.hh"
 #include "enum_set.hh"
@@ -124,6 +125,7 @@ class resource_manager {
     const size_t _max_send_in_flight_memory;
     const size_t _min_send_hint_budget;
     seastar::named_semaphore _send_limiter;
+    utils::token_bucket _send_throughput;
 
     seastar::named_semaphore _operation_lock;
     space_watchdog::shard_managers_set _shard_managers;
@@ -172,10 +174,13 @@ public:
     static constexpr size_t max_hints_send_queue_length = 128;
 
 public:
-    resource_manager(size_t max_send_in_flight_memory)
+    /// send_rate_limit: hint sending bandwidth in bytes per second for this
+    /// shard (0 - unlimited).
+    resource_manager(size_t max_send_in_flight_memory, uint64_t send_rate_limit = 0)
         : _max_send_in_flight_memory(std::max(max_send_in_flight_memory, max_hints_send_queue_length))
         , _min_send_hint_budget(_max_send_in_flight_memory / max_hints_send_queue_length)
         , _send_limiter(_max_send_in_flight_memory, named_semaphore_exception_factory{"send limiter"})
+        , _send_throughput(send_rate_limit)
         , _operation_lock(1, named_semaphore_exception_factory{"operation lock"})
         , _space_watchdog(_shard_managers, _per_device_limits_map)
     {}
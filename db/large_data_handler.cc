@@ -31,19 +31,21 @@ namespace db {
 
 nop_large_data_handler::nop_large_data_handler()
     : large_data_handler(std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max(),
-          std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max()) {
+          std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max()) {
     // Don't require start() to be called on nop large_data_handler.
     start();
 }
 
-large_data_handler::large_data_handler(uint64_t partition_threshold_bytes, uint64_t row_threshold_bytes, uint64_t cell_threshold_bytes, uint64_t rows_count_threshold)
+large_data_handler::large_data_handler(uint64_t partition_threshold_bytes, uint64_t row_threshold_bytes, uint64_t cell_threshold_bytes, uint64_t rows_count_threshold,
+        uint64_t read_tombstone_threshold)
         : _partition_threshold_bytes(partition_threshold_bytes)
         , _row_threshold_bytes(row_threshold_bytes)
         , _cell_threshold_bytes(cell_threshold_bytes)
         , _rows_count_threshold(rows_count_threshold)
+        , _read_tombstone_threshold(read_tombstone_threshold)
 {
-    large_data_logger.debug("partition_threshold_bytes={} row_threshold_bytes={} cell_threshold_bytes={} rows_count_threshold={}",
-        partition_threshold_bytes, row_threshold_bytes, cell_threshold_bytes, rows_count_threshold);
+    large_data_logger.debug("partition_threshold_bytes={} row_threshold_bytes={} cell_threshold_bytes={} rows_count_threshold={} read_tombstone_threshold={}",
+        partition_threshold_bytes, row_threshold_bytes, cell_threshold_bytes, rows_count_threshold, read_tombstone_threshold);
 }
 
 future<bool> large_data_handler::maybe_record_large_partitions(const sstables::sstable& sst, const sstables::key& key, uint64_t partition_size) {
@@ -59,6 +61,20 @@ future<bool> large_data_handler::maybe_record_large_partitions(const sstables::s
     return make_ready_future<bool>(false);
 }
 
+future<> large_data_handler::maybe_record_large_read(read_info info) {
+    if (!running()) {
+        return make_ready_future<>();
+    }
+    if (__builtin_expect(info.partition_size_bytes > _partition_threshold_bytes
+            || info.tombstones > _read_tombstone_threshold
+            || info.fragments > _rows_count_threshold, false)) {
+        return with_sem([info = std::move(info), this] {
+            return record_large_read(info);
+        });
+    }
+    return make_ready_future<>();
+}
+
 void large_data_handler::start() {
     _running = true;
 }
@@ -171,6 +187,25 @@ future<> cql_table_large_data_handler::record_large_rows(const sstables::sstable
     }
 }
 
+future<> cql_table_large_data_handler::record_large_read(const read_info& info) const {
+    static const sstring req = format("INSERT INTO system.{} (keyspace_name, table_name, partition_size, partition_key, tombstones, fragments, read_time)"
+            " VALUES (?, ?, ?, ?, ?, ?, ?) USING TTL 2592000", db::system_keyspace::LARGE_READS);
+    const schema& s = *info.s;
+    auto ks_name = s.ks_name();
+    auto cf_name = s.cf_name();
+    std::string pk_str = key_to_str(info.key.key(), s);
+    auto timestamp = db_clock::now();
+    large_data_logger.warn("Large read from {}/{}: {} ({} bytes merged, {} tombstones, {} fragments)",
+            ks_name, cf_name, pk_str, info.partition_size_bytes, info.tombstones, info.fragments);
+    return db::qctx->execute_cql(req, ks_name, cf_name, int64_t(info.partition_size_bytes), pk_str,
+                int64_t(info.tombstones), int64_t(info.fragments), timestamp)
+            .discard_result()
+            .handle_exception([ks_name, cf_name] (std::exception_ptr ep) {
+                large_data_logger.warn("Failed to add a record to system.{}: ks = {}, table = {} exception = {}",
+                        db::system_keyspace::LARGE_READS, ks_name, cf_name, ep);
+            });
+}
+
 future<> cql_table_large_data_handler::delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const {
     const sstring req =
             format("DELETE FROM system.{} WHERE keyspace_name = ? AND table_name = ? AND sstable_name = ?",
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <cstdint>
+#include "dht/i_partitioner.hh"
 #include "schema_fwd.hh"
 #include "system_keyspace.hh"
 #include "sstables/shared_sstable.hh"
@@ -39,6 +40,18 @@ public:
         int64_t partitions_bigger_than_threshold = 0; // number of large partition updates exceeding threshold_bytes
     };
 
+    // What a sampled read saw while merging one partition. Unlike the
+    // sstable-write-time records, which describe data at rest, this describes
+    // the work a query actually did, so the partition size here is the amount
+    // of data merged, across all sstables and the memtables.
+    struct read_info {
+        schema_ptr s;
+        dht::decorated_key key;
+        uint64_t partition_size_bytes;
+        uint64_t fragments;
+        uint64_t tombstones;
+    };
+
 private:
     // Assuming:
     // * there is at most one log entry every 1MB
@@ -67,10 +80,12 @@ private:
     uint64_t _row_threshold_bytes;
     uint64_t _cell_threshold_bytes;
     uint64_t _rows_count_threshold;
+    uint64_t _read_tombstone_threshold;
     mutable large_data_handler::stats _stats;
 
 public:
-    explicit large_data_handler(uint64_t partition_threshold_bytes, uint64_t row_threshold_bytes, uint64_t cell_threshold_bytes, uint64_t rows_count_threshold);
+    explicit large_data_handler(uint64_t partition_threshold_bytes, uint64_t row_threshold_bytes, uint64_t cell_threshold_bytes, uint64_t rows_count_threshold,
+            uint64_t read_tombstone_threshold);
     virtual ~large_data_handler() {}
 
     // Once large_data_handler is stopped no further updates will be accepted.
@@ -114,6 +129,11 @@ public:
         return make_ready_future<bool>(false);
     }
 
+    // Called by the read path for sampled reads, once per partition. Unlike
+    // the write-time entry points this does not assert running() - a read in
+    // flight during shutdown is not an error, its record is just dropped.
+    future<> maybe_record_large_read(read_info info);
+
     future<> maybe_delete_large_data_entries(sstables::shared_sstable sst);
 
     const large_data_handler::stats& stats() const { return _stats; }
@@ -130,6 +150,9 @@ public:
     uint64_t get_rows_count_threshold() const noexcept {
         return _rows_count_threshold;
     }
+    uint64_t get_read_tombstone_threshold() const noexcept {
+        return _read_tombstone_threshold;
+    }
 
 protected:
     virtual void log_too_many_rows(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t rows_count) const = 0;
@@ -138,12 +161,14 @@ protected:
     virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const = 0;
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const = 0;
     virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size) const = 0;
+    virtual future<> record_large_read(const read_info& info) const = 0;
 };
 
 class cql_table_large_data_handler : public large_data_handler {
 public:
-    explicit cql_table_large_data_handler(uint64_t partition_threshold_bytes, uint64_t row_threshold_bytes, uint64_t cell_threshold_bytes, uint64_t rows_count_threshold)
-        : large_data_handler(partition_threshold_bytes, row_threshold_bytes, cell_threshold_bytes, rows_count_threshold) {}
+    explicit cql_table_large_data_handler(uint64_t partition_threshold_bytes, uint64_t row_threshold_bytes, uint64_t cell_threshold_bytes, uint64_t rows_count_threshold,
+            uint64_t read_tombstone_threshold)
+        : large_data_handler(partition_threshold_bytes, row_threshold_bytes, cell_threshold_bytes, rows_count_threshold, read_tombstone_threshold) {}
 
 protected:
     virtual void log_too_many_rows(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t rows_count) const override;
@@ -152,6 +177,7 @@ protected:
     virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size) const override;
     virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const override;
+    virtual future<> record_large_read(const read_info& info) const override;
 };
 
 class nop_large_data_handler : public large_data_handler {
@@ -178,6 +204,10 @@ public:
             const clustering_key_prefix* clustering_key, uint64_t row_size) const override {
         return make_ready_future<>();
     }
+
+    virtual future<> record_large_read(const read_info& info) const override {
+        return make_ready_future<>();
+    }
 };
 
 }
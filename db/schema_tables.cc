@@ -79,6 +79,7 @@
 #include <boost/range/algorithm/transform.hpp>
 #include <boost/range/adaptor/indirected.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/join.hpp>
 
 #include "compaction_strategy.hh"
@@ -723,8 +724,12 @@ future<utils::UUID> calculate_schema_digest(distributed<service::storage_proxy>&
         }
     };
     return do_with(md5_hasher(), all_table_names(features), std::move(map), [features, reduce] (auto& hash, auto& tables, auto& map) mutable {
-        return do_for_each(tables, [&hash, &map, reduce, features] (auto& table) mutable {
-            return map(table).then([&hash, reduce, features] (auto&& mutations) {
+        // Query all schema tables concurrently. The hash is fed strictly in
+        // table order from the results below, so the digest is unchanged.
+        auto futures = boost::copy_range<std::vector<future<std::vector<mutation>>>>(
+                tables | boost::adaptors::transformed([&map] (auto& table) { return map(table); }));
+        return when_all_succeed(futures.begin(), futures.end()).then([&hash, reduce, features] (std::vector<std::vector<mutation>> results) mutable {
+            for (auto&& mutations : results) {
                 if (diff_logger.is_enabled(logging::log_level::trace)) {
                     for (const mutation& m : mutations) {
                         md5_hasher h;
@@ -733,8 +738,7 @@ future<utils::UUID> calculate_schema_digest(distributed<service::storage_proxy>&
                     }
                 }
                 reduce(hash, mutations);
-            });
-        }).then([&hash] {
+            }
             return make_ready_future<utils::UUID>(utils::UUID_gen::get_name_UUID(hash.finalize()));
         });
     });
@@ -930,14 +934,21 @@ std::map<utils::UUID, schema_mutations>
 read_tables_for_keyspaces(distributed<service::storage_proxy>& proxy, const std::set<sstring>& keyspace_names, schema_ptr s)
 {
     std::map<utils::UUID, schema_mutations> result;
-    for (auto&& keyspace_name : keyspace_names) {
-        for (auto&& table_name : read_table_names_of_keyspace(proxy, keyspace_name, s).get0()) {
-            auto qn = qualified_name(keyspace_name, table_name);
-            auto muts = read_table_mutations(proxy, qn, s).get0();
-            auto id = table_id_from_mutations(muts);
-            result.emplace(std::move(id), std::move(muts));
-        }
-    }
+    // Reading a table's schema takes several partition reads, so with many
+    // tables doing them one after another dominates a full-schema merge.
+    // Fan the reads out across keyspaces and tables instead.
+    parallel_for_each(keyspace_names, [&] (const sstring& keyspace_name) {
+        return read_table_names_of_keyspace(proxy, keyspace_name, s).then([&] (std::vector<sstring>&& table_names) {
+            return do_with(std::move(table_names), [&] (std::vector<sstring>& table_names) {
+                return parallel_for_each(table_names, [&] (const sstring& table_name) {
+                    return read_table_mutations(proxy, qualified_name(keyspace_name, table_name), s).then([&result] (schema_mutations&& muts) {
+                        auto id = table_id_from_mutations(muts);
+                        result.emplace(std::move(id), std::move(muts));
+                    });
+                });
+            });
+        });
+    }).get();
     return result;
 }
 
@@ -3117,7 +3128,7 @@ view_ptr maybe_fix_legacy_secondary_index_mv_schema(database& db, const view_ptr
     // If the first clustering key part of a view is a column with name not found in base schema,
     // it implies it might be backing an index created before computed columns were introduced,
     // and as such it must be recreated properly.
-    if (!base_schema->columns_by_name().contains(first_view_ck.name())) {
+    if (!base_schema->get_column_definition(first_view_ck.name())) {
         schema_builder builder{schema_ptr(v)};
         builder.mark_column_computed(first_view_ck.name(), std::make_unique<legacy_token_column_computation>());
         if (preserve_version) {
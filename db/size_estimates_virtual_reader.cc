@@ -156,25 +156,14 @@ static std::vector<sstring> get_keyspaces(const schema& s, const database& db, d
 }
 
 /**
- * Makes a wrapping range of ring_position from a nonwrapping range of token, used to select sstables.
- */
-static dht::partition_range as_ring_position_range(dht::token_range& r) {
-    std::optional<range<dht::ring_position>::bound> start_bound, end_bound;
-    if (r.start()) {
-        start_bound = {{ dht::ring_position(r.start()->value(), dht::ring_position::token_bound::start), r.start()->is_inclusive() }};
-    }
-    if (r.end()) {
-        end_bound = {{ dht::ring_position(r.end()->value(), dht::ring_position::token_bound::end), r.end()->is_inclusive() }};
-    }
-    return dht::partition_range(std::move(start_bound), std::move(end_bound), r.is_singular());
-}
-
-/**
- * Add a new range_estimates for the specified range, considering the sstables associated with `cf`.
+ * Add a new range_estimates for the specified range, using the online
+ * size histogram maintained by the table's sstable set. This is a plain
+ * walk over in-memory buckets: connectors that query every range at
+ * startup no longer trigger any sstable metadata crunching.
  */
 static system_keyspace::range_estimates estimate(const column_family& cf, const token_range& r) {
     int64_t count{0};
-    utils::estimated_histogram hist{0};
+    int64_t data_size{0};
     auto from_bytes = [] (auto& b) {
         return dht::token::from_sstring(utf8_type->to_string(b));
     };
@@ -183,14 +172,13 @@ static system_keyspace::range_estimates estimate(const column_family& cf, const
         wrapping_range<dht::token>({{ from_bytes(r.start), false }}, {{ from_bytes(r.end) }}),
         dht::token_comparator(),
         [&] (auto&& rng) { ranges.push_back(std::move(rng)); });
+    const auto& hist = cf.get_sstable_set().size_histogram();
     for (auto&& r : ranges) {
-        auto rp_range = as_ring_position_range(r);
-        for (auto&& sstable : cf.select_sstables(rp_range)) {
-            count += sstable->estimated_keys_for_range(r);
-            hist.merge(sstable->get_stats_metadata().estimated_partition_size);
-        }
+        auto e = hist.estimate_for(r);
+        count += e.partitions;
+        data_size += e.data_size;
     }
-    return {cf.schema(), r.start, r.end, count, count > 0 ? hist.mean() : 0};
+    return {cf.schema(), r.start, r.end, count, count > 0 ? data_size / count : 0};
 }
 
 /**
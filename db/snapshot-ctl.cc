@@ -44,6 +44,12 @@
 
 namespace db {
 
+// Bounds how many tables have their sstables linked at once on each shard.
+// Each table's linking is further bounded by the sstable loading concurrency,
+// so this mostly caps the number of snapshot directories being populated
+// simultaneously when a keyspace holds thousands of tables.
+static constexpr size_t max_concurrent_table_snapshots = 16;
+
 future<> snapshot_ctl::check_snapshot_not_exist(sstring ks_name, sstring name, std::optional<std::vector<sstring>> filter) {
     auto& ks = _db.local().find_keyspace(ks_name);
     return parallel_for_each(ks.metadata()->cf_meta_data(), [this, ks_name = std::move(ks_name), name = std::move(name), filter = std::move(filter)] (auto& pair) {
@@ -94,7 +100,7 @@ future<> snapshot_ctl::take_snapshot(sstring tag, std::vector<sstring> keyspace_
             return _db.invoke_on_all([tag = std::move(tag), keyspace_names] (database& db) {
                 return parallel_for_each(keyspace_names, [&db, tag = std::move(tag)] (auto& ks_name) {
                     auto& ks = db.find_keyspace(ks_name);
-                    return parallel_for_each(ks.metadata()->cf_meta_data(), [&db, tag = std::move(tag)] (auto& pair) {
+                    return max_concurrent_for_each(ks.metadata()->cf_meta_data(), max_concurrent_table_snapshots, [&db, tag = std::move(tag)] (auto& pair) {
                         auto& cf = db.find_column_family(pair.second);
                         return cf.snapshot(db, tag);
                     });
@@ -116,12 +122,14 @@ future<> snapshot_ctl::take_column_family_snapshot(sstring ks_name, std::vector<
     }
 
     return run_snapshot_modify_operation([this, ks_name = std::move(ks_name), tables = std::move(tables), tag = std::move(tag)] {
+        for (const auto& table_name : tables) {
+            if (table_name.find(".") != sstring::npos) {
+                throw std::invalid_argument("Cannot take a snapshot of a secondary index by itself. Run snapshot on the table that owns the index.");
+            }
+        }
         return check_snapshot_not_exist(ks_name, tag, tables).then([this, ks_name, tables, tag] {
             return do_with(std::vector<sstring>(std::move(tables)),[this, ks_name, tag](const std::vector<sstring>& tables) {
-                return do_for_each(tables, [ks_name, tag, this] (const sstring& table_name) {
-                    if (table_name.find(".") != sstring::npos) {
-                        throw std::invalid_argument("Cannot take a snapshot of a secondary index by itself. Run snapshot on the table that owns the index.");
-                    }
+                return max_concurrent_for_each(tables, max_concurrent_table_snapshots, [ks_name, tag, this] (const sstring& table_name) {
                     return _db.invoke_on_all([ks_name, table_name, tag] (database &db) {
                         auto& cf = db.find_column_family(ks_name, table_name);
                         return cf.snapshot(db, tag);
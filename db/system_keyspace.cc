@@ -470,6 +470,68 @@ schema_ptr built_indexes() {
     return compaction_history;
 }
 
+/*static*/ schema_ptr compaction_checkpoints() {
+    static thread_local auto compaction_checkpoints = [] {
+        schema_builder builder(make_shared_schema(generate_legacy_id(NAME, COMPACTION_CHECKPOINTS), NAME, COMPACTION_CHECKPOINTS,
+        // partition key
+        {
+            {"keyspace_name", utf8_type},
+            {"table_name", utf8_type},
+        },
+        // clustering key
+        {
+            {"shard", int32_type},
+            {"sub_compaction", int32_type},
+        },
+        // regular columns
+        {
+            {"sub_compactions", int32_type},
+            {"inputs", set_type_impl::get_instance(long_type, true)},
+        },
+        // static columns
+        {},
+        // regular column name type
+        utf8_type,
+        // comment
+        "progress checkpoints of interrupted major compactions"
+        ));
+        builder.set_gc_grace_seconds(0);
+        builder.with_version(generate_schema_version(builder.uuid()));
+        return builder.build(schema_builder::compact_storage::no);
+    }();
+    return compaction_checkpoints;
+}
+
+/*static*/ schema_ptr cache_warmup() {
+    static thread_local auto cache_warmup = [] {
+        schema_builder builder(make_shared_schema(generate_legacy_id(NAME, CACHE_WARMUP), NAME, CACHE_WARMUP,
+        // partition key
+        {
+            {"keyspace_name", utf8_type},
+            {"table_name", utf8_type},
+        },
+        // clustering key
+        {
+            {"shard", int32_type},
+        },
+        // regular columns
+        {
+            {"keys", set_type_impl::get_instance(bytes_type, true)},
+        },
+        // static columns
+        {},
+        // regular column name type
+        utf8_type,
+        // comment
+        "cache-resident partition keys for warmup after restart"
+        ));
+        builder.set_gc_grace_seconds(0);
+        builder.with_version(generate_schema_version(builder.uuid()));
+        return builder.build(schema_builder::compact_storage::no);
+    }();
+    return cache_warmup;
+}
+
 /*static*/ schema_ptr sstable_activity() {
     static thread_local auto sstable_activity = [] {
         schema_builder builder(make_shared_schema(generate_legacy_id(NAME, SSTABLE_ACTIVITY), NAME, SSTABLE_ACTIVITY,
@@ -593,6 +655,41 @@ static schema_ptr large_cells() {
     return large_cells;
 }
 
+static schema_ptr large_reads() {
+    static thread_local auto large_reads = [] {
+        auto id = generate_legacy_id(NAME, LARGE_READS);
+        return schema_builder(NAME, LARGE_READS, std::optional(id))
+                .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+                .with_column("table_name", utf8_type, column_kind::partition_key)
+                // We want the largest reads first, so use reversed_type_impl
+                .with_column("partition_size", reversed_type_impl::get_instance(long_type), column_kind::clustering_key)
+                .with_column("partition_key", utf8_type, column_kind::clustering_key)
+                .with_column("tombstones", long_type)
+                .with_column("fragments", long_type)
+                .with_column("read_time", timestamp_type)
+                .set_comment("sampled reads that merged large partitions or scanned many tombstones")
+                .with_version(generate_schema_version(id))
+                .set_gc_grace_seconds(0)
+                .build();
+    }();
+    return large_reads;
+}
+
+static schema_ptr table_activity() {
+    static thread_local auto table_activity = [] {
+        auto id = generate_legacy_id(NAME, TABLE_ACTIVITY);
+        return schema_builder(NAME, TABLE_ACTIVITY, std::optional(id))
+                .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+                .with_column("table_name", utf8_type, column_kind::clustering_key)
+                .with_column("last_active", timestamp_type)
+                .set_comment("when each table was last read; drives startup population order")
+                .with_version(generate_schema_version(id))
+                .set_gc_grace_seconds(0)
+                .build();
+    }();
+    return table_activity;
+}
+
 /*static*/ schema_ptr scylla_local() {
     static thread_local auto scylla_local = [] {
         schema_builder builder(make_shared_schema(generate_legacy_id(NAME, SCYLLA_LOCAL), NAME, SCYLLA_LOCAL,
@@ -1434,6 +1531,26 @@ future<db_clock::time_point> get_truncated_at(utils::UUID cf_id) {
     });
 }
 
+future<> update_table_activity(const sstring& ks_name, const sstring& cf_name, db_clock::time_point last_active) {
+    sstring req = format("INSERT INTO system.{} (keyspace_name, table_name, last_active) VALUES (?, ?, ?)", TABLE_ACTIVITY);
+    return qctx->execute_cql(req, ks_name, cf_name, last_active).discard_result();
+}
+
+future<std::map<std::pair<sstring, sstring>, db_clock::time_point>> load_table_activity() {
+    sstring req = format("SELECT keyspace_name, table_name, last_active FROM system.{}", TABLE_ACTIVITY);
+    return qctx->execute_cql(req).then([] (::shared_ptr<cql3::untyped_result_set> cql_result) {
+        std::map<std::pair<sstring, sstring>, db_clock::time_point> ret;
+        for (auto& row : *cql_result) {
+            if (!row.has("last_active")) {
+                continue;
+            }
+            ret.emplace(std::make_pair(row.get_as<sstring>("keyspace_name"), row.get_as<sstring>("table_name")),
+                    row.get_as<db_clock::time_point>("last_active"));
+        }
+        return ret;
+    });
+}
+
 static set_type_impl::native_type prepare_tokens(const std::unordered_set<dht::token>& tokens) {
     set_type_impl::native_type tset;
     for (auto& t: tokens) {
@@ -1852,8 +1969,10 @@ std::vector<schema_ptr> all_tables() {
     std::copy(schema_tables.begin(), schema_tables.end(), std::back_inserter(r));
     r.insert(r.end(), { built_indexes(), hints(), batchlog(), paxos(), local(),
                     peers(), peer_events(), range_xfers(),
-                    compactions_in_progress(), compaction_history(),
-                    sstable_activity(), clients(), size_estimates(), large_partitions(), large_rows(), large_cells(),
+                    compactions_in_progress(), compaction_history(), compaction_checkpoints(),
+                    cache_warmup(),
+                    sstable_activity(), clients(), size_estimates(), large_partitions(), large_rows(), large_cells(), large_reads(),
+                    table_activity(),
                     scylla_local(), db::schema_tables::scylla_table_schema_history(),
                     raft(), raft_snapshots(),
                     v3::views_builds_in_progress(), v3::built_views(),
@@ -2044,6 +2163,71 @@ future<> get_compaction_history(compaction_history_consumer&& f) {
     });
 }
 
+future<> save_compaction_checkpoint(sstring ksname, sstring cfname, int32_t sub_compaction, int32_t sub_compactions, const std::unordered_set<int64_t>& inputs) {
+    auto set_type = set_type_impl::get_instance(long_type, true);
+    sstring req = format("INSERT INTO system.{} (keyspace_name, table_name, shard, sub_compaction, sub_compactions, inputs) VALUES (?, ?, ?, ?, ?, ?)",
+                    COMPACTION_CHECKPOINTS);
+    set_type_impl::native_type input_values(inputs.begin(), inputs.end());
+    return qctx->execute_cql(req, ksname, cfname, int32_t(this_shard_id()), sub_compaction, sub_compactions,
+                       make_set_value(set_type, std::move(input_values))).discard_result().handle_exception([] (auto ep) {
+        // Failing to checkpoint only costs resumability, not correctness.
+        slogger.error("save compaction checkpoint failed: {}: ignored", ep);
+    });
+}
+
+future<std::optional<compaction_checkpoint>> get_compaction_checkpoint(sstring ksname, sstring cfname) {
+    sstring req = format("SELECT * FROM system.{} WHERE keyspace_name = ? AND table_name = ? AND shard = ?", COMPACTION_CHECKPOINTS);
+    return qctx->execute_cql(req, ksname, cfname, int32_t(this_shard_id())).then([] (::shared_ptr<cql3::untyped_result_set> rs) {
+        std::optional<compaction_checkpoint> ret;
+        for (const auto& row : *rs) {
+            auto sub_compactions = row.get_as<int32_t>("sub_compactions");
+            auto inputs = row.get_set<int64_t>("inputs");
+            if (!ret) {
+                ret.emplace();
+                ret->sub_compactions = sub_compactions;
+                ret->inputs = std::move(inputs);
+            } else if (ret->sub_compactions != sub_compactions || ret->inputs != inputs) {
+                // Rows can only disagree on the job they belong to if cleaning
+                // up an older checkpoint failed; the whole thing is stale then.
+                return std::optional<compaction_checkpoint>();
+            }
+            ret->completed.insert(row.get_as<int32_t>("sub_compaction"));
+        }
+        return ret;
+    });
+}
+
+future<> remove_compaction_checkpoint(sstring ksname, sstring cfname) {
+    sstring req = format("DELETE FROM system.{} WHERE keyspace_name = ? AND table_name = ? AND shard = ?", COMPACTION_CHECKPOINTS);
+    return qctx->execute_cql(req, ksname, cfname, int32_t(this_shard_id())).discard_result().handle_exception([] (auto ep) {
+        slogger.error("remove compaction checkpoint failed: {}: ignored", ep);
+    });
+}
+
+future<> save_cache_warmup_keys(sstring ksname, sstring cfname, const std::vector<bytes>& keys) {
+    auto set_type = set_type_impl::get_instance(bytes_type, true);
+    sstring req = format("INSERT INTO system.{} (keyspace_name, table_name, shard, keys) VALUES (?, ?, ?, ?)", CACHE_WARMUP);
+    set_type_impl::native_type key_values(keys.begin(), keys.end());
+    return qctx->execute_cql(req, ksname, cfname, int32_t(this_shard_id()),
+                       make_set_value(set_type, std::move(key_values))).discard_result().handle_exception([] (auto ep) {
+        // The snapshot is refreshed periodically; losing one only costs warmup accuracy.
+        slogger.error("save cache warmup keys failed: {}: ignored", ep);
+    });
+}
+
+future<std::vector<bytes>> get_cache_warmup_keys(sstring ksname, sstring cfname) {
+    sstring req = format("SELECT keys FROM system.{} WHERE keyspace_name = ? AND table_name = ? AND shard = ?", CACHE_WARMUP);
+    return qctx->execute_cql(req, ksname, cfname, int32_t(this_shard_id())).then([] (::shared_ptr<cql3::untyped_result_set> rs) {
+        std::vector<bytes> keys;
+        if (!rs->empty() && rs->one().has("keys")) {
+            auto key_set = rs->one().get_set<bytes>("keys");
+            keys.reserve(key_set.size());
+            std::move(key_set.begin(), key_set.end(), std::back_inserter(keys));
+        }
+        return keys;
+    });
+}
+
 future<int> increment_and_get_generation() {
     auto req = format("SELECT gossip_generation FROM system.{} WHERE key='{}'", LOCAL, LOCAL);
     return qctx->qp().execute_internal(req).then([] (auto rs) {
@@ -97,11 +97,15 @@ static constexpr auto PEER_EVENTS = "peer_events";
 static constexpr auto RANGE_XFERS = "range_xfers";
 static constexpr auto COMPACTIONS_IN_PROGRESS = "compactions_in_progress";
 static constexpr auto COMPACTION_HISTORY = "compaction_history";
+static constexpr auto COMPACTION_CHECKPOINTS = "compaction_checkpoints";
+static constexpr auto CACHE_WARMUP = "cache_warmup";
 static constexpr auto SSTABLE_ACTIVITY = "sstable_activity";
 static constexpr auto SIZE_ESTIMATES = "size_estimates";
 static constexpr auto LARGE_PARTITIONS = "large_partitions";
 static constexpr auto LARGE_ROWS = "large_rows";
 static constexpr auto LARGE_CELLS = "large_cells";
+static constexpr auto LARGE_READS = "large_reads";
+static constexpr auto TABLE_ACTIVITY = "table_activity";
 static constexpr auto SCYLLA_LOCAL = "scylla_local";
 static constexpr auto RAFT = "raft";
 static constexpr auto RAFT_SNAPSHOTS = "raft_snapshots";
@@ -206,6 +210,17 @@ future<> remove_endpoint(gms::inet_address ep);
 future<> set_scylla_local_param(const sstring& key, const sstring& value);
 future<std::optional<sstring>> get_scylla_local_param(const sstring& key);
 
+/**
+ * Record that a table was recently read. Used at startup to populate
+ * recently-used tables before archival ones.
+ */
+future<> update_table_activity(const sstring& ks_name, const sstring& cf_name, db_clock::time_point last_active);
+
+/**
+ * Load the recorded last-activity time of every table.
+ */
+future<std::map<std::pair<sstring, sstring>, db_clock::time_point>> load_table_activity();
+
 std::vector<schema_ptr> all_tables();
 future<> make(database& db);
 
@@ -393,6 +408,27 @@ enum class bootstrap_state {
     using compaction_history_consumer = noncopyable_function<future<>(const compaction_history_entry&)>;
     future<> get_compaction_history(compaction_history_consumer&& f);
 
+    // Checkpoint of an interrupted major compaction, per table and shard: the
+    // generations of the job's input sstables, how many token-range
+    // sub-compactions the job was split into, and which of them already sealed
+    // their output. See compaction_manager::submit_major_compaction().
+    struct compaction_checkpoint {
+        std::unordered_set<int64_t> inputs;
+        int32_t sub_compactions = 0;
+        std::unordered_set<int32_t> completed;
+    };
+
+    future<> save_compaction_checkpoint(sstring ksname, sstring cfname, int32_t sub_compaction, int32_t sub_compactions, const std::unordered_set<int64_t>& inputs);
+    future<std::optional<compaction_checkpoint>> get_compaction_checkpoint(sstring ksname, sstring cfname);
+    future<> remove_compaction_checkpoint(sstring ksname, sstring cfname);
+
+    // Snapshot of the partition keys resident in a table's row cache, per
+    // shard, in serialized form. Periodically refreshed while the node runs
+    // and read back after a restart to warm the cache up.
+    // See database::warm_up_row_cache().
+    future<> save_cache_warmup_keys(sstring ksname, sstring cfname, const std::vector<bytes>& keys);
+    future<std::vector<bytes>> get_cache_warmup_keys(sstring ksname, sstring cfname);
+
     typedef std::vector<db::replay_position> replay_positions;
 
     future<> save_truncation_record(utils::UUID, db_clock::time_point truncated_at, db::replay_position);
@@ -673,8 +673,8 @@ bool view_updates::can_skip_view_updates(const clustering_row& update, const clu
 
     const bool base_has_nonexpiring_marker = update.marker().is_live() && !update.marker().is_expiring();
     return boost::algorithm::all_of(_base->regular_columns(), [this, &updated_row, &existing_row, base_has_nonexpiring_marker] (const column_definition& cdef) {
-        const auto view_it = _view->columns_by_name().find(cdef.name());
-        const bool column_is_selected = view_it != _view->columns_by_name().end();
+        const column_definition* view_cdef = _view->get_column_definition(cdef.name());
+        const bool column_is_selected = view_cdef != nullptr;
 
         //TODO(sarna): Optimize collections case - currently they do not go under optimization
         if (!cdef.is_atomic()) {
@@ -692,7 +692,7 @@ bool view_updates::can_skip_view_updates(const clustering_row& update, const clu
 
         // We cannot skip when a selected column is changed
         if (column_is_selected) {
-            if (view_it->second->is_view_virtual()) {
+            if (view_cdef->is_view_virtual()) {
                 return atomic_cells_liveness_equal(existing_cell_view, updated_cell_view);
             }
             return compare_atomic_cell_for_merge(existing_cell_view, updated_cell_view) == 0;
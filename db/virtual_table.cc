@@ -62,6 +62,84 @@ bool virtual_table::contains_key(const dht::partition_range& pr, const dht::deco
     return pr.contains(dk, dht::ring_position_comparator(*_s));
 }
 
+future<> result_collector::emit_partition_start(const dht::decorated_key& dk) {
+    return take(mutation_fragment(*_schema, _permit, partition_start(dk, tombstone())));
+}
+
+future<> result_collector::emit_partition_end() {
+    return take(mutation_fragment(*_schema, _permit, partition_end()));
+}
+
+future<> result_collector::emit_row(clustering_row&& cr) {
+    return take(mutation_fragment(*_schema, _permit, std::move(cr)));
+}
+
+mutation_source streaming_virtual_table::as_mutation_source() {
+    return mutation_source([this] (schema_ptr s,
+        reader_permit permit,
+        const dht::partition_range& range,
+        const query::partition_slice& slice,
+        const io_priority_class& pc,
+        tracing::trace_state_ptr trace_state,
+        streamed_mutation::forwarding fwd,
+        mutation_reader::forwarding fwd_mr) {
+
+        struct my_result_collector : public result_collector {
+            queue_reader_handle handle;
+
+            my_result_collector(schema_ptr s, reader_permit permit, queue_reader_handle handle)
+                : result_collector(std::move(s), std::move(permit))
+                , handle(std::move(handle))
+            { }
+
+            virtual future<> take(mutation_fragment mf) override {
+                return handle.push(std::move(mf));
+            }
+        };
+
+        struct query_restrictions_impl : public query_restrictions {
+            dht::partition_range _range;
+
+            explicit query_restrictions_impl(const dht::partition_range& range) : _range(range) {}
+
+            const dht::partition_range& partition_range() const override {
+                return _range;
+            }
+        };
+
+        auto [rd, handle] = make_queue_reader(schema(), permit);
+
+        // The fill fiber runs in the background, pushing fragments into the
+        // queue as the reader drains it. do_with() keeps the collector and
+        // the restrictions alive until execute() resolves.
+        (void)do_with(my_result_collector(schema(), permit, std::move(handle)), query_restrictions_impl(range),
+                [this, permit] (my_result_collector& collector, query_restrictions_impl& restrictions) {
+            return execute(permit, collector, restrictions).then([&collector] {
+                collector.handle.push_end_of_stream();
+            }).handle_exception([&collector] (std::exception_ptr ex) {
+                collector.handle.abort(std::move(ex));
+            });
+        });
+
+        // The slicing reader handles partition skipping by dropping
+        // fragments, so it can wrap the queue reader directly; the filtering
+        // reader can't, but may wrap the slicing reader.
+        rd = make_slicing_filtering_reader(std::move(rd), range, slice);
+
+        if (!_shard_aware) {
+            rd = make_filtering_reader(std::move(rd), [this] (const dht::decorated_key& dk) -> bool {
+                return this_shard_owns(dk);
+            });
+        }
+
+        if (fwd == streamed_mutation::forwarding::yes) {
+            rd = make_forwardable(std::move(rd));
+        }
+
+        return rd;
+    });
+}
+
 mutation_source memtable_filling_virtual_table::as_mutation_source() {
     return mutation_source([this] (schema_ptr s,
         reader_permit permit,
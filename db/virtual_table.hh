@@ -75,5 +75,57 @@ public:
     mutation_source as_mutation_source() override;
 };
 
+// Accepts the results of a query, one fragment at a time, propagating
+// the reader's back-pressure to the producer.
+//
+// Use like this:
+//
+//   co_await result.emit_partition_start(dk1);
+//   co_await result.emit_row(std::move(row1));
+//   co_await result.emit_row(std::move(row2));
+//   co_await result.emit_partition_end();
+//   co_await result.emit_partition_start(dk2);
+//   ...
+//
+class result_collector {
+protected:
+    schema_ptr _schema;
+    reader_permit _permit;
+public:
+    result_collector(schema_ptr s, reader_permit permit)
+        : _schema(std::move(s))
+        , _permit(std::move(permit))
+    { }
+
+    virtual ~result_collector() = default;
+
+    const ::schema& schema() const { return *_schema; }
+
+    future<> emit_partition_start(const dht::decorated_key& dk);
+    future<> emit_partition_end();
+    future<> emit_row(clustering_row&& cr);
+
+    // Lower-level interface for producers which already have a fragment
+    // stream. Fragments must form a valid mutation fragment stream.
+    virtual future<> take(mutation_fragment mf) = 0;
+};
+
+// Produces results by emitting a stream of mutation fragments into a
+// result_collector, which only buffers a bounded amount of data and lets
+// the producer run only as fast as the query consumes the stream.
+// Use when the amount of data may be significant relative to shard's
+// memory size.
+//
+// The implementation is allowed to produce more data than implied by the
+// query_restrictions, it will be filtered out automatically. Partitions
+// must be emitted in ring order and rows in clustering order, though.
+class streaming_virtual_table : public virtual_table {
+public:
+    using virtual_table::virtual_table;
+
+    virtual future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) = 0;
+
+    mutation_source as_mutation_source() override;
+};
 
 }
@@ -65,6 +65,14 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
         const dht::token_range& range_ = x.first;
         const std::vector<inet_address>& addresses = x.second;
         bool found_source = false;
+        // Each range is still fetched from exactly one node, but among the
+        // acceptable sources we pick the one with the fewest ranges assigned
+        // so far. Ranges with overlapping replica sets then spread over the
+        // replicas instead of all landing on the first candidate, letting
+        // do_stream_async() actually stream from them in parallel. Sources
+        // are sorted by proximity, so on a tie we keep the closest.
+        std::optional<inet_address> best_source;
+        size_t best_load = 0;
         for (auto address : addresses) {
             if (address == utils::fb_utilities::get_broadcast_address()) {
                 // If localhost is a source, we have found one, but we don't add it to the map to avoid streaming locally
@@ -85,9 +93,17 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                 continue;
             }
 
-            range_fetch_map_map[address].push_back(range_);
+            auto it = range_fetch_map_map.find(address);
+            auto load = it == range_fetch_map_map.end() ? size_t(0) : it->second.size();
+            if (!best_source || load < best_load) {
+                best_source = address;
+                best_load = load;
+            }
             found_source = true;
-            break; // ensure we only stream from one other node for each range
+        }
+
+        if (best_source) {
+            range_fetch_map_map[*best_source].push_back(range_);
         }
 
         if (!found_source) {
@@ -36,7 +36,7 @@ struct noop_hasher {
 };
 
 class digester final {
-    std::variant<noop_hasher, md5_hasher, xx_hasher, legacy_xx_hasher_without_null_digest> _impl;
+    std::variant<noop_hasher, md5_hasher, xx_hasher, legacy_xx_hasher_without_null_digest, xx3_hasher> _impl;
 
 public:
     explicit digester(digest_algorithm algo) {
@@ -50,6 +50,9 @@ public:
         case digest_algorithm::legacy_xxHash_without_null_digest:
             _impl = legacy_xx_hasher_without_null_digest();
             break;
+        case digest_algorithm::xxHash3:
+            _impl = xx3_hasher();
+            break;
         case digest_algorithm ::none:
             _impl = noop_hasher();
             break;
@@ -72,8 +75,14 @@ public:
 
 using default_hasher = xx_hasher;
 
+// Hashers that digest a per-cell hash instead of the full cell content.
+// The per-cell hashes are cached in rows (row::prepare_hash()) and are
+// always computed with default_hasher, so only hashers producing identical
+// cell hashes may take part -- otherwise the digest would depend on which
+// cells happen to have a cached hash. In particular xx3_hasher digests the
+// full cell content; it is fast enough to not need the memoization.
 template<typename Hasher>
-using using_hash_of_hash = std::negation<std::disjunction<std::is_same<Hasher, md5_hasher>, std::is_same<Hasher, noop_hasher>>>;
+using using_hash_of_hash = std::disjunction<std::is_same<Hasher, xx_hasher>, std::is_same<Hasher, legacy_xx_hasher_without_null_digest>>;
 
 template<typename Hasher>
 inline constexpr bool using_hash_of_hash_v = using_hash_of_hash<Hasher>::value;
@@ -203,6 +203,10 @@ public:
         return _real_region_group.memory_used();
     }
 
+    size_t real_throttle_threshold() const {
+        return _real_dirty_reclaimer.throttle_threshold();
+    }
+
     size_t virtual_dirty_memory() const {
         return _virtual_region_group.memory_used();
     }
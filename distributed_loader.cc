@@ -160,7 +160,7 @@ distributed_loader::process_sstable_dir(sharded<sstables::sstable_directory>& di
         // Supposed to be called with the node either down or on behalf of maintenance tasks
         // like nodetool refresh
         return d.process_sstable_dir(service::get_local_streaming_priority(), sort_sstables_according_to_owner).then([&dir, &d] {
-            return d.move_foreign_sstables(dir);
+            return d.move_foreign_sstables(dir, service::get_local_streaming_priority());
         });
       });
     }).then([&dir] {
@@ -269,7 +269,7 @@ future<> run_resharding_jobs(sharded<sstables::sstable_directory>& dir, std::vec
             auto max_threshold = table.schema()->max_compaction_threshold();
             auto& iop = service::get_local_streaming_priority();
             return d.reshard(std::move(info_vec), cm, table, max_threshold, creator, iop).then([&d, &dir] {
-                return d.move_foreign_sstables(dir);
+                return d.move_foreign_sstables(dir, service::get_local_streaming_priority());
             });
         }).then([start, total_size, ks_name, table_name] {
             auto duration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - start);
@@ -594,6 +594,16 @@ future<> distributed_loader::populate_column_family(distributed<database>& db, s
                 return global_table->add_sstable_and_update_cache(sst);
             });
         }).get();
+
+        // Persist the final ownership layout, so that the next boot can hand misplaced
+        // SSTables straight to their owner shard instead of opening them first.
+        using manifest_entries = std::vector<sstables::sstable_directory::manifest_entry>;
+        auto entries = directory.map_reduce0(std::mem_fn(&sstables::sstable_directory::local_ownership_entries),
+                manifest_entries(), [] (manifest_entries a, manifest_entries b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        }).get0();
+        directory.local().store_ownership_manifest(std::move(entries)).get();
     });
 }
 
@@ -721,20 +731,33 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<database>& db
             }
         }).get();
 
-        std::vector<future<>> futures;
+        // Populate recently-read keyspaces first, so that archival data does
+        // not compete with them for startup I/O. A keyspace none of whose
+        // tables has recorded activity within the last week is considered
+        // archival and populated in a second wave. When there is no recorded
+        // activity at all (e.g. first boot on this version) every keyspace
+        // lands in the first wave and the behavior is unchanged.
+        auto activity = db::system_keyspace::load_table_activity().get0();
+        const auto archival_before = db_clock::now() - std::chrono::hours(24 * 7);
+        auto is_archival = [&] (const sstring& ks_name) {
+            if (activity.empty()) {
+                return false;
+            }
+            for (auto& [key, last_active] : activity) {
+                if (key.first == ks_name && last_active >= archival_before) {
+                    return false;
+                }
+            }
+            return true;
+        };
 
-        // treat "dirs" as immutable to avoid modifying it while still in 
-        // a range-iteration. Also to simplify the "finally"
-        for (auto i = dirs.begin(); i != dirs.end();) {
-            auto& ks_name = i->first;
-            auto e = dirs.equal_range(ks_name).second;
-            auto j = i++;
+        auto populate_range = [&db] (ks_dirs::iterator b, ks_dirs::iterator e, sstring ks_name) {
             // might have more than one dir for a keyspace iff data_file_directories is > 1 and
-            // somehow someone placed sstables in more than one of them for a given ks. (import?) 
-            futures.emplace_back(parallel_for_each(j, e, [&](const std::pair<sstring, sstring>& p) {
+            // somehow someone placed sstables in more than one of them for a given ks. (import?)
+            return parallel_for_each(b, e, [&db, ks_name] (const std::pair<sstring, sstring>& p) {
                 auto& datadir = p.second;
                 return distributed_loader::populate_keyspace(db, datadir, ks_name);
-            }).finally([&] {
+            }).finally([&db, ks_name] {
                 return db.invoke_on_all([ks_name] (database& db) {
                     // can be false if running test environment
                     // or ks_name was just a borked directory not representing
@@ -744,11 +767,33 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<database>& db
                     }
                     return make_ready_future<>();
                 });
-            }));
+            });
+        };
+
+        std::vector<future<>> futures;
+        std::vector<std::tuple<ks_dirs::iterator, ks_dirs::iterator, sstring>> deferred;
+
+        // treat "dirs" as immutable to avoid modifying it while still in
+        // a range-iteration. Also to simplify the "finally"
+        for (auto i = dirs.begin(); i != dirs.end();) {
+            auto& ks_name = i->first;
+            auto e = dirs.equal_range(ks_name).second;
+            auto j = i++;
+            if (is_archival(ks_name)) {
+                deferred.emplace_back(j, e, ks_name);
+            } else {
+                futures.emplace_back(populate_range(j, e, ks_name));
+            }
         }
 
         when_all_succeed(futures.begin(), futures.end()).discard_result().get();
 
+        futures.clear();
+        for (auto& [b, e, ks_name] : deferred) {
+            futures.emplace_back(populate_range(b, e, ks_name));
+        }
+        when_all_succeed(futures.begin(), futures.end()).discard_result().get();
+
         db.invoke_on_all([] (database& db) {
             return parallel_for_each(db.get_non_system_column_families(), [] (lw_shared_ptr<table> table) {
                 // Make sure this is called even if the table is empty
@@ -66,6 +66,7 @@ constexpr std::string_view features::CORRECT_IDX_TOKEN_IN_SECONDARY_INDEX = "COR
 constexpr std::string_view features::ALTERNATOR_STREAMS = "ALTERNATOR_STREAMS";
 constexpr std::string_view features::RANGE_SCAN_DATA_VARIANT = "RANGE_SCAN_DATA_VARIANT";
 constexpr std::string_view features::CDC_GENERATIONS_V2 = "CDC_GENERATIONS_V2";
+constexpr std::string_view features::XXHASH3_DIGEST = "XXHASH3_DIGEST";
 
 static logging::logger logger("features");
 
@@ -91,6 +92,7 @@ feature_service::feature_service(feature_config cfg) : _config(cfg)
         , _alternator_streams_feature(*this, features::ALTERNATOR_STREAMS)
         , _range_scan_data_variant(*this, features::RANGE_SCAN_DATA_VARIANT)
         , _cdc_generations_v2(*this, features::CDC_GENERATIONS_V2)
+        , _xxhash3_digest_feature(*this, features::XXHASH3_DIGEST)
 {}
 
 feature_config feature_config_from_db_config(db::config& cfg, std::set<sstring> disabled) {
@@ -188,6 +190,7 @@ std::set<std::string_view> feature_service::known_feature_set() {
         gms::features::ALTERNATOR_STREAMS,
         gms::features::RANGE_SCAN_DATA_VARIANT,
         gms::features::CDC_GENERATIONS_V2,
+        gms::features::XXHASH3_DIGEST,
     };
 
     for (const sstring& s : _config._disabled_features) {
@@ -268,6 +271,7 @@ void feature_service::enable(const std::set<std::string_view>& list) {
         std::ref(_alternator_streams_feature),
         std::ref(_range_scan_data_variant),
         std::ref(_cdc_generations_v2),
+        std::ref(_xxhash3_digest_feature),
     })
     {
         if (list.contains(f.name())) {
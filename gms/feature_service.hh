@@ -93,6 +93,7 @@ private:
     gms::feature _alternator_streams_feature;
     gms::feature _range_scan_data_variant;
     gms::feature _cdc_generations_v2;
+    gms::feature _xxhash3_digest_feature;
 
 public:
     bool cluster_supports_user_defined_functions() const {
@@ -167,6 +168,10 @@ public:
     bool cluster_supports_cdc_generations_v2() const {
         return bool(_cdc_generations_v2);
     }
+
+    bool cluster_supports_xxhash3_digest() const {
+        return bool(_xxhash3_digest_feature);
+    }
 };
 
 } // namespace gms
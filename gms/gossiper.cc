@@ -268,7 +268,10 @@ future<> gossiper::handle_syn_msg(msg_addr from, gossip_digest_syn syn_msg) {
 }
 
 future<> gossiper::do_send_ack_msg(msg_addr from, gossip_digest_syn syn_msg) {
-    return futurize_invoke([this, from, syn_msg = std::move(syn_msg)] () mutable {
+    // Examining the digest list copies endpoint states, which can be
+    // expensive with many nodes, so run it in a thread where
+    // examine_gossiper() can yield between digests.
+    return seastar::async([this, from, syn_msg = std::move(syn_msg)] () mutable {
         auto g_digest_list = syn_msg.get_gossip_digests();
         do_sort(g_digest_list);
         utils::chunked_vector<gossip_digest> delta_gossip_digest_list;
@@ -276,7 +279,7 @@ future<> gossiper::do_send_ack_msg(msg_addr from, gossip_digest_syn syn_msg) {
         this->examine_gossiper(g_digest_list, delta_gossip_digest_list, delta_ep_state_map);
         gms::gossip_digest_ack ack_msg(std::move(delta_gossip_digest_list), std::move(delta_ep_state_map));
         logger.debug("Calling do_send_ack_msg to node {}, syn_msg={}, ack_msg={}", from, syn_msg, ack_msg);
-        return _messaging.send_gossip_digest_ack(from, std::move(ack_msg));
+        _messaging.send_gossip_digest_ack(from, std::move(ack_msg)).get();
     });
 }
 
@@ -370,10 +373,13 @@ future<> gossiper::handle_ack_msg(msg_addr id, gossip_digest_ack ack_msg) {
 }
 
 future<> gossiper::do_send_ack2_msg(msg_addr from, utils::chunked_vector<gossip_digest> ack_msg_digest) {
-    return futurize_invoke([this, from, ack_msg_digest = std::move(ack_msg_digest)] () mutable {
+    return seastar::async([this, from, ack_msg_digest = std::move(ack_msg_digest)] () mutable {
         /* Get the state required to send to this gossipee - construct GossipDigestAck2Message */
         std::map<inet_address, endpoint_state> delta_ep_state_map;
         for (auto g_digest : ack_msg_digest) {
+            // Limit the amount of work done in one go - the states we copy
+            // below can add up to a lot with many endpoints.
+            seastar::thread::maybe_yield();
             inet_address addr = g_digest.get_endpoint();
             auto local_ep_state_ptr = this->get_state_for_version_bigger_than(addr, g_digest.get_max_version());
             if (local_ep_state_ptr) {
@@ -382,7 +388,7 @@ future<> gossiper::do_send_ack2_msg(msg_addr from, utils::chunked_vector<gossip_
         }
         gms::gossip_digest_ack2 ack2_msg(std::move(delta_ep_state_map));
         logger.debug("Calling do_send_ack2_msg to node {}, ack_msg_digest={}, ack2_msg={}", from, ack_msg_digest, ack2_msg);
-        return _messaging.send_gossip_digest_ack2(from, std::move(ack2_msg));
+        _messaging.send_gossip_digest_ack2(from, std::move(ack2_msg)).get();
     });
 }
 
@@ -634,6 +640,7 @@ void gossiper::apply_state_locally_without_listener_notification(std::unordered_
         const inet_address& node = x.first;
         const endpoint_state& remote_state = x.second;
         do_apply_state_locally(node, remote_state, false);
+        seastar::thread::maybe_yield();
     }
 }
 
@@ -1730,6 +1737,7 @@ void gossiper::send_all(gossip_digest& g_digest,
     }
 }
 
+// Runs inside seastar::async context
 void gossiper::examine_gossiper(utils::chunked_vector<gossip_digest>& g_digest_list,
     utils::chunked_vector<gossip_digest>& delta_gossip_digest_list,
     std::map<inet_address, endpoint_state>& delta_ep_state_map) {
@@ -1745,6 +1753,10 @@ void gossiper::examine_gossiper(utils::chunked_vector<gossip_digest>& g_digest_l
         }
     }
     for (gossip_digest& g_digest : g_digest_list) {
+        // Processing a digest may copy a full endpoint state (send_all());
+        // yield between digests so a large syn does not stall the reactor.
+        // The endpoint state is re-fetched below, after the potential yield.
+        seastar::thread::maybe_yield();
         int remote_generation = g_digest.get_generation();
         int max_remote_version = g_digest.get_max_version();
         /* Get state associated with the end point in digest */
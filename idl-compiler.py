@@ -284,6 +284,21 @@ class ClassDef:
         name = ns_qualified_name(self.name, namespaces)
         full_name = name + template_class_param
 
+        fixed = fixed_layout(self) if not template_decl else None
+        if fixed:
+            offsets, size = fixed
+            fprintln(cout, f"""
+template <typename Output>
+void serializer<{full_name}>::write(Output& buf, const {full_name}& obj) {{
+  // Fixed-layout message: pack the fields into one block.
+  char tmp[{size}];""")
+            for member, offset in offsets:
+                fprintln(cout, f"""  static_assert(is_equivalent<decltype(obj.{member.name}), {param_type(member.type)}>::value, "member value has a wrong type");
+  serialize_fixed_at<{param_type(member.type)}>(tmp + {offset}, obj.{member.name});""")
+            fprintln(cout, f"""  buf.write(tmp, {size});
+}}""")
+            return
+
         fprintln(cout, f"""
 {template_decl}
 template <typename Output>
@@ -302,6 +317,28 @@ void serializer<{full_name}>::write(Output& buf, const {full_name}& obj) {{""")
         is_final = self.final
         name = ns_qualified_name(self.name, namespaces)
 
+        fixed = fixed_layout(self) if not template_decl else None
+        if fixed:
+            offsets, size = fixed
+            fprintln(cout, f"""
+template <typename Input>
+{name} serializer<{name}>::read(Input& buf) {{
+ return seastar::with_serialized_stream(buf, [] (auto& buf) {{
+  // Fixed-layout message: read the whole block, then unpack.
+  char tmp[{size}];
+  buf.read(tmp, {size});""")
+            params = []
+            for index, (member, offset) in enumerate(offsets):
+                local_param = "__local_" + str(index)
+                fprintln(cout, f"""  auto {local_param} = deserialize_fixed_at<{param_type(member.type)}>(tmp + {offset});""")
+                params.append(local_param)
+            fprintln(cout, f"""
+  {name} res {{{", ".join(params)}}};
+  return res;
+ }});
+}}""")
+            return
+
         fprintln(cout, f"""
 {template_decl}
 template <typename Input>
@@ -345,6 +382,18 @@ template <typename Input>
         is_final = self.final
         name = ns_qualified_name(self.name, namespaces)
 
+        fixed = fixed_layout(self) if not template_decl else None
+        if fixed:
+            _, size = fixed
+            fprintln(cout, f"""
+template <typename Input>
+void serializer<{name}>::skip(Input& buf) {{
+ seastar::with_serialized_stream(buf, [] (auto& buf) {{
+  buf.skip({size});
+ }});
+}}""")
+            return
+
         fprintln(cout, f"""
 {template_decl}
 template <typename Input>
@@ -645,6 +694,44 @@ def get_members(cls):
     return [p for p in cls.members if not isinstance(p, ClassDef) and not isinstance(p, EnumDef)]
 
 
+# Serialized sizes of the types with a fixed on-wire layout. A message whose
+# members all come from this table is serialized as one contiguous
+# little-endian block at constant offsets (see serialize_fixed_at() in
+# serializer.hh) instead of field-by-field stream writes. Only final classes
+# qualify: non-final ones carry a size prefix and may grow new fields in a
+# future version.
+FIXED_LAYOUT_SIZES = {
+    'bool': 1,
+    'int8_t': 1,
+    'uint8_t': 1,
+    'int16_t': 2,
+    'uint16_t': 2,
+    'int32_t': 4,
+    'uint32_t': 4,
+    'int64_t': 8,
+    'uint64_t': 8,
+}
+
+
+def fixed_layout(cls):
+    '''For classes with a fixed on-wire layout returns ([(member, offset)], total_size),
+    otherwise returns None.'''
+    if not cls.final or cls.template_params is not None:
+        return None
+    members = get_members(cls)
+    # Be conservative about nested type definitions.
+    if not members or len(members) != len(cls.members):
+        return None
+    offsets = []
+    size = 0
+    for m in members:
+        if m.attribute or not is_basic_type(m.type) or m.type.name not in FIXED_LAYOUT_SIZES:
+            return None
+        offsets.append((m, size))
+        size += FIXED_LAYOUT_SIZES[m.type.name]
+    return offsets, size
+
+
 def is_final(cls):
     return cls.final
 
@@ -79,19 +79,21 @@ inet_address_vector_replica_set abstract_replication_strategy::get_natural_endpo
 }
 
 inet_address_vector_replica_set abstract_replication_strategy::do_get_natural_endpoints(const token& search_token, const token_metadata& tm, can_yield can_yield) {
-    const token& key_token = tm.first_token(search_token);
-    auto& cached_endpoints = get_cached_endpoints(tm);
-    auto res = cached_endpoints.find(key_token);
-
-    if (res == cached_endpoints.end()) {
-        auto endpoints = calculate_natural_endpoints(search_token, tm, can_yield);
-        cached_endpoints.emplace(key_token, endpoints);
-
-        return endpoints;
+    const auto key_token_index = tm.first_token_index(search_token);
+    {
+        auto& cached_endpoints = get_cached_endpoints(tm);
+        auto& entry = cached_endpoints[key_token_index];
+        if (entry) {
+            ++_cache_hits_count;
+            return *entry;
+        }
     }
-
-    ++_cache_hits_count;
-    return res->second;
+    auto endpoints = calculate_natural_endpoints(search_token, tm, can_yield);
+    // calculate_natural_endpoints() may have yielded, and the cache may
+    // have been invalidated for a newer ring meanwhile; re-fetching
+    // revalidates the ring version (and the slot count) before storing.
+    get_cached_endpoints(tm)[key_token_index] = endpoints;
+    return endpoints;
 }
 
 inet_address_vector_replica_set abstract_replication_strategy::get_natural_endpoints_without_node_being_replaced(const token& search_token, can_yield can_yield) {
@@ -132,13 +134,14 @@ void abstract_replication_strategy::validate_replication_factor(sstring rf) cons
     }
 }
 
-inline std::unordered_map<token, inet_address_vector_replica_set>&
+inline std::vector<std::optional<inet_address_vector_replica_set>>&
 abstract_replication_strategy::get_cached_endpoints(const token_metadata& tm) {
     auto ring_version = tm.get_ring_version();
     if (_last_invalidated_ring_version != ring_version) {
         _cached_endpoints.clear();
         _last_invalidated_ring_version = ring_version;
     }
+    _cached_endpoints.resize(tm.sorted_tokens().size());
 
     return _cached_endpoints;
 }
@@ -23,7 +23,9 @@
 
 #include <memory>
 #include <functional>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 #include "gms/inet_address.hh"
 #include "locator/snitch_base.hh"
 #include "dht/i_partitioner.hh"
@@ -52,12 +54,16 @@ using can_yield = utils::can_yield;
 class abstract_replication_strategy {
 private:
     long _last_invalidated_ring_version = 0;
-    std::unordered_map<token, inet_address_vector_replica_set> _cached_endpoints;
+    // Replica sets cached per ring position: slot i holds the replicas
+    // for the range owned by sorted_tokens()[i]. Keeping this a flat
+    // vector makes the hot path lookup the binary search we do anyway
+    // plus one index into contiguous memory.
+    std::vector<std::optional<inet_address_vector_replica_set>> _cached_endpoints;
     uint64_t _cache_hits_count = 0;
 
     static logging::logger logger;
 
-    std::unordered_map<token, inet_address_vector_replica_set>&
+    std::vector<std::optional<inet_address_vector_replica_set>>&
     get_cached_endpoints(const token_metadata& tm);
 protected:
     sstring _ks_name;
@@ -1532,13 +1532,14 @@ void token_metadata_impl::calculate_pending_ranges_for_leaving(
         const abstract_replication_strategy& strategy,
         std::unordered_multimap<range<token>, inet_address>& new_pending_ranges,
         mutable_token_metadata_ptr all_left_metadata) const {
-    std::unordered_multimap<inet_address, dht::token_range> address_ranges = strategy.get_address_ranges(unpimplified_this, can_yield::yes);
+    if (_leaving_endpoints.empty()) {
+        return;
+    }
     // get all ranges that will be affected by leaving nodes
     std::unordered_set<range<token>> affected_ranges;
     for (auto endpoint : _leaving_endpoints) {
-        auto r = address_ranges.equal_range(endpoint);
-        for (auto x = r.first; x != r.second; x++) {
-            affected_ranges.emplace(x->second);
+        for (const auto& x : strategy.get_address_ranges(unpimplified_this, endpoint, can_yield::yes)) {
+            affected_ranges.emplace(x.second);
         }
     }
     // for each of those ranges, find what new nodes will be responsible for the range when
@@ -1630,13 +1631,17 @@ future<> token_metadata_impl::update_pending_ranges(
     return async([this, &unpimplified_this, &strategy, keyspace_name] () mutable {
         std::unordered_multimap<range<token>, inet_address> new_pending_ranges;
         calculate_pending_ranges_for_replacing(unpimplified_this, strategy, new_pending_ranges);
-        // Copy of metadata reflecting the situation after all leave operations are finished.
-        auto all_left_metadata = make_token_metadata_ptr(std::make_unique<token_metadata_impl>(clone_after_all_left().get0()));
-        calculate_pending_ranges_for_leaving(unpimplified_this, strategy, new_pending_ranges, all_left_metadata);
-        // At this stage newPendingRanges has been updated according to leave operations. We can
-        // now continue the calculation by checking bootstrapping nodes.
-        calculate_pending_ranges_for_bootstrap(strategy, new_pending_ranges, all_left_metadata);
-        all_left_metadata->clear_gently().get();
+        if (!_leaving_endpoints.empty() || !_bootstrap_tokens.empty()) {
+            // Copy of metadata reflecting the situation after all leave operations are finished.
+            // Only the leaving and bootstrap calculations need it, so don't pay for the
+            // clone when nodes are merely being replaced.
+            auto all_left_metadata = make_token_metadata_ptr(std::make_unique<token_metadata_impl>(clone_after_all_left().get0()));
+            calculate_pending_ranges_for_leaving(unpimplified_this, strategy, new_pending_ranges, all_left_metadata);
+            // At this stage newPendingRanges has been updated according to leave operations. We can
+            // now continue the calculation by checking bootstrapping nodes.
+            calculate_pending_ranges_for_bootstrap(strategy, new_pending_ranges, all_left_metadata);
+            all_left_metadata->clear_gently().get();
+        }
 
         // At this stage newPendingRanges has been updated according to leaving and bootstrapping nodes.
         set_pending_ranges(keyspace_name, std::move(new_pending_ranges), can_yield::yes);
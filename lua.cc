@@ -61,6 +61,7 @@ struct lua_closer {
 };
 
 static const char scylla_decimal_metatable_name[] = "Scylla.decimal";
+static const char scylla_udf_chunk_name[] = "Scylla.udf_chunk";
 
 class lua_slice_state {
     std::unique_ptr<alloc_state> a_state;
@@ -441,6 +442,11 @@ static int load_script_l(lua_State* l) {
         lua_error(l);
     }
 
+    // Keep a reference to the loaded chunk in the registry, so that a reused
+    // state can call it again without going through luaL_loadbufferx.
+    lua_pushvalue(l, -1);
+    lua_setfield(l, LUA_REGISTRYINDEX, scylla_udf_chunk_name);
+
     return 1;
 }
 
@@ -459,6 +465,15 @@ static lua_slice_state load_script(const lua::runtime_config& cfg, lua::bitcode_
     return l;
 }
 
+struct lua::reusable_state::impl {
+    lua_slice_state state;
+};
+
+lua::reusable_state::reusable_state() noexcept = default;
+lua::reusable_state::reusable_state(reusable_state&&) noexcept = default;
+lua::reusable_state& lua::reusable_state::operator=(reusable_state&&) noexcept = default;
+lua::reusable_state::~reusable_state() = default;
+
 using millisecond = std::chrono::duration<double, std::milli>;
 static auto now() { return std::chrono::system_clock::now(); }
 
@@ -1082,8 +1097,19 @@ lua::runtime_config lua::make_runtime_config(const db::config& config) {
 }
 
 // run the script for at most max_instructions
-future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg) {
-    lua_slice_state l = load_script(cfg, bitcode);
+future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg, lua::reusable_state& state) {
+    // Take ownership of the cached interpreter, if there is one. A concurrent
+    // invocation that finds the cache empty just builds a fresh interpreter.
+    auto st = std::exchange(state._impl, nullptr);
+    if (st) {
+        // Discard whatever the previous invocation left on the stack and call
+        // the chunk that load_script_l() stashed in the registry.
+        lua_settop(st->state, 0);
+        lua_getfield(st->state, LUA_REGISTRYINDEX, scylla_udf_chunk_name);
+    } else {
+        st = std::make_unique<reusable_state::impl>(reusable_state::impl{load_script(cfg, bitcode)});
+    }
+    lua_slice_state& l = st->state;
     unsigned nargs = values.size();
     if (!lua_checkstack(l, nargs)) {
         throw std::runtime_error("could push args to the stack");
@@ -1097,7 +1123,8 @@ future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<d
     using duration = std::chrono::system_clock::duration;
     duration elapsed{0};
     duration timeout = std::chrono::duration_cast<duration>(millisecond(cfg.timeout_in_ms));
-    return repeat_until_value([l = std::move(l), elapsed, return_type, nargs, timeout = std::move(timeout)] () mutable {
+    return repeat_until_value([st = std::move(st), &state, elapsed, return_type, nargs, timeout = std::move(timeout)] () mutable {
+        lua_slice_state& l = st->state;
         // Set the hook before resuming. We have to do it here since the hook can reset itself
         // if it detects we are spending too much time in C.
         // The hook will be called after 1000 instructions.
@@ -1105,8 +1132,14 @@ future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<d
         auto start = ::now();
         LUA_504_PLUS(int nresults;)
         switch (lua_resume(l, nullptr, nargs LUA_504_PLUS(, &nresults))) {
-        case LUA_OK:
-            return make_ready_future<std::optional<bytes_opt>>(convert_return(l, return_type));
+        case LUA_OK: {
+            // convert_return() can throw, in which case the interpreter is
+            // discarded along with st. Otherwise it completed cleanly and can
+            // serve the next invocation of this function.
+            auto ret = convert_return(l, return_type);
+            state._impl = std::move(st);
+            return make_ready_future<std::optional<bytes_opt>>(std::move(ret));
+        }
         case LUA_YIELD: {
             nargs = 0;
             elapsed += ::now() - start;
@@ -43,7 +43,28 @@ struct runtime_config {
 
 runtime_config make_runtime_config(const db::config& config);
 
+// Holds an initialized interpreter in which the function's bytecode has
+// already been loaded. Opaque outside lua.cc. run_script() consumes it when
+// valid and stores the interpreter back on successful completion, so
+// consecutive invocations of the same function skip interpreter construction,
+// library setup and bytecode loading. States which failed or timed out are
+// discarded rather than stored back.
+//
+// Note that, as in other UDF runtimes, global state a function leaves behind
+// persists into its later invocations; functions are expected to be pure.
+class reusable_state {
+    struct impl;
+    std::unique_ptr<impl> _impl;
+    friend seastar::future<bytes_opt> run_script(bitcode_view, const std::vector<data_value>&,
+                                                 data_type, const runtime_config&, reusable_state&);
+public:
+    reusable_state() noexcept;
+    reusable_state(reusable_state&&) noexcept;
+    reusable_state& operator=(reusable_state&&) noexcept;
+    ~reusable_state();
+};
+
 sstring compile(const runtime_config& cfg, const std::vector<sstring>& arg_names, sstring script);
 seastar::future<bytes_opt> run_script(bitcode_view bitcode, const std::vector<data_value>& values,
-                                      data_type return_type, const runtime_config& cfg);
+                                      data_type return_type, const runtime_config& cfg, reusable_state& state);
 }
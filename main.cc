@@ -79,6 +79,8 @@
 #include "transport/controller.hh"
 #include "thrift/controller.hh"
 #include "service/memory_limiter.hh"
+#include "utils/cpu_counter_metrics.hh"
+#include "utils/stall_flight_recorder.hh"
 
 #include "alternator/server.hh"
 #include "redis/service.hh"
@@ -88,6 +90,7 @@
 #include "alternator/tags_extension.hh"
 #include "alternator/rmw_operation.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/blocked_bloom_filter_extension.hh"
 #include "service/qos/standard_service_level_distributed_data_accessor.hh"
 
 #include "service/raft/raft_services.hh"
@@ -182,6 +185,7 @@ class sighup_handler {
     condition_variable _cond;
     bool _pending = false; // if asked to reread while already reading
     bool _stopping = false;
+    std::function<future<>()> _on_config_change;
     future<> _done = do_work();  // Launch main work loop, capture completion future
 public:
     // Installs the signal handler. Must call stop() (and wait for it) before destruction.
@@ -189,6 +193,12 @@ public:
         startlog.info("installing SIGHUP handler");
         engine().handle_signal(SIGHUP, [this] { reread_config(); });
     }
+    // Registers a hook run once after each successful configuration re-read,
+    // so that live-updatable settings can be re-applied in a single batched
+    // reconfiguration pass rather than through per-option callbacks.
+    void set_on_config_change(std::function<future<>()> hook) {
+        _on_config_change = std::move(hook);
+    }
 private:
     void reread_config() {
         if (_stopping) {
@@ -213,6 +223,9 @@ private:
                             startlog.info("re-reading configuration file");
                             read_config(_opts, _cfg).get();
                             _cfg.broadcast_to_all_shards().get();
+                            if (_on_config_change) {
+                                _on_config_change().get();
+                            }
                             startlog.info("completed re-reading configuration file");
                         } catch (...) {
                             startlog.error("failed to re-read configuration file: {}", std::current_exception());
@@ -313,6 +326,33 @@ verify_seastar_io_scheduler(bool has_max_io_requests, bool has_properties, bool
     });
 }
 
+// Pulls the system tables which every new connection touches -- local
+// node info, peers, schema version and the auth tables -- through the
+// regular read path on every shard, so that the first clients after a
+// restart are served from a warm cache instead of paying for cold
+// sstable reads during connection setup.
+static future<> prefetch_system_tables(sharded<cql3::query_processor>& qp) {
+    return qp.invoke_on_all([] (cql3::query_processor& qp) {
+        std::vector<sstring> queries = {
+            "SELECT * FROM system.local",
+            "SELECT * FROM system.peers",
+            "SELECT * FROM system.scylla_local",
+        };
+        if (qp.db().has_keyspace("system_auth")) {
+            for (auto& s : qp.db().find_keyspace("system_auth").metadata()->tables()) {
+                queries.push_back(format("SELECT * FROM system_auth.\"{}\"", s->cf_name()));
+            }
+        }
+        return do_with(std::move(queries), [&qp] (std::vector<sstring>& queries) {
+            return do_for_each(queries, [&qp] (const sstring& query) {
+                return qp.execute_internal(query).discard_result().handle_exception([query] (std::exception_ptr ep) {
+                    startlog.warn("Prefetching \"{}\" failed: {}", query, ep);
+                });
+            });
+        });
+    });
+}
+
 static
 void
 verify_adequate_memory_per_shard(bool developer_mode) {
@@ -437,6 +477,7 @@ int main(int ac, char** av) {
     ext->add_schema_extension<alternator::tags_extension>(alternator::tags_extension::NAME);
     ext->add_schema_extension<cdc::cdc_extension>(cdc::cdc_extension::NAME);
     ext->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
+    ext->add_schema_extension<db::blocked_bloom_filter_extension>(db::blocked_bloom_filter_extension::NAME);
 
     auto cfg = make_lw_shared<db::config>(ext);
     auto init = app.get_options_description().add_options();
@@ -496,6 +537,8 @@ int main(int ac, char** av) {
     sharded<raft_services> raft_srvs;
     sharded<service::memory_limiter> service_memory_limiter;
     sharded<repair_service> repair;
+    sharded<utils::cpu_counter_metrics> cpu_counter_metrics;
+    sharded<utils::stall_flight_recorder> stall_recorder;
 
     return app.run(ac, av, [&] () -> future<int> {
 
@@ -525,7 +568,7 @@ int main(int ac, char** av) {
         return seastar::async([cfg, ext, &db, &qp, &proxy, &mm, &mm_notifier, &ctx, &opts, &dirs,
                 &prometheus_server, &cf_cache_hitrate_calculator, &load_meter, &feature_service,
                 &token_metadata, &snapshot_ctl, &messaging, &sst_dir_semaphore, &raft_srvs, &service_memory_limiter,
-                &repair] {
+                &repair, &cpu_counter_metrics, &stall_recorder] {
           try {
             // disable reactor stall detection during startup
             auto blocked_reactor_notify_ms = engine().get_blocked_reactor_notify_ms();
@@ -775,6 +818,15 @@ int main(int ac, char** av) {
             dbcfg.memtable_scheduling_group = make_sched_group("memtable", 1000);
             dbcfg.memtable_to_cache_scheduling_group = make_sched_group("memtable_to_cache", 200);
             dbcfg.gossip_scheduling_group = make_sched_group("gossip", 1000);
+            for (auto& [ks, shares_str] : cfg->keyspace_scheduling_shares()) {
+                unsigned shares;
+                try {
+                    shares = std::stoul(shares_str);
+                } catch (...) {
+                    throw std::runtime_error(format("Invalid keyspace_scheduling_shares value for keyspace {}: {}", ks, shares_str));
+                }
+                dbcfg.keyspace_scheduling_groups.emplace(ks, make_sched_group("statement:" + ks, shares));
+            }
             dbcfg.available_memory = memory::stats().total_memory();
 
             const auto& ssl_opts = cfg->server_encryption_options();
@@ -874,6 +926,11 @@ int main(int ac, char** av) {
                 // service_memory_limiter.stop().get();
             });
 
+            cpu_counter_metrics.start().get();
+            auto stop_cpu_counter_metrics = defer_verbose_shutdown("CPU counter metrics", [&cpu_counter_metrics] {
+                cpu_counter_metrics.stop().get();
+            });
+
             db.start(std::ref(*cfg), dbcfg, std::ref(mm_notifier), std::ref(feature_service), std::ref(token_metadata), std::ref(stop_signal.as_sharded_abort_source()), std::ref(sst_dir_semaphore)).get();
             start_large_data_handler(db).get();
             auto stop_database_and_sstables = defer_verbose_shutdown("database", [&db] {
@@ -1065,6 +1122,14 @@ int main(int ac, char** av) {
                     cf.trigger_compaction();
                 }
             }).get();
+
+            // Warm the row cache up from the hot-set snapshot taken by the
+            // previous run. The reads run in the background at streaming I/O
+            // priority, so this doesn't hold up startup.
+            db.invoke_on_all([] (database& db) {
+                db.warm_up_row_cache();
+            }).get();
+
             api::set_server_gossip(ctx).get();
             api::set_server_snitch(ctx).get();
             api::set_server_storage_proxy(ctx).get();
@@ -1258,6 +1323,16 @@ int main(int ac, char** av) {
                 api::unset_server_snapshot(ctx).get();
             });
 
+            stall_recorder.start().get();
+            auto stop_stall_recorder = defer_verbose_shutdown("stall flight recorder", [&stall_recorder] {
+                stall_recorder.stop().get();
+            });
+
+            api::set_server_stall_recorder(ctx, stall_recorder).get();
+            auto stop_api_stall_recorder = defer_verbose_shutdown("stall flight recorder API", [&ctx] {
+                api::unset_server_stall_recorder(ctx).get();
+            });
+
             supervisor::notify("starting batchlog manager");
             db::get_batchlog_manager().invoke_on_all([] (db::batchlog_manager& b) {
                 return b.start();
@@ -1318,6 +1393,9 @@ int main(int ac, char** av) {
                 db.revert_initial_system_read_concurrency_boost();
             }).get();
 
+            supervisor::notify("prefetching system tables");
+            prefetch_system_tables(qp).get();
+
             cql_transport::controller cql_server_ctl(db, auth_service, mm_notifier, gossiper.local(), qp, service_memory_limiter, sl_controller);
 
             ss.register_client_shutdown_hook("native transport", [&cql_server_ctl] {
@@ -1342,6 +1420,25 @@ int main(int ac, char** av) {
                 api::unset_transport_controller(ctx).get();
             });
 
+            // Re-apply live-updatable performance settings in one pass per
+            // configuration reload, after the new values were broadcast.
+            sighup_handler.set_on_config_change([&db, &cql_server_ctl] {
+                return db.invoke_on_all([] (database& db) {
+                    auto& cfg = db.get_config();
+                    if (cfg.memtable_flush_static_shares() > 0) {
+                        db.update_memtable_flush_static_shares(cfg.memtable_flush_static_shares());
+                    }
+                    if (cfg.compaction_static_shares() > 0) {
+                        db.get_compaction_manager().update_static_shares(cfg.compaction_static_shares());
+                    }
+                }).then([&db, &cql_server_ctl] {
+                    return cql_server_ctl.update_timeout_config(make_timeout_config(db.local().get_config()));
+                });
+            });
+            auto unset_on_config_change = defer([&sighup_handler] {
+                sighup_handler.set_on_config_change({});
+            });
+
             ::thrift_controller thrift_ctl(db, auth_service, qp, service_memory_limiter);
 
             ss.register_client_shutdown_hook("rpc server", [&thrift_ctl] {
@@ -119,14 +119,16 @@ void memtable::memtable_encoding_stats_collector::update(const ::schema& s, cons
 }
 
 memtable::memtable(schema_ptr schema, dirty_memory_manager& dmm, table_stats& table_stats,
-    memtable_list* memtable_list, seastar::scheduling_group compaction_scheduling_group)
-        : logalloc::region(dmm.region_group())
+    memtable_list* memtable_list, seastar::scheduling_group compaction_scheduling_group,
+    logalloc::region_group* dirty_memory_group)
+        : logalloc::region(dirty_memory_group ? *dirty_memory_group : dmm.region_group())
         , _dirty_mgr(dmm)
         , _cleaner(*this, no_cache_tracker, table_stats.memtable_app_stats, compaction_scheduling_group)
         , _memtable_list(memtable_list)
         , _schema(std::move(schema))
         , partitions(dht::raw_token_less_comparator{})
         , _table_stats(table_stats) {
+    region().set_label(format("memtable:{}.{}", _schema->ks_name(), _schema->cf_name()));
 }
 
 static thread_local dirty_memory_manager mgr_for_tests;
@@ -151,6 +153,7 @@ void memtable::evict_entry(memtable_entry& e, mutation_cleaner& cleaner) noexcep
 }
 
 void memtable::clear() noexcept {
+    _last_write = std::nullopt;
     auto dirty_before = dirty_size();
     with_allocator(allocator(), [this] {
         partitions.clear_and_dispose([this] (memtable_entry* e) noexcept {
@@ -166,6 +169,7 @@ future<> memtable::clear_gently() noexcept {
             auto& alloc = allocator();
 
             auto p = std::move(partitions);
+            _last_write = std::nullopt;
             nr_partitions = 0;
             while (!p.empty()) {
                 auto dirty_before = dirty_size();
@@ -202,6 +206,18 @@ partition_entry&
 memtable::find_or_create_partition_slow(partition_key_view key) {
     assert(!reclaiming_enabled());
 
+    // Batched ingest tends to hit the same partition repeatedly. Matching the
+    // insertion point cached by find_or_create_partition() against the raw key
+    // skips the token computation as well as the tree descent.
+    if (_last_write && reclaim_counter() == _last_write_reclaim_counter && nr_partitions == _last_write_partition_count) {
+        memtable_entry& e = **_last_write;
+        if (e.key().key().equal(*_schema, key)) {
+            ++_table_stats.memtable_partition_hits;
+            upgrade_entry(e);
+            return e.partition();
+        }
+    }
+
     // FIXME: Perform lookup using std::pair<token, partition_key_view>
     // to avoid unconditional copy of the partition key.
     // We can't do it right now because std::map<> which holds
@@ -220,11 +236,24 @@ partition_entry&
 memtable::find_or_create_partition(const dht::decorated_key& key) {
     assert(!reclaiming_enabled());
 
+    if (_last_write) {
+        if (reclaim_counter() == _last_write_reclaim_counter && nr_partitions == _last_write_partition_count) {
+            memtable_entry& e = **_last_write;
+            if (e.key().equal(*_schema, key)) {
+                ++_table_stats.memtable_partition_hits;
+                upgrade_entry(e);
+                return e.partition();
+            }
+        } else {
+            _last_write = std::nullopt;
+        }
+    }
+
     // call lower_bound so we have a hint for the insert, just in case.
     partitions_type::bound_hint hint;
     auto i = partitions.lower_bound(key, dht::ring_position_comparator(*_schema), hint);
     if (i == partitions.end() || !hint.match) {
-        partitions_type::iterator entry = partitions.emplace_before(i,
+        i = partitions.emplace_before(i,
                 key.token().raw(), hint,
                 _schema, dht::decorated_key(key), mutation_partition(_schema));
         ++nr_partitions;
@@ -232,11 +261,13 @@ memtable::find_or_create_partition(const dht::decorated_key& key) {
         if (!hint.emplace_keeps_iterators()) {
             current_allocator().invalidate_references();
         }
-        return entry->partition();
     } else {
         ++_table_stats.memtable_partition_hits;
         upgrade_entry(*i);
     }
+    _last_write = i;
+    _last_write_reclaim_counter = reclaim_counter();
+    _last_write_partition_count = nr_partitions;
     return i->partition();
 }
 
@@ -579,9 +610,9 @@ class flush_reader final : public flat_mutation_reader::impl, private iterator_r
     flat_mutation_reader_opt _partition_reader;
     flush_memory_accounter _flushed_memory;
 public:
-    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m)
+    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m, const dht::partition_range& range)
         : impl(s, std::move(permit))
-        , iterator_reader(std::move(s), m, query::full_partition_range)
+        , iterator_reader(std::move(s), m, range)
         , _flushed_memory(*m)
     {}
     flush_reader(const flush_reader&) = delete;
@@ -701,14 +732,14 @@ memtable::make_flat_reader(schema_ptr s,
 }
 
 flat_mutation_reader
-memtable::make_flush_reader(schema_ptr s, const io_priority_class& pc) {
+memtable::make_flush_reader(schema_ptr s, const io_priority_class& pc, const dht::partition_range& range) {
     auto permit = _flush_semaphore.make_permit(s.get(), "memtable-flush");
     if (group()) {
-        return make_flat_mutation_reader<flush_reader>(std::move(s), std::move(permit), shared_from_this());
+        return make_flat_mutation_reader<flush_reader>(std::move(s), std::move(permit), shared_from_this(), range);
     } else {
         auto& full_slice = s->full_slice();
         return make_flat_mutation_reader<scanning_reader>(std::move(s), shared_from_this(), std::move(permit),
-            query::full_partition_range, full_slice, pc, mutation_reader::forwarding::no);
+            range, full_slice, pc, mutation_reader::forwarding::no);
     }
 }
 
@@ -136,6 +136,16 @@ private:
     uint64_t _flushed_memory = 0;
     table_stats& _table_stats;
 
+    // Insertion point of the most recent write. Small-row workloads tend to
+    // issue many consecutive writes to the same partition, and revalidating
+    // this iterator is much cheaper than a full tree descent. Must be
+    // revalidated against the reclaim counter and partition count before use,
+    // like the iterators in iterator_reader, since both compaction and
+    // insertion can invalidate it.
+    std::optional<partitions_type::iterator> _last_write;
+    uint64_t _last_write_reclaim_counter = 0;
+    size_t _last_write_partition_count = 0;
+
     class memtable_encoding_stats_collector : public encoding_stats_collector {
     private:
         min_max_tracker<api::timestamp_type> min_max_timestamp;
@@ -178,8 +188,12 @@ private:
     void clear() noexcept;
     uint64_t dirty_size() const;
 public:
+    // When dirty_memory_group is given, the memtable's region is accounted in
+    // it instead of directly in the dirty memory manager's group; it must be a
+    // descendant of the latter.
     explicit memtable(schema_ptr schema, dirty_memory_manager&, table_stats& table_stats, memtable_list *memtable_list = nullptr,
-            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group());
+            seastar::scheduling_group compaction_scheduling_group = seastar::current_scheduling_group(),
+            logalloc::region_group* dirty_memory_group = nullptr);
     // Used for testing that want to control the flush process.
     explicit memtable(schema_ptr schema);
     ~memtable();
@@ -259,7 +273,11 @@ public:
         return make_flat_reader(s, std::move(permit), range, full_slice);
     }
 
-    flat_mutation_reader make_flush_reader(schema_ptr, const io_priority_class& pc);
+    // Creates a reader which drains this memtable's contents for flushing.
+    // The 'range' parameter must be live as long as the reader is being used.
+    // Flush readers over disjoint ranges may be used concurrently.
+    flat_mutation_reader make_flush_reader(schema_ptr, const io_priority_class& pc,
+                                           const dht::partition_range& range = query::full_partition_range);
 
     mutation_source as_data_source();
 
@@ -430,7 +430,7 @@ messaging_service::messaging_service(config cfg, scheduling_config scfg, std::sh
     : _cfg(std::move(cfg))
     , _rpc(new rpc_protocol_wrapper(serializer { }))
     , _credentials_builder(credentials ? std::make_unique<seastar::tls::credentials_builder>(*credentials) : nullptr)
-    , _clients(2 + scfg.statement_tenants.size() * 2)
+    , _clients(3 + scfg.statement_tenants.size() * 2)
     , _scheduling_config(scfg)
     , _scheduling_info_for_connection_index(initial_scheduling_info())
 {
@@ -538,7 +538,6 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::GOSSIP_DIGEST_ACK:
     case messaging_verb::GOSSIP_DIGEST_ACK2:
     case messaging_verb::GOSSIP_SHUTDOWN:
-    case messaging_verb::GOSSIP_ECHO:
     case messaging_verb::GOSSIP_GET_ENDPOINT_STATES:
     case messaging_verb::GET_SCHEMA_VERSION:
         return 0;
@@ -568,6 +567,12 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::HINT_SYNC_POINT_CREATE:
     case messaging_verb::HINT_SYNC_POINT_CHECK:
         return 1;
+    // The failure detector verb gets a connection of its own, so that
+    // liveness probes are not queued behind large gossip state exchanges
+    // and do not report a node down just because its gossip connection
+    // is busy.
+    case messaging_verb::GOSSIP_ECHO:
+        return 2;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
     case messaging_verb::READ_DATA:
@@ -590,10 +595,10 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::RAFT_VOTE_REQUEST:
     case messaging_verb::RAFT_VOTE_REPLY:
     case messaging_verb::RAFT_TIMEOUT_NOW:
-        return 2;
+        return 3;
     case messaging_verb::MUTATION_DONE:
     case messaging_verb::MUTATION_FAILED:
-        return 3;
+        return 4;
     case messaging_verb::LAST:
         return -1; // should never happen
     }
@@ -613,7 +618,7 @@ unsigned
 messaging_service::get_rpc_client_idx(messaging_verb verb) const {
     auto idx = s_rpc_client_idx_table[static_cast<size_t>(verb)];
 
-    if (idx < 2) {
+    if (idx < 3) {
         return idx;
     }
 
@@ -621,7 +626,7 @@ messaging_service::get_rpc_client_idx(messaging_verb verb) const {
     const auto curr_sched_group = current_scheduling_group();
     for (unsigned i = 0; i < _connection_index_for_tenant.size(); ++i) {
         if (_connection_index_for_tenant[i].sched_group == curr_sched_group) {
-            // i == 0: the default tenant maps to the default client indexes of 2 and 3.
+            // i == 0: the default tenant maps to the default client indexes of 3 and 4.
             idx += i * 2;
             break;
         }
@@ -637,6 +642,7 @@ messaging_service::initial_scheduling_info() const {
     auto sched_infos = std::vector<scheduling_info_for_connection_index>({
         { _scheduling_config.gossip, "gossip" },
         { _scheduling_config.streaming, "streaming", },
+        { _scheduling_config.gossip, "gossip-echo", },
     });
     sched_infos.reserve(sched_infos.size() + _scheduling_config.statement_tenants.size() * 2);
     for (const auto& tenant : _scheduling_config.statement_tenants) {
@@ -771,6 +777,9 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
         if (idx == 1) {
             return true; // gossip
         }
+        if (idx == 2) {
+            return true; // failure detector echo; keep probe latency low
+        }
         if (_cfg.tcp_nodelay == tcp_nodelay_what::local) {
             auto& snitch_ptr = locator::i_endpoint_snitch::get_local_snitch_ptr();
             return snitch_ptr->get_datacenter(id.addr)
@@ -790,7 +799,7 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     opts.tcp_nodelay = must_tcp_nodelay;
     opts.reuseaddr = true;
     // We send cookies only for non-default statement tenant clients.
-    if (idx > 3) {
+    if (idx > 4) {
         opts.isolation_cookie = _scheduling_info_for_connection_index[idx].isolation_cookie;
     }
 
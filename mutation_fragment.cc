@@ -27,6 +27,53 @@
 #include "mutation_fragment.hh"
 #include "clustering_interval_set.hh"
 
+namespace {
+
+// Freelist of mutation_fragment::data blocks. The list is threaded through
+// the freed blocks themselves, so pooling allocates nothing and freeing is
+// noexcept. The cap only needs to absorb the fragments alive at any one time
+// across the shard's reader pipelines.
+struct fragment_data_pool {
+    struct free_block {
+        free_block* next;
+    };
+    static constexpr size_t max_size = 128;
+    free_block* head = nullptr;
+    size_t size = 0;
+    ~fragment_data_pool() {
+        while (head) {
+            auto* next = head->next;
+            ::operator delete(static_cast<void*>(head));
+            head = next;
+        }
+    }
+};
+
+thread_local fragment_data_pool fragment_pool;
+
+}
+
+void* mutation_fragment::data::operator new(size_t size) {
+    if (fragment_pool.head) {
+        auto* blk = fragment_pool.head;
+        fragment_pool.head = blk->next;
+        --fragment_pool.size;
+        return static_cast<void*>(blk);
+    }
+    return ::operator new(size);
+}
+
+void mutation_fragment::data::operator delete(void* ptr) {
+    if (fragment_pool.size < fragment_data_pool::max_size) {
+        auto* blk = static_cast<fragment_data_pool::free_block*>(ptr);
+        blk->next = fragment_pool.head;
+        fragment_pool.head = blk;
+        ++fragment_pool.size;
+        return;
+    }
+    ::operator delete(ptr);
+}
+
 std::ostream&
 operator<<(std::ostream& os, const clustering_row::printer& p) {
     auto& row = p._clustering_row;
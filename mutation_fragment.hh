@@ -295,6 +295,13 @@ private:
         data(reader_permit permit) :  _memory(permit.consume_memory()) { }
         ~data() { }
 
+        // All fragment kinds share this fixed-size block (the union below),
+        // and reader loops allocate and free one per fragment consumed, so
+        // blocks are recycled through a small per-shard freelist instead of
+        // going back to the allocator on every fragment.
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
+
         reader_permit::resource_units _memory;
         union {
             static_row _static_row;
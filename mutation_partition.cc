@@ -264,6 +264,11 @@ void mutation_partition::apply(const schema& s, mutation_partition&& p,
     apply_weak(s, std::move(p), app_stats);
 }
 
+void mutation_partition::apply(const schema& s, mutation_partition&& p, const schema& p_schema,
+        mutation_application_stats& app_stats) {
+    apply_weak(s, std::move(p), p_schema, app_stats);
+}
+
 void mutation_partition::apply(const schema& s, mutation_partition_view p, const schema& p_schema,
         mutation_application_stats& app_stats) {
     apply_weak(s, p, p_schema, app_stats);
@@ -434,6 +439,11 @@ void mutation_partition::apply_weak(const schema& s, mutation_partition&& p, mut
     apply_monotonically(s, std::move(p), no_cache_tracker, app_stats);
 }
 
+void mutation_partition::apply_weak(const schema& s, mutation_partition&& p, const schema& p_schema,
+        mutation_application_stats& app_stats) {
+    apply_monotonically(s, std::move(p), p_schema, app_stats);
+}
+
 tombstone
 mutation_partition::range_tombstone_for_row(const schema& schema, const clustering_key& key) const {
     check_schema(schema);
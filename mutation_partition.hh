@@ -1195,6 +1195,13 @@ public:
     // Use in case this instance and p share the same schema.
     // Same guarantees as apply(const schema&, mutation_partition&&, const schema&);
     void apply(const schema& s, mutation_partition&& p, mutation_application_stats& app_stats);
+    // Use when p is about to be destroyed. When schemas match, rows and cell
+    // payloads are moved out of p instead of copied; otherwise p is upgraded
+    // into a temporary first. Both partitions must be managed by the current
+    // allocation strategy.
+    // Same guarantees as apply(const schema&, const mutation_partition&, const schema&).
+    void apply(const schema& this_schema, mutation_partition&& p, const schema& p_schema,
+            mutation_application_stats& app_stats);
     // Same guarantees and constraints as for apply(const schema&, const mutation_partition&, const schema&).
     void apply(const schema& this_schema, mutation_partition_view p, const schema& p_schema,
             mutation_application_stats& app_stats);
@@ -1227,6 +1234,8 @@ public:
             mutation_application_stats& app_stats);
     void apply_weak(const schema& s, mutation_partition&&,
             mutation_application_stats& app_stats);
+    void apply_weak(const schema& s, mutation_partition&& p, const schema& p_schema,
+            mutation_application_stats& app_stats);
     void apply_weak(const schema& s, mutation_partition_view p, const schema& p_schema,
             mutation_application_stats& app_stats);
 
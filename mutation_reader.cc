@@ -30,6 +30,7 @@
 
 #include "mutation_reader.hh"
 #include "flat_mutation_reader.hh"
+#include "clustering_ranges_walker.hh"
 #include "schema_registry.hh"
 #include "mutation_compactor.hh"
 #include "dht/sharder.hh"
@@ -152,6 +153,65 @@ public:
     }
 };
 
+// Fixed-width comparison prefix of a position in partition, cached alongside
+// each merge heap entry.
+//
+// Orders consistently with position_in_partition::tri_compare whenever the
+// result of less_than() is engaged; a disengaged result says nothing and the
+// caller must fall back to the full comparison. The prefix holds the position's
+// region and, for clustered positions, the leading bytes of the first
+// clustering key component folded into one big-endian integer, so the common
+// heap sift operations are decided by integer compares instead of walking the
+// compound-encoded keys. The key bytes can only be used when the first
+// component's type compares bytewise (see is_byte_order_comparable());
+// otherwise only the region takes part and comparisons between clustered
+// positions always fall back.
+class position_comparison_prefix {
+    partition_region _region;
+    bool _comparable = false;
+    uint64_t _prefix = 0;
+public:
+    position_comparison_prefix() : _region(partition_region::partition_start) { }
+    position_comparison_prefix(bool enabled, position_in_partition_view pos)
+            : _region(pos.region()) {
+        if (!enabled || !pos.has_clustering_key()) {
+            return;
+        }
+        auto components = pos.key().components();
+        auto it = components.begin();
+        if (it == components.end()) {
+            return;
+        }
+        managed_bytes_view first = *it;
+        size_t remaining = sizeof(_prefix);
+        while (remaining && first.size_bytes()) {
+            auto frag = first.current_fragment();
+            auto n = std::min(remaining, frag.size());
+            for (size_t i = 0; i < n; i++) {
+                _prefix = (_prefix << 8) | uint8_t(frag[i]);
+            }
+            remaining -= n;
+            first.remove_prefix(n);
+        }
+        // Zero-padding keeps the prefix order of a strict byte-prefix of a
+        // longer key: either the longer key has a non-zero byte where the
+        // padding is, deciding the comparison the same way the full one would,
+        // or the prefixes are equal and we fall back.
+        _prefix <<= 8 * remaining;
+        _comparable = true;
+    }
+    // Engaged when the prefixes alone decide whether *this < other.
+    std::optional<bool> less_than(const position_comparison_prefix& other) const {
+        if (_region != other._region) {
+            return _region < other._region;
+        }
+        if (_comparable && other._comparable && _prefix != other._prefix) {
+            return _prefix < other._prefix;
+        }
+        return std::nullopt;
+    }
+};
+
 // Merges the output of the sub-readers into a single non-decreasing
 // stream of mutation-fragments.
 class mutation_reader_merger {
@@ -161,10 +221,12 @@ public:
     struct reader_and_fragment {
         reader_iterator reader{};
         mutation_fragment fragment;
+        position_comparison_prefix heap_key;
 
-        reader_and_fragment(reader_iterator r, mutation_fragment f)
+        reader_and_fragment(reader_iterator r, mutation_fragment f, bool cache_heap_key = false)
             : reader(r)
-            , fragment(std::move(f)) {
+            , fragment(std::move(f))
+            , heap_key(cache_heap_key, fragment.position()) {
         }
     };
 
@@ -227,6 +289,10 @@ private:
     // that the gallop mode was stopped (galloping reader lost to some other reader).
     int _gallop_mode_hits = 0;
     const schema_ptr _schema;
+    // Whether position_comparison_prefix can use the clustering key bytes for
+    // this schema; computed once instead of re-inspecting the type for every
+    // fragment.
+    const bool _heap_key_enabled;
     streamed_mutation::forwarding _fwd_sm;
     mutation_reader::forwarding _fwd_mr;
 private:
@@ -344,6 +410,9 @@ struct mutation_reader_merger::fragment_heap_compare {
 
     bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
         // Invert comparison as this is a max-heap.
+        if (auto decided = b.heap_key.less_than(a.heap_key)) {
+            return *decided;
+        }
         return cmp(b.fragment.position(), a.fragment.position());
     }
 };
@@ -393,7 +462,16 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                 if (reader_galloping) {
                     // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
                     // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    auto galloping_wins = [&] {
+                        if (_fragment_heap.empty()) {
+                            return true;
+                        }
+                        if (auto decided = position_comparison_prefix(_heap_key_enabled, mfo->position()).less_than(_fragment_heap.front().heap_key)) {
+                            return *decided;
+                        }
+                        return position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position());
+                    };
+                    if (galloping_wins()) {
                         _current.clear();
                         _current.push_back(std::move(*mfo));
                         _galloping_reader.last_kind = _current.back().mutation_fragment_kind();
@@ -403,7 +481,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                     _gallop_mode_hits = 0;
                 }
 
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
+                _fragment_heap.emplace_back(rk.reader, std::move(*mfo), _heap_key_enabled);
                 boost::range::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
             }
         } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment::kind::partition_end) {
@@ -466,6 +544,10 @@ mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
         mutation_reader::forwarding fwd_mr)
     : _selector(std::move(selector))
     , _schema(std::move(schema))
+    , _heap_key_enabled([this] {
+        const auto& types = _schema->clustering_key_type()->types();
+        return !types.empty() && types.front()->is_byte_order_comparable();
+    }())
     , _fwd_sm(fwd_sm)
     , _fwd_mr(fwd_mr) {
     maybe_add_readers(std::nullopt);
@@ -753,7 +835,8 @@ class restricting_mutation_reader : public flat_mutation_reader::impl {
             return fn(state->reader);
         }
 
-        return std::get<pending_state>(_state).reader_factory._permit.wait_admission(new_reader_base_cost,
+        auto& permit = std::get<pending_state>(_state).reader_factory._permit;
+        return permit.wait_admission(permit.semaphore().admission_cost(new_reader_base_cost),
                 timeout).then([this, fn = std::move(fn)] (reader_permit::resource_units units) mutable {
             auto reader_factory = std::move(std::get<pending_state>(_state).reader_factory);
             _state.emplace<admitted_state>(admitted_state{reader_factory(), std::move(units)});
@@ -2151,6 +2234,99 @@ std::pair<flat_mutation_reader, queue_reader_handle> make_queue_reader(schema_pt
     return {flat_mutation_reader(std::move(impl)), std::move(handle)};
 }
 
+flat_mutation_reader make_slicing_filtering_reader(flat_mutation_reader rd, const dht::partition_range& pr, const query::partition_slice& slice) {
+    class reader : public flat_mutation_reader::impl {
+        flat_mutation_reader _rd;
+        const dht::partition_range* _pr;
+        const query::partition_slice* _slice;
+        dht::ring_position_comparator _cmp;
+        std::optional<clustering_ranges_walker> _ranges_walker;
+        // Set when the current partition of the source stream was accepted
+        // by the filter. Partition skipping and partition-range fast
+        // forwarding are implemented by dropping source fragments until the
+        // next matching partition_start, so the source doesn't have to
+        // support next_partition()/fast_forward_to() (the queue reader
+        // doesn't).
+        bool _inside_partition = false;
+    public:
+        reader(flat_mutation_reader rd, const dht::partition_range& pr, const query::partition_slice& slice)
+            : flat_mutation_reader::impl(rd.schema(), rd.permit())
+            , _rd(std::move(rd))
+            , _pr(&pr)
+            , _slice(&slice)
+            , _cmp(*_schema) {
+        }
+        virtual future<> fill_buffer(db::timeout_clock::time_point timeout) override {
+            return do_until([this] { return is_buffer_full() || is_end_of_stream(); }, [this, timeout] {
+                return _rd.fill_buffer(timeout).then([this] {
+                    while (!_rd.is_buffer_empty()) {
+                        auto mf = _rd.pop_mutation_fragment();
+                        switch (mf.mutation_fragment_kind()) {
+                        case mutation_fragment::kind::partition_start: {
+                            auto& dk = mf.as_partition_start().key();
+                            _inside_partition = _pr->contains(dk, _cmp);
+                            if (_inside_partition) {
+                                _ranges_walker.emplace(*_schema, _slice->row_ranges(*_schema, dk.key()), false);
+                                push_mutation_fragment(std::move(mf));
+                            }
+                            break;
+                        }
+                        case mutation_fragment::kind::static_row:
+                            if (_inside_partition) {
+                                push_mutation_fragment(std::move(mf));
+                            }
+                            break;
+                        case mutation_fragment::kind::clustering_row:
+                            if (_inside_partition && _ranges_walker->advance_to(mf.position())) {
+                                push_mutation_fragment(std::move(mf));
+                            }
+                            break;
+                        case mutation_fragment::kind::range_tombstone:
+                            if (_inside_partition && _ranges_walker->advance_to(mf.position(), mf.as_range_tombstone().end_position())) {
+                                push_mutation_fragment(std::move(mf));
+                            }
+                            break;
+                        case mutation_fragment::kind::partition_end:
+                            if (_inside_partition) {
+                                push_mutation_fragment(std::move(mf));
+                                _inside_partition = false;
+                            }
+                            break;
+                        }
+                    }
+                    _end_of_stream = _rd.is_end_of_stream();
+                });
+            });
+        }
+        virtual future<> next_partition() override {
+            clear_buffer_to_next_partition();
+            if (is_buffer_empty()) {
+                _end_of_stream = false;
+                // Drop the remaining source fragments of the current partition.
+                _inside_partition = false;
+            }
+            return make_ready_future<>();
+        }
+        virtual future<> fast_forward_to(const dht::partition_range& pr, db::timeout_clock::time_point timeout) override {
+            clear_buffer();
+            _end_of_stream = false;
+            _inside_partition = false;
+            _pr = &pr;
+            return make_ready_future<>();
+        }
+        virtual future<> fast_forward_to(position_range pr, db::timeout_clock::time_point timeout) override {
+            forward_buffer_to(pr.start());
+            _end_of_stream = false;
+            return _rd.fast_forward_to(std::move(pr), timeout);
+        }
+        virtual future<> close() noexcept override {
+            return _rd.close();
+        }
+    };
+
+    return make_flat_mutation_reader<reader>(std::move(rd), pr, slice);
+}
+
 namespace {
 
 class compacting_reader : public flat_mutation_reader::impl {
@@ -136,6 +136,19 @@ flat_mutation_reader make_filtering_reader(flat_mutation_reader rd, MutationFilt
     return make_flat_mutation_reader<filtering_reader<MutationFilter>>(std::move(rd), std::forward<MutationFilter>(filter));
 }
 
+// Creates a wrapper which filters the stream down to the given partition
+// range and slice, dropping partitions and clustering rows outside of them.
+// Used to implement slicing on top of readers which produce more data than
+// the query asked for, e.g. because the producer ignores the restrictions.
+// Partition skipping and fast forwarding are implemented by dropping source
+// fragments, so the source doesn't need to support next_partition() or
+// fast_forward_to(); it only has to produce a superset of the requested
+// data, in ring and clustering order.
+// The range and slice must be kept alive as long as the reader is used.
+flat_mutation_reader make_slicing_filtering_reader(flat_mutation_reader rd,
+        const dht::partition_range& pr,
+        const query::partition_slice& slice);
+
 /// A partition_presence_checker quickly returns whether a key is known not to exist
 /// in a data source (it may return false positives, but not false negatives).
 enum class partition_presence_checker_result {
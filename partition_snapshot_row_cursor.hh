@@ -210,6 +210,14 @@ class partition_snapshot_row_cursor final {
                 _latest_it = curr.it;
             }
             if (curr.it) {
+                // Entries of a wide partition are scattered across LSA
+                // segments, so stepping to the successor takes a cache miss.
+                // The successor is not consumed until the next advance(),
+                // which leaves enough distance for a prefetch issued now to
+                // overlap with consuming the current row.
+                if (auto next = std::next(curr.it)) {
+                    __builtin_prefetch(&*next);
+                }
                 _heap.push_back(curr);
                 boost::range::push_heap(_heap, heap_less);
             }
@@ -514,6 +514,40 @@ void partition_entry::upgrade(schema_ptr from, schema_ptr to, mutation_cleaner&
     remove_or_mark_as_unique_owner(old_version, &cleaner);
 }
 
+stop_iteration partition_entry::squash_unreferenced_versions(const schema& s, cache_tracker* tracker) {
+    partition_version* current = &*_version;
+    while (current->next()) {
+        current = current->next();
+    }
+    // Walk from the oldest version towards the latest. A version which is not
+    // directly referenced by a snapshot is never the sole constituent of
+    // anyone's view, so its newer neighbour can be merged into it, with the
+    // neighbour's referer (if any) redirected to the merged version: every
+    // snapshot as well as the entry keep seeing the same union of versions.
+    while (auto prev = current->prev()) {
+        if (current->is_referenced()) {
+            // A snapshot's view starts at this version; cannot merge newer
+            // data into it.
+            current = prev;
+            continue;
+        }
+        if (prev->is_referenced_from_entry()) {
+            break;
+        }
+        current_allocator().invalidate_references();
+        mutation_application_stats app_stats;
+        if (current->partition().apply_monotonically(s, std::move(prev->partition()), tracker, app_stats,
+                is_preemptible::yes) == stop_iteration::no) {
+            return stop_iteration::no;
+        }
+        if (prev->is_referenced()) {
+            prev->back_reference() = partition_version_ref(*current, prev->back_reference().is_unique_owner());
+        }
+        current_allocator().destroy(prev);
+    }
+    return stop_iteration::yes;
+}
+
 partition_snapshot_ptr partition_entry::read(logalloc::region& r,
     mutation_cleaner& cleaner, schema_ptr entry_schema, cache_tracker* tracker, partition_snapshot::phase_type phase)
 {
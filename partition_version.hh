@@ -611,6 +611,18 @@ public:
     // Must not be called when is_locked().
     void upgrade(schema_ptr from, schema_ptr to, mutation_cleaner&, cache_tracker*);
 
+    // Squashes versions which are not directly referenced by any snapshot
+    // into their newer neighbours, shortening the chain which every read has
+    // to merge. The views of the entry and of all snapshots are preserved.
+    // The latest version is always left in place so that incoming writes
+    // don't have to create a new one.
+    // Preemptible; returns stop_iteration::no if preempted before the whole
+    // chain was processed, in which case the call can be retried.
+    // Needs to be called with reclaiming disabled, under the region's
+    // allocator, with the cache_tracker passed if the entry is linked in one.
+    // Must not be called when is_locked().
+    stop_iteration squash_unreferenced_versions(const schema& s, cache_tracker* tracker);
+
     // Snapshots with different values of phase will point to different partition_version objects.
     // When is_locked(), read() can only be called with a phase which is <= the phase of the current snapshot.
     partition_snapshot_ptr read(logalloc::region& region,
@@ -383,9 +383,9 @@ public:
             if (!a._ck) {
                 return 0;
             }
-            auto&& types = _s.clustering_key_type()->types();
-            auto cmp = [&] (const data_type& t, managed_bytes_view c1, managed_bytes_view c2) { return t->compare(c1, c2); };
-            return lexicographical_tri_compare(types.begin(), types.end(),
+            auto&& cmp_fns = _s.clustering_key_type()->compare_fns();
+            auto cmp = [] (const auto& c, managed_bytes_view c1, managed_bytes_view c2) -> int { return c(c1, c2); };
+            return lexicographical_tri_compare(cmp_fns.begin(), cmp_fns.end(),
                 a._ck->begin(_s), a._ck->end(_s),
                 b._ck->begin(_s), b._ck->end(_s),
                 cmp, a.relation(), b.relation());
@@ -402,10 +402,10 @@ public:
             if (!a._ck) {
                 return 0;
             }
-            auto&& types = _s.clustering_key_type()->types();
+            auto&& cmp_fns = _s.clustering_key_type()->compare_fns();
             auto b_values = b.values();
-            auto cmp = [&] (const data_type& t, managed_bytes_view c1, managed_bytes_view c2) { return t->compare(c1, c2); };
-            return lexicographical_tri_compare(types.begin(), types.end(),
+            auto cmp = [] (const auto& c, managed_bytes_view c1, managed_bytes_view c2) -> int { return c(c1, c2); };
+            return lexicographical_tri_compare(cmp_fns.begin(), cmp_fns.end(),
                 a._ck->begin(_s), a._ck->end(_s),
                 b_values.begin(), b_values.end(),
                 cmp, a.relation(), relation_for_lower_bound(b));
@@ -419,11 +419,11 @@ public:
             if (a.is_static() != b.is_static()) {
                 return a.is_static() ? -1 : 1;
             }
-            auto&& types = _s.clustering_key_type()->types();
+            auto&& cmp_fns = _s.clustering_key_type()->compare_fns();
             auto a_values = a.values();
             auto b_values = b.values();
-            auto cmp = [&] (const data_type& t, bytes_view c1, bytes_view c2) { return t->compare(c1, c2); };
-            return lexicographical_tri_compare(types.begin(), types.end(),
+            auto cmp = [] (const auto& c, bytes_view c1, bytes_view c2) -> int { return c(c1, c2); };
+            return lexicographical_tri_compare(cmp_fns.begin(), cmp_fns.end(),
                 a_values.begin(), a_values.end(),
                 b_values.begin(), b_values.end(),
                 cmp,
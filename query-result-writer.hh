@@ -131,8 +131,12 @@ class result::builder {
     digester _digest;
     result_memory_accounter _memory_accounter;
 public:
-    builder(const partition_slice& slice, result_options options, result_memory_accounter memory_accounter)
-        : _slice(slice)
+    // result_size_hint, when non-zero, sizes the first buffer chunk so that
+    // results of a typical size fit in a single allocation instead of growing
+    // through the doubling ramp. It's a hint only and doesn't limit anything.
+    builder(const partition_slice& slice, result_options options, result_memory_accounter memory_accounter, size_t result_size_hint = 0)
+        : _out(result_size_hint ? bytes_ostream(result_size_hint) : bytes_ostream())
+        , _slice(slice)
         , _w(ser::writer_of_query_result<bytes_ostream>(_out).start_partitions())
         , _request(options.request)
         , _digest(digester(options.digest_algo))
@@ -162,7 +166,10 @@ public:
         // fetch the row range for this partition already.
         auto& ranges = _slice.row_ranges(s, key);
         auto after_key = [this, pw = _w.add(), &key] () mutable {
-            if (_slice.options.contains<partition_slice::option::send_partition_key>()) {
+            // For digest-only requests the result buffer is discarded by build(),
+            // so don't serialize keys into it.
+            if (_request != result_request::only_digest
+                    && _slice.options.contains<partition_slice::option::send_partition_key>()) {
                 return std::move(pw).write_key(key);
             } else {
                 return std::move(pw).skip_key();
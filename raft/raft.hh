@@ -486,6 +486,10 @@ public:
     virtual future<snapshot> load_snapshot() = 0;
 
     // Persist given log entries.
+    // After a leader change the new leader may replace an
+    // uncommitted tail of the log, so previously persisted entries
+    // with an index >= entries[0]->idx which are not overwritten by
+    // this batch must be removed atomically with storing the batch.
     // Can be called without waiting for previous call to resolve,
     // but internally all writes should be serialized into forming
     // one contiguous log that holds entries in order of the
@@ -496,15 +500,6 @@ public:
     // initialization only, should not run in parallel with store.
     virtual future<log_entries> load_log() = 0;
 
-    // Truncate all entries with an index greater or equal than
-    // the given index in the log and persist the truncation. Can be
-    // called in parallel with store_log_entries() but internally
-    // should be linearized vs store_log_entries():
-    // store_log_entries() called after truncate_log() should wait
-    // for truncation to complete internally before persisting its
-    // entries.
-    virtual future<> truncate_log(index_t idx) = 0;
-
     // Stop the persistence instance by aborting the work that can be
     // aborted and waiting for all the rest to complete. Any
     // unfinished store/load operation may return an error after
@@ -108,7 +108,6 @@ private:
         uint64_t store_term_and_vote = 0;
         uint64_t store_snapshot = 0;
         uint64_t sm_load_snapshot = 0;
-        uint64_t truncate_persisted_log = 0;
         uint64_t persisted_log_entries = 0;
         uint64_t queue_entries_for_apply = 0;
         uint64_t applied_entries = 0;
@@ -162,7 +161,7 @@ private:
     //  - persist the current term and vote
     //  - persist unstable log entries on disk.
     //  - send out messages
-    future<> io_fiber(index_t stable_idx);
+    future<> io_fiber();
 
     // This fiber runs in the background and applies committed entries.
     future<> applier_fiber();
@@ -239,7 +238,6 @@ future<> server_impl::start() {
     auto log_entries = co_await _persistence->load_log();
     auto log = raft::log(std::move(snapshot), std::move(log_entries));
     raft::configuration rpc_config = log.get_configuration();
-    index_t stable_idx = log.stable_idx();
     _fsm = std::make_unique<fsm>(_id, term, vote, std::move(log), *_failure_detector,
                                  fsm_config {
                                      .append_request_threshold = _config.append_request_threshold,
@@ -266,7 +264,7 @@ future<> server_impl::start() {
     }
 
     // start fiber to persist entries added to in-memory log
-    _io_status = io_fiber(stable_idx);
+    _io_status = io_fiber();
     // start fiber to apply committed entries
     _applier_status = applier_fiber();
 
@@ -441,7 +439,7 @@ static configuration_diff diff_address_sets(const server_address_set& prev, cons
     return result;
 }
 
-future<> server_impl::io_fiber(index_t last_stable) {
+future<> server_impl::io_fiber() {
     logger.trace("[{}] io_fiber start", _id);
     try {
         while (true) {
@@ -478,16 +476,11 @@ future<> server_impl::io_fiber(index_t last_stable) {
             if (batch.log_entries.size()) {
                 auto& entries = batch.log_entries;
 
-                if (last_stable >= entries[0]->idx) {
-                    co_await _persistence->truncate_log(entries[0]->idx);
-                    _stats.truncate_persisted_log++;
-                }
-
-                // Combine saving and truncating into one call?
-                // will require persistence to keep track of last idx
+                // Removes a previously persisted tail with
+                // idx >= entries[0]->idx, if any, atomically with
+                // storing the new entries.
                 co_await _persistence->store_log_entries(entries);
 
-                last_stable = (*entries.crbegin())->idx;
                 _stats.persisted_log_entries += entries.size();
             }
 
@@ -742,8 +735,6 @@ void server_impl::register_metrics() {
              sm::description("how many snapshot were persisted"), {server_id_label(_id)}),
         sm::make_total_operations("sm_load_snapshot", _stats.sm_load_snapshot,
              sm::description("how many times user state machine was reloaded with a snapshot"), {server_id_label(_id)}),
-        sm::make_total_operations("truncate_persisted_log", _stats.truncate_persisted_log,
-             sm::description("how many times log was truncated on storage"), {server_id_label(_id)}),
         sm::make_total_operations("persisted_log_entries", _stats.persisted_log_entries,
              sm::description("how many log entries were persisted"), {server_id_label(_id)}),
         sm::make_total_operations("queue_entries_for_apply", _stats.queue_entries_for_apply,
@@ -19,6 +19,8 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <seastar/core/seastar.hh>
 #include <seastar/core/print.hh>
 #include <seastar/util/lazy.hh>
@@ -79,6 +81,10 @@ class reader_permit::impl : public boost::intrusive::list_base_hook<boost::intru
     std::string_view _op_name_view;
     reader_resources _resources;
     reader_permit::state _state = reader_permit::state::active;
+    size_t _peak_memory = 0;
+    size_t _admission_memory = 0;
+    bool _admitted = false;
+    read_budget _budget;
 
 public:
     struct value_tag {};
@@ -102,6 +108,11 @@ public:
                         _resources.memory));
             signal(_resources);
         }
+        if (_admitted) {
+            // Report only what the read consumed on top of its admission
+            // grant, so the estimate can shrink when the grant was oversized.
+            _semaphore.on_permit_released(_peak_memory > _admission_memory ? _peak_memory - _admission_memory : 0);
+        }
     }
 
     reader_concurrency_semaphore& semaphore() {
@@ -124,8 +135,10 @@ public:
         _state = reader_permit::state::waiting;
     }
 
-    void on_admission() {
+    void on_admission(size_t admitted_memory) {
         _state = reader_permit::state::active;
+        _admitted = true;
+        _admission_memory = admitted_memory;
     }
 
     void on_register_as_inactive() {
@@ -138,6 +151,7 @@ public:
 
     void consume(reader_resources res) {
         _resources += res;
+        _peak_memory = std::max(_peak_memory, size_t(std::max<ssize_t>(_resources.memory, 0)));
         _semaphore.consume(res);
     }
 
@@ -150,6 +164,30 @@ public:
         return _resources;
     }
 
+    void set_budget(read_budget budget) {
+        _budget = budget;
+    }
+
+    const read_budget& budget() const {
+        return _budget;
+    }
+
+    bool budget_is_low() const {
+        if (_budget.deadline != db::no_timeout) {
+            const auto now = db::timeout_clock::now();
+            if (now >= _budget.deadline || (_budget.deadline - now) * 4 < _budget.deadline - _budget.start) {
+                return true;
+            }
+        }
+        if (_budget.max_memory != std::numeric_limits<uint64_t>::max()) {
+            const auto used = uint64_t(std::max<ssize_t>(_resources.memory, 0));
+            if (used * 4 > _budget.max_memory * 3) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     sstring description() const {
         return format("{}.{}:{}",
                 _schema ? _schema->ks_name() : "*",
@@ -180,8 +218,8 @@ void reader_permit::on_waiting() {
     _impl->on_waiting();
 }
 
-void reader_permit::on_admission() {
-    _impl->on_admission();
+void reader_permit::on_admission(size_t admitted_memory) {
+    _impl->on_admission(admitted_memory);
 }
 
 reader_permit::~reader_permit() {
@@ -215,6 +253,18 @@ reader_resources reader_permit::consumed_resources() const {
     return _impl->resources();
 }
 
+void reader_permit::set_budget(read_budget budget) {
+    _impl->set_budget(budget);
+}
+
+const read_budget& reader_permit::budget() const {
+    return _impl->budget();
+}
+
+bool reader_permit::budget_is_low() const {
+    return _impl->budget_is_low();
+}
+
 sstring reader_permit::description() const {
     return _impl->description();
 }
@@ -374,12 +424,32 @@ void reader_concurrency_semaphore::inactive_read_handle::abandon() noexcept {
     }
 }
 
+size_t reader_concurrency_semaphore::admission_cost(size_t base_cost) const {
+    if (!_average_peak_memory) {
+        return base_cost;
+    }
+    // Never estimate below a page worth of memory, nor above a quarter of the
+    // semaphore's budget, so a few pathological reads cannot lock admission up.
+    static constexpr size_t min_cost = 1024;
+    auto max_cost = size_t(std::max<ssize_t>(_initial_resources.memory / 4, ssize_t(base_cost)));
+    return std::clamp(_average_peak_memory, min_cost, max_cost);
+}
+
+void reader_concurrency_semaphore::on_permit_released(size_t peak_memory) noexcept {
+    if (!peak_memory) {
+        return;
+    }
+    // Biased towards history so a single oversized read does not inflate the
+    // estimate for long.
+    _average_peak_memory = _average_peak_memory ? (_average_peak_memory * 7 + peak_memory) / 8 : peak_memory;
+}
+
 void reader_concurrency_semaphore::signal(const resources& r) noexcept {
     _resources += r;
     while (!_wait_list.empty() && has_available_units(_wait_list.front().res)) {
         auto& x = _wait_list.front();
         try {
-            x.permit.on_admission();
+            x.permit.on_admission(size_t(x.res.memory));
             x.pr.set_value(reader_permit::resource_units(std::move(x.permit), x.res));
         } catch (...) {
             x.pr.set_exception(std::current_exception());
@@ -587,7 +657,7 @@ future<reader_permit::resource_units> reader_concurrency_semaphore::do_wait_admi
     auto first = _wait_list.empty();
 
     if (first && has_available_units(r)) {
-        permit.on_admission();
+        permit.on_admission(memory);
         return make_ready_future<reader_permit::resource_units>(reader_permit::resource_units(std::move(permit), r));
     }
 
@@ -173,6 +173,9 @@ private:
     std::unique_ptr<permit_list> _permit_list;
     bool _stopped = false;
     gate _close_readers_gate;
+    // Exponential moving average of the peak memory consumption of admitted
+    // reads, as reported by their permits on release. Feeds admission_cost().
+    size_t _average_peak_memory = 0;
 
 private:
     [[nodiscard]] flat_mutation_reader detach_inactive_reader(inactive_read&, evict_reason reason) noexcept;
@@ -305,6 +308,19 @@ public:
 
     void signal(const resources& r) noexcept;
 
+    /// The memory cost to request on admission for a new reader.
+    ///
+    /// Starts out as base_cost and converges to the observed peak memory
+    /// consumption of reads executed through this semaphore, so that on
+    /// small-row workloads more readers are admitted concurrently within the
+    /// same memory budget, while oversized reads stop being underestimated.
+    /// The estimate is only used for admission; readers which outgrow it
+    /// still register their consumption via their permit as they go.
+    size_t admission_cost(size_t base_cost) const;
+
+    /// Called by the permit of an admitted read when it is released.
+    void on_permit_released(size_t peak_memory) noexcept;
+
     size_t waiters() const {
         return _wait_list.size();
     }
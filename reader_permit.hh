@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/file.hh>
 #include "seastarx.hh"
@@ -74,6 +76,19 @@ inline bool operator==(const reader_resources& a, const reader_resources& b) {
     return a.count == b.count && a.memory == b.memory;
 }
 
+/// A per-read resource budget.
+///
+/// Carries the read's deadline and memory allowance down to the storage
+/// layers via the reader permit, so that deep layers can skip speculative
+/// work (e.g. readahead) when little of the budget remains and can afford
+/// to be aggressive when plenty does. Reads that never attach a budget
+/// behave as if their budget was unlimited.
+struct read_budget {
+    db::timeout_clock::time_point start = db::timeout_clock::time_point::min();
+    db::timeout_clock::time_point deadline = db::no_timeout;
+    uint64_t max_memory = std::numeric_limits<uint64_t>::max();
+};
+
 class reader_concurrency_semaphore;
 
 /// A permit for a specific read.
@@ -106,7 +121,7 @@ private:
     explicit reader_permit(reader_concurrency_semaphore& semaphore, const schema* const schema, sstring&& op_name);
 
     void on_waiting();
-    void on_admission();
+    void on_admission(size_t admitted_memory);
 
 public:
     ~reader_permit();
@@ -135,6 +150,15 @@ public:
 
     reader_resources consumed_resources() const;
 
+    void set_budget(read_budget budget);
+
+    const read_budget& budget() const;
+
+    // True when less than a quarter of the read's time budget or memory
+    // allowance remains. Storage layers use this to throttle speculative
+    // work; always false for reads without a budget.
+    bool budget_is_low() const;
+
     sstring description() const;
 };
 
@@ -97,11 +97,12 @@ future<redis_server::result> redis_server::connection::process_request_internal(
 
 void redis_server::connection::write_reply(const redis_exception& e)
 {
+    ++_pending_replies;
     _ready_to_respond = _ready_to_respond.then([this, exception_message = e.what_message()] () mutable {
         return redis_message::exception(exception_message).then([this] (auto&& result) {
             auto m = result.message();
             return _write_buf.write(std::move(*m)).then([this] {
-                return _write_buf.flush();
+                return maybe_flush();
             });
         });
     });
@@ -109,14 +110,25 @@ void redis_server::connection::write_reply(const redis_exception& e)
 
 void redis_server::connection::write_reply(redis_server::result result)
 {
+    ++_pending_replies;
     _ready_to_respond = _ready_to_respond.then([this, result = std::move(result)] () mutable {
         auto m = result.make_message();
         return _write_buf.write(std::move(*m)).then([this] {
-            return _write_buf.flush();
+            return maybe_flush();
         });
     });
 }
 
+future<> redis_server::connection::maybe_flush()
+{
+    // Flush only when no further replies are queued behind this one,
+    // so a burst of pipelined commands pays for a single flush.
+    if (--_pending_replies == 0) {
+        return _write_buf.flush();
+    }
+    return make_ready_future<>();
+}
+
 future<> redis_server::connection::process_request() {
     _parser.init();
     return _read_buf.consume(_parser).then([this] {
@@ -93,6 +93,12 @@ private:
         socket_address _server_addr;
         redis_protocol_parser _parser;
         redis::redis_options _options;
+        // Replies queued on _ready_to_respond but not yet written out.
+        // Commands execute one at a time, but the next command runs
+        // while the previous reply drains, so under pipelining replies
+        // can queue up behind a slow socket - and then only the last
+        // one needs to flush.
+        size_t _pending_replies = 0;
 
         using execution_stage_type = inheriting_concrete_execution_stage<
                 future<redis_server::result>,
@@ -109,6 +115,7 @@ private:
         void handle_error(future<>&& f) override;
         void write_reply(const redis_exception&);
         void write_reply(redis_server::result result);
+        future<> maybe_flush();
     private:
         const ::timeout_config& timeout_config() { return _server.timeout_config(); }
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
@@ -56,11 +56,16 @@ cache_tracker::cache_tracker()
     : cache_tracker(dummy_app_stats)
 {}
 
-cache_tracker::cache_tracker(mutation_application_stats& app_stats)
+cache_tracker::cache_tracker(sstring name)
+    : cache_tracker(dummy_app_stats, std::move(name))
+{}
+
+cache_tracker::cache_tracker(mutation_application_stats& app_stats, sstring name)
     : _garbage(_region, this, app_stats)
     , _memtable_cleaner(_region, nullptr, app_stats)
 {
-    setup_metrics();
+    setup_metrics(name);
+    _region.set_label(name);
 
     _region.make_evictable([this] {
         return with_allocator(_region.allocator(), [this] {
@@ -75,6 +80,11 @@ cache_tracker::cache_tracker(mutation_application_stats& app_stats)
                 _memtable_cleaner.clear_some();
                 return memory::reclaiming_result::reclaimed_something;
             }
+            if (_region.occupancy().used_space() <= _evict_reserve) {
+                // Entries below the reserve are protected from eviction;
+                // send the reclaimer to other regions.
+                return memory::reclaiming_result::reclaimed_nothing;
+            }
             if (_lru.empty()) {
                 return memory::reclaiming_result::reclaimed_nothing;
             }
@@ -100,9 +110,9 @@ void cache_tracker::set_compaction_scheduling_group(seastar::scheduling_group sg
 }
 
 void
-cache_tracker::setup_metrics() {
+cache_tracker::setup_metrics(const sstring& name) {
     namespace sm = seastar::metrics;
-    _metrics.add_group("cache", {
+    _metrics.add_group(name, {
         sm::make_gauge("bytes_used", sm::description("current bytes used by the cache out of the total size of memory"), [this] { return _region.occupancy().used_space(); }),
         sm::make_gauge("bytes_total", sm::description("total size of memory for the cache"), [this] { return _region.occupancy().total_space(); }),
         sm::make_derive("partition_hits", sm::description("number of partitions needed by reads and found in cache"), _stats.partition_hits),
@@ -117,6 +127,7 @@ cache_tracker::setup_metrics() {
         sm::make_derive("static_row_insertions", sm::description("total number of static rows added to cache"), _stats.static_row_insertions),
         sm::make_derive("concurrent_misses_same_key", sm::description("total number of operation with misses same key"), _stats.concurrent_misses_same_key),
         sm::make_derive("partition_merges", sm::description("total number of partitions merged"), _stats.partition_merges),
+        sm::make_derive("version_chain_squashes", sm::description("total number of version chain squashes on read"), _stats.version_chain_squashes),
         sm::make_derive("partition_evictions", sm::description("total number of evicted partitions"), _stats.partition_evictions),
         sm::make_derive("partition_removals", sm::description("total number of invalidated partitions"), _stats.partition_removals),
         sm::make_derive("mispopulations", sm::description("number of entries not inserted by reads"), _stats.mispopulations),
@@ -180,6 +191,10 @@ void cache_tracker::on_partition_merge() noexcept {
     ++_stats.partition_merges;
 }
 
+void cache_tracker::on_version_chain_squash() noexcept {
+    ++_stats.version_chain_squashes;
+}
+
 void cache_tracker::on_partition_hit() noexcept {
     ++_stats.partition_hits;
 }
@@ -437,12 +452,53 @@ void cache_tracker::clear_continuity(cache_entry& ce) noexcept {
     ce.set_continuous(false);
 }
 
-void row_cache::on_partition_hit() {
+void row_cache::note_working_set(dht::token t) {
+    auto now = lowres_clock::now();
+    if (now - _ws_window_start > working_set_window) {
+        _ws_previous = std::exchange(_ws_current, hll::HyperLogLog(working_set_sketch_bits));
+        _ws_window_start = now;
+    }
+    _ws_current.offer_hashed(uint64_t(t.raw()));
+}
+
+uint64_t row_cache::working_set_partitions() const {
+    return uint64_t(std::max(_ws_current.estimate(), _ws_previous.estimate()));
+}
+
+uint64_t row_cache::working_set_bytes() const {
+    auto partitions = _tracker.partitions();
+    if (!partitions) {
+        return 0;
+    }
+    return working_set_partitions() * (_tracker.region().occupancy().used_space() / partitions);
+}
+
+void row_cache::on_partition_hit(dht::token t) {
     _tracker.on_partition_hit();
+    note_working_set(t);
 }
 
-void row_cache::on_partition_miss() {
+void row_cache::on_partition_miss(dht::token t) {
     _tracker.on_partition_miss();
+    note_working_set(t);
+    if (_promotion_hook) {
+        // Bucket index is the token's topmost bits, so buckets are equally
+        // sized slices of the ring, in ring order.
+        constexpr auto bucket_bits = continuity_promotion_bucket_bits;
+        auto biased = uint64_t(t.raw()) + (uint64_t(1) << 63);
+        auto bucket = biased >> (64 - bucket_bits);
+        if (++_miss_buckets[bucket] >= continuity_promotion_threshold) {
+            _miss_buckets[bucket] = 0;
+            auto first = int64_t((bucket << (64 - bucket_bits)) - (uint64_t(1) << 63));
+            auto last = int64_t((((bucket + 1) << (64 - bucket_bits)) - 1) - (uint64_t(1) << 63));
+            if (first == std::numeric_limits<int64_t>::min()) {
+                // token::from_int64() normalizes min to max; min is not a
+                // valid key token anyway.
+                first++;
+            }
+            _promotion_hook(dht::token_range::make(dht::token::from_int64(first), dht::token::from_int64(last)));
+        }
+    }
 }
 
 void row_cache::on_row_hit() {
@@ -517,9 +573,9 @@ public:
                         return make_ready_future<read_result>(read_result(std::nullopt, std::nullopt));
                     });
                 }
-                _cache.on_partition_miss();
                 const partition_start& ps = mfopt->as_partition_start();
                 const dht::decorated_key& key = ps.key();
+                _cache.on_partition_miss(key.token());
                 if (_reader.creation_phase() == _cache.phase_of(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
@@ -570,7 +626,8 @@ class scanning_and_populating_reader final : public flat_mutation_reader::impl {
 private:
     flat_mutation_reader read_from_entry(cache_entry& ce) {
         _cache.upgrade_entry(ce);
-        _cache.on_partition_hit();
+        _cache.maybe_squash_version_chain(ce);
+        _cache.on_partition_hit(ce.key().token());
         return ce.read(_cache, *_read_context);
     }
 
@@ -745,13 +802,19 @@ row_cache::make_reader(schema_ptr s,
             if (hint.match) {
                 cache_entry& e = *i;
                 upgrade_entry(e);
-                on_partition_hit();
+                maybe_squash_version_chain(e);
+                on_partition_hit(pos.token());
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
+                // Negative hit: the cache has no entry for this key but the
+                // interval around it is continuous, so the partition is known
+                // to not exist and sstables don't need to be poked.
+                tracing::trace(trace_state, "Range {} is known to be empty in cache", range);
+                on_partition_hit(pos.token());
                 return make_empty_flat_reader(std::move(s), std::move(permit));
             } else {
                 tracing::trace(trace_state, "Range {} not found in cache", range);
-                on_partition_miss();
+                on_partition_miss(pos.token());
                 return make_flat_mutation_reader<single_partition_populating_reader>(*this, make_context());
             }
         });
@@ -874,6 +937,24 @@ void row_cache::populate(const mutation& m, const previous_entry_pointer* previo
   });
 }
 
+std::vector<dht::decorated_key> row_cache::resident_keys(size_t max) {
+    std::vector<dht::decorated_key> keys;
+    keys.reserve(std::min(max, size_t(_tracker.get_stats().partitions)));
+    _read_section(_tracker.region(), [&] {
+        for (auto it = _partitions.begin(); it != _partitions.end() && keys.size() < max; ++it) {
+            if (it->is_dummy_entry()) {
+                continue;
+            }
+            // The keys outlive the read section, so they must not live in the
+            // cache's region.
+            with_allocator(standard_allocator(), [&] {
+                keys.push_back(it->key());
+            });
+        }
+    });
+    return keys;
+}
+
 cache_entry& row_cache::lookup(const dht::decorated_key& key) {
     return do_find_or_create_entry(key, nullptr, [&] (auto i, const partitions_type::bound_hint& hint) {
         throw std::runtime_error(format("cache doesn't contain entry for {}", key));
@@ -960,9 +1041,10 @@ future<> row_cache::do_update(external_updater eu, memtable& m, Updater updater)
                     size_t partition_count = 0;
                     {
                         STAP_PROBE(scylla, row_cache_update_one_batch_start);
-                        // FIXME: we should really be checking should_yield() here instead of
-                        // need_preempt(). However, should_yield() is currently quite
-                        // expensive and we need to amortize it somehow.
+                        // The cheap need_preempt() is checked on every partition, and
+                        // should_yield(), which also reacts to higher-priority work
+                        // being queued but is quite expensive, is amortized over
+                        // every 8th one.
                         do {
                           STAP_PROBE(scylla, row_cache_update_partition_start);
                           {
@@ -992,7 +1074,8 @@ future<> row_cache::do_update(external_updater eu, memtable& m, Updater updater)
                             ++partition_count;
                           }
                           STAP_PROBE(scylla, row_cache_update_partition_end);
-                        } while (!m.partitions.empty() && !need_preempt());
+                        } while (!m.partitions.empty() && !need_preempt()
+                                 && ((partition_count & 7) || !seastar::thread::should_yield()));
                         with_allocator(standard_allocator(), [&] {
                             if (m.partitions.empty()) {
                                 _prev_snapshot_pos = {};
@@ -1306,6 +1389,39 @@ void row_cache::upgrade_entry(cache_entry& e) {
     }
 }
 
+// Reads have to merge data from all versions in the entry's chain, so an
+// entry which accumulated a long chain, e.g. under long-lived snapshots
+// taken during repair, makes every read of it merge-heavy until the
+// snapshots die and mutation_cleaner gets to the chain. Instead of waiting
+// for that, squash unreferenced versions when a read finds a deep chain.
+// Squashing is preemptible; whatever is left over after the quantum expires
+// is picked up by subsequent reads, so hot entries with the deepest chains
+// get fixed up first, at a bounded cost per read.
+// Called from the read path, under _read_section.
+void row_cache::maybe_squash_version_chain(cache_entry& e) {
+    static constexpr unsigned version_chain_squash_threshold = 8;
+    partition_entry& pe = e.partition();
+    if (pe.is_locked()) {
+        return;
+    }
+    unsigned count = 0;
+    for (partition_version& v : pe.versions()) {
+        (void)v;
+        if (++count == version_chain_squash_threshold) {
+            break;
+        }
+    }
+    if (count < version_chain_squash_threshold) {
+        return;
+    }
+    auto& r = _tracker.region();
+    assert(!r.reclaiming_enabled());
+    with_allocator(r.allocator(), [this, &e, &pe] {
+        pe.squash_unreferenced_versions(*e.schema(), &_tracker);
+    });
+    _tracker.on_version_chain_squash();
+}
+
 std::ostream& operator<<(std::ostream& out, row_cache& rc) {
     rc._read_section(rc._tracker.region(), [&] {
         out << "{row_cache: " << ::join(", ", rc._partitions.begin(), rc._partitions.end()) << "}";
@@ -27,6 +27,7 @@
 
 #include <seastar/core/memory.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/util/noncopyable_function.hh>
 
 #include "mutation_reader.hh"
@@ -38,6 +39,7 @@
 #include "tracing/trace_state.hh"
 #include <seastar/core/metrics_registration.hh>
 #include "mutation_cleaner.hh"
+#include "sstables/hyperloglog.hh"
 #include "utils/double-decker.hh"
 
 namespace bi = boost::intrusive;
@@ -173,6 +175,7 @@ public:
         uint64_t static_row_insertions;
         uint64_t concurrent_misses_same_key;
         uint64_t partition_merges;
+        uint64_t version_chain_squashes;
         uint64_t rows_processed_from_memtable;
         uint64_t rows_dropped_from_memtable;
         uint64_t rows_merged_from_memtable;
@@ -202,10 +205,12 @@ private:
     lru_type _lru;
     mutation_cleaner _garbage;
     mutation_cleaner _memtable_cleaner;
+    size_t _evict_reserve = 0;
 private:
-    void setup_metrics();
+    void setup_metrics(const sstring& name);
 public:
-    cache_tracker(mutation_application_stats&);
+    cache_tracker(mutation_application_stats&, sstring name = "cache");
+    explicit cache_tracker(sstring name);
     cache_tracker();
     ~cache_tracker();
     void clear();
@@ -218,6 +223,7 @@ public:
     void clear_continuity(cache_entry& ce) noexcept;
     void on_partition_erase() noexcept;
     void on_partition_merge() noexcept;
+    void on_version_chain_squash() noexcept;
     void on_partition_hit() noexcept;
     void on_partition_miss() noexcept;
     void on_partition_eviction() noexcept;
@@ -239,6 +245,12 @@ public:
     uint64_t partitions() const noexcept { return _stats.partitions; }
     const stats& get_stats() const noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
+    // Protects up to `bytes` of cache entries from eviction under memory
+    // pressure; while the cache uses less than that, the memory reclaimer
+    // is sent to other regions instead. Used to shield the caches of small
+    // critical tables from bulk reads of user tables. The reserve is not
+    // preallocated and entries can still be removed by invalidation.
+    void set_evict_reserve(size_t bytes) noexcept { _evict_reserve = bytes; }
 };
 
 inline
@@ -334,6 +346,10 @@ public:
         utils::timed_rate_moving_average reads_with_misses;
         utils::timed_rate_moving_average reads_with_no_misses;
     };
+
+    // Invoked (if set) with a token range which accumulated enough partition
+    // misses to justify promoting it to a continuous cache range.
+    using continuity_promotion_hook = std::function<void(dht::token_range)>;
 private:
     cache_tracker& _tracker;
     stats _stats{};
@@ -381,15 +397,43 @@ private:
     logalloc::allocating_section _update_section;
     logalloc::allocating_section _populate_section;
     logalloc::allocating_section _read_section;
+
+    // Partition misses counted in coarse token buckets. When a bucket
+    // accumulates continuity_promotion_threshold misses, the promotion hook
+    // is invoked with the bucket's token range, so that the owning table can
+    // schedule a read-through of the whole bucket, which establishes
+    // continuity there and turns further misses in the bucket into hits.
+    // Reads which scan slightly different ranges every time, each of them
+    // paying for the margin not covered by the previous scans, benefit the
+    // most.
+    static constexpr unsigned continuity_promotion_bucket_bits = 10;
+    static constexpr uint8_t continuity_promotion_threshold = 16;
+    std::array<uint8_t, 1 << continuity_promotion_bucket_bits> _miss_buckets{};
+    continuity_promotion_hook _promotion_hook;
+
+    // Working set estimation: the tokens of partitions touched by reads
+    // (hits and misses alike) are fed into a HyperLogLog sketch, which is
+    // rotated every working_set_window. The estimate spans the current and
+    // the previous window, so it doesn't collapse to zero right after a
+    // rotation. A token is as good as a hash of the key here since it is
+    // itself the output of the partitioner's hash.
+    static constexpr std::chrono::minutes working_set_window{15};
+    static constexpr uint8_t working_set_sketch_bits = 10; // 1KB per sketch, ~3% error
+    hll::HyperLogLog _ws_current{working_set_sketch_bits};
+    hll::HyperLogLog _ws_previous{working_set_sketch_bits};
+    lowres_clock::time_point _ws_window_start = lowres_clock::now();
+    void note_working_set(dht::token t);
+
     flat_mutation_reader create_underlying_reader(cache::read_context&, mutation_source&, const dht::partition_range&);
     flat_mutation_reader make_scanning_reader(const dht::partition_range&, std::unique_ptr<cache::read_context>);
-    void on_partition_hit();
-    void on_partition_miss();
+    void on_partition_hit(dht::token t);
+    void on_partition_miss(dht::token t);
     void on_row_hit();
     void on_row_miss();
     void on_static_row_insert();
     void on_mispopulate();
     void upgrade_entry(cache_entry&);
+    void maybe_squash_version_chain(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void clear_now() noexcept;
 
@@ -500,6 +544,32 @@ public:
     }
 
     const stats& stats() const { return _stats; }
+
+    // Returns keys of up to max partitions currently resident in cache, in
+    // ring order. Since residency is governed by LRU eviction, the resident
+    // set approximates the read-hot set; it is snapshotted periodically so
+    // the cache can be warmed back up after a restart.
+    std::vector<dht::decorated_key> resident_keys(size_t max);
+
+    void set_continuity_promotion_hook(continuity_promotion_hook hook) {
+        _promotion_hook = std::move(hook);
+    }
+
+    // Estimated number of distinct partitions read (found in cache or not)
+    // over the last two working-set windows.
+    uint64_t working_set_partitions() const;
+
+    // working_set_partitions() scaled by the tracker-wide average size of a
+    // cached partition, i.e. approximately how much cache the hot set of
+    // this table would occupy. Compare with the cache's actual allocation
+    // to see whether the cache is over- or under-sized.
+    uint64_t working_set_bytes() const;
+
+    // Rebuild counters of the underlying partition index, see
+    // double_decker::stats. Buckets are rebuilt on token collisions.
+    const partitions_type::stats& partition_index_stats() const noexcept {
+        return _partitions.get_stats();
+    }
 public:
     // Populate cache from given mutation, which must be fully continuous.
     // Intended to be used only in tests.
@@ -274,10 +274,14 @@ void schema::rebuild() {
     _regular_column_count = _raw._columns.size() - column_offset(column_kind::regular_column);
     _static_column_count = column_offset(column_kind::regular_column) - column_offset(column_kind::static_column);
     _columns_by_name.clear();
+    _columns_by_name.reserve(_raw._columns.size());
 
     for (const column_definition& def : all_columns()) {
-        _columns_by_name[def.name()] = &def;
+        _columns_by_name.emplace_back(def.name(), &def);
     }
+    std::sort(_columns_by_name.begin(), _columns_by_name.end(), [] (const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
 
     static_assert(row_column_ids_are_ordered_by_name::value, "row columns don't need to be ordered by name");
     if (!std::is_sorted(regular_columns().begin(), regular_columns().end(), column_definition::name_comparator(regular_column_name_type()))) {
@@ -599,8 +603,11 @@ std::ostream& operator<<(std::ostream& os, const column_definition& cd) {
 
 const column_definition*
 schema::get_column_definition(const bytes& name) const {
-    auto i = _columns_by_name.find(name);
-    if (i == _columns_by_name.end()) {
+    auto i = std::lower_bound(_columns_by_name.begin(), _columns_by_name.end(), name,
+            [] (const auto& cdef, const bytes& name) {
+        return cdef.first < name;
+    });
+    if (i == _columns_by_name.end() || i->first != name) {
         return nullptr;
     }
     return i->second;
@@ -663,7 +663,10 @@ private:
         return k == column_kind::partition_key ? 0 : _offsets[column_count_type(k) - 1];
     }
 
-    std::unordered_map<bytes, const column_definition*> _columns_by_name;
+    // Sorted by name and frozen after rebuild(); schemas are immutable, so
+    // name lookup is a binary search over a flat array rather than a hash
+    // map probe, which is cheaper for the few dozen columns a table has.
+    std::vector<std::pair<bytes, const column_definition*>> _columns_by_name;
     lw_shared_ptr<compound_type<allow_prefixes::no>> _partition_key_type;
     lw_shared_ptr<compound_type<allow_prefixes::yes>> _clustering_key_type;
     column_mapping _column_mapping;
@@ -872,10 +875,6 @@ public:
         return _raw._columns;
     }
 
-    const std::unordered_map<bytes, const column_definition*>& columns_by_name() const {
-        return _columns_by_name;
-    }
-
     const auto& dropped_columns() const {
         return _raw._dropped_columns;
     }
@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <unordered_set>
 #include <list>
@@ -213,6 +214,26 @@ inline void serialize_integral(Output& output, T data) {
     output.write(reinterpret_cast<const char*>(&data), sizeof(T));
 }
 
+// Helpers for messages with a fixed on-wire layout, used by the serializers
+// which idl-compiler.py generates for such messages. The fields are packed
+// into (unpacked from) one contiguous little-endian block at offsets known
+// at compile time, so the stream is touched once per message rather than
+// once per field.
+template<typename T>
+inline void serialize_fixed_at(char* p, T data) {
+    static_assert(std::is_integral<T>::value, "T should be integral");
+    data = cpu_to_le(data);
+    std::copy_n(reinterpret_cast<const char*>(&data), sizeof(T), p);
+}
+
+template<typename T>
+inline T deserialize_fixed_at(const char* p) {
+    static_assert(std::is_integral<T>::value, "T should be integral");
+    T data;
+    std::copy_n(p, sizeof(T), reinterpret_cast<char*>(&data));
+    return le_to_cpu(data);
+}
+
 template<typename T>
 struct serializer;
 
@@ -121,6 +121,15 @@ public:
 
     future<cql3::result_generator> fetch_page_generator(uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout, cql3::cql_stats& stats);
 
+    /**
+     * Fetches the next page and returns only the number of CQL rows in it,
+     * without materializing them. Only useful for selections whose output
+     * doesn't depend on any cell value (SELECT COUNT(*)). Must not be used
+     * when the results need post-filtering, since the replica-provided row
+     * counts include rows the filter would have dropped.
+     */
+    future<uint64_t> fetch_page_row_count(uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout);
+
     /**
      * Whether or not this pager is exhausted, i.e. whether or not a call to
      * fetchPage may return more result.
@@ -45,6 +45,12 @@ raft_sys_table_storage::raft_sys_table_storage(cql3::query_processor& qp, raft::
     auto prepared_stmt_ptr = _qp.prepare_internal(store_cql);
     shared_ptr<cql3::cql_statement> cql_stmt = prepared_stmt_ptr->statement;
     _store_entry_stmt = dynamic_pointer_cast<cql3::statements::modification_statement>(cql_stmt);
+
+    static const auto truncate_cql = format("DELETE FROM system.{} WHERE group_id = ? AND \"index\" > ?",
+        db::system_keyspace::RAFT);
+    prepared_stmt_ptr = _qp.prepare_internal(truncate_cql);
+    cql_stmt = prepared_stmt_ptr->statement;
+    _truncate_tail_stmt = dynamic_pointer_cast<cql3::statements::modification_statement>(cql_stmt);
 }
 
 future<> raft_sys_table_storage::store_term_and_vote(raft::term_t term, raft::server_id vote) {
@@ -87,6 +93,9 @@ future<raft::log_entries> raft_sys_table_storage::load_log() {
 
         co_await make_ready_future<>();
     }
+    if (!log.empty()) {
+        _last_stored_idx = log.back()->idx;
+    }
     co_return log;
 }
 
@@ -149,11 +158,36 @@ future<> raft_sys_table_storage::do_store_log_entries(const std::vector<raft::lo
     std::vector<fragmented_temporary_buffer> stmt_data_views;
     // statement value views -- required for `query_options` to consume `fragmented_temporary_buffer::view`
     std::vector<std::vector<cql3::raw_value_view>> stmt_value_views;
-    const size_t entries_size = entries.size();
-    batch_stmts.reserve(entries_size);
-    stmt_values.reserve(entries_size);
-    stmt_data_views.reserve(entries_size);
-    stmt_value_views.reserve(entries_size);
+    // Reserve an extra slot for the optional tail deletion; the views point
+    // into `stmt_values`, so the vectors must not reallocate.
+    const size_t max_batch_size = entries.size() + 1;
+    batch_stmts.reserve(max_batch_size);
+    stmt_values.reserve(max_batch_size);
+    stmt_data_views.reserve(max_batch_size);
+    stmt_value_views.reserve(max_batch_size);
+
+    const raft::index_t last_idx = entries.back()->idx;
+    if (_last_stored_idx > last_idx) {
+        // A leader change has replaced a suffix of the persisted log. The new
+        // entries overwrite the rows with matching indices, so only the part
+        // of the old tail extending past `last_idx` has to be deleted.
+        // Folding the deletion into the same batch makes truncation atomic
+        // with the append and shares a single commitlog sync with it. The
+        // tombstone range must not cover the new entries: it carries the same
+        // batch timestamp, and a tombstone wins a timestamp tie.
+        batch_stmts.emplace_back(cql3::statements::batch_statement::single_statement(_truncate_tail_stmt, false));
+        std::vector<cql3::raw_value> delete_values = {
+            cql3::raw_value::make_value(long_type->decompose(_group_id.id)),
+            cql3::raw_value::make_value(long_type->decompose(int64_t(last_idx)))
+        };
+        stmt_values.emplace_back(std::move(delete_values));
+        std::vector<cql3::raw_value_view> delete_value_views;
+        delete_value_views.reserve(2); // 2 is the number of required values for the deletion query
+        for (const cql3::raw_value& raw : stmt_values.back()) {
+            delete_value_views.push_back(raw.to_view());
+        }
+        stmt_value_views.emplace_back(std::move(delete_value_views));
+    }
 
     for (const raft::log_entry_ptr& eptr : entries) {
         batch_stmts.emplace_back(cql3::statements::batch_statement::single_statement(_store_entry_stmt, false));
@@ -203,6 +237,7 @@ future<> raft_sys_table_storage::do_store_log_entries(const std::vector<raft::lo
         _qp.get_cql_stats());
 
     co_await batch.execute(_qp, _dummy_query_state, batch_options);
+    _last_stored_idx = last_idx;
 }
 
 future<> raft_sys_table_storage::store_log_entries(const std::vector<raft::log_entry_ptr>& entries) {
@@ -212,10 +247,13 @@ future<> raft_sys_table_storage::store_log_entries(const std::vector<raft::log_e
 }
 
 future<> raft_sys_table_storage::truncate_log(raft::index_t idx) {
-    return execute_with_linearization_point([this, idx] {
+    return execute_with_linearization_point([this, idx] () -> future<> {
         static const auto truncate_cql = format("DELETE FROM system.{} WHERE group_id = ? AND \"index\" >= ?",
-            db::system_keyspace::RAFT); 
-        return _qp.execute_internal(truncate_cql, {_group_id.id, int64_t(idx)}).discard_result();
+            db::system_keyspace::RAFT);
+        co_await _qp.execute_internal(truncate_cql, {_group_id.id, int64_t(idx)}).discard_result();
+        if (_last_stored_idx >= idx) {
+            _last_stored_idx = idx ? raft::index_t(idx - 1) : raft::index_t(0);
+        }
     });
 }
 
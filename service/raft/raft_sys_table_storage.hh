@@ -33,6 +33,10 @@ class raft_sys_table_storage : public raft::persistence {
     // Prepared statement instance used for construction of batch statements on
     // `store_log_entries` calls.
     shared_ptr<cql3::statements::modification_statement> _store_entry_stmt;
+    // Prepared statement that deletes the log tail past a given index. Folded
+    // into the `store_log_entries` batch when a leader change replaces a
+    // suffix of the persisted log.
+    shared_ptr<cql3::statements::modification_statement> _truncate_tail_stmt;
     cql3::query_processor& _qp;
     service::query_state _dummy_query_state;
     // The future of the currently executing (or already finished) write operation.
@@ -42,6 +46,10 @@ class raft_sys_table_storage : public raft::persistence {
     // All RPC entry points that involve writing to system.raft are guarded with
     // this helper.
     future<> _pending_op_fut;
+    // Index of the last persisted log entry. Initialized by `load_log` and
+    // used by `store_log_entries` to decide whether an older log tail has to
+    // be removed along with storing the new entries.
+    raft::index_t _last_stored_idx;
 
 public:
     explicit raft_sys_table_storage(cql3::query_processor& qp, raft::group_id gid);
@@ -54,11 +62,16 @@ public:
     // Store a snapshot `snap` and preserve the most recent `preserve_log_entries` log entries,
     // i.e. truncate all entries with `idx <= (snap.idx - preserve_log_entries)`
     future<> store_snapshot(const raft::snapshot& snap, size_t preserve_log_entries) override;
-    // Pre-checks that no log truncation is in process before dispatching to the actual implementation
+    // Stores the given entries and, in the same atomic batch, removes any
+    // previously persisted log tail that the entries do not overwrite
     future<> store_log_entries(const std::vector<raft::log_entry_ptr>& entries) override;
-    future<> truncate_log(raft::index_t idx) override;
     future<> abort() override;
 
+    // Truncate all entries with indices >= `idx` from the persisted log.
+    // Not used on the store path (`store_log_entries` truncates the replaced
+    // tail itself), but kept for administrative resets of the log.
+    future<> truncate_log(raft::index_t idx);
+
 private:
 
     future<> do_store_log_entries(const std::vector<raft::log_entry_ptr>& entries);
@@ -132,6 +132,9 @@ using fbu = utils::fb_utilities;
 
 static inline
 query::digest_algorithm digest_algorithm(service::storage_proxy& proxy) {
+    if (proxy.features().cluster_supports_xxhash3_digest()) {
+        return query::digest_algorithm::xxHash3;
+    }
     return proxy.features().cluster_supports_digest_for_null_values()
             ? query::digest_algorithm::xxHash
             : query::digest_algorithm::legacy_xxHash_without_null_digest;
@@ -1702,6 +1705,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of remote digest read requests this Node received"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("digest")}),
 
+        sm::make_total_operations("reads_dropped_expired", replica_reads_dropped_expired,
+                       sm::description("number of remote read requests this Node dropped because the coordinator's deadline had already expired"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
         sm::make_total_operations("cross_shard_ops", replica_cross_shard_ops,
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
@@ -1791,7 +1798,7 @@ storage_proxy::storage_proxy(distributed<database>& db, storage_proxy::config cf
     , _hints_write_smp_service_group(cfg.hints_write_smp_service_group)
     , _write_ack_smp_service_group(cfg.write_ack_smp_service_group)
     , _next_response_id(std::chrono::system_clock::now().time_since_epoch()/1ms)
-    , _hints_resource_manager(cfg.available_memory / 10)
+    , _hints_resource_manager(cfg.available_memory / 10, uint64_t(_db.local().get_config().hinted_handoff_throttle_in_kb()) * 1024 / smp::count)
     , _hints_manager(_db.local().get_config().hints_directory(), cfg.hinted_handoff_enabled, _db.local().get_config().max_hint_window_in_ms(), _hints_resource_manager, _db)
     , _hints_directory_initializer(std::move(cfg.hints_directory_initializer))
     , _hints_for_views_manager(_db.local().get_config().view_hints_directory(), {}, _db.local().get_config().max_hint_window_in_ms(), _hints_resource_manager, _db)
@@ -4965,6 +4972,13 @@ void storage_proxy::init_messaging_service(shared_ptr<migration_manager> mm) {
         }
         return do_with(std::move(pr), std::move(sp), std::move(trace_state_ptr), [&cinfo, cmd = make_lw_shared<query::read_command>(std::move(cmd)), src_addr = std::move(src_addr), da, t, mm] (::compat::wrapping_partition_range& pr, shared_ptr<storage_proxy>& p, tracing::trace_state_ptr& trace_state_ptr) mutable {
             p->get_stats().replica_data_reads++;
+            if (t && *t <= clock_type::now()) {
+                // The coordinator has timed this read out already, so nobody
+                // waits for the result; don't waste the read work.
+                ++p->get_stats().replica_reads_dropped_expired;
+                tracing::trace(trace_state_ptr, "read_data: dropping the request, its deadline has already expired");
+                throw timed_out_error();
+            }
             auto src_ip = src_addr.addr;
             return mm->get_schema_for_read(cmd->schema_version, std::move(src_addr), p->_messaging).then([cmd, da, &pr, &p, &trace_state_ptr, t] (schema_ptr s) {
                 auto pr2 = ::compat::unwrap(std::move(pr), *s);
@@ -5003,6 +5017,11 @@ void storage_proxy::init_messaging_service(shared_ptr<migration_manager> mm) {
                                tracing::trace_state_ptr& trace_state_ptr,
                                ::compat::one_or_two_partition_ranges& unwrapped) mutable {
             p->get_stats().replica_mutation_data_reads++;
+            if (t && *t <= clock_type::now()) {
+                ++p->get_stats().replica_reads_dropped_expired;
+                tracing::trace(trace_state_ptr, "read_mutation_data: dropping the request, its deadline has already expired");
+                throw timed_out_error();
+            }
             auto src_ip = src_addr.addr;
             return mm->get_schema_for_read(cmd->schema_version, std::move(src_addr), p->_messaging).then([cmd, &pr, &p, &trace_state_ptr, &unwrapped, t] (schema_ptr s) mutable {
                 unwrapped = ::compat::unwrap(std::move(pr), *s);
@@ -5027,6 +5046,11 @@ void storage_proxy::init_messaging_service(shared_ptr<migration_manager> mm) {
         }
         return do_with(std::move(pr), get_local_shared_storage_proxy(), std::move(trace_state_ptr), [&cinfo, cmd = make_lw_shared<query::read_command>(std::move(cmd)), src_addr = std::move(src_addr), da, t, mm] (::compat::wrapping_partition_range& pr, shared_ptr<storage_proxy>& p, tracing::trace_state_ptr& trace_state_ptr) mutable {
             p->get_stats().replica_digest_reads++;
+            if (t && *t <= clock_type::now()) {
+                ++p->get_stats().replica_reads_dropped_expired;
+                tracing::trace(trace_state_ptr, "read_digest: dropping the request, its deadline has already expired");
+                throw timed_out_error();
+            }
             auto src_ip = src_addr.addr;
             return mm->get_schema_for_read(cmd->schema_version, std::move(src_addr), p->_messaging).then([cmd, &pr, &p, &trace_state_ptr, t, da] (schema_ptr s) {
                 auto pr2 = ::compat::unwrap(std::move(pr), *s);
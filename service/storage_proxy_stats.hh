@@ -166,6 +166,10 @@ struct stats : public write_stats {
     uint64_t replica_digest_reads = 0;
     uint64_t replica_mutation_data_reads = 0;
 
+    // number of received read requests dropped because the coordinator's
+    // deadline had already expired when we got to them
+    uint64_t replica_reads_dropped_expired = 0;
+
     uint64_t replica_cross_shard_ops = 0;
 
     utils::timed_rate_moving_average_and_histogram read;
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <list>
 #include <vector>
 #include <seastar/core/shared_ptr.hh>
 
@@ -72,9 +73,14 @@ private:
                 const schema& s,
                 const utils::chunked_vector<serialization_header::column_desc>& src,
                 const sstable_enabled_features& features,
+                std::list<bytes>& name_storage,
                 bool is_static);
 
         utils::UUID schema_uuid;
+        // Owns the column names the column_infos point at, so that a state
+        // shared between sstables (see sstables_manager) doesn't dangle into
+        // any particular sstable's serialization header.
+        std::list<bytes> name_storage;
         std::vector<column_info> regular_schema_columns_from_sstable;
         std::vector<column_info> static_schema_columns_from_sstable;
         column_values_fixed_lengths clustering_column_value_fix_lengths;
@@ -87,8 +93,8 @@ private:
 
         state(const schema& s, const serialization_header& header, const sstable_enabled_features& features)
             : schema_uuid(s.version())
-            , regular_schema_columns_from_sstable(build(s, header.regular_columns.elements, features, false))
-            , static_schema_columns_from_sstable(build(s, header.static_columns.elements, features, true))
+            , regular_schema_columns_from_sstable(build(s, header.regular_columns.elements, features, name_storage, false))
+            , static_schema_columns_from_sstable(build(s, header.static_columns.elements, features, name_storage, true))
             , clustering_column_value_fix_lengths (get_clustering_values_fixed_lengths(header))
         {}
     };
@@ -96,12 +102,19 @@ private:
     lw_shared_ptr<const state> _state = make_lw_shared<const state>();
 
 public:
-    column_translation get_for_schema(
-            const schema& s, const serialization_header& header, const sstable_enabled_features& features) {
-        if (s.version() != _state->schema_uuid) {
-            _state = make_lw_shared<const state>(s, header, features);
-        }
-        return *this;
+    column_translation() = default;
+    column_translation(const schema& s, const serialization_header& header, const sstable_enabled_features& features)
+        : _state(make_lw_shared<const state>(s, header, features))
+    {}
+
+    bool matches(const schema& s) const {
+        return _state->schema_uuid == s.version();
+    }
+
+    // True when nothing but the caller (e.g. the sstables_manager cache)
+    // shares this translation anymore.
+    bool unused() const {
+        return _state.owned();
     }
 
     const std::vector<column_info>& regular_columns() const {
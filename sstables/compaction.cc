@@ -157,23 +157,65 @@ std::ostream& operator<<(std::ostream& os, pretty_printed_throughput tp) {
     return os;
 }
 
-static api::timestamp_type get_max_purgeable_timestamp(const column_family& cf, sstable_set::incremental_selector& selector,
-        const std::unordered_set<shared_sstable>& compacting_set, const dht::decorated_key& dk) {
-    auto timestamp = api::max_timestamp;
-    std::optional<utils::hashed_key> hk;
-    for (auto&& sst : boost::range::join(selector.select(dk).sstables, cf.compacted_undeleted_sstables())) {
-        if (compacting_set.contains(sst)) {
-            continue;
+// Answers up to which timestamp tombstones of a given partition may purge
+// data, by checking which other sstables may still hold that data.
+//
+// The selector returns the same set of overlapping sstables for every
+// position within one interval of the ring, so the candidate list -- the
+// non-compacting sstables sorted by min_timestamp -- is rebuilt only when the
+// compaction crosses into the next interval or when the compacting set
+// shrinks due to early input release. That leaves the bloom filter probes as
+// the only per-partition work, and those stop at the first hit: no sstable
+// after it in min_timestamp order can lower the result further.
+class max_purgeable_checker {
+    const column_family& _cf;
+    sstable_set::incremental_selector& _selector;
+    const std::unordered_set<shared_sstable>& _compacting_set;
+    std::optional<dht::ring_position_ext> _candidates_valid_until;
+    size_t _compacting_set_size = 0;
+    std::vector<shared_sstable> _candidates;
+public:
+    max_purgeable_checker(const column_family& cf, sstable_set::incremental_selector& selector,
+            const std::unordered_set<shared_sstable>& compacting_set)
+        : _cf(cf)
+        , _selector(selector)
+        , _compacting_set(compacting_set)
+    { }
+
+    api::timestamp_type max_purgeable_timestamp(const dht::decorated_key& dk) {
+        maybe_refresh_candidates(dk);
+        std::optional<utils::hashed_key> hk;
+        for (auto&& sst : _candidates) {
+            if (!hk) {
+                hk = sstables::sstable::make_hashed_key(*_cf.schema(), dk.key());
+            }
+            if (sst->filter_has_key(*hk)) {
+                return sst->get_stats_metadata().min_timestamp;
+            }
         }
-        if (!hk) {
-            hk = sstables::sstable::make_hashed_key(*cf.schema(), dk.key());
+        return api::max_timestamp;
+    }
+private:
+    void maybe_refresh_candidates(const dht::decorated_key& dk) {
+        if (_candidates_valid_until
+                && dht::ring_position_tri_compare(*_cf.schema(), dk, *_candidates_valid_until) < 0
+                && _compacting_set.size() == _compacting_set_size) {
+            return;
         }
-        if (sst->filter_has_key(*hk)) {
-            timestamp = std::min(timestamp, sst->get_stats_metadata().min_timestamp);
+        auto selection = _selector.select(dk);
+        _candidates_valid_until = dht::ring_position_ext(selection.next_position);
+        _compacting_set_size = _compacting_set.size();
+        _candidates.clear();
+        for (auto&& sst : boost::range::join(selection.sstables, _cf.compacted_undeleted_sstables())) {
+            if (!_compacting_set.contains(sst)) {
+                _candidates.push_back(sst);
+            }
         }
+        boost::sort(_candidates, [] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_stats_metadata().min_timestamp < b->get_stats_metadata().min_timestamp;
+        });
     }
-    return timestamp;
-}
+};
 
 static bool belongs_to_current_node(const dht::token& t, const dht::token_range_vector& sorted_owned_ranges) {
     auto low = std::lower_bound(sorted_owned_ranges.begin(), sorted_owned_ranges.end(), t,
@@ -301,6 +343,40 @@ public:
     void consume_end_of_stream();
 };
 
+// Adapts compacting_sstable_writer to consume the input stream directly,
+// without the merging and garbage-collecting mutation compactor in between.
+// Only used when every fragment would stream through the compactor unchanged
+// (see compaction::can_bypass_mutation_compactor()), in which case its
+// per-partition purgeability lookup against the sstable set and per-fragment
+// tombstone bookkeeping are all for nothing.
+class passthrough_sstable_writer {
+    compacting_sstable_writer _writer;
+public:
+    explicit passthrough_sstable_writer(compacting_sstable_writer writer) : _writer(std::move(writer)) {}
+
+    void consume_new_partition(const dht::decorated_key& dk) { _writer.consume_new_partition(dk); }
+    void consume(tombstone t) { _writer.consume(t); }
+    stop_iteration consume(static_row&& sr) {
+        _writer.consume(std::move(sr), tombstone(), true);
+        return stop_iteration::no;
+    }
+    stop_iteration consume(clustering_row&& cr) {
+        _writer.consume(std::move(cr), row_tombstone(), true);
+        return stop_iteration::no;
+    }
+    stop_iteration consume(range_tombstone&& rt) {
+        _writer.consume(std::move(rt));
+        return stop_iteration::no;
+    }
+    stop_iteration consume_end_of_partition() {
+        // The writer seals the output sstable here when it's full; the read
+        // itself always proceeds to the next partition.
+        _writer.consume_end_of_partition();
+        return stop_iteration::no;
+    }
+    void consume_end_of_stream() { _writer.consume_end_of_stream(); }
+};
+
 struct compaction_read_monitor_generator final : public read_monitor_generator {
     class compaction_read_monitor final : public  sstables::read_monitor, public backlog_read_progress_manager {
         sstables::shared_sstable _sst;
@@ -329,9 +405,9 @@ struct compaction_read_monitor_generator final : public read_monitor_generator {
 
         void remove_sstable(bool is_tracking) {
             if (is_tracking && _sst) {
-                _cf.get_compaction_strategy().get_backlog_tracker().remove_sstable(_sst);
+                _cf.get_compaction_strategy().get_backlog_tracker().remove_compacting_sstable(_sst, *this);
             } else if (_sst) {
-                _cf.get_compaction_strategy().get_backlog_tracker().revert_charges(_sst);
+                _cf.get_compaction_strategy().get_backlog_tracker().revert_compacting_charges(_sst, *this);
             }
             _sst = {};
         }
@@ -343,7 +419,7 @@ struct compaction_read_monitor_generator final : public read_monitor_generator {
             // We failed to finish handling this SSTable, so we have to update the backlog_tracker
             // about it.
             if (_sst) {
-                _cf.get_compaction_strategy().get_backlog_tracker().revert_charges(_sst);
+                _cf.get_compaction_strategy().get_backlog_tracker().revert_compacting_charges(_sst, *this);
             }
         }
 
@@ -489,6 +565,12 @@ protected:
     // used to incrementally calculate max purgeable timestamp, as we iterate through decorated keys.
     std::optional<sstable_set::incremental_selector> _selector;
     std::unordered_set<shared_sstable> _compacting_for_max_purgeable_func;
+    // Lazily engaged by max_purgeable_func(); dropped whenever the selector
+    // is recreated, so the cached candidates cannot outlive it.
+    std::optional<max_purgeable_checker> _purgeable_checker;
+    // Engaged when this compaction is a token-range sub-compaction of a larger job,
+    // restricting the input readers to its own slice of the token span.
+    std::optional<dht::partition_range> _range;
 protected:
     compaction(column_family& cf, compaction_descriptor descriptor)
         : _cf(cf)
@@ -505,6 +587,7 @@ protected:
         , _sstable_set(std::move(descriptor.all_sstables_snapshot))
         , _selector(_sstable_set ? _sstable_set->make_incremental_selector() : std::optional<sstable_set::incremental_selector>{})
         , _compacting_for_max_purgeable_func(std::unordered_set<shared_sstable>(_sstables.begin(), _sstables.end()))
+        , _range(std::move(descriptor.range))
     {
         _info->type = descriptor.options.type();
         _info->run_identifier = _run_identifier;
@@ -549,6 +632,9 @@ protected:
         });
         sstable_writer_config cfg = _cf.get_sstables_manager().configure_writer(std::move(s));
         cfg.max_sstable_size = _max_sstable_size;
+        // Output size is bounded by what goes in and by the size cap; good
+        // enough for extent preallocation (see sstable::create_data()).
+        cfg.estimated_output_size = std::min(_info->start_size, std::max<uint64_t>(_max_sstable_size, 1));
         cfg.monitor = &default_write_monitor();
         cfg.run_identifier = _run_identifier;
         cfg.replay_position = _rp;
@@ -577,6 +663,28 @@ protected:
     bool tombstone_expiration_enabled() const {
         return bool(_sstable_set);
     }
+
+    // True when the mutation compactor has no work to do for this job: each
+    // partition of non-overlapping inputs comes from a single sstable, so
+    // there are no duplicates to merge, and with no tombstones or expiring
+    // cells anywhere in the inputs there is nothing to purge either.
+    // A minimum local deletion time at the no-deletion sentinel guarantees
+    // the latter, since tombstones and TTLed cells all pull it down;
+    // formats that don't keep the field leave it at zero and stay on the
+    // regular path.
+    bool can_bypass_mutation_compactor() const {
+        auto nothing_purgeable = std::all_of(_sstables.begin(), _sstables.end(), [] (const shared_sstable& sst) {
+            return sst->get_stats_metadata().min_local_deletion_time == std::numeric_limits<int32_t>::max();
+        });
+        if (!nothing_purgeable) {
+            return false;
+        }
+        auto sorted = _sstables;
+        std::sort(sorted.begin(), sorted.end(), [this] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_first_decorated_key().tri_compare(*_schema, b->get_first_decorated_key()) < 0;
+        });
+        return sstable_set_overlapping_count(_schema, sorted) == 0;
+    }
 public:
     compaction& operator=(const compaction&) = delete;
     compaction(const compaction&) = delete;
@@ -653,6 +761,18 @@ private:
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
         auto now = gc_clock::now();
+        if constexpr (std::is_same_v<GCConsumer, noop_compacted_fragments_consumer>) {
+            if (can_bypass_mutation_compactor()) {
+                log_debug("Input is non-overlapping and contains nothing purgeable, writing it through unchanged");
+                auto consumer = make_interposer_consumer([this] (flat_mutation_reader reader) mutable {
+                    return seastar::async([this, reader = std::move(reader)] () mutable {
+                        auto close_reader = deferred_close(reader);
+                        reader.consume_in_thread(passthrough_sstable_writer(get_compacting_sstable_writer()), db::no_timeout);
+                    });
+                });
+                return consumer(make_sstable_reader());
+            }
+        }
         auto consumer = make_interposer_consumer([this, gc_consumer = std::move(gc_consumer), now] (flat_mutation_reader reader) mutable
         {
             return seastar::async([this, reader = std::move(reader), gc_consumer = std::move(gc_consumer), now] () mutable {
@@ -720,7 +840,10 @@ private:
             };
         }
         return [this] (const dht::decorated_key& dk) {
-            return get_max_purgeable_timestamp(_cf, *_selector, _compacting_for_max_purgeable_func, dk);
+            if (!_purgeable_checker) {
+                _purgeable_checker.emplace(_cf, *_selector, _compacting_for_max_purgeable_func);
+            }
+            return _purgeable_checker->max_purgeable_timestamp(dk);
         };
     }
 
@@ -794,7 +917,21 @@ public:
     bool enable_garbage_collected_sstable_writer() const {
         // FIXME: Disable GC writer if interposer consumer is enabled until they both can work simultaneously.
         // More details can be found at https://github.com/scylladb/scylla/issues/6472
-        return _contains_multi_fragment_runs && !use_interposer_consumer();
+        // The writer only pays off together with early sstable replacement, which
+        // token-range sub-compactions cannot do, so it is disabled for them too.
+        return _contains_multi_fragment_runs && !use_interposer_consumer() && !_range;
+    }
+
+    bool enable_release_exhausted_sstables_early() const {
+        // An input sstable is exhausted once a sealed output covers its last key,
+        // which only holds if a single writer consumes the merged stream in token
+        // order. Interposer consumers keep several writers open at once, so data
+        // from an exhausted input may still sit in an unsealed output; keep all
+        // inputs until the end of compaction in that case.
+        // A token-range sub-compaction consumes only its own slice of each input,
+        // which is still needed by its siblings; inputs are released by the
+        // replacement of the last sub-compaction to finish.
+        return !use_interposer_consumer() && !_range;
     }
 
     template <typename GCConsumer = noop_compacted_fragments_consumer>
@@ -924,7 +1061,7 @@ public:
     flat_mutation_reader make_sstable_reader() const override {
         return _compacting->make_local_shard_sstable_reader(_schema,
                 _permit,
-                query::full_partition_range,
+                _range ? *_range : query::full_partition_range,
                 _schema->full_slice(),
                 _io_priority,
                 tracing::trace_state_ptr(),
@@ -1003,9 +1140,7 @@ private:
     }
 
     void maybe_replace_exhausted_sstables_by_sst(shared_sstable sst) {
-        // Skip earlier replacement of exhausted sstables if compaction works with only single-fragment runs,
-        // meaning incremental compaction is disabled for this compaction.
-        if (!enable_garbage_collected_sstable_writer()) {
+        if (!enable_release_exhausted_sstables_early()) {
             return;
         }
         // Replace exhausted sstable(s), if any, by new one(s) in the column family.
@@ -1071,6 +1206,7 @@ private:
             }
         }
         _selector.emplace(_sstable_set->make_incremental_selector());
+        _purgeable_checker.reset();
         _info->pending_replacements.clear();
     }
 };
@@ -1539,6 +1675,51 @@ compaction_type compaction_options::type() const {
     return index_to_type[_options.index()];
 }
 
+std::vector<compaction_descriptor> compaction_descriptor::split() const {
+    if (sub_compactions <= 1) {
+        return { *this };
+    }
+    // Interpolate the boundaries over the token span of the inputs, which gives
+    // each sub-compaction roughly even amounts of data with the partitioners we
+    // support, all of which distribute keys uniformly over the token space.
+    auto first = std::numeric_limits<int64_t>::max();
+    auto last = std::numeric_limits<int64_t>::min();
+    for (auto& sst : sstables) {
+        first = std::min(first, sst->get_first_decorated_key().token().raw());
+        last = std::max(last, sst->get_last_decorated_key().token().raw());
+    }
+    const auto step = (uint64_t(last) - uint64_t(first)) / sub_compactions;
+    if (!step) {
+        // All inputs sit on nearly the same token; nothing to split by range.
+        auto desc = *this;
+        desc.sub_compactions = 1;
+        return { std::move(desc) };
+    }
+    std::vector<compaction_descriptor> ret;
+    ret.reserve(sub_compactions);
+    std::optional<dht::token> prev_boundary;
+    for (unsigned i = 0; i < sub_compactions; ++i) {
+        std::optional<dht::token_range::bound> start;
+        std::optional<dht::token_range::bound> end;
+        if (prev_boundary) {
+            start.emplace(*prev_boundary, false);
+        }
+        // Outermost sub-compactions get open-ended ranges so that no input
+        // data can fall off the span estimated above.
+        if (i + 1 < sub_compactions) {
+            auto boundary = dht::token::from_int64(int64_t(uint64_t(first) + step * (i + 1)));
+            end.emplace(boundary, true);
+            prev_boundary = boundary;
+        }
+        auto desc = *this;
+        desc.range = dht::to_partition_range(dht::token_range(std::move(start), std::move(end)));
+        desc.sub_compactions = 1;
+        desc.run_identifier = utils::make_random_uuid();
+        ret.push_back(std::move(desc));
+    }
+    return ret;
+}
+
 static std::unique_ptr<compaction> make_compaction(column_family& cf, sstables::compaction_descriptor descriptor) {
     struct {
         column_family& cf;
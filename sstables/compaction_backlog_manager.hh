@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 #include <memory>
 #include <seastar/core/shared_ptr.hh>
 #include "shared_sstable.hh"
@@ -88,10 +91,50 @@ public:
     void add_sstable(sstables::shared_sstable sst);
     void remove_sstable(sstables::shared_sstable sst);
     void register_partially_written_sstable(sstables::shared_sstable sst, backlog_write_progress_manager& wp);
+    // May be called more than once for the same sstable, by token-range sub-compactions
+    // of a single job. The strategy tracker is presented with a single ongoing
+    // compaction whose progress is the sum of all registered readers.
     void register_compacting_sstable(sstables::shared_sstable sst, backlog_read_progress_manager& rp);
+    // Deregisters one reader of sst; behaves like remove_sstable() once the last one is gone.
+    void remove_compacting_sstable(sstables::shared_sstable sst, backlog_read_progress_manager& rp);
+    // Deregisters one reader of sst; behaves like revert_charges() once the last one is gone.
+    void revert_compacting_charges(sstables::shared_sstable sst, backlog_read_progress_manager& rp);
     void transfer_ongoing_charges(compaction_backlog_tracker& new_bt, bool move_read_charges = true);
     void revert_charges(sstables::shared_sstable sst);
 private:
+    // Merges the read progress of the token-range sub-compactions of one job, which
+    // register the same sstable once each. Progress of finished sub-compactions is
+    // retained until the last one deregisters, to avoid valleys in the backlog.
+    class merged_read_progress final : public backlog_read_progress_manager {
+        std::vector<const backlog_read_progress_manager*> _readers;
+        uint64_t _retired = 0;
+    public:
+        virtual uint64_t compacted() const override {
+            auto compacted = _retired;
+            for (auto* rp : _readers) {
+                compacted += rp->compacted();
+            }
+            return compacted;
+        }
+        void add(const backlog_read_progress_manager& rp) {
+            _readers.push_back(&rp);
+        }
+        void remove(const backlog_read_progress_manager& rp) {
+            auto it = std::find(_readers.begin(), _readers.end(), &rp);
+            if (it != _readers.end()) {
+                _retired += (*it)->compacted();
+                _readers.erase(it);
+            }
+        }
+        size_t readers() const {
+            return _readers.size();
+        }
+    };
+
+    // Returns true if rp was the last reader of sst, meaning the sstable can be
+    // removed from the tracker.
+    bool deregister_reader(const sstables::shared_sstable& sst, backlog_read_progress_manager& rp);
+
     // Returns true if this SSTable can be added or removed from the tracker.
     bool sstable_belongs_to_tracker(const sstables::shared_sstable& sst);
 
@@ -99,6 +142,7 @@ private:
         _disabled = true;
         _ongoing_writes = {};
         _ongoing_compactions = {};
+        _merged_reads = {};
     }
     bool _disabled = false;
     std::unique_ptr<impl> _impl;
@@ -106,6 +150,9 @@ private:
     // changed in the middle of a compaction.
     ongoing_writes _ongoing_writes;
     ongoing_compactions _ongoing_compactions;
+    // Keyed by sstables with more than one registered reader; the corresponding
+    // _ongoing_compactions entry points at the merged progress.
+    std::unordered_map<sstables::shared_sstable, std::unique_ptr<merged_read_progress>> _merged_reads;
     compaction_backlog_manager* _manager = nullptr;
     friend class compaction_backlog_manager;
 };
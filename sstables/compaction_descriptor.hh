@@ -24,6 +24,7 @@
 
 #include <functional>
 #include <optional>
+#include <unordered_set>
 #include <variant>
 #include <seastar/core/smp.hh>
 #include <seastar/core/file.hh>
@@ -148,6 +149,31 @@ struct compaction_descriptor {
     // This also selects the kind of compaction to do.
     compaction_options options = compaction_options::make_regular();
 
+    // Set by the compaction strategy when the output is expected to be rarely
+    // read again, e.g. data compacted entirely out of the most recent time
+    // window. The table may then place the output on the capacity tier (the
+    // last configured data directory) when more than one is configured.
+    bool cold_tier = false;
+
+    // Number of token-range sub-compactions this job should be split into,
+    // all executed concurrently on the same shard. Set to more than 1 only
+    // for jobs large enough that a single merge fiber would leave the disk
+    // underutilized. See split().
+    unsigned sub_compactions = 1;
+
+    // Engaged when this descriptor is a token-range sub-compaction of a
+    // larger job: restricts the input readers to the given range. The job's
+    // inputs are replaced only by the last sub-compaction to finish, see
+    // table::compact_sstables().
+    std::optional<dht::partition_range> range;
+
+    // Engaged for jobs that checkpoint per-sub-compaction progress in the
+    // system keyspace (major compactions). Holds the indexes, within split(),
+    // of sub-compactions that already sealed their output in an interrupted
+    // earlier run of the same job over the same inputs; those are skipped on
+    // resume. See table::compact_sstables_in_parallel().
+    std::optional<std::unordered_set<int32_t>> checkpoints;
+
     compaction_sstable_creator_fn creator;
     compaction_sstable_replacer_fn replacer;
 
@@ -173,6 +199,11 @@ struct compaction_descriptor {
         , options(options)
         , io_priority(io_priority)
     {}
+
+    // Splits this job into sub_compactions token-range sub-compactions
+    // covering disjoint slices of the input's token span, each with its own
+    // run identifier. Returns the job unsplit if it's not worth splitting.
+    std::vector<compaction_descriptor> split() const;
 };
 
 }
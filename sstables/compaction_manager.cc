@@ -25,6 +25,8 @@
 #include "sstables/sstables.hh"
 #include "sstables/sstables_manager.hh"
 #include "database.hh"
+#include "db/system_keyspace.hh"
+#include "db/query_context.hh"
 #include "service/storage_service.hh"
 #include <seastar/core/metrics.hh>
 #include "exceptions.hh"
@@ -230,6 +232,58 @@ private:
     virtual void remove_sstable(sstables::shared_sstable sst)  override { }
 };
 
+future<sstables::compaction_descriptor> compaction_manager::maybe_resume_from_checkpoint(column_family* cf, sstables::compaction_descriptor descriptor) {
+    // Checkpoints live in the system keyspace; skip when running without a
+    // query context, for example, in a test case.
+    if (!db::qctx) {
+        return make_ready_future<sstables::compaction_descriptor>(std::move(descriptor));
+    }
+    auto s = cf->schema();
+    return db::system_keyspace::get_compaction_checkpoint(s->ks_name(), s->cf_name()).then(
+            [s, descriptor = std::move(descriptor)] (std::optional<db::system_keyspace::compaction_checkpoint> ckpt) mutable {
+        if (descriptor.sub_compactions > 1) {
+            // Arms checkpointing of this job's sub-compactions,
+            // see table::compact_sstables_in_parallel().
+            descriptor.checkpoints.emplace();
+        }
+        if (!ckpt || ckpt->completed.empty()) {
+            return make_ready_future<sstables::compaction_descriptor>(std::move(descriptor));
+        }
+        auto stale = [&s, &descriptor] (sstring_view reason) {
+            cmlog.info("Discarding stale major compaction checkpoint of {}.{}: {}", s->ks_name(), s->cf_name(), reason);
+            return db::system_keyspace::remove_compaction_checkpoint(s->ks_name(), s->cf_name()).then([descriptor = std::move(descriptor)] () mutable {
+                return make_ready_future<sstables::compaction_descriptor>(std::move(descriptor));
+            });
+        };
+        if (ckpt->sub_compactions <= 1 || ckpt->completed.size() >= size_t(ckpt->sub_compactions)) {
+            return stale("inconsistent sub-compaction count");
+        }
+        // The checkpoint can only be finished over exactly the inputs it was
+        // taken against: outputs sealed by the interrupted run and sstables
+        // written since then already hold their data for the completed ranges
+        // and must stay out of this job.
+        std::unordered_map<int64_t, sstables::shared_sstable> candidates_by_generation;
+        for (auto& sst : descriptor.sstables) {
+            candidates_by_generation.emplace(sst->generation(), sst);
+        }
+        std::vector<sstables::shared_sstable> inputs;
+        inputs.reserve(ckpt->inputs.size());
+        for (auto generation : ckpt->inputs) {
+            auto it = candidates_by_generation.find(generation);
+            if (it == candidates_by_generation.end()) {
+                return stale(format("input sstable {} is gone", generation));
+            }
+            inputs.push_back(it->second);
+        }
+        cmlog.info("Resuming major compaction of {}.{} from checkpoint, {} of {} token ranges already compacted",
+                s->ks_name(), s->cf_name(), ckpt->completed.size(), ckpt->sub_compactions);
+        descriptor.sstables = std::move(inputs);
+        descriptor.sub_compactions = ckpt->sub_compactions;
+        descriptor.checkpoints = std::move(ckpt->completed);
+        return make_ready_future<sstables::compaction_descriptor>(std::move(descriptor));
+    });
+}
+
 future<> compaction_manager::submit_major_compaction(column_family* cf) {
     if (_state != state::enabled) {
         return make_ready_future<>();
@@ -252,19 +306,36 @@ future<> compaction_manager::submit_major_compaction(column_family* cf) {
             // those are eligible for major compaction.
             sstables::compaction_strategy cs = cf->get_compaction_strategy();
             sstables::compaction_descriptor descriptor = cs.get_major_compaction_job(*cf, get_candidates(*cf));
-            auto compacting = make_lw_shared<compacting_sstable_registration>(this, descriptor.sstables);
-            descriptor.release_exhausted = [compacting] (const std::vector<sstables::shared_sstable>& exhausted_sstables) {
-                compacting->release_compacting(exhausted_sstables);
-            };
+            // A major compaction job spans most of the table, and a single merge
+            // fiber rarely comes close to saturating the disk. Split the job into
+            // token-range sub-compactions running concurrently on this shard,
+            // keeping each of them large enough that the extra seal/replace work
+            // stays in the noise. The compaction I/O class bounds their aggregate
+            // disk usage like it would a single fiber's.
+            static constexpr uint64_t major_sub_compaction_min_size = 1UL << 30;
+            static constexpr uint64_t major_sub_compactions_max = 4;
+            descriptor.sub_compactions = std::min(major_sub_compactions_max,
+                    std::max<uint64_t>(1, get_total_size(descriptor.sstables) / major_sub_compaction_min_size));
+            // An interrupted major left behind a checkpoint; pick up from the
+            // last sealed token range of the same job instead of starting over.
+            return maybe_resume_from_checkpoint(cf, std::move(descriptor)).then([this, task, cf] (sstables::compaction_descriptor descriptor) {
+                if (!can_proceed(task)) {
+                    return make_ready_future<>();
+                }
+                auto compacting = make_lw_shared<compacting_sstable_registration>(this, descriptor.sstables);
+                descriptor.release_exhausted = [compacting] (const std::vector<sstables::shared_sstable>& exhausted_sstables) {
+                    compacting->release_compacting(exhausted_sstables);
+                };
 
-            cmlog.info0("User initiated compaction started on behalf of {}.{}", cf->schema()->ks_name(), cf->schema()->cf_name());
-            compaction_backlog_tracker user_initiated(std::make_unique<user_initiated_backlog_tracker>(_compaction_controller.backlog_of_shares(200), _available_memory));
-            return do_with(std::move(user_initiated), [this, cf, descriptor = std::move(descriptor)] (compaction_backlog_tracker& bt) mutable {
-                register_backlog_tracker(bt);
-                return with_scheduling_group(_scheduling_group, [this, cf, descriptor = std::move(descriptor)] () mutable {
-                    return cf->compact_sstables(std::move(descriptor));
-                });
-            }).then([compacting = std::move(compacting)] {});
+                cmlog.info0("User initiated compaction started on behalf of {}.{}", cf->schema()->ks_name(), cf->schema()->cf_name());
+                compaction_backlog_tracker user_initiated(std::make_unique<user_initiated_backlog_tracker>(_compaction_controller.backlog_of_shares(200), _available_memory));
+                return do_with(std::move(user_initiated), [this, cf, descriptor = std::move(descriptor)] (compaction_backlog_tracker& bt) mutable {
+                    register_backlog_tracker(bt);
+                    return with_scheduling_group(_scheduling_group, [this, cf, descriptor = std::move(descriptor)] () mutable {
+                        return cf->compact_sstables(std::move(descriptor));
+                    });
+                }).then([compacting = std::move(compacting)] {});
+            });
         });
     }).then_wrapped([this, task] (future<> f) {
         _stats.active_tasks--;
@@ -918,6 +989,7 @@ void compaction_backlog_tracker::remove_sstable(sstables::shared_sstable sst) {
     }
 
     _ongoing_compactions.erase(sst);
+    _merged_reads.erase(sst);
     try {
         _impl->remove_sstable(std::move(sst));
     } catch (...) {
@@ -951,12 +1023,48 @@ void compaction_backlog_tracker::register_compacting_sstable(sstables::shared_ss
     }
 
     try {
-        _ongoing_compactions.emplace(sst, &rp);
+        auto [it, inserted] = _ongoing_compactions.emplace(sst, &rp);
+        if (!inserted) {
+            // Another sub-compaction of the same job is already reading this
+            // sstable; merge both progresses under a single entry.
+            auto& merged = _merged_reads[sst];
+            if (!merged) {
+                merged = std::make_unique<merged_read_progress>();
+                merged->add(*it->second);
+                it->second = merged.get();
+            }
+            merged->add(rp);
+        }
     } catch (...) {
         cmlog.warn("backlog tracker couldn't register partially compacting SSTable to exception {}", std::current_exception());
     }
 }
 
+bool compaction_backlog_tracker::deregister_reader(const sstables::shared_sstable& sst, backlog_read_progress_manager& rp) {
+    auto it = _merged_reads.find(sst);
+    if (it == _merged_reads.end()) {
+        return true;
+    }
+    it->second->remove(rp);
+    if (it->second->readers()) {
+        return false;
+    }
+    _merged_reads.erase(it);
+    return true;
+}
+
+void compaction_backlog_tracker::remove_compacting_sstable(sstables::shared_sstable sst, backlog_read_progress_manager& rp) {
+    if (deregister_reader(sst, rp)) {
+        remove_sstable(std::move(sst));
+    }
+}
+
+void compaction_backlog_tracker::revert_compacting_charges(sstables::shared_sstable sst, backlog_read_progress_manager& rp) {
+    if (deregister_reader(sst, rp)) {
+        revert_charges(std::move(sst));
+    }
+}
+
 void compaction_backlog_tracker::transfer_ongoing_charges(compaction_backlog_tracker& new_bt, bool move_read_charges) {
     for (auto&& w : _ongoing_writes) {
         new_bt.register_partially_written_sstable(w.first, *w.second);
@@ -966,14 +1074,19 @@ void compaction_backlog_tracker::transfer_ongoing_charges(compaction_backlog_tra
         for (auto&& w : _ongoing_compactions) {
             new_bt.register_compacting_sstable(w.first, *w.second);
         }
+        // Merged progress objects are pointed at by the entries moved above,
+        // so their ownership must follow the charges.
+        new_bt._merged_reads = std::move(_merged_reads);
     }
     _ongoing_writes = {};
     _ongoing_compactions = {};
+    _merged_reads = {};
 }
 
 void compaction_backlog_tracker::revert_charges(sstables::shared_sstable sst) {
     _ongoing_writes.erase(sst);
     _ongoing_compactions.erase(sst);
+    _merged_reads.erase(sst);
 }
 
 compaction_backlog_tracker::~compaction_backlog_tracker() {
@@ -162,6 +162,12 @@ private:
 
     using get_candidates_func = std::function<std::vector<sstables::shared_sstable>(const column_family&)>;
 
+    // Major compactions are checkpointed in the system keyspace as their
+    // token-range sub-compactions complete. Returns the descriptor adjusted
+    // to resume from the persisted checkpoint when a valid one exists, or
+    // unchanged (apart from arming checkpointing) otherwise.
+    future<sstables::compaction_descriptor> maybe_resume_from_checkpoint(column_family* cf, sstables::compaction_descriptor descriptor);
+
     future<> rewrite_sstables(column_family* cf, sstables::compaction_options options, get_candidates_func);
 
     future<> stop_ongoing_compactions(sstring reason);
@@ -174,6 +180,12 @@ public:
 
     void register_metrics();
 
+    // Re-applies the compaction_static_shares setting after a configuration
+    // reload. A no-op unless the manager was created with static shares.
+    void update_static_shares(float shares) {
+        _compaction_controller.update_static_shares(shares);
+    }
+
     // enable/disable compaction manager.
     void enable();
     void disable();
@@ -21,12 +21,15 @@
 
 #include <stdexcept>
 #include <cstdlib>
+#include <deque>
 
 #include <boost/range/algorithm/find_if.hpp>
 #include <seastar/core/align.hh>
 #include <seastar/core/bitops.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/memory.hh>
 
 #include "../compress.hh"
 #include "compress.hh"
@@ -239,6 +242,7 @@ void compression::segmented_offsets::push_back(uint64_t offset, compression::seg
  */
 class local_compression {
     compressor_ptr _compressor;
+    ::compressor::dict_ptr _dict;
 public:
     local_compression()= default;
     local_compression(const compression&);
@@ -250,6 +254,18 @@ public:
                     size_t output_len) const;
     size_t compress_max_size(size_t input_len) const;
 
+    bool can_use_dictionaries() const {
+        return _compressor && _compressor->supports_dictionaries();
+    }
+    bytes train_dictionary(const std::vector<bytes>& samples, size_t max_dict_size) const {
+        return _compressor->train_dictionary(samples, max_dict_size);
+    }
+    // Digests a raw dictionary and routes subsequent compress()/uncompress()
+    // calls through it.
+    void adopt_dictionary(bytes_view raw) {
+        _dict = _compressor->make_dictionary(raw);
+    }
+
     operator bool() const {
         return _compressor != nullptr;
     }
@@ -280,13 +296,22 @@ local_compression::local_compression(const compression& c)
             return std::nullopt;
         });
     }())
-{}
+{
+    if (can_use_dictionaries()) {
+        if (auto d = c.dictionary()) {
+            adopt_dictionary(*d);
+        }
+    }
+}
 
 size_t local_compression::uncompress(const char* input,
                 size_t input_len, char* output, size_t output_len) const {
     if (!_compressor) {
         throw std::runtime_error("uncompress is not supported");
     }
+    if (_dict) {
+        return _compressor->uncompress(input, input_len, output, output_len, *_dict);
+    }
     return _compressor->uncompress(input, input_len, output, output_len);
 }
 size_t local_compression::compress(const char* input, size_t input_len,
@@ -294,12 +319,31 @@ size_t local_compression::compress(const char* input, size_t input_len,
     if (!_compressor) {
         throw std::runtime_error("compress is not supported");
     }
+    if (_dict) {
+        return _compressor->compress(input, input_len, output, output_len, *_dict);
+    }
     return _compressor->compress(input, input_len, output, output_len);
 }
 size_t local_compression::compress_max_size(size_t input_len) const {
     return _compressor ? _compressor->compress_max_size(input_len) : 0;
 }
 
+static const sstring dictionary_option_name = "sstable_compression_dictionary";
+
+std::optional<bytes_view> compression::dictionary() const {
+    for (auto& o : options.elements) {
+        if (sstring(o.key.value.begin(), o.key.value.end()) == dictionary_option_name) {
+            return bytes_view(o.value.value);
+        }
+    }
+    return std::nullopt;
+}
+
+void compression::set_dictionary(bytes_view dict) {
+    options.elements.push_back({bytes(dictionary_option_name.begin(), dictionary_option_name.end()),
+            bytes(dict.begin(), dict.end())});
+}
+
 void compression::set_compressor(compressor_ptr c) {
     if (c) {
         unqualified_name uqn(compressor::namespace_prefix, c->name());
@@ -319,6 +363,69 @@ void compression::update(uint64_t compressed_file_length) {
     _compressed_file_length = compressed_file_length;
 }
 
+compression::~compression() {
+    uncompressed_chunk_cache::shard().remove(this);
+}
+
+uncompressed_chunk_cache& uncompressed_chunk_cache::shard() {
+    static thread_local uncompressed_chunk_cache instance;
+    return instance;
+}
+
+size_t uncompressed_chunk_cache::budget() const {
+    // Decompressed chunks are a second-order cache (behind the row cache),
+    // so keep them on a short leash.
+    return seastar::memory::stats().total_memory() / 50;
+}
+
+void uncompressed_chunk_cache::evict_one() noexcept {
+    entry& victim = _lru.back();
+    ++_stats.evictions;
+    _stats.used_bytes -= victim.data.size();
+    victim.lru_link.unlink();
+    _entries.erase(victim.key);
+}
+
+std::optional<temporary_buffer<char>> uncompressed_chunk_cache::get(const compression* cm, uint64_t chunk_start) {
+    auto it = _entries.find(key_type{cm, chunk_start});
+    if (it == _entries.end()) {
+        ++_stats.misses;
+        return std::nullopt;
+    }
+    ++_stats.hits;
+    entry& e = *it->second;
+    e.lru_link.unlink();
+    _lru.push_front(e);
+    return e.data.share();
+}
+
+void uncompressed_chunk_cache::put(const compression* cm, uint64_t chunk_start, temporary_buffer<char> data) {
+    key_type key{cm, chunk_start};
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        return; // Concurrent readers may race to decompress the same chunk.
+    }
+    _stats.used_bytes += data.size();
+    auto e = std::make_unique<entry>(entry{key, std::move(data)});
+    _lru.push_front(*e);
+    _entries.emplace(key, std::move(e));
+    while (_stats.used_bytes > budget() && !_lru.empty()) {
+        evict_one();
+    }
+}
+
+void uncompressed_chunk_cache::remove(const compression* cm) noexcept {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (it->first.owner == cm) {
+            _stats.used_bytes -= it->second->data.size();
+            it->second->lru_link.unlink();
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 compressor_ptr get_sstable_compressor(const compression& c) {
     return local_compression(c).compressor();
 }
@@ -354,6 +461,24 @@ class compressed_file_data_source_impl : public data_source_impl {
     uint64_t _pos;
     uint64_t _beg_pos;
     uint64_t _end_pos;
+    // Decompress-ahead pipeline for forward scans (see maybe_fill()). While
+    // the consumer parses one chunk we read and decompress up to
+    // _readahead_depth upcoming chunks in the background, so multi-chunk
+    // scans do not serialize I/O wait with parsing. Point reads (requests
+    // confined to a single chunk) keep going through the shard chunk cache
+    // instead; the pipeline deliberately bypasses the cache so that scans
+    // do not flush it.
+    struct ready_chunk {
+        uint64_t pos; // uncompressed position of the chunk start
+        temporary_buffer<char> data;
+    };
+    std::deque<ready_chunk> _ready;
+    unsigned _readahead_depth = 0;
+    uint64_t _fill_pos = 0;
+    bool _fill_active = false;
+    bool _stopping = false;
+    std::optional<promise<>> _fill_done;
+    std::exception_ptr _fill_ex;
 public:
     compressed_file_data_source_impl(file f, sstables::compression* cm,
                 uint64_t pos, size_t len, file_input_stream_options options)
@@ -380,6 +505,13 @@ public:
         // and open a file_input_stream to read that range.
         auto start = _compression_metadata->locate(_beg_pos, _offsets);
         auto end = _compression_metadata->locate(_end_pos - 1, _offsets);
+        if (options.read_ahead && end.chunk_start != start.chunk_start) {
+            // The request spans several chunks, so treat it as a forward
+            // scan and run the decompress-ahead pipeline as deep as the
+            // caller's readahead setting.
+            _readahead_depth = options.read_ahead;
+            _fill_pos = _beg_pos;
+        }
         _input_stream = make_file_input_stream(std::move(f),
                 start.chunk_start,
                 end.chunk_start + end.chunk_len - start.chunk_start,
@@ -387,43 +519,133 @@ public:
         _underlying_pos = start.chunk_start;
         _pos = _beg_pos;
     }
+    // Reads, verifies and decompresses the whole chunk at addr, leaving the
+    // underlying stream right past it. If earlier chunks were skipped over,
+    // the stream is resynced first.
+    future<temporary_buffer<char>> read_chunk(sstables::compression::chunk_and_offset addr) {
+        auto resync = (addr.chunk_start != _underlying_pos)
+                ? _input_stream->skip(addr.chunk_start - _underlying_pos)
+                : make_ready_future<>();
+        return resync.then([this, addr] {
+            _underlying_pos = addr.chunk_start;
+            return _input_stream->read_exactly(addr.chunk_len);
+        }).then([this, addr](temporary_buffer<char> buf) {
+            // The last 4 bytes of the chunk are the adler32/crc32 checksum
+            // of the rest of the (compressed) chunk.
+            auto compressed_len = addr.chunk_len - 4;
+            // FIXME: Do not always calculate checksum - Cassandra has a
+            // probability (defaulting to 1.0, but still...)
+            auto checksum = read_be<uint32_t>(buf.get() + compressed_len);
+            if (checksum != ChecksumType::checksum(buf.get(), compressed_len)) {
+                throw std::runtime_error("compressed chunk failed checksum");
+            }
+
+            // We know that the uncompressed data will take exactly
+            // chunk_length bytes (or less, if reading the last chunk).
+            temporary_buffer<char> out(
+                    _compression_metadata->uncompressed_chunk_length());
+            // The compressed data is the whole chunk, minus the last 4
+            // bytes (which contain the checksum verified above).
+
+            auto len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
+
+            out.trim(len);
+            _underlying_pos += addr.chunk_len;
+            return out;
+        });
+    }
+
+    // Starts a background read of the next chunk unless the pipeline is
+    // already full (or a read is already in flight). Re-arms itself after
+    // each chunk, so once primed the pipeline keeps _readahead_depth
+    // decompressed chunks ahead of the consumer.
+    void maybe_fill() {
+        if (_fill_active || _stopping || _fill_ex
+                || _ready.size() >= _readahead_depth || _fill_pos >= _end_pos) {
+            return;
+        }
+        if (_ready.empty() && _fill_pos < _pos) {
+            // A skip() jumped past the pipeline head; read_chunk() will
+            // resync the underlying stream.
+            _fill_pos = _pos;
+        }
+        _fill_active = true;
+        auto addr = _compression_metadata->locate(_fill_pos, _offsets);
+        // The continuation is detached; close() waits for it via _fill_done.
+        (void)futurize_invoke([this, addr] {
+            return read_chunk(addr);
+        }).then_wrapped([this, addr] (future<temporary_buffer<char>> f) {
+            _fill_active = false;
+            try {
+                auto out = f.get0();
+                auto chunk_pos = _fill_pos - addr.offset;
+                _fill_pos = chunk_pos + out.size();
+                _ready.push_back(ready_chunk{chunk_pos, std::move(out)});
+            } catch (...) {
+                _fill_ex = std::current_exception();
+            }
+            if (_fill_done) {
+                _fill_done->set_value();
+                _fill_done.reset();
+            }
+            maybe_fill();
+        });
+    }
+
+    future<temporary_buffer<char>> get_pipelined() {
+        // Drop chunks a skip() made stale while a fill was in flight.
+        while (!_ready.empty() && _ready.front().pos + _ready.front().data.size() <= _pos) {
+            _ready.pop_front();
+        }
+        if (_ready.empty()) {
+            if (_fill_ex) {
+                return make_exception_future<temporary_buffer<char>>(std::exchange(_fill_ex, {}));
+            }
+            maybe_fill();
+            _fill_done.emplace();
+            return _fill_done->get_future().then([this] {
+                return get_pipelined();
+            });
+        }
+        auto chunk = std::move(_ready.front());
+        _ready.pop_front();
+        auto out = std::move(chunk.data);
+        out.trim_front(_pos - chunk.pos);
+        _pos += out.size();
+        maybe_fill();
+        return make_ready_future<temporary_buffer<char>>(std::move(out));
+    }
+
     virtual future<temporary_buffer<char>> get() override {
         if (_pos >= _end_pos) {
             return make_ready_future<temporary_buffer<char>>();
         }
+        if (_readahead_depth) {
+            return get_pipelined();
+        }
         auto addr = _compression_metadata->locate(_pos, _offsets);
         // Uncompress the next chunk. We need to skip part of the first
         // chunk, but then continue to read from beginning of chunks.
         if (_pos != _beg_pos && addr.offset != 0) {
             throw std::runtime_error("compressed reader out of sync");
         }
-        return _input_stream->read_exactly(addr.chunk_len).
-            then([this, addr](temporary_buffer<char> buf) {
-                // The last 4 bytes of the chunk are the adler32/crc32 checksum
-                // of the rest of the (compressed) chunk.
-                auto compressed_len = addr.chunk_len - 4;
-                // FIXME: Do not always calculate checksum - Cassandra has a
-                // probability (defaulting to 1.0, but still...)
-                auto checksum = read_be<uint32_t>(buf.get() + compressed_len);
-                if (checksum != ChecksumType::checksum(buf.get(), compressed_len)) {
-                    throw std::runtime_error("compressed chunk failed checksum");
-                }
-
-                // We know that the uncompressed data will take exactly
-                // chunk_length bytes (or less, if reading the last chunk).
-                temporary_buffer<char> out(
-                        _compression_metadata->uncompressed_chunk_length());
-                // The compressed data is the whole chunk, minus the last 4
-                // bytes (which contain the checksum verified above).
-
-                auto len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
-
-                out.trim(len);
-                out.trim_front(addr.offset);
-                _pos += out.size();
-                _underlying_pos += addr.chunk_len;
-
-                return out;
+        if (auto cached = uncompressed_chunk_cache::shard().get(_compression_metadata, addr.chunk_start)) {
+            // Serve the chunk zero-copy from the shard cache, skipping both
+            // the read and the decompression. The underlying stream is kept
+            // in sync so the next miss continues from the right place.
+            auto out = std::move(*cached);
+            out.trim_front(addr.offset);
+            _pos += out.size();
+            _underlying_pos += addr.chunk_len;
+            return _input_stream->skip(addr.chunk_len).then([out = std::move(out)] () mutable {
+                return std::move(out);
+            });
+        }
+        return read_chunk(addr).then([this, addr](temporary_buffer<char> out) {
+            uncompressed_chunk_cache::shard().put(_compression_metadata, addr.chunk_start, out.share());
+            out.trim_front(addr.offset);
+            _pos += out.size();
+            return out;
         });
     }
 
@@ -431,12 +653,28 @@ public:
         if (!_input_stream) {
             return make_ready_future<>();
         }
-        return _input_stream->close();
+        _stopping = true;
+        auto drained = make_ready_future<>();
+        if (_fill_active) {
+            _fill_done.emplace();
+            drained = _fill_done->get_future();
+        }
+        return drained.then([this] {
+            return _input_stream->close();
+        });
     }
 
     virtual future<temporary_buffer<char>> skip(uint64_t n) override {
         _pos += n;
         assert(_pos <= _end_pos);
+        if (_readahead_depth) {
+            // Drop the pre-decompressed chunks the skip jumped over; the
+            // next fill resyncs the underlying stream lazily.
+            while (!_ready.empty() && _ready.front().pos + _ready.front().data.size() <= _pos) {
+                _ready.pop_front();
+            }
+            return make_ready_future<temporary_buffer<char>>();
+        }
         if (_pos == _end_pos) {
             return make_ready_future<temporary_buffer<char>>();
         }
@@ -491,6 +729,24 @@ class compressed_file_data_sink_impl : public data_sink_impl {
     sstables::local_compression _compression;
     size_t _pos = 0;
     uint32_t _full_checksum;
+
+    // Dictionary training state. While sampling, raw chunks are held back
+    // and only compressed once the dictionary is trained (or training was
+    // abandoned), so that the whole file is uniformly either dictionary- or
+    // plain-compressed; the reader tells the two apart by the presence of
+    // the dictionary in the compression metadata.
+    bool _sampling = false;
+    std::vector<temporary_buffer<char>> _deferred;
+    size_t _deferred_bytes = 0;
+
+    // How much raw data to sample (and hold back) before training.
+    static constexpr size_t sample_target_bytes = 1 << 20;
+    // Must fit in a disk_string<uint16_t> option value; also, ZDICT
+    // recommends dictionaries ~100x smaller than the training set.
+    static constexpr size_t max_dict_size = 16 * 1024;
+    // A dictionary only pays off when chunks are too small to provide
+    // useful back-references on their own.
+    static constexpr size_t max_dict_chunk_len = 16 * 1024;
 public:
     compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
             : _out(std::move(out))
@@ -498,10 +754,45 @@ public:
             , _offsets(_compression_metadata->offsets.get_writer())
             , _compression(lc)
             , _full_checksum(ChecksumType::init_checksum())
+            , _sampling(_compression.can_use_dictionaries()
+                    && _compression_metadata->uncompressed_chunk_length() <= max_dict_chunk_len)
     {}
 
     future<> put(net::packet data) { abort(); }
     virtual future<> put(temporary_buffer<char> buf) override {
+        if (_sampling) {
+            _deferred_bytes += buf.size();
+            _deferred.push_back(std::move(buf));
+            if (_deferred_bytes < sample_target_bytes) {
+                return make_ready_future<>();
+            }
+            return train_and_drain();
+        }
+        return compress_and_write(std::move(buf));
+    }
+
+    future<> train_and_drain() {
+        _sampling = false;
+        std::vector<bytes> samples;
+        samples.reserve(_deferred.size());
+        for (auto& chunk : _deferred) {
+            samples.emplace_back(reinterpret_cast<const int8_t*>(chunk.get()), chunk.size());
+        }
+        auto dict = _compression.train_dictionary(samples, max_dict_size);
+        if (!dict.empty()) {
+            _compression_metadata->set_dictionary(dict);
+            _compression.adopt_dictionary(dict);
+        }
+        // Training failure (e.g. too few or too uniform chunks) is not an
+        // error - the file is simply written without a dictionary.
+        return do_with(std::exchange(_deferred, {}), [this] (std::vector<temporary_buffer<char>>& deferred) {
+            return do_for_each(deferred, [this] (temporary_buffer<char>& chunk) {
+                return compress_and_write(std::move(chunk));
+            });
+        });
+    }
+
+    future<> compress_and_write(temporary_buffer<char> buf) {
         auto output_len = _compression.compress_max_size(buf.size());
 
         // account space for checksum that goes after compressed data.
@@ -542,7 +833,15 @@ public:
         return f.then([compressed = std::move(compressed)] {});
     }
     virtual future<> close() override {
-        return _out.close();
+        auto f = make_ready_future<>();
+        if (_sampling) {
+            // The file ended before the sample target was reached; train
+            // with whatever was collected.
+            f = train_and_drain();
+        }
+        return f.then([this] {
+            return _out.close();
+        });
     }
 
     virtual size_t buffer_size() const noexcept override {
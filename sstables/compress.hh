@@ -49,6 +49,12 @@
 #include <vector>
 #include <cstdint>
 #include <iterator>
+#include <optional>
+#include <unordered_map>
+
+#include <boost/intrusive/list.hpp>
+
+#include <seastar/core/temporary_buffer.hh>
 
 #include <seastar/core/file.hh>
 #include <seastar/core/seastar.hh>
@@ -317,6 +323,10 @@ private:
 public:
     // Set the compressor algorithm, please check the definition of enum compressor.
     void set_compressor(compressor_ptr c);
+    // Raw compression dictionary trained at write time, if any. It is kept
+    // as an entry in options, so it travels with the CompressionInfo file.
+    std::optional<bytes_view> dictionary() const;
+    void set_dictionary(bytes_view dict);
     // After changing _compression, update() must be called to update
     // additional variables depending on it.    
     void update(uint64_t compressed_file_length);
@@ -371,9 +381,76 @@ public:
         _full_checksum = checksum;
     }
 
+    compression() = default;
+    compression(compression&&) = default;
+    compression& operator=(compression&&) = default;
+    // Purges this object's chunks from the uncompressed chunk cache.
+    ~compression();
+
     friend class sstable;
 };
 
+// Shard-local cache of uncompressed sstable chunks.
+//
+// The compressed data source decompresses whole chunks, so without this
+// cache every reader which misses the OS page boundary of a hot chunk pays
+// the read and the decompression again. Chunks are keyed by the sstable's
+// compression metadata object and the chunk's position in the compressed
+// file, kept on an LRU and accounted against a shard-wide byte budget.
+// Cached chunks are served zero-copy, by sharing the underlying buffer.
+//
+// Entries of an sstable are purged when its compression metadata is
+// destroyed, i.e. when the sstable is closed.
+class uncompressed_chunk_cache {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t used_bytes = 0;
+    };
+private:
+    struct key_type {
+        const compression* owner;
+        uint64_t chunk_start;
+        bool operator==(const key_type&) const = default;
+    };
+    struct key_hash {
+        size_t operator()(const key_type& k) const {
+            return std::hash<const compression*>()(k.owner) ^ std::hash<uint64_t>()(k.chunk_start);
+        }
+    };
+    struct entry {
+        key_type key;
+        temporary_buffer<char> data;
+        boost::intrusive::list_member_hook<> lru_link;
+    };
+    using lru_type = boost::intrusive::list<entry,
+        boost::intrusive::member_hook<entry, boost::intrusive::list_member_hook<>, &entry::lru_link>,
+        boost::intrusive::constant_time_size<false>>;
+
+    std::unordered_map<key_type, std::unique_ptr<entry>, key_hash> _entries;
+    lru_type _lru; // Most recently used in front.
+    stats _stats;
+
+    size_t budget() const;
+    void evict_one() noexcept;
+public:
+    // The per-shard instance.
+    static uncompressed_chunk_cache& shard();
+
+    // Returns a zero-copy view of the cached chunk, if present.
+    std::optional<temporary_buffer<char>> get(const compression* cm, uint64_t chunk_start);
+
+    // Inserts an uncompressed chunk, evicting older chunks if over budget.
+    void put(const compression* cm, uint64_t chunk_start, temporary_buffer<char> data);
+
+    // Drops all chunks belonging to the given compression metadata.
+    void remove(const compression* cm) noexcept;
+
+    const stats& shard_stats() const { return _stats; }
+};
+
 // for API query only. Free function just to distinguish it from an accessor in compression
 compressor_ptr get_sstable_compressor(const compression&);
 
@@ -98,6 +98,8 @@ private:
         READING_UNSIGNED_VINT_LENGTH_BYTES_WITH_LEN,
         READING_SIGNED_VINT,
         READING_SIGNED_VINT_WITH_LEN,
+        READING_UNSIGNED_VINT_BATCH,
+        READING_UNSIGNED_VINT_BATCH_WITH_LEN,
     } _prestate = prestate::NONE;
 
 public:
@@ -119,6 +121,10 @@ private:
         uint8_t  uint8;
     } _read_int;
 
+    // state for READING_UNSIGNED_VINT_BATCH prestates
+    uint64_t* _batch_dest;
+    unsigned _batch_remaining = 0;
+
     // state for READING_BYTES prestate
     size_t _read_bytes_len = 0;
     utils::small_vector<temporary_buffer<char>, 1> _read_bytes;
@@ -171,6 +177,34 @@ private:
         }
         return read_status::waiting;
     };
+    // Decodes the remaining vints of a batch one by one, entering a prestate
+    // when the input runs out mid-run.
+    read_status continue_unsigned_vint_batch(temporary_buffer<char>& data) {
+        while (_batch_remaining) {
+            if (data.empty()) {
+                _prestate = prestate::READING_UNSIGNED_VINT_BATCH;
+                return read_status::waiting;
+            }
+            const vint_size_type len = unsigned_vint::serialized_size_from_first_byte(*data.begin());
+            if (data.size() >= len) {
+                *_batch_dest++ = unsigned_vint::deserialize(
+                        bytes_view(reinterpret_cast<bytes::value_type*>(data.get_write()), data.size()));
+                data.trim_front(len);
+                --_batch_remaining;
+            } else {
+                _read_bytes.clear();
+                _read_bytes.push_back(make_tracked_temporary_buffer(temporary_buffer<char>(len), _permit));
+                std::copy(data.begin(), data.end(), _read_bytes.front().get_write());
+                _read_bytes_len = len;
+                _pos = data.size();
+                data.trim(0);
+                _prestate = prestate::READING_UNSIGNED_VINT_BATCH_WITH_LEN;
+                return read_status::waiting;
+            }
+        }
+        _prestate = prestate::NONE;
+        return read_status::ready;
+    }
 public:
     primitive_consumer(reader_permit permit) : _permit(std::move(permit)) {}
 
@@ -270,6 +304,22 @@ public:
                 prestate::READING_SIGNED_VINT,
                 prestate::READING_SIGNED_VINT_WITH_LEN>(data, _i64);
     }
+    // Reads a run of `n` consecutive unsigned vints into dest[0..n).
+    // The destination must remain valid until the read completes. When the
+    // whole run is known to be in the buffer (the common case), it is
+    // decoded in one pass instead of bouncing through the enclosing state
+    // machine between fields.
+    inline read_status read_unsigned_vint_batch(temporary_buffer<char>& data, uint64_t* dest, unsigned n) {
+        if (__builtin_expect(data.size() >= n * max_vint_length, true)) {
+            auto consumed = unsigned_vint::deserialize_run(
+                    reinterpret_cast<const bytes::value_type*>(data.get()), data.size(), dest, n);
+            data.trim_front(consumed);
+            return read_status::ready;
+        }
+        _batch_dest = dest;
+        _batch_remaining = n;
+        return continue_unsigned_vint_batch(data);
+    }
     inline read_status read_unsigned_vint_length_bytes_contiguous(temporary_buffer<char>& data, temporary_buffer<char>& where) {
         if (data.empty()) {
             _prestate = prestate::READING_UNSIGNED_VINT_LENGTH_BYTES_CONTIGUOUS;
@@ -372,6 +422,21 @@ public:
             break;
         case prestate::READING_UNSIGNED_VINT_WITH_LEN:
             return read_vint_with_len<unsigned_vint>(data, _u64);
+        case prestate::READING_UNSIGNED_VINT_BATCH:
+            return continue_unsigned_vint_batch(data);
+        case prestate::READING_UNSIGNED_VINT_BATCH_WITH_LEN: {
+            const auto n = std::min(_read_bytes_len - _pos, data.size());
+            std::copy_n(data.begin(), n, _read_bytes.front().get_write() + _pos);
+            data.trim_front(n);
+            _pos += n;
+            if (_pos == _read_bytes_len) {
+                *_batch_dest++ = unsigned_vint::deserialize(
+                        bytes_view(reinterpret_cast<bytes::value_type*>(_read_bytes.front().get_write()), _read_bytes_len));
+                --_batch_remaining;
+                return continue_unsigned_vint_batch(data);
+            }
+            return read_status::waiting;
+        }
         case prestate::READING_SIGNED_VINT_WITH_LEN:
             return read_vint_with_len<signed_vint>(data, _i64);
         case prestate::READING_UNSIGNED_VINT_LENGTH_BYTES_WITH_LEN_CONTIGUOUS: {
@@ -289,6 +289,11 @@ public:
     const std::unique_ptr<promoted_index>& get_promoted_index() const { return _index; }
     std::unique_ptr<promoted_index>& get_promoted_index() { return _index; }
     uint32_t get_promoted_index_size() const { return _index ? _index->get_promoted_index_size() : 0; }
+
+    // Approximation of the amount of memory used by this entry, for cache accounting.
+    size_t external_memory_usage() const {
+        return sizeof(index_entry) + _key.size() + get_promoted_index_size();
+    }
 };
 
 }
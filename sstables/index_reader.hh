@@ -23,7 +23,7 @@
 #include "sstables.hh"
 #include "consumer.hh"
 #include "downsampling.hh"
-#include "sstables/shared_index_lists.hh"
+#include "sstables/partition_index_cache.hh"
 #include <seastar/util/bool_class.hh>
 #include "utils/buffer_input_stream.hh"
 #include "sstables/prepended_input_stream.hh"
@@ -354,7 +354,7 @@ struct open_rt_marker {
 // Contains information about index_reader position in the index file
 struct index_bound {
     index_bound() = default;
-    shared_index_lists::list_ptr current_list;
+    partition_index_cache::list_ptr current_list;
     uint64_t previous_summary_idx = 0;
     uint64_t current_summary_idx = 0;
     uint64_t current_index_idx = 0;
@@ -396,7 +396,7 @@ class index_reader {
     reader_permit _permit;
     const io_priority_class& _pc;
     tracing::trace_state_ptr _trace_state;
-    shared_index_lists& _index_lists;
+    partition_index_cache& _index_lists;
 
     struct reader {
         index_consumer _consumer;
@@ -410,10 +410,12 @@ class index_reader {
             return tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", sst.filename(component_type::Index)));
         }
 
-        inline static file_input_stream_options get_file_input_stream_options(shared_sstable sst, const io_priority_class& pc) {
+        inline static file_input_stream_options get_file_input_stream_options(shared_sstable sst, const io_priority_class& pc, const reader_permit& permit) {
             file_input_stream_options options;
             options.buffer_size = sst->sstable_buffer_size;
-            options.read_ahead = 2;
+            // Index readahead speculates that we will walk on to the next
+            // index pages; skip it when the read has little budget left.
+            options.read_ahead = permit.budget_is_low() ? 0 : 2;
             options.io_priority_class = pc;
             options.dynamic_adjustments = sst->_index_history;
             return options;
@@ -424,7 +426,7 @@ class index_reader {
             , _context(permit, _consumer,
                        trust_promoted_index(sst->has_correct_promoted_index_entries()), *sst->_schema,
                        get_file(*sst, permit, trace_state),
-                       get_file_input_stream_options(sst, pc), begin, end - begin,
+                       get_file_input_stream_options(sst, pc, permit), begin, end - begin,
                        (sst->get_version() >= sstable_version_types::mc
                            ? std::make_optional(get_clustering_values_fixed_lengths(sst->get_serialization_header()))
                            : std::optional<column_values_fixed_lengths>{}),
@@ -502,7 +504,7 @@ private:
             });
         };
 
-        return _index_lists.get_or_load(summary_idx, loader).then([this, &bound, summary_idx] (shared_index_lists::list_ptr ref) {
+        return _index_lists.get_or_load(summary_idx, loader).then([this, &bound, summary_idx] (partition_index_cache::list_ptr ref) {
             bound.current_list = std::move(ref);
             bound.current_summary_idx = summary_idx;
             bound.current_index_idx = 0;
@@ -740,7 +742,8 @@ public:
     file_input_stream_options get_file_input_stream_options(const io_priority_class& pc) {
         file_input_stream_options options;
         options.buffer_size = _sstable->sstable_buffer_size;
-        options.read_ahead = 2;
+        // See reader::get_file_input_stream_options().
+        options.read_ahead = _permit.budget_is_low() ? 0 : 2;
         options.io_priority_class = pc;
         options.dynamic_adjustments = _sstable->_index_history;
         return options;
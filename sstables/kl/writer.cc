@@ -477,6 +477,7 @@ sstable_writer_k_l::sstable_writer_k_l(sstable& sst, const schema& s, uint64_t e
     _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::k_l_format);
     _pi_write.desired_block_size = cfg.promoted_index_block_size;
     _index_sampling_state.summary_byte_cost = cfg.summary_byte_cost;
+    _index_sampling_state.summary_memory_budget = cfg.summary_memory_budget;
     _index = std::make_unique<file_writer>(index_file_writer(sst, pc));
 
     prepare_summary(_sst._components->summary, estimated_partitions, _schema.min_index_interval());
@@ -490,6 +491,7 @@ sstable_writer_k_l::sstable_writer_k_l(sstable& sst, const schema& s, uint64_t e
 void sstable_writer_k_l::consume_new_partition(const dht::decorated_key& dk) {
     // Set current index of data to later compute row size.
     _c_stats.start_offset = _writer->offset();
+    _c_stats.token = dk.token();
 
     _partition_key = key::from_partition_key(_schema, dk.key());
 
@@ -649,7 +651,7 @@ void sstable_writer_k_l::consume_end_of_stream()
     _sst.write_compression(_pc);
     auto features = all_features();
     run_identifier identifier{_run_identifier};
-    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), {}, "");
+    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), {}, "", _collector.get_tombstone_density());
 
     if (!_leave_unsealed) {
         _sst.seal_sstable(_backup).get();
@@ -22,12 +22,60 @@
 #include "leveled_compaction_strategy.hh"
 #include "sstables/leveled_manifest.hh"
 #include <algorithm>
+#include <numeric>
 #include <ranges>
+#include <unordered_set>
 
 #include <boost/range/algorithm/remove_if.hpp>
 
 namespace sstables {
 
+// Returns the narrowest token range holding at least 90% of the sstable's
+// tombstones, computed from the density histogram collected at write time.
+// Returns nothing when the histogram is absent or the tombstones are spread
+// over more than a quarter of the token space, in which case a targeted
+// compaction wouldn't be any cheaper than a regular one.
+static std::optional<::range<dht::token>> hot_tombstone_range(const shared_sstable& sst) {
+    auto* density = sst->get_tombstone_density();
+    if (!density) {
+        return std::nullopt;
+    }
+    auto& buckets = density->buckets.elements;
+    auto total = std::accumulate(buckets.begin(), buckets.end(), uint64_t(0));
+    if (buckets.empty() || !total) {
+        return std::nullopt;
+    }
+    // Smallest contiguous bucket window holding at least 90% of the tombstones.
+    const uint64_t needed = total - total / 10;
+    size_t best_begin = 0, best_end = buckets.size();
+    size_t begin = 0;
+    uint64_t window = 0;
+    for (size_t end = 0; end < buckets.size(); end++) {
+        window += buckets[end];
+        while (window - buckets[begin] >= needed) {
+            window -= buckets[begin++];
+        }
+        if (window >= needed && end + 1 - begin < best_end - best_begin) {
+            best_begin = begin;
+            best_end = end + 1;
+        }
+    }
+    if (best_end - best_begin > buckets.size() / 4) {
+        return std::nullopt;
+    }
+    // Buckets divide the whole signed token space evenly; the boundary math
+    // relies on the modular unsigned-to-signed conversion.
+    const uint64_t width = (uint64_t(1) << 63) / buckets.size() * 2;
+    auto first = dht::token::from_int64(int64_t(best_begin * width + (uint64_t(1) << 63)));
+    auto last = dht::token::from_int64(int64_t(best_end * width + (uint64_t(1) << 63) - 1));
+    return ::range<dht::token>::make(first, last);
+}
+
+static bool contained_in(const shared_sstable& sst, const ::range<dht::token>& r) {
+    auto sst_range = ::range<dht::token>::make(sst->get_first_decorated_key().token(), sst->get_last_decorated_key().token());
+    return r.contains(sst_range, dht::token_comparator());
+}
+
 compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(column_family& cfs, std::vector<sstables::shared_sstable> candidates) {
     // NOTE: leveled_manifest creation may be slightly expensive, so later on,
     // we may want to store it in the strategy itself. However, the sstable
@@ -63,6 +111,41 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(c
         auto& sst = *std::max_element(sstables.begin(), sstables.end(), [&] (auto& i, auto& j) {
             return i->estimate_droppable_tombstone_ratio(gc_before) < j->estimate_droppable_tombstone_ratio(gc_before);
         });
+        // If the tombstones of the chosen sstable concentrate in a narrow token
+        // span, compact all the tombstone-laden sstables contained in that span
+        // together: the data they shadow in one another is then part of the same
+        // job, so the tombstones can actually be purged, instead of being carried
+        // through one full-sstable rewrite per sstable.
+        auto hot_range = hot_tombstone_range(sst);
+        if (hot_range && contained_in(sst, *hot_range)) {
+            std::vector<sstables::shared_sstable> job;
+            unsigned target_level = 0;
+            for (auto l = int(manifest.get_level_count()); l >= 0; l--) {
+                for (auto& candidate : manifest.get_level(l)) {
+                    if (contained_in(candidate, *hot_range) && worth_dropping_tombstones(candidate, gc_before)) {
+                        target_level = std::max(target_level, candidate->get_sstable_level());
+                        job.push_back(candidate);
+                    }
+                }
+            }
+            if (job.size() > 1) {
+                if (target_level > 0) {
+                    // The output lands in the deepest input level, which must stay
+                    // disjoint, so any of its sstables overlapping the job's span
+                    // comes along too.
+                    auto members = std::unordered_set<sstables::shared_sstable>(job.begin(), job.end());
+                    for (auto& straddler : leveled_manifest::overlapping(*cfs.schema(), job, manifest.get_level(target_level))) {
+                        if (members.insert(straddler).second) {
+                            job.push_back(straddler);
+                        }
+                    }
+                }
+                leveled_manifest::logger.info("Compacting {} sstables whose tombstones concentrate in range {} on behalf of {}.{}",
+                        job.size(), *hot_range, cfs.schema()->ks_name(), cfs.schema()->cf_name());
+                return sstables::compaction_descriptor(std::move(job), cfs.get_sstable_set(), service::get_local_compaction_priority(),
+                                                       target_level, _max_sstable_size_in_mb*1024*1024);
+            }
+        }
         return sstables::compaction_descriptor({ sst }, cfs.get_sstable_set(), service::get_local_compaction_priority(), sst->get_sstable_level());
     }
     return {};
@@ -434,6 +434,24 @@ private:
             auto l1overlapping = overlapping(*_schema, candidates, get_level(1));
             candidates.insert(candidates.end(), l1overlapping.begin(), l1overlapping.end());
             can_promote = true;
+
+            // If this batch overflows L1, promoting it there only forces the same
+            // data through an immediate L1->L2 compaction, and so on down the
+            // levels: an ingest burst becomes a cascade of rewrites. Absorb the
+            // burst in a single pass instead, by bringing in the overlapping
+            // sstables of every level the output would overflow; the deepest of
+            // them then becomes the target level (see get_next_level()), so the
+            // result lands directly in a level with capacity for it. Each level
+            // is matched against the span of all candidates gathered so far, so
+            // the output cannot overlap what remains in the target level.
+            for (size_t level = 2; level < _generations.size() && get_total_bytes(candidates) > max_bytes_for_level(level - 1); level++) {
+                auto deeper_overlapping = overlapping(*_schema, candidates, get_level(level));
+                if (!deeper_overlapping.empty()) {
+                    logger.info("L0 batch of {} bytes overflows L{}, bringing in {} overlapping sstables from L{} to absorb the burst in one pass",
+                                get_total_bytes(candidates), level - 1, deeper_overlapping.size(), level);
+                    candidates.insert(candidates.end(), deeper_overlapping.begin(), deeper_overlapping.end());
+                }
+            }
         } else {
             // do STCS in L0 when max_sstable_size is high compared to size of new sstables, so we'll
             // avoid quadratic behavior until L0 is worth promoting.
@@ -47,8 +47,10 @@
 #include "hyperloglog.hh"
 #include "db/commitlog/replay_position.hh"
 #include "clustering_bounds_comparator.hh"
+#include "dht/token.hh"
 
 #include <algorithm>
+#include <bit>
 
 class range_tombstone;
 
@@ -56,6 +58,10 @@ namespace sstables {
 
 static constexpr int TOMBSTONE_HISTOGRAM_BIN_SIZE = 100;
 
+// Number of equal-width buckets the token space is divided into by the
+// tombstone density histogram. Must be a power of two.
+static constexpr unsigned TOMBSTONE_DENSITY_BUCKET_COUNT = 128;
+
 /**
  * ColumnStats holds information about the columns for one partition inside sstable
  */
@@ -69,6 +75,10 @@ struct column_stats {
 
     uint64_t start_offset;
     uint64_t partition_size;
+    /** how many tombstones (including expiring cells) are there in the partition */
+    uint64_t tombstone_count;
+    /** token of the partition, for the tombstone density histogram */
+    dht::token token;
 
     /** the largest/smallest (client-supplied) timestamp in the partition */
     min_max_tracker<api::timestamp_type> timestamp_tracker;
@@ -86,6 +96,7 @@ struct column_stats {
         rows_count(0),
         start_offset(0),
         partition_size(0),
+        tombstone_count(0),
         tombstone_histogram(TOMBSTONE_HISTOGRAM_BIN_SIZE),
         has_legacy_counter_shards(false)
         {
@@ -111,6 +122,7 @@ struct column_stats {
     void update_local_deletion_time_and_tombstone_histogram(int32_t value) {
         local_deletion_time_tracker.update(value);
         tombstone_histogram.update(value);
+        tombstone_count++;
     }
     void update_local_deletion_time_and_tombstone_histogram(gc_clock::time_point value) {
         bool capped;
@@ -168,6 +180,9 @@ private:
     bool _has_legacy_counter_shards = false;
     uint64_t _columns_count = 0;
     uint64_t _rows_count = 0;
+    // Tombstone counts bucketed by token, see add_partition_tombstones().
+    // Kept empty while no tombstones are seen.
+    std::vector<uint64_t> _tombstone_density;
 
     /**
      * Default cardinality estimation method is to use HyperLogLog++.
@@ -211,6 +226,19 @@ public:
         _estimated_tombstone_drop_time.merge(histogram);
     }
 
+    void add_partition_tombstones(const dht::token& token, uint64_t count) {
+        if (!count) {
+            return;
+        }
+        if (_tombstone_density.empty()) {
+            _tombstone_density.resize(TOMBSTONE_DENSITY_BUCKET_COUNT);
+        }
+        // Flipping the sign bit maps the signed token order onto the unsigned
+        // one, so the top bits of the result index the bucket directly.
+        auto bucket = (uint64_t(token.raw()) ^ (uint64_t(1) << 63)) >> (64 - std::countr_zero(TOMBSTONE_DENSITY_BUCKET_COUNT));
+        _tombstone_density[bucket] += count;
+    }
+
     /**
      * Ratio is compressed/uncompressed and it is
      * if you have 1.x then compression isn't helping
@@ -246,11 +274,21 @@ public:
         add_partition_size(stats.partition_size);
         add_cells_count(stats.cells_count);
         merge_tombstone_histogram(stats.tombstone_histogram);
+        add_partition_tombstones(stats.token, stats.tombstone_count);
         update_has_legacy_counter_shards(stats.has_legacy_counter_shards);
         _columns_count += stats.column_count;
         _rows_count += stats.rows_count;
     }
 
+    std::optional<scylla_metadata::tombstone_density> get_tombstone_density() const {
+        if (_tombstone_density.empty()) {
+            return std::nullopt;
+        }
+        scylla_metadata::tombstone_density td;
+        td.buckets.elements = utils::chunked_vector<uint64_t>(_tombstone_density.begin(), _tombstone_density.end());
+        return td;
+    }
+
     void construct_compaction(compaction_metadata& m) {
         auto cardinality = _cardinality.get_bytes();
         m.cardinality.elements = utils::chunked_vector<uint8_t>(cardinality.get(), cardinality.get() + cardinality.size());
@@ -26,6 +26,7 @@
 #include "sstables/promoted_index_blocks_reader.hh"
 #include "parsers.hh"
 #include "schema.hh"
+#include "utils/array-search.hh"
 #include "utils/cached_file.hh"
 
 #include <seastar/core/byteorder.hh>
@@ -167,6 +168,100 @@ private:
     //
     using block_set_type = std::set<promoted_index_block, block_comparator>;
     block_set_type _blocks;
+
+    // Sorted, contiguous array of fixed-width prefixes of block start positions,
+    // built lazily as blocks are parsed.
+    //
+    // Engaged only for schemas whose first clustering column is a fixed-width
+    // integer type (bigint, timestamp, time), where the decoded 64-bit value
+    // orders the same way as the column. Unlike _blocks, recorded prefixes
+    // survive invalidate_prior(), so repeated bisections can narrow their range
+    // with a SIMD search (utils::array_search_gt) over contiguous memory instead
+    // of re-reading and re-parsing evicted blocks.
+    //
+    // Prefix comparisons are used only when strict: blocks with equal prefixes
+    // may order either way on the remaining key components.
+    struct prefix_index {
+        static constexpr int64_t unused = utils::simple_key_unused_value;
+        // Sorted by (prefix, block index); padded with `unused` to a multiple
+        // of 4 slots, as utils::array_search_gt() requires.
+        std::vector<int64_t> prefixes;
+        // Parallel to the used part of `prefixes`.
+        std::vector<pi_index_type> blocks;
+
+        size_t size() const { return blocks.size(); }
+
+        size_t memory_usage() const {
+            return prefixes.capacity() * sizeof(int64_t) + blocks.capacity() * sizeof(pi_index_type);
+        }
+
+        void insert(int64_t p, pi_index_type idx) {
+            size_t old_size = size();
+            size_t i = std::lower_bound(prefixes.begin(), prefixes.begin() + old_size, p) - prefixes.begin();
+            while (i < old_size && prefixes[i] == p && blocks[i] < idx) {
+                ++i;
+            }
+            if (i < old_size && prefixes[i] == p && blocks[i] == idx) {
+                return; // Already recorded, e.g. the block was evicted and parsed again.
+            }
+            if (old_size == prefixes.size()) {
+                prefixes.resize(prefixes.size() + 4, unused);
+            }
+            blocks.insert(blocks.begin() + i, idx);
+            std::copy_backward(prefixes.begin() + i, prefixes.begin() + old_size, prefixes.begin() + old_size + 1);
+            prefixes[i] = p;
+        }
+
+        // Returns the first slot whose prefix is strictly greater than p.
+        size_t upper(int64_t p) const {
+            return utils::array_search_gt(p, prefixes.data(), prefixes.size(), size());
+        }
+    };
+    std::optional<prefix_index> _prefix_index;
+
+    static bool prefix_search_eligible(const schema& s) {
+        if (s.clustering_key_size() == 0) {
+            return false;
+        }
+        // Singleton comparison excludes reversed (descending) columns, whose
+        // type is a reversed_type_impl wrapper.
+        auto& t = s.clustering_key_columns().front().type;
+        return t == long_type || t == timestamp_type || t == time_type;
+    }
+
+    // Decodes the fixed-width prefix of pos, or nullopt when pos doesn't have
+    // a usable one.
+    std::optional<int64_t> position_prefix(position_in_partition_view pos) const {
+        if (pos.region() != partition_region::clustered) {
+            return std::nullopt;
+        }
+        auto& key = pos.key();
+        if (key.is_empty(_s)) {
+            return std::nullopt;
+        }
+        auto component = *key.begin(_s);
+        if (component.size() != sizeof(int64_t)) {
+            return std::nullopt; // null first component
+        }
+        int64_t v = component.with_linearized([] (bytes_view b) {
+            return seastar::read_be<int64_t>(reinterpret_cast<const char*>(b.data()));
+        });
+        if (v == prefix_index::unused) {
+            return std::nullopt; // Indistinguishable from the padding sentinel.
+        }
+        return v;
+    }
+
+    void maybe_record_prefix(const promoted_index_block& block) {
+        if (!_prefix_index) {
+            return;
+        }
+        if (auto p = position_prefix(*block.start)) {
+            auto mem_before = _prefix_index->memory_usage();
+            _prefix_index->insert(*p, block.index);
+            _metrics.used_bytes += _prefix_index->memory_usage() - mem_before;
+        }
+    }
 public:
     const schema& _s;
     metrics& _metrics;
@@ -220,6 +315,7 @@ private:
             auto mem_before = block.memory_usage();
             block.start.emplace(_clustering_parser.get_and_reset());
             _metrics.used_bytes += block.memory_usage() - mem_before;
+            maybe_record_prefix(block);
         });
     }
 
@@ -236,6 +332,7 @@ private:
             block.data_file_offset = _block_parser.offset();
             block.width = _block_parser.width();
             _metrics.used_bytes += block.memory_usage() - mem_before;
+            maybe_record_prefix(block);
         });
     }
 
@@ -273,6 +370,7 @@ public:
             io_priority_class pc,
             pi_index_type blocks_count)
         : _blocks(block_comparator{s})
+        , _prefix_index(prefix_search_eligible(s) ? std::make_optional<prefix_index>() : std::nullopt)
         , _s(s)
         , _metrics(m)
         , _blocks_count(blocks_count)
@@ -339,6 +437,47 @@ public:
         return make_ready_future<std::optional<uint64_t>>(block.data_file_offset);
     }
 
+    // Narrows the bisection range [lo, hi) over block indexes using prefixes of
+    // previously parsed block starts, without touching the index file.
+    //
+    // Preserves the bisection invariants: every returned lower bound lo' satisfies
+    // pos >= start(i) for all i < lo', and hi is only tightened to hi' when the
+    // caller can establish pos < start(hi') (see get_cached_block_start()).
+    // Relies on block starts being non-decreasing with the block index.
+    std::pair<pi_index_type, pi_index_type> narrow_range_by_prefix(position_in_partition_view pos, pi_index_type lo, pi_index_type hi) {
+        if (!_prefix_index || !_prefix_index->size()) {
+            return {lo, hi};
+        }
+        auto p = position_prefix(pos);
+        if (!p) {
+            return {lo, hi};
+        }
+        auto& pi = *_prefix_index;
+        // The first block with a strictly greater prefix starts after pos.
+        auto i = pi.upper(*p);
+        if (i < pi.size() && pi.blocks[i] > lo && pi.blocks[i] < hi) {
+            hi = pi.blocks[i];
+        }
+        // Blocks with a strictly smaller prefix start before pos.
+        if (*p != std::numeric_limits<int64_t>::min()) {
+            auto j = pi.upper(*p - 1); // First slot with prefix >= *p.
+            if (j > 0 && pi.blocks[j - 1] >= lo && pi.blocks[j - 1] < hi) {
+                lo = pi.blocks[j - 1] + 1;
+            }
+        }
+        return {lo, hi};
+    }
+
+    // Returns the start position of the block if it is currently materialized
+    // in the cache with its start parsed, nullptr otherwise.
+    const position_in_partition* get_cached_block_start(pi_index_type idx) const {
+        auto i = _blocks.find(idx);
+        if (i != _blocks.end() && i->start) {
+            return &*i->start;
+        }
+        return nullptr;
+    }
+
     // Invalidates information about blocks with smaller indexes than a given block.
     void invalidate_prior(promoted_index_block* block, tracing::trace_state_ptr trace_state) {
         _cached_file.invalidate_at_most_front(block->offset, trace_state);
@@ -406,6 +545,20 @@ private:
         // Eventually _current_idx will reach _upper_idx.
 
         _upper_idx = _blocks_count;
+
+        // Narrow the bisection range using prefixes of block starts parsed
+        // earlier, before the I/O-bound bisection below touches any block.
+        auto [lo, hi] = _promoted_index.narrow_range_by_prefix(pos, _current_idx, _upper_idx);
+        _current_idx = lo;
+        if (hi < _upper_idx) {
+            // _current_pos must track the start of the upper bound block, so the
+            // tightened bound is usable only when that start is still cached.
+            if (auto* start = _promoted_index.get_cached_block_start(hi)) {
+                _current_pos = *start;
+                _upper_idx = hi;
+            }
+        }
+
         return repeat([this, pos] {
             if (_current_idx >= _upper_idx) {
                 if (_current_idx == _blocks_count) {
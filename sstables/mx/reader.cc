@@ -145,14 +145,10 @@ private:
         ROW_BODY_SIZE,
         ROW_BODY_PREV_SIZE,
         ROW_BODY_TIMESTAMP,
-        ROW_BODY_TIMESTAMP_TTL,
-        ROW_BODY_TIMESTAMP_DELTIME,
         ROW_BODY_DELETION,
         ROW_BODY_DELETION_2,
-        ROW_BODY_DELETION_3,
         ROW_BODY_SHADOWABLE_DELETION,
         ROW_BODY_SHADOWABLE_DELETION_2,
-        ROW_BODY_SHADOWABLE_DELETION_3,
         ROW_BODY_MARKER,
         ROW_BODY_MISSING_COLUMNS,
         ROW_BODY_MISSING_COLUMNS_2,
@@ -181,12 +177,8 @@ private:
         RANGE_TOMBSTONE_SIZE,
         RANGE_TOMBSTONE_CONSUME_CK,
         RANGE_TOMBSTONE_BODY,
-        RANGE_TOMBSTONE_BODY_SIZE,
-        RANGE_TOMBSTONE_BODY_PREV_SIZE,
         RANGE_TOMBSTONE_BODY_TIMESTAMP,
         RANGE_TOMBSTONE_BODY_TIMESTAMP2,
-        RANGE_TOMBSTONE_BODY_LOCAL_DELTIME,
-        RANGE_TOMBSTONE_BODY_LOCAL_DELTIME2,
     } _state = state::PARTITION_START;
 
     consumer_m& _consumer;
@@ -200,6 +192,9 @@ private:
     unfiltered_flags_m _flags{0};
     unfiltered_extended_flags_m _extended_flags{0};
     uint64_t _next_row_offset;
+    // Destination of batched vint reads; must outlive the read, so it
+    // cannot live on process_state()'s stack.
+    uint64_t _vint_batch[4];
     liveness_info _liveness;
     bool _is_first_unfiltered = true;
 
@@ -324,8 +319,9 @@ public:
                 || _state == state::CLUSTERING_ROW
                 || _state == state::CK_BLOCK_HEADER
                 || _state == state::CK_BLOCK_END
-                || _state == state::ROW_BODY_TIMESTAMP_DELTIME
-                || _state == state::ROW_BODY_DELETION_3
+                || _state == state::ROW_BODY_TIMESTAMP
+                || _state == state::ROW_BODY_DELETION_2
+                || _state == state::ROW_BODY_SHADOWABLE_DELETION_2
                 || _state == state::ROW_BODY_MISSING_COLUMNS_2
                 || _state == state::ROW_BODY_MISSING_COLUMNS_READ_COLUMNS_2
                 || _state == state::COLUMN
@@ -517,47 +513,33 @@ private:
                 _state = state::ROW_BODY_DELETION;
                 goto row_body_deletion_label;
             }
-            if (read_unsigned_vint(data) != read_status::ready) {
+            // The timestamp, and when the row carries a ttl also the ttl and
+            // the local deletion time, are consecutive vints; decode them as
+            // one run.
+            if (read_unsigned_vint_batch(data, _vint_batch, _flags.has_ttl() ? 3 : 1) != read_status::ready) {
                 _state = state::ROW_BODY_TIMESTAMP;
                 break;
             }
           }
         case state::ROW_BODY_TIMESTAMP:
-            _liveness.set_timestamp(parse_timestamp(_header, _u64));
-            if (!_flags.has_ttl()) {
-                _state = state::ROW_BODY_DELETION;
-                goto row_body_deletion_label;
-            }
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::ROW_BODY_TIMESTAMP_TTL;
-                break;
+            _liveness.set_timestamp(parse_timestamp(_header, _vint_batch[0]));
+            if (_flags.has_ttl()) {
+                _liveness.set_ttl(parse_ttl(_header, _vint_batch[1]));
+                _liveness.set_local_deletion_time(parse_expiry(_header, _vint_batch[2]));
             }
-        case state::ROW_BODY_TIMESTAMP_TTL:
-            _liveness.set_ttl(parse_ttl(_header, _u64));
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::ROW_BODY_TIMESTAMP_DELTIME;
-                break;
-            }
-        case state::ROW_BODY_TIMESTAMP_DELTIME:
-            _liveness.set_local_deletion_time(parse_expiry(_header, _u64));
         case state::ROW_BODY_DELETION:
         row_body_deletion_label:
             if (!_flags.has_deletion()) {
                 _state = state::ROW_BODY_SHADOWABLE_DELETION;
                 goto row_body_shadowable_deletion_label;
             }
-            if (read_unsigned_vint(data) != read_status::ready) {
+            if (read_unsigned_vint_batch(data, _vint_batch, 2) != read_status::ready) {
                 _state = state::ROW_BODY_DELETION_2;
                 break;
             }
         case state::ROW_BODY_DELETION_2:
-            _row_tombstone.timestamp = parse_timestamp(_header, _u64);
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::ROW_BODY_DELETION_3;
-                break;
-            }
-        case state::ROW_BODY_DELETION_3:
-            _row_tombstone.deletion_time = parse_expiry(_header, _u64);
+            _row_tombstone.timestamp = parse_timestamp(_header, _vint_batch[0]);
+            _row_tombstone.deletion_time = parse_expiry(_header, _vint_batch[1]);
         case state::ROW_BODY_SHADOWABLE_DELETION:
         row_body_shadowable_deletion_label:
             if (_extended_flags.has_scylla_shadowable_deletion()) {
@@ -568,18 +550,13 @@ private:
                 _state = state::ROW_BODY_MARKER;
                 goto row_body_marker_label;
             }
-            if (read_unsigned_vint(data) != read_status::ready) {
+            if (read_unsigned_vint_batch(data, _vint_batch, 2) != read_status::ready) {
                 _state = state::ROW_BODY_SHADOWABLE_DELETION_2;
                 break;
             }
         case state::ROW_BODY_SHADOWABLE_DELETION_2:
-            _row_shadowable_tombstone.timestamp = parse_timestamp(_header, _u64);
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::ROW_BODY_SHADOWABLE_DELETION_3;
-                break;
-            }
-        case state::ROW_BODY_SHADOWABLE_DELETION_3:
-            _row_shadowable_tombstone.deletion_time = parse_expiry(_header, _u64);
+            _row_shadowable_tombstone.timestamp = parse_timestamp(_header, _vint_batch[0]);
+            _row_shadowable_tombstone.deletion_time = parse_expiry(_header, _vint_batch[1]);
         case state::ROW_BODY_MARKER:
         row_body_marker_label:
             if (_consumer.consume_row_marker_and_tombstone(
@@ -835,30 +812,16 @@ private:
             _reading_range_tombstone_ck = false;
         case state::RANGE_TOMBSTONE_BODY:
         range_tombstone_body_label:
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::RANGE_TOMBSTONE_BODY_SIZE;
-                break;
-            }
-        case state::RANGE_TOMBSTONE_BODY_SIZE:
-            // Ignore result
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::RANGE_TOMBSTONE_BODY_PREV_SIZE;
-                break;
-            }
-        case state::RANGE_TOMBSTONE_BODY_PREV_SIZE:
-            // Ignore result
-            if (read_unsigned_vint(data) != read_status::ready) {
+            // The body size, size of the previous unfiltered (both ignored),
+            // timestamp and local deletion time are consecutive vints;
+            // decode them as one run.
+            if (read_unsigned_vint_batch(data, _vint_batch, 4) != read_status::ready) {
                 _state = state::RANGE_TOMBSTONE_BODY_TIMESTAMP;
                 break;
             }
         case state::RANGE_TOMBSTONE_BODY_TIMESTAMP:
-            _left_range_tombstone.timestamp = parse_timestamp(_header, _u64);
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::RANGE_TOMBSTONE_BODY_LOCAL_DELTIME;
-                break;
-            }
-        case state::RANGE_TOMBSTONE_BODY_LOCAL_DELTIME:
-            _left_range_tombstone.deletion_time = parse_expiry(_header, _u64);
+            _left_range_tombstone.timestamp = parse_timestamp(_header, _vint_batch[2]);
+            _left_range_tombstone.deletion_time = parse_expiry(_header, _vint_batch[3]);
             if (!is_boundary_between_adjacent_intervals(_range_tombstone_kind)) {
                 if (!is_bound_kind(_range_tombstone_kind)) {
                     throw sstables::malformed_sstable_exception(
@@ -874,18 +837,13 @@ private:
                 _row_key.clear();
                 goto flags_label;
             }
-            if (read_unsigned_vint(data) != read_status::ready) {
+            if (read_unsigned_vint_batch(data, _vint_batch, 2) != read_status::ready) {
                 _state = state::RANGE_TOMBSTONE_BODY_TIMESTAMP2;
                 break;
             }
         case state::RANGE_TOMBSTONE_BODY_TIMESTAMP2:
-            _right_range_tombstone.timestamp = parse_timestamp(_header, _u64);
-            if (read_unsigned_vint(data) != read_status::ready) {
-                _state = state::RANGE_TOMBSTONE_BODY_LOCAL_DELTIME2;
-                break;
-            }
-        case state::RANGE_TOMBSTONE_BODY_LOCAL_DELTIME2:
-            _right_range_tombstone.deletion_time = parse_expiry(_header, _u64);
+            _right_range_tombstone.timestamp = parse_timestamp(_header, _vint_batch[0]);
+            _right_range_tombstone.deletion_time = parse_expiry(_header, _vint_batch[1]);
             if (_consumer.consume_range_tombstone(_row_key,
                                                   _range_tombstone_kind,
                                                   _left_range_tombstone,
@@ -964,6 +922,7 @@ class mp_row_consumer_m : public consumer_m {
     std::optional<mutation_fragment_filter> _mf_filter;
 
     bool _is_mutation_end = true;
+    tombstone _partition_tombstone;
     streamed_mutation::forwarding _fwd;
     // For static-compact tables C* stores the only row in the static row but in our representation they're regular rows.
     const bool _treat_static_row_as_regular;
@@ -1061,8 +1020,28 @@ class mp_row_consumer_m : public consumer_m {
         return proceed(!_reader->is_buffer_full() && !need_preempt());
     }
 
+    // The tombstones already known to cover the cell being parsed: the
+    // partition tombstone, the currently open range tombstone (which spans
+    // the in-progress row, see consume_row_start()) and the row's own
+    // tombstone. Only the regular part of the row tombstone counts here; a
+    // shadowable tombstone may itself be cancelled by a newer row marker
+    // from another source.
+    tombstone current_shadowing_tombstone() const {
+        tombstone t = _partition_tombstone;
+        if (!_inside_static_row) {
+            if (_opened_range_tombstone) {
+                t.apply(_opened_range_tombstone->tomb);
+            }
+            if (_in_progress_row) {
+                t.apply(_in_progress_row->tomb().regular());
+            }
+        }
+        return t;
+    }
+
     inline void reset_for_new_partition() {
         _is_mutation_end = true;
+        _partition_tombstone = {};
         _in_progress_row.reset();
         _stored_tombstone.reset();
         _mf_filter.reset();
@@ -1218,6 +1197,7 @@ public:
         }
         auto pk = partition_key::from_exploded(key.explode(*_schema));
         setup_for_partition(pk);
+        _partition_tombstone = tombstone(deltime);
         auto dk = dht::decorate_key(*_schema, pk);
         _reader->on_next_partition(std::move(dk), tombstone(deltime));
         return proceed(!_reader->is_buffer_full() && !need_preempt());
@@ -1322,6 +1302,19 @@ public:
             return proceed::yes;
         }
         check_schema_mismatch(column_info, column_def);
+        if (!is_deleted) {
+            auto shadow = current_shadowing_tombstone();
+            if (column_def.is_multi_cell()) {
+                shadow.apply(_cm.tomb);
+            }
+            if (timestamp <= shadow.timestamp) {
+                // The cell cannot survive reconciliation with the tombstones
+                // this stream carries, so don't materialize its payload. The
+                // shadowing tombstone itself is still emitted, so merging
+                // with other sources is unaffected.
+                return proceed::yes;
+            }
+        }
         if (column_def.is_multi_cell()) {
             auto& value_type = visit(*column_def.type, make_visitor(
                 [] (const collection_type_impl& ctype) -> const abstract_type& { return *ctype.value_comparator(); },
@@ -1400,6 +1393,9 @@ public:
             return proceed::yes;
         }
         check_schema_mismatch(column_info, column_def);
+        if (timestamp <= current_shadowing_tombstone().timestamp) {
+            return proceed::yes;
+        }
         auto ac = make_counter_cell(timestamp, value);
         _cells.push_back({*column_id, atomic_cell_or_collection(std::move(ac))});
         return proceed::yes;
@@ -28,10 +28,12 @@
 #include "sstables/types.hh"
 #include "sstables/mx/types.hh"
 #include "db/config.hh"
+#include "db/blocked_bloom_filter_extension.hh"
 #include "atomic_cell.hh"
 #include "utils/exceptions.hh"
 
 #include <functional>
+#include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/container/static_vector.hpp>
 #include <boost/range/adaptor/indexed.hpp>
@@ -563,6 +565,11 @@ private:
     range_tombstone_stream _range_tombstones;
     bytes_ostream _tmp_bufs;
 
+    // Whether the schema has any non-atomic (collection or non-frozen UDT)
+    // columns of the given kind. Gates the per-row complex-deletion pre-pass.
+    bool _has_complex_static_columns;
+    bool _has_complex_regular_columns;
+
     const sstable_schema _sst_schema;
 
     struct cdef_and_collection {
@@ -761,6 +768,10 @@ public:
         , _shard(shard)
         , _range_tombstones(_schema, reader_semaphore.make_permit(&s, "mx-writer"))
         , _tmp_bufs(_sst.sstable_buffer_size)
+        , _has_complex_static_columns(boost::algorithm::any_of(s.static_columns(),
+                [] (const column_definition& cdef) { return !cdef.is_atomic(); }))
+        , _has_complex_regular_columns(boost::algorithm::any_of(s.regular_columns(),
+                [] (const column_definition& cdef) { return !cdef.is_atomic(); }))
         , _sst_schema(make_sstable_schema(s, _enc_stats, _cfg))
         , _run_identifier(cfg.run_identifier)
         , _write_regular_as_static(s.is_static_compact_table())
@@ -798,15 +809,28 @@ public:
 
         _sst.generate_toc(_schema.get_compressor_params().get_compressor(), _schema.bloom_filter_fp_chance());
         _sst.write_toc(_pc);
-        _sst.create_data().get();
+        _sst.create_data(_cfg.estimated_output_size).get();
         _compression_enabled = !_sst.has_component(component_type::CRC);
         init_file_writers();
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format,
+                db::blocked_bloom_filter_extension::filter_mode(_schema));
         _pi_write_m.desired_block_size = cfg.promoted_index_block_size;
+        if (_compression_enabled) {
+            // With compression the promoted index is the only row-aligned
+            // resume point the reader has, so an index block spanning several
+            // compression chunks forces narrow slices to decompress all of
+            // them. Align the block size with the chunk length (never growing
+            // it) so index-driven skips can step over whole chunks; the
+            // per-block min/max clustering and open-marker metadata the
+            // reader needs is already part of every promoted index entry.
+            auto chunk_len = size_t(_schema.get_compressor_params().chunk_length());
+            _pi_write_m.desired_block_size = std::min(_pi_write_m.desired_block_size, chunk_len);
+        }
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
+        _index_sampling_state.summary_memory_budget = _cfg.summary_memory_budget;
         prepare_summary(_sst._components->summary, estimated_partitions, _schema.min_index_interval());
     }
 
@@ -880,6 +904,13 @@ void writer::init_file_writers() {
     options.io_priority_class = _pc;
     options.buffer_size = _sst.sstable_buffer_size;
     options.write_behind = 10;
+    if (_cfg.estimated_output_size) {
+        // Bulk output (compaction): write in large aligned batches, with a
+        // correspondingly lower write-behind depth so the amount of memory
+        // in flight stays roughly the same.
+        options.buffer_size = std::max<unsigned>(options.buffer_size, 1 << 20);
+        options.write_behind = 4;
+    }
 
     if (!_compression_enabled) {
         auto out = make_file_data_sink(std::move(_sst._data_file), options).get0();
@@ -989,6 +1020,7 @@ void writer::drain_tombstones(std::optional<position_in_partition_view> pos) {
 
 void writer::consume_new_partition(const dht::decorated_key& dk) {
     _c_stats.start_offset = _data_writer->offset();
+    _c_stats.token = dk.token();
     _prev_row_start = _data_writer->offset();
 
     _partition_key = key::from_partition_key(_schema, dk.key());
@@ -1290,7 +1322,8 @@ void writer::write_static_row(const row& static_row, column_kind kind) {
     if (static_row.size() == _sst_schema.static_columns.size()) {
         flags |= row_flags::has_all_columns;
     }
-    bool has_complex_deletion = row_has_complex_deletion(_schema, static_row, kind);
+    bool has_complex_deletion = (kind == column_kind::static_column ? _has_complex_static_columns : _has_complex_regular_columns)
+            && row_has_complex_deletion(_schema, static_row, kind);
     if (has_complex_deletion) {
         flags |= row_flags::has_complex_deletion;
     }
@@ -1337,7 +1370,8 @@ void writer::write_clustered(const clustering_row& clustered_row, uint64_t prev_
     if (clustered_row.cells().size() == _sst_schema.regular_columns.size()) {
         flags |= row_flags::has_all_columns;
     }
-    bool has_complex_deletion = row_has_complex_deletion(_schema, clustered_row.cells(), column_kind::regular_column);
+    bool has_complex_deletion = _has_complex_regular_columns
+            && row_has_complex_deletion(_schema, clustered_row.cells(), column_kind::regular_column);
     if (has_complex_deletion) {
         flags |= row_flags::has_complex_deletion;
     }
@@ -1499,7 +1533,8 @@ void writer::consume_end_of_stream() {
     auto features = sstable_enabled_features::all();
     run_identifier identifier{_run_identifier};
     std::optional<scylla_metadata::large_data_stats> ld_stats(std::move(_large_data_stats));
-    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), std::move(ld_stats), _cfg.origin);
+    _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), std::move(ld_stats), _cfg.origin,
+            _collector.get_tombstone_density());
     if (!_cfg.leave_unsealed) {
         _sst.seal_sstable(_cfg.backup).get();
     }
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "index_entry.hh"
+#include <boost/intrusive/list.hpp>
+#include <seastar/core/future.hh>
+#include <seastar/core/memory.hh>
+#include <unordered_map>
+#include "utils/loading_shared_values.hh"
+#include "utils/chunked_vector.hh"
+
+namespace sstables {
+
+using index_list = utils::chunked_vector<index_entry>;
+
+namespace bi = boost::intrusive;
+
+// Shard-wide cache of parsed partition index pages.
+//
+// Each sstable owns one instance, which (like the shared_index_lists it
+// replaces) deduplicates concurrent loads of the same page. In addition,
+// pages stay cached after the last reader drops its reference: the cache
+// keeps its own reference and links the page on a shard-global LRU, so
+// repeated point reads of hot sstables skip both the index file read and
+// the binary parse of index entries.
+//
+// Retained pages from all sstables on this shard are accounted against a
+// common byte budget. When the budget is exceeded, the least recently
+// used retained pages are dropped, regardless of which sstable owns them.
+// Pages still referenced by a reader are never dropped; only the cache's
+// own retaining reference is.
+class partition_index_cache {
+public:
+    using key_type = uint64_t;
+    static thread_local struct stats {
+        uint64_t hits = 0; // Number of times entry was found ready
+        uint64_t misses = 0; // Number of times entry was not found
+        uint64_t blocks = 0; // Number of times entry was not ready (>= misses)
+        uint64_t evictions = 0; // Number of times a retained page was dropped due to memory pressure
+        uint64_t used_bytes = 0; // Memory consumed by pages retained by the cache across all sstables on this shard
+    } _shard_stats;
+
+    struct stats_updater {
+        static void inc_hits() noexcept { ++_shard_stats.hits; }
+        static void inc_misses() noexcept { ++_shard_stats.misses; }
+        static void inc_blocks() noexcept { ++_shard_stats.blocks; }
+        static void inc_evictions() noexcept {}
+    };
+
+    using loading_shared_lists_type = utils::loading_shared_values<key_type, index_list, std::hash<key_type>, std::equal_to<key_type>, stats_updater>;
+    // Pointer to index_list
+    using list_ptr = loading_shared_lists_type::entry_ptr;
+private:
+    struct retained_page {
+        partition_index_cache* owner;
+        key_type key;
+        list_ptr list;
+        size_t size = 0;
+        bi::list_member_hook<> lru_link;
+
+        retained_page(partition_index_cache* owner, key_type key, list_ptr list)
+            : owner(owner), key(key), list(std::move(list)) {
+            for (const index_entry& e : *this->list) {
+                size += e.external_memory_usage();
+            }
+        }
+    };
+
+    using lru_type = bi::list<retained_page,
+        bi::member_hook<retained_page, bi::list_member_hook<>, &retained_page::lru_link>,
+        bi::constant_time_size<false>>;
+
+    // LRU of retained pages, shared by all sstables on this shard.
+    // Most recently used pages are at the front.
+    static thread_local lru_type _shard_lru;
+
+    loading_shared_lists_type _lists;
+    std::unordered_map<key_type, std::unique_ptr<retained_page>> _retained;
+private:
+    static size_t shard_budget() {
+        // Same fraction as the dirty memory soft limit uses for headroom;
+        // parsed index pages are a second-order cache so keep them on a
+        // short leash.
+        return seastar::memory::stats().total_memory() / 50;
+    }
+
+    static void trim_to_budget() {
+        while (_shard_stats.used_bytes > shard_budget() && !_shard_lru.empty()) {
+            retained_page& victim = _shard_lru.back();
+            ++_shard_stats.evictions;
+            victim.owner->drop(victim.key);
+        }
+    }
+
+    void retain(key_type key, list_ptr list) {
+        auto it = _retained.find(key);
+        if (it != _retained.end()) {
+            // Move to the front of the shard LRU.
+            auto& page = *it->second;
+            page.lru_link.unlink();
+            _shard_lru.push_front(page);
+            return;
+        }
+        auto page = std::make_unique<retained_page>(this, key, std::move(list));
+        _shard_stats.used_bytes += page->size;
+        _shard_lru.push_front(*page);
+        _retained.emplace(key, std::move(page));
+        trim_to_budget();
+    }
+
+    void drop(key_type key) noexcept {
+        auto it = _retained.find(key);
+        if (it != _retained.end()) {
+            _shard_stats.used_bytes -= it->second->size;
+            it->second->lru_link.unlink();
+            _retained.erase(it);
+        }
+    }
+public:
+    partition_index_cache() = default;
+    partition_index_cache(partition_index_cache&&) = delete;
+    partition_index_cache(const partition_index_cache&) = delete;
+
+    ~partition_index_cache() {
+        for (auto&& [key, page] : _retained) {
+            _shard_stats.used_bytes -= page->size;
+            page->lru_link.unlink();
+        }
+    }
+
+    // Returns a future which resolves with a shared pointer to index_list for given key.
+    // Always returns a valid pointer if succeeds. The pointer is never invalidated externally.
+    //
+    // If entry is missing, the loader is invoked. If list is already loading, this invocation
+    // will wait for prior loading to complete and use its result when it's done.
+    //
+    // The returned page is also retained by the cache (subject to the shard-wide
+    // memory budget), so a subsequent get_or_load() of the same key is likely to
+    // hit even if no reader held on to the page in the meantime.
+    //
+    // The loader object does not survive deferring, so the caller must deal with its liveness.
+    template<typename Loader>
+    future<list_ptr> get_or_load(const key_type& key, Loader&& loader) {
+        return _lists.get_or_load(key, std::forward<Loader>(loader)).then([this, key] (list_ptr ref) {
+            retain(key, ref);
+            return ref;
+        });
+    }
+
+    // Drops all pages retained by this cache (but not pages referenced by readers).
+    void evict_gently() noexcept {
+        for (auto it = _retained.begin(); it != _retained.end();) {
+            _shard_stats.used_bytes -= it->second->size;
+            it->second->lru_link.unlink();
+            it = _retained.erase(it);
+        }
+    }
+
+    static const stats& shard_stats() { return _shard_stats; }
+};
+
+}
@@ -20,6 +20,13 @@
  */
 
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/lexical_cast.hpp>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/thread.hh>
 #include "sstables/sstable_directory.hh"
 #include "sstables/sstables.hh"
 #include "sstables/compaction_manager.hh"
@@ -34,13 +41,19 @@ namespace sstables {
 
 bool manifest_json_filter(const fs::path&, const directory_entry& entry) {
     // Filter out directories. If type of the entry is unknown - check its name.
-    if (entry.type.value_or(directory_entry_type::regular) != directory_entry_type::directory && (entry.name == "manifest.json" || entry.name == "schema.cql")) {
+    if (entry.type.value_or(directory_entry_type::regular) != directory_entry_type::directory && (entry.name == "manifest.json" || entry.name == "schema.cql"
+            || entry.name == sstable_directory::ownership_manifest_basename() || entry.name == sstable_directory::ownership_manifest_basename() + ".tmp")) {
         return false;
     }
 
     return true;
 }
 
+// Bumped whenever the on-disk layout of the ownership manifest changes. Manifests written with
+// a different version - or under a different shard count, which invalidates every owner in
+// them - are ignored and the boot falls back to opening every SSTable.
+static constexpr unsigned ownership_manifest_format = 1;
+
 sstable_directory::sstable_directory(fs::path sstable_dir,
         unsigned load_parallelism,
         semaphore& load_semaphore,
@@ -58,6 +71,7 @@ sstable_directory::sstable_directory(fs::path sstable_dir,
     , _allow_loading_materialized_view(allow_mv)
     , _sstable_object_from_existing_sstable(std::move(sstable_from_existing))
     , _unshared_remote_sstables(smp::count)
+    , _unshared_remote_descriptors(smp::count)
 {}
 
 void
@@ -112,6 +126,19 @@ sstable_directory::process_descriptor(sstables::entry_descriptor desc, const ::i
         _max_version_seen = desc.version;
     }
 
+    // If a previous boot recorded this generation's owner and it is a foreign shard, hand the
+    // descriptor over without opening the SSTable here: the owner will do the one load that is
+    // needed anyway. Mutating the level requires the SSTable open on this shard, so that path
+    // keeps the old behavior.
+    if (sort_sstables_according_to_owner && !_need_mutate_level) {
+        auto it = _manifest_owners.find(desc.generation);
+        if (it != _manifest_owners.end() && it->second != this_shard_id()) {
+            dirlog.trace("Generation {} identified as owned by shard {} by the ownership manifest", desc.generation, it->second);
+            _unshared_remote_descriptors[it->second].push_back(std::move(desc));
+            return make_ready_future<>();
+        }
+    }
+
     auto sst = _sstable_object_from_existing_sstable(_sstable_dir, desc.generation, desc.version, desc.format);
     return sst->load(iop).then([this, sst] {
         validate(sst);
@@ -162,6 +189,96 @@ sstable_directory::highest_version_seen() const {
     return _max_version_seen;
 }
 
+future<>
+sstable_directory::read_ownership_manifest() {
+    return seastar::async([this] {
+        auto manifest = (_sstable_dir / fs::path(ownership_manifest_basename())).native();
+        if (!file_exists(manifest).get0()) {
+            return;
+        }
+        try {
+            auto f = open_file_dma(manifest, open_flags::ro).get0();
+            auto size = f.size().get0();
+            auto in = make_file_input_stream(f);
+            auto text = in.read_exactly(size).get0();
+            in.close().get();
+            f.close().get();
+
+            sstring all(text.begin(), text.end());
+            std::vector<sstring> lines;
+            boost::split(lines, all, boost::is_any_of("\n"), boost::token_compress_on);
+
+            std::unordered_map<int64_t, shard_id> owners;
+            bool header_seen = false;
+            for (auto& line : lines) {
+                if (line.empty()) {
+                    continue;
+                }
+                std::vector<sstring> fields;
+                boost::split(fields, line, boost::is_any_of(" "));
+                if (fields.size() != 2) {
+                    throw std::runtime_error(format("malformed line \"{}\"", line));
+                }
+                if (!header_seen) {
+                    header_seen = true;
+                    if (boost::lexical_cast<unsigned>(fields[0]) != ownership_manifest_format || boost::lexical_cast<unsigned>(fields[1]) != smp::count) {
+                        dirlog.debug("Ignoring ownership manifest {}: written with format {} for {} shards", manifest, fields[0], fields[1]);
+                        return;
+                    }
+                    continue;
+                }
+                auto shard = boost::lexical_cast<shard_id>(fields[1]);
+                if (shard >= smp::count) {
+                    throw std::runtime_error(format("shard {} out of range", shard));
+                }
+                owners.emplace(boost::lexical_cast<int64_t>(fields[0]), shard);
+            }
+            _manifest_owners = std::move(owners);
+            dirlog.debug("Loaded ownership manifest for {}: {} entries", _sstable_dir, _manifest_owners.size());
+        } catch (...) {
+            dirlog.warn("Error reading ownership manifest {}: {}. Ignoring.", manifest, std::current_exception());
+        }
+    });
+}
+
+std::vector<sstable_directory::manifest_entry>
+sstable_directory::local_ownership_entries() const {
+    return boost::copy_range<std::vector<manifest_entry>>(_unshared_local_sstables | boost::adaptors::transformed([] (const sstables::shared_sstable& sst) {
+        return manifest_entry(sst->generation(), this_shard_id());
+    }));
+}
+
+future<>
+sstable_directory::store_ownership_manifest(std::vector<manifest_entry> entries) {
+    return seastar::async([this, entries = std::move(entries)] {
+        auto manifest = (_sstable_dir / fs::path(ownership_manifest_basename())).native();
+        auto tmp_manifest = manifest + ".tmp";
+        try {
+            auto f = open_file_dma(tmp_manifest, open_flags::wo | open_flags::create | open_flags::truncate).get0();
+            auto out = make_file_output_stream(std::move(f)).get0();
+            auto header = format("{} {}\n", ownership_manifest_format, smp::count);
+            out.write(header.c_str(), header.size()).get();
+            for (const auto& [generation, shard] : entries) {
+                auto line = format("{} {}\n", generation, shard);
+                out.write(line.c_str(), line.size()).get();
+            }
+            out.flush().get();
+            out.close().get();
+
+            auto dir_f = open_directory(_sstable_dir.native()).get0();
+            // Once flushed and closed, the temporary manifest can be renamed.
+            rename_file(tmp_manifest, manifest).get();
+
+            // Guarantee that the changes above reached the disk.
+            dir_f.flush().get();
+            dir_f.close().get();
+            dirlog.debug("Wrote ownership manifest for {}: {} entries", _sstable_dir, entries.size());
+        } catch (...) {
+            dirlog.warn("Error writing ownership manifest {}: {}. Ignoring.", manifest, std::current_exception());
+        }
+    });
+}
+
 future<>
 sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort_sstables_according_to_owner) {
     dirlog.debug("Start processing directory {} for SSTables", _sstable_dir);
@@ -177,7 +294,8 @@ sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort
     //   to make sure they all update their own version of scan_state and then merge it.
     // - If all shards scan in parallel, they can start loading sooner. That is faster than having
     //   a separate step to fetch all files, followed by another step to distribute and process.
-    return do_with(scan_state{}, [this, sort_sstables_according_to_owner, &iop] (scan_state& state) {
+    return read_ownership_manifest().then([this, sort_sstables_according_to_owner, &iop] {
+      return do_with(scan_state{}, [this, sort_sstables_according_to_owner, &iop] (scan_state& state) {
         return lister::scan_dir(_sstable_dir, { directory_entry_type::regular },
                 [this, sort_sstables_according_to_owner, &state] (fs::path parent_dir, directory_entry de) {
             auto comps = sstables::entry_descriptor::make_descriptor(_sstable_dir.native(), de.name);
@@ -227,6 +345,7 @@ sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort
                 }
             });
         });
+      });
     });
 }
 
@@ -240,16 +359,21 @@ sstable_directory::commit_directory_changes() {
 }
 
 future<>
-sstable_directory::move_foreign_sstables(sharded<sstable_directory>& source_directory) {
-    return parallel_for_each(boost::irange(0u, smp::count), [this, &source_directory] (unsigned shard_id) mutable {
+sstable_directory::move_foreign_sstables(sharded<sstable_directory>& source_directory, const ::io_priority_class& iop) {
+    return parallel_for_each(boost::irange(0u, smp::count), [this, &source_directory, iop] (unsigned shard_id) mutable {
         auto info_vec = std::exchange(_unshared_remote_sstables[shard_id], {});
-        if (info_vec.empty()) {
+        auto desc_vec = std::exchange(_unshared_remote_descriptors[shard_id], {});
+        if (info_vec.empty() && desc_vec.empty()) {
             return make_ready_future<>();
         }
         // Should be empty, since an SSTable that belongs to this shard is not remote.
         assert(shard_id != this_shard_id());
-        dirlog.debug("Moving {} unshared SSTables to shard {} ", info_vec.size(), shard_id);
-        return source_directory.invoke_on(shard_id, &sstables::sstable_directory::load_foreign_sstables, std::move(info_vec));
+        dirlog.debug("Moving {} unshared SSTables and {} descriptors to shard {} ", info_vec.size(), desc_vec.size(), shard_id);
+        return source_directory.invoke_on(shard_id, [info_vec = std::move(info_vec), desc_vec = std::move(desc_vec), iop] (sstable_directory& d) mutable {
+            return d.load_foreign_sstables(std::move(info_vec)).then([&d, desc_vec = std::move(desc_vec), iop] () mutable {
+                return d.load_foreign_descriptors(std::move(desc_vec), iop);
+            });
+        });
     });
 }
 
@@ -264,6 +388,21 @@ sstable_directory::load_foreign_sstables(sstable_info_vector info_vec) {
     });
 }
 
+future<>
+sstable_directory::load_foreign_descriptors(scan_descriptors descs, ::io_priority_class iop) {
+    return parallel_for_each_restricted(std::move(descs), [this, iop] (sstables::entry_descriptor& desc) {
+        auto sst = _sstable_object_from_existing_sstable(_sstable_dir, desc.generation, desc.version, desc.format);
+        return sst->load(iop).then([sst, this] {
+            validate(sst);
+            // The manifest is rewritten on every boot and generations are never reused, so the
+            // recorded owner should always be this shard. Still classify through the generic
+            // path, which copes with a manifest that turned out to be stale: a shared or
+            // misattributed SSTable will simply take another hop.
+            return sort_sstable(std::move(sst));
+        });
+    });
+}
+
 future<>
 sstable_directory::remove_input_sstables_from_resharding(std::vector<sstables::shared_sstable> sstlist) {
     dirlog.debug("Removing {} resharded SSTables", sstlist.size());
@@ -61,6 +61,9 @@ public:
     // favor chunked vectors when dealing with file lists: they can grow to hundreds of thousands
     // of elements.
     using sstable_info_vector = utils::chunked_vector<sstables::foreign_sstable_open_info>;
+
+    // An entry in the ownership manifest: an SSTable generation and the shard that owns it.
+    using manifest_entry = std::pair<int64_t, shard_id>;
 private:
     using scan_multimap = std::unordered_multimap<int64_t, std::filesystem::path>;
     using scan_descriptors = utils::chunked_vector<sstables::entry_descriptor>;
@@ -118,6 +121,17 @@ private:
     // the amount of data resharded per shard, so a coordinator may redistribute this.
     sstable_info_vector _shared_sstable_info;
 
+    // Owners recorded by a previous boot in the ownership manifest. Generations scanned by this
+    // shard but owned by another one can be handed over without opening the SSTable here: the
+    // owner will do the one load that is needed anyway. Empty if there is no manifest or it was
+    // written under a different shard count.
+    std::unordered_map<int64_t, shard_id> _manifest_owners;
+
+    // Descriptors for SSTables that the ownership manifest assigns to foreign shards. Like
+    // _unshared_remote_sstables, the indexes of the outer vector represent the shards, and
+    // having anything in the index representing this shard is illegal.
+    std::vector<scan_descriptors> _unshared_remote_descriptors;
+
     future<> process_descriptor(sstables::entry_descriptor desc, const ::io_priority_class& iop, bool sort_sstables_according_to_owner = true);
     void validate(sstables::shared_sstable sst) const;
     void handle_component(scan_state& state, sstables::entry_descriptor desc, std::filesystem::path filename);
@@ -130,6 +144,8 @@ private:
     template <typename Container, typename Func>
     future<> parallel_for_each_restricted(Container&& C, Func&& func);
     future<> load_foreign_sstables(sstable_info_vector info_vec);
+    future<> load_foreign_descriptors(scan_descriptors descs, ::io_priority_class iop);
+    future<> read_ownership_manifest();
 
     std::vector<sstables::shared_sstable> _unsorted_sstables;
 public:
@@ -146,8 +162,10 @@ public:
         return _unsorted_sstables;
     }
 
-    // moves unshared SSTables that don't belong to this shard to the right shards.
-    future<> move_foreign_sstables(sharded<sstable_directory>& source_directory);
+    // moves unshared SSTables that don't belong to this shard to the right shards. SSTables whose
+    // owner was recorded in the ownership manifest are moved as descriptors and opened on the
+    // owning shard only, which is what the I/O priority is for.
+    future<> move_foreign_sstables(sharded<sstable_directory>& source_directory, const ::io_priority_class& iop);
 
     // returns what is the highest generation seen in this directory.
     int64_t highest_generation_seen() const;
@@ -208,6 +226,20 @@ public:
     // is called.
     sstable_info_vector retrieve_shared_sstables();
 
+    // Returns an ownership manifest entry for every unshared SSTable owned by this shard.
+    // Meant to be called after the directory was fully processed, so that the entries
+    // describe the final layout.
+    std::vector<manifest_entry> local_ownership_entries() const;
+
+    // Atomically replaces the ownership manifest of this directory with the given entries.
+    // The manifest is advisory: errors are logged and swallowed, and a reboot that cannot
+    // use it falls back to opening every SSTable to determine ownership.
+    future<> store_ownership_manifest(std::vector<manifest_entry> entries);
+
+    static sstring ownership_manifest_basename() {
+        return "ownership.manifest";
+    }
+
     std::filesystem::path sstable_dir() const noexcept {
         return _sstable_dir;
     }
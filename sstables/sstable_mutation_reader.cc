@@ -103,12 +103,13 @@ std::vector<column_translation::column_info> column_translation::state::build(
         const schema& s,
         const utils::chunked_vector<serialization_header::column_desc>& src,
         const sstable_enabled_features& features,
+        std::list<bytes>& name_storage,
         bool is_static) {
     std::vector<column_info> cols;
     if (s.is_dense()) {
         const column_definition& col = is_static ? *s.static_begin() : *s.regular_begin();
         cols.push_back(column_info{
-            &col.name(),
+            &name_storage.emplace_back(col.name()),
             col.type,
             col.id,
             col.type->value_length_if_fixed(),
@@ -135,7 +136,7 @@ std::vector<column_translation::column_info> column_translation::state::build(
                                   !def->type->is_value_compatible_with(*type);
             }
             cols.push_back(column_info{
-                &desc.name.value,
+                &name_storage.emplace_back(desc.name.value),
                 type,
                 id,
                 type->value_length_if_fixed(),
@@ -23,6 +23,7 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/algorithm/sort.hpp>
+#include <boost/range/irange.hpp>
 
 #include "compatible_ring_position.hh"
 #include "compaction_strategy_impl.hh"
@@ -74,7 +75,8 @@ sstable_set::sstable_set(std::unique_ptr<sstable_set_impl> impl, schema_ptr s)
 
 sstable_set::sstable_set(const sstable_set& x)
         : _impl(x._impl->clone())
-        , _schema(x._schema) {
+        , _schema(x._schema)
+        , _size_histogram(x._size_histogram) {
 }
 
 sstable_set::sstable_set(sstable_set&&) noexcept = default;
@@ -122,11 +124,120 @@ void sstable_set::for_each_sstable(std::function<void(const shared_sstable&)> fu
 void
 sstable_set::insert(shared_sstable sst) {
     _impl->insert(sst);
+    // Update the histogram only once the impl accepted the sstable, so a
+    // throwing impl cannot leave the estimates out of sync with the set.
+    _size_histogram.add(*sst);
 }
 
 void
 sstable_set::erase(shared_sstable sst) {
     _impl->erase(sst);
+    _size_histogram.remove(*sst);
+}
+
+void token_range_size_histogram::apply(const sstable& sst, int64_t sign) {
+    static constexpr uint64_t sign_flip = uint64_t(1) << 63;
+    if (_buckets.empty()) {
+        _buckets.resize(bucket_count);
+    }
+    const auto first = unsigned((uint64_t(sst.get_first_decorated_key().token().raw()) ^ sign_flip) >> bucket_shift);
+    const auto last = unsigned((uint64_t(sst.get_last_decorated_key().token().raw()) ^ sign_flip) >> bucket_shift);
+    const int64_t n = last - first + 1;
+    const int64_t partitions = sst.get_estimated_key_count();
+    const int64_t data_size = sst.data_size();
+    for (auto i = first; i <= last; ++i) {
+        // An even split with the remainder going to the first bucket keeps
+        // add() and remove() exactly symmetric for a given sstable.
+        _buckets[i].partitions += sign * (partitions / n + (i == first ? partitions % n : 0));
+        _buckets[i].data_size += sign * (data_size / n + (i == first ? data_size % n : 0));
+    }
+}
+
+void token_range_size_histogram::add(const sstable& sst) {
+    apply(sst, 1);
+}
+
+void token_range_size_histogram::remove(const sstable& sst) {
+    apply(sst, -1);
+}
+
+void token_range_size_histogram::merge(const token_range_size_histogram& o) {
+    if (o._buckets.empty()) {
+        return;
+    }
+    if (_buckets.empty()) {
+        _buckets.resize(bucket_count);
+    }
+    for (unsigned i = 0; i < bucket_count; ++i) {
+        _buckets[i].partitions += o._buckets[i].partitions;
+        _buckets[i].data_size += o._buckets[i].data_size;
+    }
+}
+
+token_range_size_histogram::estimate
+token_range_size_histogram::estimate_for(const dht::token_range& r) const {
+    if (_buckets.empty()) {
+        return {};
+    }
+    static constexpr uint64_t sign_flip = uint64_t(1) << 63;
+    const auto start_raw = r.start() ? r.start()->value().raw() : std::numeric_limits<int64_t>::min();
+    const auto end_raw = r.end() ? r.end()->value().raw() : std::numeric_limits<int64_t>::max();
+    const uint64_t start = uint64_t(start_raw) ^ sign_flip;
+    const uint64_t end = uint64_t(end_raw) ^ sign_flip;
+    if (end < start) {
+        return {};
+    }
+    constexpr uint64_t bucket_width = uint64_t(1) << bucket_shift;
+    estimate res;
+    for (auto i = unsigned(start >> bucket_shift); i <= unsigned(end >> bucket_shift); ++i) {
+        const uint64_t bucket_begin = uint64_t(i) << bucket_shift;
+        const uint64_t overlap = std::min(bucket_begin + (bucket_width - 1), end) - std::max(bucket_begin, start) + 1;
+        const auto fraction = double(overlap) / double(bucket_width);
+        res.partitions += int64_t(double(_buckets[i].partitions) * fraction);
+        res.data_size += int64_t(double(_buckets[i].data_size) * fraction);
+    }
+    return res;
+}
+
+dht::token_range_vector
+token_range_size_histogram::split_ranges(const dht::token_range& r, uint64_t target_data_size) const {
+    dht::token_range_vector res;
+    target_data_size = std::max<uint64_t>(target_data_size, 1);
+    if (_buckets.empty()) {
+        res.push_back(r);
+        return res;
+    }
+    static constexpr uint64_t sign_flip = uint64_t(1) << 63;
+    const auto start_raw = r.start() ? r.start()->value().raw() : std::numeric_limits<int64_t>::min();
+    const auto end_raw = r.end() ? r.end()->value().raw() : std::numeric_limits<int64_t>::max();
+    const uint64_t start = uint64_t(start_raw) ^ sign_flip;
+    const uint64_t end = uint64_t(end_raw) ^ sign_flip;
+    if (end < start) {
+        res.push_back(r);
+        return res;
+    }
+    constexpr uint64_t bucket_width = uint64_t(1) << bucket_shift;
+    auto current_start = r.start();
+    uint64_t acc = 0;
+    const auto first = unsigned(start >> bucket_shift);
+    const auto last = unsigned(end >> bucket_shift);
+    for (auto i = first; i <= last; ++i) {
+        const uint64_t bucket_begin = uint64_t(i) << bucket_shift;
+        const uint64_t bucket_end = bucket_begin + (bucket_width - 1);
+        const uint64_t overlap = std::min(bucket_end, end) - std::max(bucket_begin, start) + 1;
+        const auto fraction = double(overlap) / double(bucket_width);
+        acc += uint64_t(std::max(double(_buckets[i].data_size) * fraction, 0.0));
+        // Cutting only whole buckets (i < last) guarantees every emitted
+        // subrange is non-empty and the final one ends exactly at r.end().
+        if (acc >= target_data_size && i < last) {
+            auto cut = dht::token::from_int64(int64_t(bucket_end ^ sign_flip));
+            res.push_back(dht::token_range(current_start, dht::token_range::bound(cut, true)));
+            current_start = dht::token_range::bound(cut, false);
+            acc = 0;
+        }
+    }
+    res.push_back(dht::token_range(std::move(current_start), r.end()));
+    return res;
 }
 
 sstable_set::~sstable_set() = default;
@@ -683,18 +794,30 @@ public:
 // Assumes the given `pos` and `schema` are alive during the function's lifetime.
 static std::predicate<const sstable&> auto
 make_pk_filter(const dht::ring_position& pos, const schema& schema) {
-    return [&pos, key = key::from_partition_key(schema, *pos.key()), cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
+    // The key is hashed once here, not once per probed sstable.
+    return [&pos, hk = sstable::make_hashed_key(schema, *pos.key()), cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
         return cmp(pos, sst.get_first_decorated_key()) >= 0 &&
                cmp(pos, sst.get_last_decorated_key()) <= 0 &&
-               sst.filter_has_key(key);
+               sst.filter_has_key(hk);
     };
 }
 
 // Filter out sstables for reader using bloom filter
 static std::vector<shared_sstable>
 filter_sstable_for_reader_by_pk(std::vector<shared_sstable>&& sstables, const schema& schema, const dht::ring_position& pos) {
-    auto filter = [_filter = make_pk_filter(pos, schema)] (const shared_sstable& sst) { return !_filter(*sst); };
-    sstables.erase(boost::remove_if(sstables, filter), sstables.end());
+    auto cmp = dht::ring_position_comparator(schema);
+    auto out_of_range = [&] (const shared_sstable& sst) {
+        return cmp(pos, sst->get_first_decorated_key()) < 0 || cmp(pos, sst->get_last_decorated_key()) > 0;
+    };
+    sstables.erase(boost::remove_if(sstables, out_of_range), sstables.end());
+    // Hash the key once and prefetch all the filters up front, so that the
+    // probes' cache misses overlap instead of being taken serially, one per
+    // sstable.
+    auto hk = sstable::make_hashed_key(schema, *pos.key());
+    for (const shared_sstable& sst : sstables) {
+        sst->filter_prefetch(hk);
+    }
+    sstables.erase(boost::remove_if(sstables, [&] (const shared_sstable& sst) { return !sst->filter_has_key(hk); }), sstables.end());
     return std::move(sstables);
 }
 
@@ -737,6 +860,145 @@ sstable_set_impl::select_sstable_runs(const std::vector<shared_sstable>& sstable
     throw_with_backtrace<std::bad_function_call>();
 }
 
+// Reads one partition from a set of sstables, opening them newest-first.
+//
+// The sstables are ordered by the max timestamp from their stats metadata and
+// opened in waves of `wave_size`. After each wave the partition tombstones
+// seen so far (peeked from the partition_start fragments) are accumulated,
+// and any remaining sstable whose max timestamp is not above the accumulated
+// tombstone is dropped without being opened: everything it could contribute
+// is already deleted. The surviving readers are then merged by the regular
+// combined reader, which this reader delegates to.
+//
+// Only valid for single-partition reads without mutation_reader::forwarding,
+// since the shadowing decision is specific to the partition being read.
+class staged_single_key_reader : public flat_mutation_reader::impl {
+    static constexpr size_t wave_size = 4;
+
+    std::vector<shared_sstable> _unopened; // Sorted by max timestamp, oldest first.
+    std::function<flat_mutation_reader(const shared_sstable&)> _make_reader;
+    std::vector<flat_mutation_reader> _opened;
+    flat_mutation_reader_opt _underlying;
+    streamed_mutation::forwarding _fwd;
+    utils::estimated_histogram& _sstable_histogram;
+    tracing::trace_state_ptr _trace_state;
+    tombstone _shadow_tomb;
+    bool _done = false;
+private:
+    future<> open_next_wave(db::timeout_clock::time_point timeout) {
+        size_t wave_start = _opened.size();
+        while (!_unopened.empty() && _opened.size() - wave_start < wave_size) {
+            auto sst = std::move(_unopened.back());
+            _unopened.pop_back();
+            if (sst->get_stats_metadata().max_timestamp <= _shadow_tomb.timestamp) {
+                tracing::trace(_trace_state, "Skipping sstable {}: fully shadowed by partition tombstone {}",
+                        seastar::value_of([&sst] { return sst->get_filename(); }), _shadow_tomb);
+                continue;
+            }
+            _opened.push_back(_make_reader(sst));
+        }
+        return parallel_for_each(boost::irange(wave_start, _opened.size()), [this, timeout] (size_t i) {
+            return _opened[i].peek(timeout).then([this] (mutation_fragment* mf) {
+                if (mf && mf->is_partition_start()) {
+                    _shadow_tomb.apply(mf->as_partition_start().partition_tombstone());
+                }
+            });
+        });
+    }
+
+    future<> create_underlying(db::timeout_clock::time_point timeout) {
+        return repeat([this, timeout] {
+            if (_unopened.empty()) {
+                return make_ready_future<stop_iteration>(stop_iteration::yes);
+            }
+            return open_next_wave(timeout).then([] { return stop_iteration::no; });
+        }).then([this] {
+            _sstable_histogram.add(_opened.size());
+            _underlying = make_combined_reader(_schema, _permit, std::move(_opened), _fwd, mutation_reader::forwarding::no);
+            _opened.clear();
+        });
+    }
+public:
+    staged_single_key_reader(schema_ptr schema,
+            reader_permit permit,
+            std::vector<shared_sstable> unopened,
+            std::function<flat_mutation_reader(const shared_sstable&)> make_reader,
+            flat_mutation_reader_opt pre_opened,
+            streamed_mutation::forwarding fwd,
+            utils::estimated_histogram& sstable_histogram,
+            tracing::trace_state_ptr trace_state)
+        : impl(std::move(schema), std::move(permit))
+        , _unopened(std::move(unopened))
+        , _make_reader(std::move(make_reader))
+        , _fwd(fwd)
+        , _sstable_histogram(sstable_histogram)
+        , _trace_state(std::move(trace_state))
+    {
+        boost::sort(_unopened, [] (const shared_sstable& x, const shared_sstable& y) {
+            return x->get_stats_metadata().max_timestamp < y->get_stats_metadata().max_timestamp;
+        });
+        if (pre_opened) {
+            _opened.push_back(std::move(*pre_opened));
+        }
+    }
+
+    virtual future<> fill_buffer(db::timeout_clock::time_point timeout) override {
+        if (_done) {
+            _end_of_stream = true;
+            return make_ready_future<>();
+        }
+        if (!_underlying) {
+            return create_underlying(timeout).then([this, timeout] { return fill_buffer(timeout); });
+        }
+        if (is_buffer_full()) {
+            return make_ready_future<>();
+        }
+        return _underlying->fill_buffer(timeout).then([this] {
+            _end_of_stream = _underlying->is_end_of_stream();
+            _underlying->move_buffer_content_to(*this);
+        });
+    }
+
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (!is_buffer_empty()) {
+            return make_ready_future<>();
+        }
+        if (!_underlying) {
+            // Nothing was emitted yet, and this reader serves exactly one
+            // partition, so skipping past it means the stream is over.
+            _done = true;
+            _end_of_stream = true;
+            return make_ready_future<>();
+        }
+        return _underlying->next_partition().then([this] {
+            _end_of_stream = _underlying->is_end_of_stream() && _underlying->is_buffer_empty();
+        });
+    }
+
+    virtual future<> fast_forward_to(position_range pr, db::timeout_clock::time_point timeout) override {
+        _end_of_stream = false;
+        forward_buffer_to(pr.start());
+        if (!_underlying) {
+            return create_underlying(timeout).then([this, pr = std::move(pr), timeout] () mutable {
+                return _underlying->fast_forward_to(std::move(pr), timeout);
+            });
+        }
+        return _underlying->fast_forward_to(std::move(pr), timeout);
+    }
+
+    virtual future<> fast_forward_to(const dht::partition_range&, db::timeout_clock::time_point) override {
+        return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
+    }
+
+    virtual future<> close() noexcept override {
+        auto f = _underlying ? _underlying->close() : make_ready_future<>();
+        return f.then([this] {
+            return parallel_for_each(_opened, [] (flat_mutation_reader& r) { return r.close(); });
+        });
+    }
+};
+
 flat_mutation_reader
 sstable_set_impl::create_single_key_sstable_reader(
         column_family* cf,
@@ -756,8 +1018,25 @@ sstable_set_impl::create_single_key_sstable_reader(
     if (!num_sstables) {
         return make_empty_flat_reader(schema, permit);
     }
+    auto surviving_sstables = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice);
+
+    if (surviving_sstables.size() > 1 && fwd_mr == mutation_reader::forwarding::no) {
+        // Read the sstables newest-first, stopping the fan-out early when the
+        // older ones turn out to be fully shadowed by a partition tombstone.
+        auto make_reader = [schema, permit, &pr, &slice, &pc, trace_state, fwd, pos = &pos] (const shared_sstable& sstable) {
+            tracing::trace(trace_state, "Reading key {} from sstable {}", *pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
+            return sstable->make_reader(schema, permit, pr, slice, pc, trace_state, fwd);
+        };
+        flat_mutation_reader_opt pre_opened;
+        if (surviving_sstables.size() != num_sstables) {
+            pre_opened = flat_mutation_reader_from_mutations(permit, {mutation(schema, *pos.key())}, slice, fwd);
+        }
+        return make_flat_mutation_reader<staged_single_key_reader>(schema, permit, std::move(surviving_sstables),
+                std::move(make_reader), std::move(pre_opened), fwd, sstable_histogram, trace_state);
+    }
+
     auto readers = boost::copy_range<std::vector<flat_mutation_reader>>(
-        filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
+        surviving_sstables
         | boost::adaptors::transformed([&] (const shared_sstable& sstable) {
             tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
             return sstable->make_reader(schema, permit, pr, slice, pc, trace_state, fwd);
@@ -983,7 +1262,13 @@ std::unique_ptr<incremental_selector_impl> compound_sstable_set::make_incrementa
 }
 
 sstable_set make_compound_sstable_set(schema_ptr schema, std::vector<lw_shared_ptr<sstable_set>> sets) {
-    return sstable_set(std::make_unique<compound_sstable_set>(schema, std::move(sets)), schema);
+    auto ret = sstable_set(std::make_unique<compound_sstable_set>(schema, sets), schema);
+    // The compound set is rebuilt whenever one of the underlying sets
+    // changes, so summing their histograms here keeps its estimates fresh.
+    for (const auto& set : sets) {
+        ret._size_histogram.merge(set->size_histogram());
+    }
+    return ret;
 }
 
 flat_mutation_reader
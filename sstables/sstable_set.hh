@@ -49,9 +49,56 @@ public:
     const sstable_list& all() const { return _all; }
 };
 
+// Online per-token-range size estimates for a set of sstables.
+//
+// The token ring is split into a fixed number of equal-width buckets; each
+// bucket holds the estimated partition count and data size contributed by the
+// sstables overlapping it. add() and remove() are exactly symmetric, so the
+// histogram is maintained incrementally as sstables come and go, and
+// estimating a token range is a plain walk over the overlapping buckets --
+// no sstable metadata is touched on the query path (see
+// db/size_estimates_virtual_reader.cc).
+class token_range_size_histogram {
+public:
+    // 256 buckets keeps the footprint of a set copy small (sets are copied
+    // on every sstable add/remove) while still giving much finer splits
+    // than one estimate per primary range.
+    static constexpr unsigned bucket_shift = 56;
+    static constexpr unsigned bucket_count = 1u << (64 - bucket_shift);
+
+    struct estimate {
+        int64_t partitions = 0;
+        int64_t data_size = 0;
+    };
+private:
+    struct bucket {
+        int64_t partitions = 0;
+        int64_t data_size = 0;
+    };
+    // Lazily allocated on the first add(), so empty sets cost nothing.
+    std::vector<bucket> _buckets;
+private:
+    void apply(const sstable& sst, int64_t sign);
+public:
+    void add(const sstable& sst);
+    void remove(const sstable& sst);
+    void merge(const token_range_size_histogram& o);
+    // Estimated partition count and data size for the given range,
+    // with edge buckets included proportionally to their overlap.
+    estimate estimate_for(const dht::token_range& r) const;
+    // Splits the given range into consecutive subranges, each holding
+    // roughly target_data_size estimated bytes. Split points fall on
+    // bucket boundaries, so the resolution is limited to bucket_count
+    // subranges over the whole ring. Always returns at least one range;
+    // the subrange bounds partition r exactly, so the end token of each
+    // subrange can serve as a resumption point for a scan of r.
+    dht::token_range_vector split_ranges(const dht::token_range& r, uint64_t target_data_size) const;
+};
+
 class sstable_set : public enable_lw_shared_from_this<sstable_set> {
     std::unique_ptr<sstable_set_impl> _impl;
     schema_ptr _schema;
+    token_range_size_histogram _size_histogram;
 public:
     ~sstable_set();
     sstable_set(std::unique_ptr<sstable_set_impl> impl, schema_ptr s);
@@ -68,6 +115,7 @@ public:
     void for_each_sstable(std::function<void(const shared_sstable&)> func) const;
     void insert(shared_sstable sst);
     void erase(shared_sstable sst);
+    const token_range_size_histogram& size_histogram() const { return _size_histogram; }
 
     // Used to incrementally select sstables from sstable set using ring-position.
     // sstable set must be alive during the lifetime of the selector.
@@ -154,6 +202,8 @@ public:
             streamed_mutation::forwarding,
             mutation_reader::forwarding,
             read_monitor_generator& rmg = default_read_monitor_generator()) const;
+
+    friend sstable_set make_compound_sstable_set(schema_ptr schema, std::vector<lw_shared_ptr<sstable_set>> sets);
 };
 
 /// Read a range from the passed-in sstables.
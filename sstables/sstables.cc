@@ -34,6 +34,7 @@
 #include <seastar/core/shared_future.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/memory.hh>
 #include <seastar/util/closeable.hh>
 #include <iterator>
 #include <seastar/core/coroutine.hh>
@@ -1242,6 +1243,14 @@ double sstable::estimate_droppable_tombstone_ratio(gc_clock::time_point gc_befor
     return 0.0f;
 }
 
+column_translation sstable::get_column_translation(
+        const schema& s, const serialization_header& h, const sstable_enabled_features& f) {
+    if (!_column_translation.matches(s)) {
+        _column_translation = _manager.get_column_translation(s, h, f);
+    }
+    return _column_translation;
+}
+
 future<> sstable::read_statistics(const io_priority_class& pc) {
     return read_simple<component_type::Statistics>(_components->statistics, pc);
 }
@@ -1332,33 +1341,34 @@ future<> sstable::open_data() noexcept {
 }
 
 future<> sstable::update_info_for_opened_data() {
-    return _data_file.stat().then([this] (struct stat st) {
+    // The stat() calls are all independent, so issue them concurrently
+    // rather than paying a disk round trip for each.
+    auto data_stated = _data_file.stat().then([this] (struct stat st) {
         if (this->has_component(component_type::CompressionInfo)) {
             _components->compression.update(st.st_size);
         }
         _data_file_size = st.st_size;
         _data_file_write_time = db_clock::from_time_t(st.st_mtime);
-    }).then([this] {
-        return _index_file.size().then([this] (auto size) {
-            _index_file_size = size;
+    });
+    auto index_stated = _index_file.size().then([this] (auto size) {
+        _index_file_size = size;
+    });
+    auto filter_stated = make_ready_future<>();
+    if (this->has_component(component_type::Filter)) {
+        filter_stated = io_check([&] {
+            return file_size(this->filename(component_type::Filter));
+        }).then([this] (auto size) {
+            _filter_file_size = size;
         });
-    }).then([this] {
-        if (this->has_component(component_type::Filter)) {
-            return io_check([&] {
-                return file_size(this->filename(component_type::Filter));
-            }).then([this] (auto size) {
-                _filter_file_size = size;
-            });
-        }
-        return make_ready_future<>();
-    }).then([this] {
+    }
+    return when_all_succeed(std::move(data_stated), std::move(index_stated), std::move(filter_stated)).discard_result().then([this] {
         this->set_position_range();
         this->set_first_and_last_keys();
         _run_identifier = _components->scylla_metadata->get_optional_run_identifier().value_or(utils::make_random_uuid());
 
         // Get disk usage for this sstable (includes all components).
         _bytes_on_disk = 0;
-        return do_for_each(_recognized_components, [this] (component_type c) {
+        return parallel_for_each(_recognized_components, [this] (component_type c) {
             return this->sstable_write_io_check([&, c] {
                 return file_exists(this->filename(c)).then([this, c] (bool exists) {
                     // ignore summary that isn't present in disk but was previously generated by read_summary().
@@ -1374,10 +1384,18 @@ future<> sstable::update_info_for_opened_data() {
     });
 }
 
-future<> sstable::create_data() noexcept {
+future<> sstable::create_data(std::optional<uint64_t> size_hint) noexcept {
     auto oflags = open_flags::wo | open_flags::create | open_flags::exclusive;
     file_open_options opt;
     opt.extent_allocation_size_hint = 32 << 20;
+    if (size_hint) {
+        // Preallocating the estimated output size up front saves the
+        // filesystem from growing the file extent by extent under heavy
+        // compaction. The hint is best-effort - the filesystem is free to
+        // ignore it - and sloppy_size means the file is truncated back to
+        // its real length when sealed.
+        opt.extent_allocation_size_hint = std::clamp<uint64_t>(*size_hint, 32 << 20, 1 << 30);
+    }
     opt.sloppy_size = true;
     return open_or_create_data(oflags, std::move(opt)).then([this, oflags] {
         _open_mode.emplace(oflags);
@@ -1385,12 +1403,25 @@ future<> sstable::create_data() noexcept {
     });
 }
 
+// High bit of the Filter component's hash count, used to mark the
+// cache-line-blocked bit layout (utils::bloom_filter_mode::blocked).
+static constexpr uint32_t blocked_filter_marker = 1u << 31;
+
 future<> sstable::read_filter(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
         _components->filter = std::make_unique<utils::filter::always_present_filter>();
         return make_ready_future<>();
     }
 
+    if (!_manager.filter_memory_available()) {
+        // The shard's bloom filter memory budget is exhausted. Serve this
+        // sstable without a filter, trading extra index/data reads for
+        // memory, rather than pushing the node towards OOM.
+        sstlog.warn("Bloom filter memory budget exhausted, not loading {}", filename(component_type::Filter));
+        _components->filter = std::make_unique<utils::filter::always_present_filter>();
+        return make_ready_future<>();
+    }
+
     return seastar::async([this, &pc] () mutable {
         sstables::filter filter;
         read_simple<component_type::Filter>(filter, pc).get();
@@ -1399,7 +1430,14 @@ future<> sstable::read_filter(const io_priority_class& pc) {
         utils::filter_format format = (_version >= sstable_version_types::mc)
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        // The cache-line-blocked layout is flagged in the high bit of the
+        // on-disk hash count (see write_filter()).
+        auto mode = (filter.hashes & blocked_filter_marker)
+                    ? utils::bloom_filter_mode::blocked
+                    : utils::bloom_filter_mode::partitioned;
+        _components->filter = utils::filter::create_filter(filter.hashes & ~blocked_filter_marker, std::move(bs), format, mode);
+        _tracked_filter_memory = _components->filter->memory_size();
+        _manager.account_filter_memory(_tracked_filter_memory);
     });
 }
 
@@ -1408,10 +1446,18 @@ void sstable::write_filter(const io_priority_class& pc) {
         return;
     }
 
-    auto f = static_cast<utils::filter::murmur3_bloom_filter *>(_components->filter.get());
+    auto f = static_cast<utils::filter::bloom_filter *>(_components->filter.get());
 
+    uint32_t hashes = f->num_hashes();
+    if (f->mode() == utils::bloom_filter_mode::blocked) {
+        // Blocked filters share the partitioned serialization, but their bit
+        // layout is different, so flag them in the on-disk hash count. The
+        // marker is only ever written for tables which opted in to blocked
+        // filters, and such sstables are not downgrade-safe.
+        hashes |= blocked_filter_marker;
+    }
     auto&& bs = f->bits();
-    auto filter_ref = sstables::filter_ref(f->num_hashes(), bs.get_storage());
+    auto filter_ref = sstables::filter_ref(hashes, bs.get_storage());
     write_simple<component_type::Filter>(filter_ref, pc);
 }
 
@@ -1422,19 +1468,23 @@ future<> sstable::load(const io_priority_class& pc) noexcept {
         // read scylla-meta after toc. Might need it to parse
         // rest (hint extensions)
         return read_scylla_metadata(pc).then([this, &pc] {
-            // Read statistics ahead of others - if summary is missing
-            // we'll attempt to re-generate it and we need statistics for that
-            return read_statistics(pc).then([this, &pc] {
-                return seastar::when_all_succeed(
-                        read_compression(pc),
-                        read_filter(pc),
-                        read_summary(pc)).then_unpack([this] {
-                            validate_min_max_metadata();
-                            validate_max_local_deletion_time();
-                            validate_partitioner();
-                            return open_data();
-                        });
-            });
+            // The remaining metadata components are independent and small,
+            // so read them concurrently - a load then costs one I/O round
+            // trip for all of them rather than one per component. The only
+            // ordering requirement is that regenerating the Summary (the
+            // rare case of it being missing or corrupt) needs Statistics,
+            // so the summary read is chained after it.
+            return seastar::when_all_succeed(
+                    read_statistics(pc).then([this, &pc] {
+                        return read_summary(pc);
+                    }),
+                    read_compression(pc),
+                    read_filter(pc)).then_unpack([this] {
+                        validate_min_max_metadata();
+                        validate_max_local_deletion_time();
+                        validate_partitioner();
+                        return open_data();
+                    });
         });
     });
 }
@@ -1443,6 +1493,10 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
     static_assert(std::is_nothrow_move_constructible_v<sstables::foreign_sstable_open_info>);
     return read_toc().then([this, info = std::move(info)] () mutable {
         _components = std::move(info.components);
+        if (_components->filter) {
+            _tracked_filter_memory = _components->filter->memory_size();
+            _manager.account_filter_memory(_tracked_filter_memory);
+        }
         _data_file = make_checked_file(_read_error_handler, info.data.to_file());
         _index_file = make_checked_file(_read_error_handler, info.index.to_file());
         _shards = std::move(info.owners);
@@ -1585,6 +1639,14 @@ void maybe_add_summary_entry(summary& s, const dht::token& token, bytes_view key
         s.add_summary_data(token.data());
         auto key_data = s.add_summary_data(key);
         s.entries.push_back({ token, key_data, index_offset });
+        state.summary_memory += entry_size + token.data().size() + sizeof(summary_entry);
+        if (state.summary_memory_budget && state.summary_memory >= state.summary_memory_budget) {
+            // Over the memory budget; downsample the rest of the sstable
+            // online by halving the density of further entries (see
+            // index_sampling_state::summary_memory_budget).
+            state.summary_byte_cost *= 2;
+            state.summary_memory_budget *= 2;
+        }
     }
 }
 
@@ -1594,6 +1656,10 @@ size_t summary_byte_cost(double summary_ratio) {
     return summary_ratio ? (1 / summary_ratio) : index_sampling_state::default_summary_byte_cost;
 }
 
+size_t default_summary_memory_budget() {
+    return seastar::memory::stats().total_memory() / 100;
+}
+
 future<>
 sstable::read_scylla_metadata(const io_priority_class& pc) noexcept {
     if (_components->scylla_metadata) {
@@ -1610,7 +1676,8 @@ sstable::read_scylla_metadata(const io_priority_class& pc) noexcept {
 
 void
 sstable::write_scylla_metadata(const io_priority_class& pc, shard_id shard, sstable_enabled_features features, struct run_identifier identifier,
-        std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin) {
+        std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin,
+        std::optional<scylla_metadata::tombstone_density> tombstone_density) {
     auto&& first_key = get_first_decorated_key();
     auto&& last_key = get_last_decorated_key();
     auto sm = create_sharding_metadata(_schema, first_key, last_key, shard);
@@ -1636,6 +1703,9 @@ sstable::write_scylla_metadata(const io_priority_class& pc, shard_id shard, ssta
         o.value = bytes(to_bytes_view(sstring_view(origin)));
         _components->scylla_metadata->data.set<scylla_metadata_type::SSTableOrigin>(std::move(o));
     }
+    if (tombstone_density) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::TombstoneDensity>(std::move(*tombstone_density));
+    }
 
     write_simple<component_type::Scylla>(*_components->scylla_metadata, pc);
 }
@@ -1738,6 +1808,7 @@ future<> sstable::generate_summary(const io_priority_class& pc) {
 
         summary_generator(const dht::i_partitioner& p, summary& s, double summary_ratio) : _partitioner(p), _summary(s) {
             _state.summary_byte_cost = summary_byte_cost(summary_ratio);
+            _state.summary_memory_budget = default_summary_memory_budget();
         }
         bool should_continue() {
             return true;
@@ -1779,6 +1850,23 @@ future<> sstable::generate_summary(const io_priority_class& pc) {
                         return ctx->close();
                     }).then([this, ctx, &s] {
                         return seal_summary(_components->summary, std::move(s.first_key), std::move(s.last_key), s.state());
+                    }).then([this, &pc] {
+                        // Persist the regenerated summary so subsequent
+                        // restarts don't pay for the index scan again. A torn
+                        // write is not a problem: a summary that fails to
+                        // parse is regenerated (and persisted) once more.
+                        return seastar::async([this, &pc] {
+                            file_output_stream_options options;
+                            options.buffer_size = sstable_buffer_size;
+                            options.io_priority_class = pc;
+                            auto w = make_component_file_writer(component_type::Summary, std::move(options),
+                                    open_flags::wo | open_flags::create | open_flags::truncate).get0();
+                            write(_version, w, _components->summary);
+                            w.flush();
+                            w.close();
+                        }).handle_exception([this] (auto ep) {
+                            sstlog.warn("Couldn't write regenerated summary file {}: {}", filename(component_type::Summary), ep);
+                        });
                     });
                 });
             }).then([index_file] () mutable {
@@ -2189,7 +2277,10 @@ input_stream<char> sstable::data_stream(uint64_t pos, size_t len, const io_prior
     file_input_stream_options options;
     options.buffer_size = sstable_buffer_size;
     options.io_priority_class = pc;
-    options.read_ahead = 4;
+    // Readahead is speculative work: when the read is close to its deadline
+    // or memory allowance, buffers read ahead of the consumer are likely to
+    // be thrown away together with the timed-out read, so don't bother.
+    options.read_ahead = permit.budget_is_low() ? 1 : 4;
     options.dynamic_adjustments = std::move(history);
 
     file f = make_tracked_file(_data_file, std::move(permit));
@@ -2816,7 +2907,8 @@ future<> replay_pending_delete_log(sstring pending_delete_log) {
 }
 
 thread_local sstables_stats::stats sstables_stats::_shard_stats;
-thread_local shared_index_lists::stats shared_index_lists::_shard_stats;
+thread_local partition_index_cache::stats partition_index_cache::_shard_stats;
+thread_local partition_index_cache::lru_type partition_index_cache::_shard_lru;
 thread_local cached_file::metrics index_page_cache_metrics;
 thread_local mc::cached_promoted_index::metrics promoted_index_cache_metrics;
 static thread_local seastar::metrics::metric_groups metrics;
@@ -2825,12 +2917,16 @@ future<> init_metrics() {
   return seastar::smp::invoke_on_all([] {
     namespace sm = seastar::metrics;
     metrics.add_group("sstables", {
-        sm::make_derive("index_page_hits", [] { return shared_index_lists::shard_stats().hits; },
+        sm::make_derive("index_page_hits", [] { return partition_index_cache::shard_stats().hits; },
             sm::description("Index page requests which could be satisfied without waiting")),
-        sm::make_derive("index_page_misses", [] { return shared_index_lists::shard_stats().misses; },
+        sm::make_derive("index_page_misses", [] { return partition_index_cache::shard_stats().misses; },
             sm::description("Index page requests which initiated a read from disk")),
-        sm::make_derive("index_page_blocks", [] { return shared_index_lists::shard_stats().blocks; },
+        sm::make_derive("index_page_blocks", [] { return partition_index_cache::shard_stats().blocks; },
             sm::description("Index page requests which needed to wait due to page not being loaded yet")),
+        sm::make_derive("index_page_evictions", [] { return partition_index_cache::shard_stats().evictions; },
+            sm::description("Index pages which got evicted from the cache due to memory pressure")),
+        sm::make_gauge("index_page_used_bytes", [] { return partition_index_cache::shard_stats().used_bytes; },
+            sm::description("Amount of memory used by index pages retained by the cache")),
 
         sm::make_derive("index_page_cache_hits", [] { return index_page_cache_metrics.page_hits; },
             sm::description("Index page cache requests which were served from cache")),
@@ -2838,6 +2934,15 @@ future<> init_metrics() {
             sm::description("Index page cache requests which had to perform I/O")),
         sm::make_derive("index_page_cache_evictions", [] { return index_page_cache_metrics.page_evictions; },
             sm::description("Total number of index page cache pages which have been evicted")),
+
+        sm::make_derive("uncompressed_chunk_cache_hits", [] { return uncompressed_chunk_cache::shard().shard_stats().hits; },
+            sm::description("Data chunk reads served decompressed from the shard chunk cache")),
+        sm::make_derive("uncompressed_chunk_cache_misses", [] { return uncompressed_chunk_cache::shard().shard_stats().misses; },
+            sm::description("Data chunk reads which had to read and decompress the chunk")),
+        sm::make_derive("uncompressed_chunk_cache_evictions", [] { return uncompressed_chunk_cache::shard().shard_stats().evictions; },
+            sm::description("Uncompressed chunks evicted from the shard chunk cache")),
+        sm::make_gauge("uncompressed_chunk_cache_used_bytes", [] { return uncompressed_chunk_cache::shard().shard_stats().used_bytes; },
+            sm::description("Memory used by the shard's uncompressed chunk cache")),
         sm::make_derive("index_page_cache_populations", [] { return index_page_cache_metrics.page_populations; },
             sm::description("Total number of index page cache pages which were inserted into the cache")),
         sm::make_gauge("index_page_cache_bytes", [] { return index_page_cache_metrics.cached_bytes; },
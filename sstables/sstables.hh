@@ -24,7 +24,7 @@
 
 #include "version.hh"
 #include "shared_sstable.hh"
-#include "shared_index_lists.hh"
+#include "partition_index_cache.hh"
 #include <seastar/core/file.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/future.hh>
@@ -108,6 +108,10 @@ extern bool use_binary_search_in_promoted_index;
 
 extern size_t summary_byte_cost(double summary_ratio);
 
+// Per-writer cap on the memory taken by the summary being built, derived
+// from the shard's memory. See index_sampling_state::summary_memory_budget.
+extern size_t default_summary_memory_budget();
+
 struct sstable_writer_config {
     size_t promoted_index_block_size;
     uint64_t max_sstable_size = std::numeric_limits<uint64_t>::max();
@@ -119,6 +123,11 @@ struct sstable_writer_config {
     write_monitor* monitor = &default_write_monitor();
     utils::UUID run_identifier = utils::make_random_uuid();
     size_t summary_byte_cost;
+    size_t summary_memory_budget = 0;
+    // Expected size of the output sstable, when the producer can estimate it
+    // (e.g. compaction). Used to preallocate extents for the data file and to
+    // write it in larger batches; purely a performance hint.
+    std::optional<uint64_t> estimated_output_size;
     sstring origin;
 
 private:
@@ -462,6 +471,9 @@ private:
     uint64_t _data_file_size;
     uint64_t _index_file_size;
     uint64_t _filter_file_size = 0;
+    // Filter memory charged against the manager's bloom filter budget,
+    // released when the sstable is deactivated.
+    size_t _tracked_filter_memory = 0;
     uint64_t _bytes_on_disk = 0;
     db_clock::time_point _data_file_write_time;
     position_range _position_range = position_range::all_clustered_rows();
@@ -483,7 +495,7 @@ private:
     format_types _format;
 
     filter_tracker _filter_tracker;
-    shared_index_lists _index_lists;
+    partition_index_cache _index_lists;
 
     enum class mark_for_deletion {
         implicit = -1,
@@ -548,7 +560,8 @@ private:
 
     future<> read_scylla_metadata(const io_priority_class& pc) noexcept;
     void write_scylla_metadata(const io_priority_class& pc, shard_id shard, sstable_enabled_features features, run_identifier identifier,
-            std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin);
+            std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin,
+            std::optional<scylla_metadata::tombstone_density> tombstone_density);
 
     future<> read_filter(const io_priority_class& pc);
 
@@ -587,7 +600,7 @@ private:
     // to be called when loading an existing sstable or after writing a new one.
     void set_position_range();
 
-    future<> create_data() noexcept;
+    future<> create_data(std::optional<uint64_t> size_hint = {}) noexcept;
 
     // Return an input_stream which reads exactly the specified byte range
     // from the data file (after uncompression, if the file is compressed).
@@ -690,6 +703,12 @@ public:
         return _components->filter->is_present(key);
     }
 
+    // Starts pulling the filter cache lines for the key into cache, ahead of
+    // a filter_has_key() call. Used to batch probes across many sstables.
+    void filter_prefetch(utils::hashed_key key) const {
+        _components->filter->prefetch(key);
+    }
+
     bool filter_has_key(const schema& s, partition_key_view key) const {
         return filter_has_key(key::from_partition_key(s, key));
     }
@@ -743,9 +762,7 @@ public:
         return get_mutable_serialization_header(*_components);
     }
     column_translation get_column_translation(
-            const schema& s, const serialization_header& h, const sstable_enabled_features& f) {
-        return _column_translation.get_for_schema(s, h, f);
-    }
+            const schema& s, const serialization_header& h, const sstable_enabled_features& f);
     const std::vector<unsigned>& get_shards_for_this_sstable() const {
         return _shards;
     }
@@ -807,6 +824,15 @@ public:
         return _origin;
     }
 
+    // Returns the tombstone density histogram collected at write time, or
+    // nullptr for sstables written before it was introduced.
+    const scylla_metadata::tombstone_density* get_tombstone_density() const noexcept {
+        if (!_components->scylla_metadata) {
+            return nullptr;
+        }
+        return _components->scylla_metadata->get_tombstone_density();
+    }
+
     // Allow the test cases from sstable_test.cc to test private methods. We use
     // a placeholder to avoid cluttering this class too much. The sstable_test class
     // will then re-export as public every method it needs.
@@ -854,6 +880,14 @@ struct index_sampling_state {
     uint64_t partition_count = 0;
     // Enforces ratio of summary to data of 1 to N.
     size_t summary_byte_cost = default_summary_byte_cost;
+    // Memory accounted to the summary entries added so far.
+    size_t summary_memory = 0;
+    // When non-zero and summary_memory reaches it, summary_byte_cost is
+    // doubled (and so is the budget), halving the sampling density of the
+    // entries still to be added. This keeps the summary of a very large
+    // sstable within a small multiple of the budget, since each further
+    // doubling of the summary requires four times more data.
+    size_t summary_memory_budget = 0;
 };
 
 class sstable_writer {
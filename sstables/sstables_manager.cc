@@ -19,7 +19,9 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <seastar/core/memory.hh>
 #include "log.hh"
+#include "schema.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/sstables.hh"
 #include "db/config.hh"
@@ -60,12 +62,59 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.summary_memory_budget = default_summary_memory_budget();
 
     cfg.origin = std::move(origin);
 
     return cfg;
 }
 
+static bytes column_translation_cache_key(const schema& s, const serialization_header& h, const sstable_enabled_features& f) {
+    bytes key;
+    auto append_uint64 = [&key] (uint64_t v) {
+        key.append(reinterpret_cast<const int8_t*>(&v), sizeof(v));
+    };
+    auto append_blob = [&] (const bytes& b) {
+        // Length-prefixed, so concatenations of different fields can't collide.
+        append_uint64(b.size());
+        key.append(b.data(), b.size());
+    };
+    append_uint64(s.version().get_most_significant_bits());
+    append_uint64(s.version().get_least_significant_bits());
+    append_uint64(f.enabled_features);
+    for (auto& t : h.clustering_key_types_names.elements) {
+        append_blob(t.value);
+    }
+    for (auto* columns : {&h.static_columns.elements, &h.regular_columns.elements}) {
+        for (auto& cd : *columns) {
+            append_blob(cd.name.value);
+            append_blob(cd.type_name.value);
+        }
+    }
+    return key;
+}
+
+column_translation sstables_manager::get_column_translation(const schema& s, const serialization_header& h, const sstable_enabled_features& f) {
+    auto key = column_translation_cache_key(s, h, f);
+    auto it = _column_translation_cache.find(key);
+    if (it == _column_translation_cache.end()) {
+        // Drop translations no sstable references anymore (closed sstables,
+        // or translations rebuilt against a newer schema version).
+        std::erase_if(_column_translation_cache, [] (auto& e) { return e.second.unused(); });
+        it = _column_translation_cache.emplace(std::move(key), column_translation(s, h, f)).first;
+    }
+    return it->second;
+}
+
+bool sstables_manager::filter_memory_available() const {
+    auto fraction = _db_config.sstable_filter_memory_fraction();
+    return !fraction || _filter_memory < fraction * seastar::memory::stats().total_memory();
+}
+
+void sstables_manager::account_filter_memory(size_t bytes) {
+    _filter_memory += bytes;
+}
+
 void sstables_manager::add(sstable* sst) {
     _active.push_back(*sst);
 }
@@ -73,6 +122,7 @@ void sstables_manager::add(sstable* sst) {
 void sstables_manager::deactivate(sstable* sst) {
     // At this point, sst has a reference count of zero, since we got here from
     // lw_shared_ptr_deleter<sstables::sstable>::dispose().
+    _filter_memory -= std::exchange(sst->_tracked_filter_memory, 0);
     _active.erase(_active.iterator_to(*sst));
     _undergoing_close.push_back(*sst);
     // guard against sstable::close_files() calling shared_from_this() and immediately destroying
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sharded.hh>
 
@@ -72,6 +74,12 @@ private:
     list_type _undergoing_close;
     bool _closing = false;
     promise<> _done;
+    // Shared column translations, keyed by the parts which influence them:
+    // read schema version, feature bits and the header's column layout.
+    std::unordered_map<bytes, column_translation> _column_translation_cache;
+    // Memory spent on loaded bloom filters on this shard, charged against
+    // the budget configured by sstable_filter_memory_fraction.
+    size_t _filter_memory = 0;
 public:
     explicit sstables_manager(db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat);
     ~sstables_manager();
@@ -89,6 +97,18 @@ public:
     sstable_writer_config configure_writer(sstring origin) const;
     const db::config& config() const { return _db_config; }
 
+    // Returns a column translation for the given read schema and
+    // serialization header. Translations are immutable and deduplicated
+    // across the sstables managed by this instance, so the thousands of
+    // sstables of a table typically share one record instead of each
+    // parsing and holding its own.
+    column_translation get_column_translation(const schema& s, const serialization_header& h, const sstable_enabled_features& f);
+
+    // Whether the bloom filter memory budget has room for another filter.
+    // Always true when the budget is disabled (the default).
+    bool filter_memory_available() const;
+    void account_filter_memory(size_t bytes);
+
     void set_format(sstable_version_types format) { _format = format; }
     sstables::sstable::version_types get_highest_supported_format() const { return _format; }
 
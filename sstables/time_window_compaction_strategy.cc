@@ -24,6 +24,7 @@
 #include "mutation_writer/timestamp_based_splitting_writer.hh"
 #include "mutation_source_metadata.hh"
 
+#include <boost/algorithm/cxx11/all_of.hpp>
 #include <boost/range/algorithm/find.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/algorithm/min_element.hpp>
@@ -220,7 +221,14 @@ time_window_compaction_strategy::get_sstables_for_compaction(column_family& cf,
     if (!expired.empty()) {
         compaction_candidates.insert(compaction_candidates.end(), expired.begin(), expired.end());
     }
-    return compaction_descriptor(std::move(compaction_candidates), cf.get_sstable_set(), service::get_local_compaction_priority());
+    auto desc = compaction_descriptor(std::move(compaction_candidates), cf.get_sstable_set(), service::get_local_compaction_priority());
+    // Output made exclusively of windows older than the most recent one is
+    // unlikely to be read again soon, so mark it cold to let the table place
+    // it on the capacity tier, if one is configured.
+    desc.cold_tier = !desc.sstables.empty() && boost::algorithm::all_of(desc.sstables, [this] (const shared_sstable& sst) {
+        return get_window_for(_options, sst->get_stats_metadata().max_timestamp) < _highest_window_seen;
+    });
+    return desc;
 }
 
 time_window_compaction_strategy::bucket_compaction_mode
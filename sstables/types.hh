@@ -511,6 +511,7 @@ enum class scylla_metadata_type : uint32_t {
     RunIdentifier = 4,
     LargeDataStats = 5,
     SSTableOrigin = 6,
+    TombstoneDensity = 7,
 };
 
 struct run_identifier {
@@ -542,10 +543,22 @@ struct large_data_stats_entry {
     auto describe_type(sstable_version_types v, Describer f) { return f(max_value, threshold, above_threshold); }
 };
 
+// Tombstone counts over equal-width buckets of the whole token space,
+// collected at write time (see sstables::metadata_collector). Lets
+// compaction spot sstables whose tombstones concentrate in a narrow
+// token span. Absent when the sstable contains no tombstones.
+struct tombstone_density_metadata {
+    disk_array<uint32_t, uint64_t> buckets;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(buckets); }
+};
+
 struct scylla_metadata {
     using extension_attributes = disk_hash<uint32_t, disk_string<uint32_t>, disk_string<uint32_t>>;
     using large_data_stats = disk_hash<uint32_t, large_data_type, large_data_stats_entry>;
     using sstable_origin = disk_string<uint32_t>;
+    using tombstone_density = tombstone_density_metadata;
 
     disk_set_of_tagged_union<scylla_metadata_type,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::Sharding, sharding_metadata>,
@@ -553,7 +566,8 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ExtensionAttributes, extension_attributes>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::RunIdentifier, run_identifier>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataStats, large_data_stats>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableOrigin, sstable_origin>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableOrigin, sstable_origin>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::TombstoneDensity, tombstone_density>
             > data;
 
     sstable_enabled_features get_features() const {
@@ -581,6 +595,9 @@ struct scylla_metadata {
         auto* m = data.get<scylla_metadata_type::RunIdentifier, run_identifier>();
         return m ? std::make_optional(m->id) : std::nullopt;
     }
+    const tombstone_density* get_tombstone_density() const {
+        return data.get<scylla_metadata_type::TombstoneDensity, tombstone_density>();
+    }
 
     template <typename Describer>
     auto describe_type(sstable_version_types v, Describer f) { return f(data); }
@@ -172,12 +172,20 @@ public:
 
         for (size_t offset = 0; offset < buf.size(); offset += _c.chunk_size) {
             size_t size = std::min(size_t(_c.chunk_size), buf.size() - offset);
-            uint32_t per_chunk_checksum = ChecksumType::init_checksum();
+            uint32_t per_chunk_checksum = ChecksumType::checksum(buf.begin() + offset, size);
 
-            per_chunk_checksum = ChecksumType::checksum(per_chunk_checksum, buf.begin() + offset, size);
-            _full_checksum = checksum_combine_or_feed<ChecksumType>(_full_checksum, per_chunk_checksum, buf.begin() + offset, size);
+            if constexpr (ChecksumType::prefer_combine()) {
+                _full_checksum = ChecksumType::checksum_combine(_full_checksum, per_chunk_checksum, size);
+            }
             _c.checksums.push_back(per_chunk_checksum);
         }
+        if constexpr (!ChecksumType::prefer_combine()) {
+            // Without a fast checksum combine the full checksum has to be fed
+            // the data again, but feed it the whole buffer at once rather than
+            // chunk by chunk, so the checksum kernel gets long runs of data
+            // while the buffer is still hot in cache.
+            _full_checksum = ChecksumType::checksum(_full_checksum, buf.begin(), buf.size());
+        }
         return _out.put(std::move(buf));
     }
 
@@ -103,6 +103,17 @@ static auto get_session(utils::UUID plan_id, gms::inet_address from, const char*
     return coordinator->get_or_create_session(from);
 }
 
+static sstables::offstrategy is_offstrategy_supported(stream_reason reason) {
+    static const std::unordered_set<stream_reason> operations_supported = {
+        stream_reason::bootstrap,
+        stream_reason::replace,
+        stream_reason::removenode,
+        stream_reason::decommission,
+        stream_reason::repair,
+    };
+    return sstables::offstrategy(operations_supported.contains(reason));
+}
+
 void stream_session::init_messaging_service_handler(netw::messaging_service& ms, shared_ptr<service::migration_manager> mm) {
     ms.register_prepare_message([] (const rpc::client_info& cinfo, prepare_message msg, UUID plan_id, sstring description, rpc::optional<stream_reason> reason_opt) {
         const auto& src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
@@ -183,13 +194,15 @@ void stream_session::init_messaging_service_handler(netw::messaging_service& ms,
                 make_generating_reader(s, permit, std::move(get_next_mutation_fragment)),
                 [plan_id, estimated_partitions, reason] (flat_mutation_reader reader) {
                     auto& cf = get_local_db().find_column_family(reader.schema());
-                    return db::view::check_needs_view_update_path(_sys_dist_ks->local(), cf, reason).then([cf = cf.shared_from_this(), estimated_partitions, reader = std::move(reader)] (bool use_view_update_path) mutable {
+                    return db::view::check_needs_view_update_path(_sys_dist_ks->local(), cf, reason).then([cf = cf.shared_from_this(), estimated_partitions, reader = std::move(reader), reason] (bool use_view_update_path) mutable {
                         //FIXME: for better estimations this should be transmitted from remote
                         auto metadata = mutation_source_metadata{};
                         auto& cs = cf->get_compaction_strategy();
                         const auto adjusted_estimated_partitions = cs.adjust_partition_estimate(metadata, estimated_partitions);
+                        sstables::offstrategy offstrategy = is_offstrategy_supported(reason);
+                        bool auto_offstrategy_trigger = offstrategy && (reason == stream_reason::repair);
                         auto consumer = cf->get_compaction_strategy().make_interposer_consumer(metadata,
-                                [cf = std::move(cf), adjusted_estimated_partitions, use_view_update_path] (flat_mutation_reader reader) {
+                                [cf = std::move(cf), adjusted_estimated_partitions, use_view_update_path, offstrategy, auto_offstrategy_trigger] (flat_mutation_reader reader) {
                             sstables::shared_sstable sst = use_view_update_path ? cf->make_streaming_staging_sstable() : cf->make_streaming_sstable_for_write();
                             schema_ptr s = reader.schema();
                             auto& pc = service::get_local_streaming_priority();
@@ -198,8 +211,13 @@ void stream_session::init_messaging_service_handler(netw::messaging_service& ms,
                                                          cf->get_sstables_manager().configure_writer("streaming"),
                                                          encoding_stats{}, pc).then([sst] {
                                 return sst->open_data();
-                            }).then([cf, sst] {
-                                return cf->add_sstable_and_update_cache(sst);
+                            }).then([cf, sst, offstrategy, auto_offstrategy_trigger] {
+                                if (auto_offstrategy_trigger) {
+                                    sslog.debug("Enabled automatic off-strategy trigger for table {}.{}",
+                                            cf->schema()->ks_name(), cf->schema()->cf_name());
+                                    cf->enable_off_strategy_trigger();
+                                }
+                                return cf->add_sstable_and_update_cache(sst, offstrategy);
                             }).then([cf, s, sst, use_view_update_path]() mutable -> future<> {
                                 if (!use_view_update_path) {
                                     return make_ready_future<>();
@@ -273,6 +291,11 @@ distributed<db::system_distributed_keyspace>* stream_session::_sys_dist_ks;
 distributed<db::view::view_update_generator>* stream_session::_view_update_generator;
 sharded<netw::messaging_service>* stream_session::_messaging;
 
+utils::token_bucket& stream_session::outbound_throughput_limiter() {
+    static thread_local utils::token_bucket limiter;
+    return limiter;
+}
+
 stream_session::stream_session() = default;
 
 stream_session::stream_session(inet_address peer_)
@@ -292,7 +315,12 @@ future<> stream_session::init_streaming_service(distributed<database>& db, distr
     // engine().at_exit([] {
     //     return get_stream_manager().stop();
     // });
-    return get_stream_manager().start().then([&ms, &mm] {
+    return db.invoke_on_all([] (database& db) {
+        uint64_t rate = uint64_t(db.get_config().stream_throughput_outbound_megabits_per_sec()) * 1024 * 1024 / 8;
+        outbound_throughput_limiter().update_rate(rate / smp::count);
+    }).then([] {
+        return get_stream_manager().start();
+    }).then([&ms, &mm] {
         gms::get_local_gossiper().register_(get_local_stream_manager().shared_from_this());
         return ms.invoke_on_all([&mm] (netw::messaging_service& ms) { init_messaging_service_handler(ms, mm.local().shared_from_this()); });
     });
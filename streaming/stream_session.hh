@@ -53,6 +53,7 @@
 #include "streaming/session_info.hh"
 #include "query-request.hh"
 #include "dht/i_partitioner.hh"
+#include "utils/rate_limiter.hh"
 #include <map>
 #include <vector>
 #include <memory>
@@ -160,6 +161,10 @@ public:
     static netw::messaging_service& ms() { return _messaging->local(); }
     static database& get_local_db() { return _db->local(); }
     static distributed<database>& get_db() { return *_db; };
+    // Shard-local token bucket throttling outbound streaming traffic,
+    // configured from stream_throughput_outbound_megabits_per_sec (each
+    // shard gets an equal share of the node-wide limit, 0 - unlimited).
+    static utils::token_bucket& outbound_throughput_limiter();
     static future<> init_streaming_service(distributed<database>& db, distributed<db::system_distributed_keyspace>& sys_dist_ks,
             distributed<db::view::view_update_generator>& view_update_generator, sharded<netw::messaging_service>& ms,
             sharded<service::migration_manager>& mm);
@@ -181,7 +181,9 @@ future<> send_mutation_fragments(lw_shared_ptr<send_info> si) {
                             frozen_mutation_fragment fmf = freeze(*s, *mf);
                             auto size = fmf.representation().size();
                             streaming::get_local_stream_manager().update_progress(si->plan_id, si->id.addr, streaming::progress_info::direction::OUT, size);
-                            return sink(fmf, stream_mutation_fragments_cmd::mutation_fragment_data).then([] { return stop_iteration::no; });
+                            return stream_session::outbound_throughput_limiter().reserve(size).then([&sink, fmf = std::move(fmf)] () mutable {
+                                return sink(fmf, stream_mutation_fragments_cmd::mutation_fragment_data);
+                            }).then([] { return stop_iteration::no; });
                         } else {
                             if (!validator.on_end_of_stream()) {
                                 return make_exception_future<stop_iteration>(std::runtime_error(format("Stream reader mutation_fragment validator failed on end_of_stream, previous={}, current=end_of_stream",
@@ -29,6 +29,7 @@
 #include "service/priority_manager.hh"
 #include "db/schema_tables.hh"
 #include "cell_locking.hh"
+#include "counter_cell_cache.hh"
 #include "utils/logalloc.hh"
 #include "checked-file-impl.hh"
 #include "view_info.hh"
@@ -50,6 +51,8 @@
 #include "db/config.hh"
 
 #include <boost/range/algorithm/remove_if.hpp>
+#include <boost/range/irange.hpp>
+#include <numeric>
 
 static logging::logger tlogger("table");
 static seastar::metrics::label column_family_label("cf");
@@ -349,6 +352,17 @@ sstables::shared_sstable table::make_sstable() {
     return make_sstable(_config.datadir);
 }
 
+const sstring& table::sstable_dir_for_compaction(bool cold_tier) const {
+    // With more than one data directory configured, the last one acts as the
+    // capacity tier and receives compaction output the strategy marked as
+    // cold. Reads are oblivious to placement, since every sstable remembers
+    // the directory it was opened from.
+    if (cold_tier && _config.all_datadirs.size() > 1) {
+        return _config.all_datadirs.back();
+    }
+    return _config.datadir;
+}
+
 void table::load_sstable(sstables::shared_sstable& sst, bool reset_level) {
     if (reset_level) {
         // When loading a migrated sstable, set level to 0 because
@@ -645,7 +659,52 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
             });
         });
 
-        auto f = consumer(old->make_flush_reader(old->schema(), service::get_local_memtable_flush_priority()));
+        // Flushing disjoint token sub-ranges through independent pipelines
+        // overlaps reading from the LSA region of one pipeline with the
+        // compression and I/O of the others, which keeps the disk busy for
+        // large memtables. When the compaction strategy interposes its own
+        // consumer it shapes the output stream itself, so splitting would
+        // only multiply the number of output sstables.
+        unsigned nr_pipelines = 1;
+        if (!_compaction_strategy.use_interposer_consumer()) {
+            static constexpr size_t bytes_per_flush_pipeline = 16 << 20;
+            nr_pipelines = std::clamp<unsigned>(old->occupancy().total_space() / bytes_per_flush_pipeline, 1, 4);
+        }
+        std::vector<dht::partition_range> ranges;
+        ranges.reserve(nr_pipelines);
+        if (nr_pipelines == 1) {
+            ranges.push_back(query::full_partition_range);
+        } else {
+            const uint64_t step = std::numeric_limits<uint64_t>::max() / nr_pipelines + 1;
+            std::optional<dht::partition_range::bound> start;
+            for (unsigned i = 1; i < nr_pipelines; ++i) {
+                auto raw = int64_t(uint64_t(std::numeric_limits<int64_t>::min()) + i * step);
+                auto pos = dht::ring_position::starting_at(dht::token::from_int64(raw));
+                ranges.emplace_back(start, dht::partition_range::bound(pos, false));
+                start = dht::partition_range::bound(std::move(pos), true);
+            }
+            ranges.emplace_back(std::move(start), std::nullopt);
+        }
+
+        // When the memtable holds data which already expired (TTL) or was
+        // deleted, run the flush stream through the compactor so expired
+        // cells are written out as value-less dead cells and data shadowed
+        // by tombstones is dropped. Nothing is purged - get_max_purgeable
+        // never allows it - so this only sheds bytes the sstable would
+        // carry for no reason. Memtables without expired data skip this.
+        const auto compaction_time = gc_clock::now();
+        const bool compact = old->get_encoding_stats().min_local_deletion_time <= compaction_time;
+
+        auto f = do_with(std::move(ranges), std::move(consumer), [old, compaction_time, compact] (auto& ranges, auto& consumer) {
+            return parallel_for_each(ranges, [old, compaction_time, compact, &consumer] (const dht::partition_range& range) {
+                auto rd = old->make_flush_reader(old->schema(), service::get_local_memtable_flush_priority(), range);
+                if (compact) {
+                    rd = make_compacting_reader(std::move(rd), compaction_time,
+                                                [] (const dht::decorated_key&) { return api::min_timestamp; });
+                }
+                return consumer(std::move(rd));
+            });
+        });
 
         // Switch back to default scheduling group for post-flush actions, to avoid them being staved by the memtable flush
         // controller. Cache update does not affect the input of the memtable cpu controller, so it can be subject to
@@ -709,6 +768,8 @@ table::stop() {
                 });
             });
         });
+    }).then([this] {
+        return _dirty_region_group.shutdown();
     });
 }
 
@@ -759,7 +820,14 @@ void table::set_metrics() {
                     ms::make_histogram("cas_prepare_latency", ms::description("CAS prepare round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_prepare);})(cf)(ks),
                     ms::make_histogram("cas_propose_latency", ms::description("CAS accept round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_accept);})(cf)(ks),
                     ms::make_histogram("cas_commit_latency", ms::description("CAS learn round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_learn);})(cf)(ks),
-                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks)
+                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks),
+                    ms::make_gauge("cache_working_set_bytes", ms::description("Estimated cache footprint of the partitions read over the last working-set windows"), [this] { return _cache.working_set_bytes(); })(cf)(ks),
+                    ms::make_counter("cache_bucket_rebuilds", [this] { return _cache.partition_index_stats().bucket_rebuilds; },
+                            ms::description("Number of times a cache partition-index bucket was rebuilt to admit a token-colliding entry"))(cf)(ks),
+                    ms::make_counter("cache_bucket_elements_moved", [this] { return _cache.partition_index_stats().elements_moved; },
+                            ms::description("Number of cache entries moved while rebuilding partition-index buckets"))(cf)(ks),
+                    ms::make_gauge("cache_bucket_max_size", ms::description("Largest bucket observed in the cache partition index"),
+                            [this] { return _cache.partition_index_stats().max_bucket_size; })(cf)(ks)
             });
         }
     }
@@ -929,8 +997,8 @@ table::compact_sstables(sstables::compaction_descriptor descriptor) {
         return make_ready_future<>();
     }
 
-    descriptor.creator = [this] (shard_id dummy) {
-            auto sst = make_sstable();
+    descriptor.creator = [this, cold_tier = descriptor.cold_tier] (shard_id dummy) {
+            auto sst = make_sstable(sstable_dir_for_compaction(cold_tier));
             return sst;
     };
     descriptor.replacer = [this, release_exhausted = descriptor.release_exhausted] (sstables::compaction_completion_desc desc) {
@@ -942,6 +1010,10 @@ table::compact_sstables(sstables::compaction_descriptor descriptor) {
         }
     };
 
+    if (descriptor.sub_compactions > 1 && descriptor.options.type() == sstables::compaction_type::Compaction) {
+        return compact_sstables_in_parallel(std::move(descriptor));
+    }
+
     return sstables::compact_sstables(std::move(descriptor), *this).then([this] (auto info) {
         if (info.type != sstables::compaction_type::Compaction) {
             return make_ready_future<>();
@@ -959,6 +1031,90 @@ table::compact_sstables(sstables::compaction_descriptor descriptor) {
     });
 }
 
+// Runs one compaction job as token-range sub-compactions executing concurrently
+// on this shard. Every sub-compaction reads the same inputs, restricted to its
+// own slice of the token span, and seals its own outputs, which become visible
+// incrementally. The inputs are removed from the sstable set - and eventually
+// deleted - only by the replacement of the last sub-compaction to finish, so
+// reads stay correct throughout; until then the set temporarily holds both
+// inputs and outputs, which the read path deduplicates like any other overlap.
+future<>
+table::compact_sstables_in_parallel(sstables::compaction_descriptor descriptor) {
+    auto subs = descriptor.split();
+    // Checkpointed jobs persist the index of every sub-compaction that seals
+    // its output, plus the job's inputs, so an interrupted run can be resumed
+    // over the surviving ranges (see compaction_manager). split() is
+    // deterministic for a given input set, so the indexes identify the same
+    // token ranges across runs.
+    const auto sub_count = int32_t(subs.size());
+    const bool checkpoint = bool(descriptor.checkpoints) && bool(db::qctx) && sub_count > 1;
+    // Original index of each sub-compaction within the split, used to key its
+    // checkpoint row; kept aligned with subs below.
+    std::vector<int32_t> sub_indexes(subs.size());
+    std::iota(sub_indexes.begin(), sub_indexes.end(), 0);
+    if (checkpoint && !descriptor.checkpoints->empty()) {
+        // These sub-compactions sealed their output in an interrupted earlier
+        // run of this job; only the remainder needs compacting.
+        std::vector<sstables::compaction_descriptor> remaining_subs;
+        std::vector<int32_t> remaining_indexes;
+        for (unsigned i = 0; i < subs.size(); i++) {
+            if (!descriptor.checkpoints->contains(int32_t(i))) {
+                remaining_subs.push_back(std::move(subs[i]));
+                remaining_indexes.push_back(int32_t(i));
+            }
+        }
+        subs = std::move(remaining_subs);
+        sub_indexes = std::move(remaining_indexes);
+    }
+    if (subs.size() == 1 && !checkpoint) {
+        return sstables::compact_sstables(std::move(subs.front()), *this).discard_result();
+    }
+    struct sub_compaction_coordinator {
+        unsigned pending;
+        std::vector<sstables::shared_sstable> inputs;
+        sstables::compaction_sstable_replacer_fn replacer;
+    };
+    auto coordinator = make_lw_shared<sub_compaction_coordinator>(sub_compaction_coordinator{
+        unsigned(subs.size()), std::move(descriptor.sstables), std::move(descriptor.replacer)});
+    for (auto& sub : subs) {
+        sub.replacer = [coordinator] (sstables::compaction_completion_desc desc) {
+            // Sub-compactions only add their outputs; the shared inputs are
+            // replaced in one go by whichever sub-compaction finishes last.
+            desc.old_sstables.clear();
+            if (!--coordinator->pending) {
+                desc.old_sstables = std::move(coordinator->inputs);
+            }
+            coordinator->replacer(std::move(desc));
+        };
+    }
+    std::unordered_set<int64_t> input_generations;
+    if (checkpoint) {
+        input_generations = boost::copy_range<std::unordered_set<int64_t>>(coordinator->inputs
+                | boost::adaptors::transformed([] (const sstables::shared_sstable& sst) { return sst->generation(); }));
+    }
+    return do_with(std::move(subs), std::move(sub_indexes), std::move(input_generations), _schema,
+            [this, checkpoint, sub_count] (std::vector<sstables::compaction_descriptor>& subs, std::vector<int32_t>& sub_indexes,
+                    std::unordered_set<int64_t>& input_generations, schema_ptr& s) {
+        return parallel_for_each(boost::irange(size_t(0), subs.size()),
+                [this, checkpoint, sub_count, &subs, &sub_indexes, &input_generations, &s] (size_t i) {
+            return sstables::compact_sstables(std::move(subs[i]), *this).discard_result().then(
+                    [checkpoint, sub_count, &sub_indexes, &input_generations, &s, i] {
+                if (!checkpoint) {
+                    return make_ready_future<>();
+                }
+                return db::system_keyspace::save_compaction_checkpoint(s->ks_name(), s->cf_name(), sub_indexes[i], sub_count, input_generations);
+            });
+        }).then([checkpoint, &s] {
+            if (!checkpoint) {
+                return make_ready_future<>();
+            }
+            // The job is done; its inputs are gone from the sstable set, so
+            // the checkpoint would be stale from here on anyway.
+            return db::system_keyspace::remove_compaction_checkpoint(s->ks_name(), s->cf_name());
+        });
+    });
+}
+
 // Note: We assume that the column_family does not get destroyed during compaction.
 future<>
 table::compact_all_sstables() {
@@ -1180,7 +1336,7 @@ const std::vector<sstables::shared_sstable>& table::compacted_undeleted_sstables
 lw_shared_ptr<memtable_list>
 table::make_memory_only_memtable_list() {
     auto get_schema = [this] { return schema(); };
-    return make_lw_shared<memtable_list>(std::move(get_schema), _config.dirty_memory_manager, _stats, _config.memory_compaction_scheduling_group);
+    return make_lw_shared<memtable_list>(std::move(get_schema), _config.dirty_memory_manager, _stats, _config.memory_compaction_scheduling_group, &_dirty_region_group);
 }
 
 lw_shared_ptr<memtable_list>
@@ -1189,7 +1345,19 @@ table::make_memtable_list() {
         return seal_active_memtable(std::move(permit));
     };
     auto get_schema = [this] { return schema(); };
-    return make_lw_shared<memtable_list>(std::move(seal), std::move(get_schema), _config.dirty_memory_manager, _stats, _config.memory_compaction_scheduling_group);
+    return make_lw_shared<memtable_list>(std::move(seal), std::move(get_schema), _config.dirty_memory_manager, _stats, _config.memory_compaction_scheduling_group, &_dirty_region_group);
+}
+
+// A single table may hold at most this fraction of the shard's real dirty
+// limit in unflushed data before further writes to it are throttled. This
+// leaves headroom for writes to other tables when one table's flushes can't
+// keep up with its ingest. Unlimited managers (tests) stay unlimited.
+static size_t table_dirty_memory_threshold(const dirty_memory_manager& dmm) {
+    auto threshold = dmm.real_throttle_threshold();
+    if (threshold == std::numeric_limits<size_t>::max()) {
+        return threshold;
+    }
+    return threshold / 4 * 3;
 }
 
 table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_manager& compaction_manager,
@@ -1200,6 +1368,10 @@ table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_man
                          keyspace_label(_schema->ks_name()),
                          column_family_label(_schema->cf_name())
                         )
+    , _dirty_group_reclaimer(table_dirty_memory_threshold(*_config.dirty_memory_manager))
+    , _dirty_region_group(format("memtable ({}.{})", _schema->ks_name(), _schema->cf_name()),
+                          &_config.dirty_memory_manager->region_group(), _dirty_group_reclaimer,
+                          _config.statement_scheduling_group)
     , _memtables(_config.enable_disk_writes ? make_memtable_list() : make_memory_only_memtable_list())
     , _compaction_strategy(make_compaction_strategy(_schema->compaction_strategy(), _schema->compaction_strategy_options()))
     , _main_sstables(make_lw_shared<sstables::sstable_set>(_compaction_strategy.make_sstable_set(_schema)))
@@ -1211,6 +1383,7 @@ table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_man
     , _compaction_manager(compaction_manager)
     , _index_manager(*this)
     , _counter_cell_locks(_schema->is_counter() ? std::make_unique<cell_locker>(_schema, cl_stats) : nullptr)
+    , _counter_cell_cache(_schema->is_counter() ? std::make_unique<counter_cell_cache>() : nullptr)
     , _row_locker(_schema)
     , _off_strategy_trigger([this] { trigger_offstrategy_compaction(); })
 {
@@ -1218,6 +1391,45 @@ table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_man
         tlogger.warn("Writes disabled, column family no durable.");
     }
     set_metrics();
+    _cache.set_continuity_promotion_hook([this] (dht::token_range range) {
+        promote_cache_continuity(std::move(range));
+    });
+}
+
+// Reads through the given token range in the background so that the cache
+// marks it continuous and overlapping scans stop going to sstables for the
+// parts of the range earlier scans didn't cover. Invoked by the cache when a
+// range accumulates enough partition misses. Only one promotion runs at a
+// time; excess requests are dropped - the miss counters will trip again if
+// the range is still hot.
+void table::promote_cache_continuity(dht::token_range range) {
+    if (_cache_promotion_running || _async_gate.is_closed()) {
+        return;
+    }
+    _cache_promotion_running = true;
+    // The returned future is tracked by _async_gate.
+    (void)with_gate(_async_gate, [this, range = std::move(range)] () mutable {
+        // Don't start the read inside the cache read which tripped the miss
+        // counter.
+        return later().then([this, range = std::move(range)] {
+            tlogger.debug("Promoting cache continuity of {} in {}.{}", range, _schema->ks_name(), _schema->cf_name());
+            return do_with(dht::to_partition_range(std::move(range)), [this] (const dht::partition_range& pr) {
+                auto s = _schema;
+                auto reader = make_reader(s, streaming_read_concurrency_semaphore().make_permit(s.get(), "cache-continuity-promotion"),
+                        pr, s->full_slice(), service::get_local_streaming_priority(), nullptr,
+                        streamed_mutation::forwarding::no, mutation_reader::forwarding::no);
+                return do_with(std::move(reader), [] (flat_mutation_reader& reader) {
+                    // Scanning through the regular read path is what populates
+                    // the cache; the data itself is not needed.
+                    return reader.consume_pausable([] (mutation_fragment) { return stop_iteration::no; }, db::no_timeout);
+                });
+            });
+        });
+    }).handle_exception([this] (auto ep) {
+        tlogger.debug("Cache continuity promotion in {}.{} failed: {}", _schema->ks_name(), _schema->cf_name(), ep);
+    }).finally([this] {
+        _cache_promotion_running = false;
+    });
 }
 
 partition_presence_checker
@@ -1229,6 +1441,12 @@ table::make_partition_presence_checker(lw_shared_ptr<sstables::sstable_set> ssta
             return partition_presence_checker_result::definitely_doesnt_exist;
         }
         auto hk = sstables::sstable::make_hashed_key(*_schema, key.key());
+        // The key is hashed once; prefetch all the filters' cache lines
+        // before probing so the misses overlap instead of being taken
+        // serially, one per sstable.
+        for (auto&& s : sst) {
+            s->filter_prefetch(hk);
+        }
         for (auto&& s : sst) {
             if (s->filter_has_key(hk)) {
                 return partition_presence_checker_result::maybe_exists;
@@ -1365,20 +1583,26 @@ future<> table::write_schema_as_cql(database& db, sstring dir) const {
 
 future<> table::snapshot(database& db, sstring name) {
     return flush().then([this, &db, name = std::move(name)]() {
-       return with_semaphore(_sstable_deletion_sem, 1, [this, &db, name = std::move(name)]() {
-        auto tables = boost::copy_range<std::vector<sstables::shared_sstable>>(*_sstables->all());
         auto jsondir = _config.datadir + "/snapshots/" + name;
-        return do_with(std::move(tables), std::move(jsondir), [this, &db] (std::vector<sstables::shared_sstable>& tables, const sstring& jsondir) {
-            return io_check([&jsondir] { return recursive_touch_directory(jsondir); }).then([this, &db, &jsondir, &tables] {
-                return max_concurrent_for_each(tables, db.get_config().initial_sstable_loading_concurrency(), [&db, &jsondir] (sstables::shared_sstable sstable) {
-                  return with_semaphore(db.get_sharded_sst_dir_semaphore().local(), 1, [&jsondir, sstable] {
-                    return io_check([sstable, &dir = jsondir] {
-                        return sstable->create_links(dir);
+        return do_with(std::vector<sstables::shared_sstable>(), std::move(jsondir), [this, &db] (std::vector<sstables::shared_sstable>& tables, const sstring& jsondir) {
+            // The deletion semaphore is only needed while the links are being
+            // created: once they exist the snapshot no longer cares what
+            // compaction does to the originals. Holding it across the
+            // cross-shard manifest barrier below would stall compacted
+            // sstable deletion until every shard finished snapshotting.
+            return with_semaphore(_sstable_deletion_sem, 1, [this, &db, &tables, &jsondir] {
+                tables = boost::copy_range<std::vector<sstables::shared_sstable>>(*_sstables->all());
+                return io_check([&jsondir] { return recursive_touch_directory(jsondir); }).then([this, &db, &jsondir, &tables] {
+                    return max_concurrent_for_each(tables, db.get_config().initial_sstable_loading_concurrency(), [&db, &jsondir] (sstables::shared_sstable sstable) {
+                      return with_semaphore(db.get_sharded_sst_dir_semaphore().local(), 1, [&jsondir, sstable] {
+                        return io_check([sstable, &dir = jsondir] {
+                            return sstable->create_links(dir);
+                        });
+                      });
                     });
-                  });
+                }).then([&jsondir, &tables] {
+                    return io_check(sync_directory, jsondir);
                 });
-            }).then([&jsondir, &tables] {
-                return io_check(sync_directory, jsondir);
             }).finally([this, &tables, &db, &jsondir] {
                 auto shard = std::hash<sstring>()(jsondir) % smp::count;
                 std::unordered_set<sstring> table_names;
@@ -1422,7 +1646,6 @@ future<> table::snapshot(database& db, sstring name) {
                 });
             });
         });
-       });
     });
 }
 
@@ -1502,6 +1725,9 @@ bool table::can_flush() const {
 }
 
 future<> table::clear() {
+    if (_counter_cell_cache) {
+        _counter_cell_cache->clear();
+    }
     _memtables->clear_and_add();
     if (_commitlog) {
         _commitlog->discard_completed_segments(_schema->id());
@@ -1514,6 +1740,11 @@ future<> table::clear() {
 future<db::replay_position> table::discard_sstables(db_clock::time_point truncated_at) {
     assert(_compaction_disabled > 0);
 
+    if (_counter_cell_cache) {
+        // Truncation resets counters, cached shards must not survive it.
+        _counter_cell_cache->clear();
+    }
+
     struct pruner {
         column_family& cf;
         db::replay_position rp;
@@ -1583,6 +1814,10 @@ void table::set_schema(schema_ptr s) {
     if (_counter_cell_locks) {
         _counter_cell_locks->set_schema(s);
     }
+    if (_counter_cell_cache) {
+        // Column ids are not stable across schema changes.
+        _counter_cell_cache->clear();
+    }
     _schema = std::move(s);
 
     for (auto&& v : _views) {
@@ -1856,6 +2091,10 @@ void table::do_apply(db::rp_handle&& h, Args&&... args) {
         _highest_rp = std::max(_highest_rp, rp);
     } catch (...) {
         _failed_counter_applies_to_memtable++;
+        if (_counter_cell_cache) {
+            // We don't know which cells, if any, made it to the memtable.
+            _counter_cell_cache->clear();
+        }
         throw;
     }
     _stats.writes.mark(lc);
@@ -1908,10 +2147,11 @@ struct query_state {
                          const query::read_command& cmd,
                          query::result_options opts,
                          const dht::partition_range_vector& ranges,
-                         query::result_memory_accounter memory_accounter)
+                         query::result_memory_accounter memory_accounter,
+                         size_t result_size_hint)
             : schema(std::move(s))
             , cmd(cmd)
-            , builder(cmd.slice, opts, std::move(memory_accounter))
+            , builder(cmd.slice, opts, std::move(memory_accounter), result_size_hint)
             , limit(cmd.get_row_limit())
             , partition_limit(cmd.partition_limit)
             , current_partition_range(ranges.begin())
@@ -1936,6 +2176,23 @@ struct query_state {
     }
 };
 
+void table::maybe_update_activity() {
+    if (is_system_keyspace(_schema->ks_name())) {
+        return;
+    }
+    auto now = db_clock::now();
+    if (now - _last_activity_update < std::chrono::hours(1)) {
+        return;
+    }
+    _last_activity_update = now;
+    // A lost record only costs boot-ordering quality, so failures are
+    // logged and dropped.
+    (void)db::system_keyspace::update_table_activity(_schema->ks_name(), _schema->cf_name(), now).handle_exception(
+            [s = _schema] (std::exception_ptr ep) {
+        tlogger.debug("Failed to persist activity of {}.{}: {}", s->ks_name(), s->cf_name(), ep);
+    });
+}
+
 future<lw_shared_ptr<query::result>>
 table::query(schema_ptr s,
         const query::read_command& cmd,
@@ -1951,6 +2208,7 @@ table::query(schema_ptr s,
     }
 
     _async_gate.enter();
+    maybe_update_activity();
     utils::latency_counter lc;
     _stats.reads.set_latency(lc);
 
@@ -1966,7 +2224,19 @@ table::query(schema_ptr s,
     auto accounter = co_await (opts.request == query::result_request::only_digest
              ? memory_limiter.new_digest_read(*cmd.max_result_size, short_read_allowed) : memory_limiter.new_data_read(*cmd.max_result_size, short_read_allowed));
 
-    query_state qs(s, cmd, opts, partition_ranges, std::move(accounter));
+    // Digest-only requests discard the result buffer, so don't pre-size it.
+    const auto result_size_hint = opts.request == query::result_request::only_digest
+            ? size_t(0) : std::min<size_t>(_stats.average_query_result_size, cmd.max_result_size->soft_limit);
+    query_state qs(s, cmd, opts, partition_ranges, std::move(accounter), result_size_hint);
+
+    // Attach the request's remaining deadline and memory allowance to the
+    // permit so the storage layers below can size their speculative work
+    // (readahead) to what is left of the budget.
+    auto make_query_permit = [&] {
+        auto permit = class_config.semaphore.make_permit(s.get(), "data-query");
+        permit.set_budget(read_budget{db::timeout_clock::now(), timeout, cmd.max_result_size->hard_limit});
+        return permit;
+    };
 
     while (!qs.done()) {
         auto&& range = *qs.current_partition_range++;
@@ -1974,7 +2244,7 @@ table::query(schema_ptr s,
         auto querier_opt = cache_ctx.lookup_data_querier(*s, range, qs.cmd.slice, trace_state);
         auto q = querier_opt
                 ? std::move(*querier_opt)
-                : query::data_querier(as_mutation_source(), s, class_config.semaphore.make_permit(s.get(), "data-query"), range, qs.cmd.slice,
+                : query::data_querier(as_mutation_source(), s, make_query_permit(), range, qs.cmd.slice,
                         service::get_local_sstable_query_read_priority(), trace_state);
 
         std::exception_ptr ex;
@@ -1994,7 +2264,11 @@ table::query(schema_ptr s,
         }
     }
 
-    co_return make_lw_shared<query::result>(qs.builder.build());
+    auto result = make_lw_shared<query::result>(qs.builder.build());
+    if (opts.request != query::result_request::only_digest) {
+        _stats.average_query_result_size = (_stats.average_query_result_size * 7 + result->buf().size_bytes()) / 8;
+    }
+    co_return result;
 }
 
 future<reconcilable_result>
@@ -2010,10 +2284,19 @@ table::mutation_query(schema_ptr s,
         co_return reconcilable_result();
     }
 
+    maybe_update_activity();
+
+    // See table::query() for why the budget is attached to the permit.
+    auto make_query_permit = [&] {
+        auto permit = class_config.semaphore.make_permit(s.get(), "mutation-query");
+        permit.set_budget(read_budget{db::timeout_clock::now(), timeout, cmd.max_result_size->hard_limit});
+        return permit;
+    };
+
     auto querier_opt = cache_ctx.lookup_mutation_querier(*s, range, cmd.slice, trace_state);
     auto q = querier_opt
             ? std::move(*querier_opt)
-            : query::mutation_querier(as_mutation_source(), s, class_config.semaphore.make_permit(s.get(), "mutation-query"), range, cmd.slice,
+            : query::mutation_querier(as_mutation_source(), s, make_query_permit(), range, cmd.slice,
                     service::get_local_sstable_query_read_priority(), trace_state);
 
     std::exception_ptr ex;
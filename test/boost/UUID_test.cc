@@ -97,6 +97,25 @@ BOOST_AUTO_TEST_CASE(test_get_time_uuid) {
     BOOST_CHECK(unix_timestamp == millis);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_time_uuids_batch) {
+    using utils::UUID, utils::UUID_gen;
+
+    std::vector<UUID> uuids;
+    UUID_gen::get_time_UUIDs(1000, std::back_inserter(uuids));
+    BOOST_REQUIRE_EQUAL(uuids.size(), 1000);
+
+    for (auto& uuid : uuids) {
+        BOOST_CHECK(uuid.is_timestamp());
+    }
+    // Timestamps within a batch are consecutive...
+    for (size_t i = 1; i < uuids.size(); i++) {
+        BOOST_CHECK_EQUAL(uuids[i].timestamp(), uuids[i - 1].timestamp() + 1);
+    }
+    // ...and later UUIDs stay ahead of the reserved window.
+    auto next = UUID_gen::get_time_UUID();
+    BOOST_CHECK(next.timestamp() > uuids.back().timestamp());
+}
+
 int timeuuid_legacy_tri_compare(bytes_view o1, bytes_view o2) {
     auto compare_pos = [&] (unsigned pos, int mask, int ifequal) {
         int d = (o1[pos] & mask) - (o2[pos] & mask);
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include "utils/bloom_filter.hh"
+
+#include <fmt/format.h>
+
+using namespace utils;
+
+static bytes make_key(int i) {
+    auto s = fmt::format("key-{}", i);
+    return bytes(reinterpret_cast<const int8_t*>(s.data()), s.size());
+}
+
+static void test_filter_mode(filter_format format, bloom_filter_mode mode) {
+    constexpr int nr_keys = 10000;
+    auto filter = i_filter::get_filter(nr_keys, 0.01, format, mode);
+    BOOST_REQUIRE(filter->mode() == mode);
+
+    for (int i = 0; i < nr_keys; i++) {
+        filter->add(make_key(i));
+    }
+
+    // A bloom filter never gives false negatives.
+    for (int i = 0; i < nr_keys; i++) {
+        BOOST_REQUIRE(filter->is_present(make_key(i)));
+    }
+
+    // The false positive rate is probabilistic; allow generous margin over
+    // the configured 1% so the test is not flaky. The blocked layout trades
+    // some precision for locality but must stay in the same ballpark.
+    int false_positives = 0;
+    for (int i = nr_keys; i < 2 * nr_keys; i++) {
+        false_positives += filter->is_present(make_key(i));
+    }
+    BOOST_REQUIRE_LT(false_positives, nr_keys / 20);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_partitioned_filter) {
+    test_filter_mode(filter_format::k_l_format, bloom_filter_mode::partitioned);
+    test_filter_mode(filter_format::m_format, bloom_filter_mode::partitioned);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_blocked_filter) {
+    test_filter_mode(filter_format::k_l_format, bloom_filter_mode::blocked);
+    test_filter_mode(filter_format::m_format, bloom_filter_mode::blocked);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_blocked_filter_small) {
+    // Regression test: tiny element counts must still produce at least one
+    // whole block.
+    auto filter = i_filter::get_filter(1, 0.01, filter_format::m_format, bloom_filter_mode::blocked);
+    filter->add(make_key(0));
+    BOOST_REQUIRE(filter->is_present(make_key(0)));
+}
@@ -331,6 +331,65 @@ BOOST_AUTO_TEST_CASE(test_erase_range) {
     BOOST_REQUIRE(*t.find(25) == 25);
 }
 
+BOOST_AUTO_TEST_CASE(test_append) {
+    /* Bulk-load a sorted stream through the right edge */
+    test_tree t(int_compare{});
+
+    for (int i = 0; i < 128; i++) {
+        auto it = t.append(i, i + 1000);
+        BOOST_REQUIRE(*it == i + 1000);
+    }
+
+    int nr = 0;
+    for (auto i = t.begin(); i != t.end(); i++) {
+        BOOST_REQUIRE(*i == nr + 1000);
+        nr++;
+    }
+    BOOST_REQUIRE(nr == 128);
+    t.clear();
+}
+
+BOOST_AUTO_TEST_CASE(test_emplace_before_hint) {
+    test_tree t(int_compare{});
+
+    /* Even keys in sorted order, hinted by the previous insertion */
+    auto hint = t.end();
+    for (int i = 0; i < 64; i += 2) {
+        auto res = t.emplace_before_hint(hint, i, i);
+        BOOST_REQUIRE(res.second);
+        hint = res.first;
+        hint++;
+    }
+
+    /* Conflicting and unrelated hints fall back gracefully */
+    auto res = t.emplace_before_hint(t.end(), 0, 0);
+    BOOST_REQUIRE(!res.second);
+    res = t.emplace_before_hint(t.begin(), 33, 33);
+    BOOST_REQUIRE(res.second);
+    res = t.emplace_before_hint(t.find(4), 33, 33);
+    BOOST_REQUIRE(!res.second);
+
+    /* Odd keys merge in between the even ones in one pass */
+    hint = t.begin();
+    for (int i = 1; i < 64; i += 2) {
+        while (hint != t.end() && *hint < (unsigned long)i) {
+            hint++;
+        }
+        res = t.emplace_before_hint(hint, i, i);
+        BOOST_REQUIRE(res.second == (i != 33));
+        hint = res.first;
+        hint++;
+    }
+
+    int nr = 0;
+    for (auto i = t.begin(); i != t.end(); i++) {
+        BOOST_REQUIRE(*i == nr);
+        nr++;
+    }
+    BOOST_REQUIRE(nr == 64);
+    t.clear();
+}
+
 static bool key_simplified = false;
 
 static void check_conversions() {
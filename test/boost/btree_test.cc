@@ -536,6 +536,45 @@ BOOST_AUTO_TEST_CASE(test_swap_between_trees) {
     t2.clear_and_dispose(key_deleter);
 }
 
+BOOST_AUTO_TEST_CASE(test_merge_sorted) {
+    test_tree t;
+
+    /* Evens in, then merge odds plus some conflicts in one pass */
+    for (int i = 0; i < 32; i += 2) {
+        t.insert(std::make_unique<test_key>(i), cmp);
+    }
+
+    std::vector<std::unique_ptr<test_key>> batch;
+    for (int i = 1; i < 32; i += 2) {
+        batch.emplace_back(std::make_unique<test_key>(i));
+        batch.emplace_back(std::make_unique<test_key>(i + 1)); // conflicts
+    }
+    batch.emplace_back(std::make_unique<test_key>(32));
+
+    t.merge_sorted(batch, cmp);
+
+    int nr = 0;
+    for (auto i = t.begin(); i != t.end(); i++) {
+        BOOST_REQUIRE(*i == nr);
+        nr++;
+    }
+    BOOST_REQUIRE(nr == 33);
+    t.clear_and_dispose(key_deleter);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_sorted_into_empty) {
+    test_tree t;
+
+    std::vector<std::unique_ptr<test_key>> batch;
+    for (int i = 0; i < 32; i++) {
+        batch.emplace_back(std::make_unique<test_key>(i));
+    }
+
+    t.merge_sorted(batch, cmp);
+    BOOST_REQUIRE(t.calculate_size() == 32);
+    t.clear_and_dispose(key_deleter);
+}
+
 static void test_unlink_leftmost_n(int n) {
     fmt::print("CHK {}\n", n);
     test_tree t;
@@ -177,6 +177,40 @@ BOOST_AUTO_TEST_CASE(tests_constructor_exception_safety) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(tests_for_each_chunk) {
+    for (auto size : {size_t(0), size_t(1), size_t(128), size_t(128 + 5), size_t(4 * 128)}) {
+        disk_array v;
+        for (uint64_t i = 0; i < size; ++i) {
+            v.push_back(i);
+        }
+        uint64_t expected = 0;
+        v.for_each_chunk([&] (const uint64_t* p, size_t n) {
+            BOOST_REQUIRE(n > 0);
+            for (size_t i = 0; i < n; ++i) {
+                BOOST_REQUIRE_EQUAL(p[i], expected++);
+            }
+        });
+        BOOST_REQUIRE_EQUAL(expected, size);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tests_copy_and_compare) {
+    auto rand = std::default_random_engine();
+    for (auto size : {size_t(0), size_t(1), size_t(127), size_t(128), size_t(1000)}) {
+        disk_array v;
+        for (uint64_t i = 0; i < size; ++i) {
+            v.push_back(rand());
+        }
+        auto u = v;
+        BOOST_REQUIRE(boost::equal(u, v));
+        BOOST_REQUIRE(u == v);
+        if (size) {
+            u.back() ^= 1;
+            BOOST_REQUIRE(u != v);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(tests_reserve_partial) {
     auto rand = std::default_random_engine();
     auto size_dist = std::uniform_int_distribution<unsigned>(1, 1 << 12);
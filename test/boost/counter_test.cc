@@ -20,6 +20,7 @@
  */
 
 #include "counters.hh"
+#include "counter_cell_cache.hh"
 
 #include <random>
 
@@ -582,3 +583,81 @@ SEASTAR_TEST_CASE(test_counter_id_ordering) {
         }
     });
 }
+
+SEASTAR_TEST_CASE(test_counter_cell_cache) {
+    return seastar::async([] {
+        auto s = get_schema();
+        auto local_id = utils::make_random_uuid();
+
+        auto pk = partition_key::from_single_value(*s, int32_type->decompose(0));
+        auto ck = clustering_key::from_single_value(*s, int32_type->decompose(0));
+        auto& col = *s->get_column_definition(utf8_type->decompose(sstring("c1")));
+        auto& scol = *s->get_column_definition(utf8_type->decompose(sstring("s1")));
+
+        auto make_update = [&] (int64_t delta) {
+            mutation m(s, pk);
+            m.set_clustered_cell(ck, col, atomic_cell::make_live_counter_update(api::new_timestamp(), delta));
+            m.set_static_cell(scol, atomic_cell::make_live_counter_update(api::new_timestamp(), delta - 1));
+            return m;
+        };
+
+        counter_cell_cache cache;
+
+        // Nothing cached yet -- the read-before-write cannot be skipped.
+        auto m1 = make_update(5);
+        BOOST_REQUIRE(!counter_state_from_cache(cache, m1));
+        BOOST_REQUIRE_EQUAL(cache.get_stats().hits, 0);
+
+        transform_counter_updates_to_shards(m1, nullptr, 0, local_id);
+        update_counter_cache(cache, m1, local_id);
+        BOOST_REQUIRE_EQUAL(cache.size(), 2);
+
+        // The second update of the same cells can use the cached shards and
+        // has to produce exactly the same result as a transform against the
+        // state read from the table.
+        auto m2 = make_update(9);
+        auto m2_reference = m2;
+        transform_counter_updates_to_shards(m2_reference, &m1, 0, local_id);
+
+        auto state = counter_state_from_cache(cache, m2);
+        BOOST_REQUIRE(state);
+        transform_counter_updates_to_shards(m2, &*state, 0, local_id);
+        BOOST_REQUIRE_EQUAL(m2, m2_reference);
+
+        auto ac = get_counter_cell(m2);
+      {
+        counter_cell_view ccv(ac);
+        BOOST_REQUIRE_EQUAL(ccv.total_value(), 14);
+        verify_shard_order(ccv);
+      }
+
+        ac = get_static_counter_cell(m2);
+      {
+        counter_cell_view ccv(ac);
+        BOOST_REQUIRE_EQUAL(ccv.total_value(), 12);
+        verify_shard_order(ccv);
+      }
+
+        update_counter_cache(cache, m2, local_id);
+        BOOST_REQUIRE_EQUAL(cache.size(), 2);
+
+        // An update touching a cell that is not cached cannot skip the read.
+        auto ck2 = clustering_key::from_single_value(*s, int32_type->decompose(1));
+        mutation m3(s, pk);
+        m3.set_clustered_cell(ck2, col, atomic_cell::make_live_counter_update(api::new_timestamp(), 1));
+        BOOST_REQUIRE(!counter_state_from_cache(cache, m3));
+
+        // Static and clustered cells of the same column id must not alias.
+        auto cs = cache.find(pk, nullptr, scol.id);
+        BOOST_REQUIRE(cs);
+        BOOST_REQUIRE_EQUAL(cs->value(), 12);
+        cs = cache.find(pk, &ck, col.id);
+        BOOST_REQUIRE(cs);
+        BOOST_REQUIRE_EQUAL(cs->value(), 14);
+        BOOST_REQUIRE_EQUAL(cs->logical_clock(), 2);
+
+        cache.clear();
+        BOOST_REQUIRE_EQUAL(cache.size(), 0);
+        BOOST_REQUIRE(!counter_state_from_cache(cache, make_update(1)));
+    });
+}
@@ -220,3 +220,38 @@ BOOST_AUTO_TEST_CASE(test_random_operations) {
         BOOST_CHECK_NO_THROW(test_random_ops(size, re));
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_rank_select) {
+    for (auto size : { 1u, 63u, 64u, 65u, 2000u, 4096u, 262144u + 1 }) {
+        utils::dynamic_bitset bits(size);
+
+        BOOST_REQUIRE_EQUAL(bits.count(), 0);
+        BOOST_REQUIRE_EQUAL(bits.select(0), utils::dynamic_bitset::npos);
+
+        for (size_t i = 0; i < size; i += 3) {
+            bits.set(i);
+        }
+
+        size_t expected = 0;
+        for (size_t i = 0; i < size; i++) {
+            BOOST_REQUIRE_EQUAL(bits.rank(i), expected);
+            if (i % 3 == 0) {
+                expected++;
+            }
+        }
+        BOOST_REQUIRE_EQUAL(bits.count(), expected);
+        BOOST_REQUIRE_EQUAL(bits.rank(size), expected);
+
+        for (size_t k = 0; k < expected; k++) {
+            BOOST_REQUIRE_EQUAL(bits.select(k), k * 3);
+        }
+        BOOST_REQUIRE_EQUAL(bits.select(expected), utils::dynamic_bitset::npos);
+
+        // The directory must be rebuilt after a modification.
+        bits.clear(0);
+        BOOST_REQUIRE_EQUAL(bits.count(), expected - 1);
+        if (expected > 1) {
+            BOOST_REQUIRE_EQUAL(bits.select(0), 3);
+        }
+    }
+}
@@ -26,6 +26,7 @@
 #include "seastarx.hh"
 #include <seastar/testing/test_case.hh>
 #include "utils/hash.hh"
+#include "xx_hasher.hh"
 
 SEASTAR_TEST_CASE(test_pair_hash){
     auto hash_compare = [](auto p) {
@@ -72,3 +73,36 @@ SEASTAR_TEST_CASE(test_tuple_hash){
 
     return make_ready_future<>();
 }
+
+SEASTAR_TEST_CASE(test_xx3_hasher_is_streaming) {
+    std::string data(100 * 1000, '\0');
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = char(i * 31 + 7);
+    }
+
+    // The digest must not depend on how the input is split into updates.
+    auto digest_with_chunk_size = [&] (size_t chunk) {
+        xx3_hasher h;
+        for (size_t pos = 0; pos < data.size(); pos += chunk) {
+            h.update(data.data() + pos, std::min(chunk, data.size() - pos));
+        }
+        return h.finalize_array();
+    };
+
+    auto expected = digest_with_chunk_size(data.size());
+    for (auto chunk : {size_t(1), size_t(7), size_t(1024), size_t(64 * 1024)}) {
+        BOOST_CHECK(digest_with_chunk_size(chunk) == expected);
+    }
+
+    // XXH3 is a different function than XXH64.
+    xx_hasher xx64;
+    xx64.update(data.data(), data.size());
+    BOOST_CHECK(xx64.finalize_array() != expected);
+
+    // Seeds produce independent digests.
+    xx3_hasher seeded(42);
+    seeded.update(data.data(), data.size());
+    BOOST_CHECK(seeded.finalize_array() != expected);
+
+    return make_ready_future<>();
+}
@@ -23,6 +23,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <string>
+
 #include "utils/like_matcher.hh"
 
 auto matcher(const char* s) { return like_matcher(bytes(s)); }
@@ -456,3 +459,20 @@ BOOST_AUTO_TEST_CASE(test_reset) {
     BOOST_TEST(matches(m, u8"alpha"));
     BOOST_TEST(!matches(m, u8"omega"));
 }
+
+BOOST_AUTO_TEST_CASE(test_long_text) {
+    // Exercise the literal-skipping path over text much longer than the
+    // pattern, including first-byte decoys in front of the real match.
+    std::string text(10000, 'x');
+    text += "needle";
+    text += std::string(10000, 'x');
+    std::replace(text.begin(), text.begin() + 5000, 'x', 'n');
+    auto m = matcher(u8"%needle%");
+    BOOST_TEST(matches(m, text.c_str()));
+    auto absent = matcher(u8"%needier%");
+    BOOST_TEST(!matches(absent, text.c_str()));
+    auto anchored = matcher(u8"n%needle%x");
+    BOOST_TEST(matches(anchored, text.c_str()));
+    auto wild = matcher(u8"%need_e%");
+    BOOST_TEST(matches(wild, text.c_str()));
+}
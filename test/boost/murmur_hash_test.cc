@@ -25,6 +25,7 @@
 
 #include "utils/murmur_hash.hh"
 #include "bytes.hh"
+#include <vector>
 #include <seastar/core/print.hh>
 
 static const bytes full_sequence("012345678901234567890123456789012345678901234567890123456789");
@@ -122,3 +123,25 @@ BOOST_AUTO_TEST_CASE(test_hash_output) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_batch_hash_output) {
+    // Every prefix of full_sequence, in one batch. The batch size is
+    // deliberately not a multiple of the interleaving width, and the key
+    // lengths cover empty keys, sub-block tails and multi-block bodies.
+    std::vector<bytes_view> keys;
+    for (size_t i = 0; i <= full_sequence.size(); ++i) {
+        keys.emplace_back(full_sequence.begin(), i);
+    }
+
+    std::vector<std::array<uint64_t, 2>> results(keys.size());
+    utils::murmur_hash::hash3_x64_128_batch(keys.data(), keys.size(), seed, results.data());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        std::array<uint64_t, 2> expected;
+        utils::murmur_hash::hash3_x64_128(keys[i], seed, expected);
+        if (results[i] != expected) {
+            BOOST_FAIL(format("Batch hash differs for {} (got {{0x{:x}, 0x{:x}}}, expected {{0x{:x}, 0x{:x}}})",
+                to_hex(keys[i]), results[i][0], results[i][1], expected[0], expected[1]));
+        }
+    }
+}
@@ -129,6 +129,40 @@ BOOST_AUTO_TEST_CASE(test_lower_bound) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_64bit_keys) {
+    /* Token-wide keys exercising the deep (10-level) radix descent */
+    using test_tree64 = tree<test_data, uint64_t>;
+    test_tree64 tree;
+
+    std::vector<uint64_t> keys;
+    for (uint64_t i = 0; i < 1000; i++) {
+        keys.push_back(i * 0x9e3779b97f4a7c15ull); // golden-ratio spread
+    }
+
+    for (auto k : keys) {
+        tree.emplace(k, k);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    auto it = tree.begin();
+    for (auto k : keys) {
+        BOOST_REQUIRE(it != tree.end());
+        BOOST_REQUIRE(it.key() == k);
+        BOOST_REQUIRE(it->value() == k);
+        it++;
+    }
+    BOOST_REQUIRE(it == tree.end());
+
+    for (auto k : keys) {
+        test_data* d = tree.lower_bound(k);
+        BOOST_REQUIRE(d != nullptr);
+        BOOST_REQUIRE(d->value() == k);
+        tree.erase(k);
+        BOOST_REQUIRE(tree.get(k) == nullptr);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_clear) {
     test_tree tree;
 
@@ -141,6 +141,31 @@ SEASTAR_TEST_CASE(test_store_load_log_entries) {
     });
 }
 
+SEASTAR_TEST_CASE(test_store_log_entries_replaces_tail) {
+    return do_with_cql_env([] (cql_test_env& env) -> future<> {
+        cql3::query_processor& qp = env.local_qp();
+        raft_sys_table_storage storage(qp, gid);
+
+        std::vector<raft::log_entry_ptr> entries = create_test_log();
+        co_await storage.store_log_entries(entries);
+
+        // A new leader may replace an uncommitted tail of the log; previously
+        // stored entries past the new ones must be removed by the store itself
+        std::vector<raft::log_entry_ptr> new_tail = {
+            make_lw_shared(raft::log_entry{
+                .term = raft::term_t(4),
+                .idx = raft::index_t(2),
+                .data = raft::log_entry::dummy()})
+        };
+        co_await storage.store_log_entries(new_tail);
+
+        raft::log_entries loaded_entries = co_await storage.load_log();
+        BOOST_CHECK_EQUAL(loaded_entries.size(), 2);
+        BOOST_CHECK(*entries[0] == *loaded_entries[0]);
+        BOOST_CHECK(*new_tail[0] == *loaded_entries[1]);
+    });
+}
+
 SEASTAR_TEST_CASE(test_truncate_log) {
     return do_with_cql_env([] (cql_test_env& env) -> future<> {
         cql3::query_processor& qp = env.local_qp();
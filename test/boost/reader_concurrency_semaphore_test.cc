@@ -478,6 +478,30 @@ SEASTAR_TEST_CASE(reader_concurrency_semaphore_timeout) {
     });
 }
 
+SEASTAR_TEST_CASE(reader_concurrency_semaphore_adaptive_admission_cost) {
+    return async([&] () {
+        reader_concurrency_semaphore semaphore(2, new_reader_base_cost, get_name());
+        auto stop_sem = deferred_stop(semaphore);
+
+        // With no history the base cost is used as-is.
+        BOOST_REQUIRE_EQUAL(semaphore.admission_cost(new_reader_base_cost), new_reader_base_cost);
+
+        {
+            auto permit = semaphore.make_permit(nullptr, "permit1");
+            auto res = permit.wait_admission(semaphore.admission_cost(new_reader_base_cost), db::no_timeout).get();
+            auto units = permit.consume_memory(2 * 1024);
+        }
+
+        // The estimate converges towards the observed peak consumption and
+        // stays clamped to sane bounds.
+        const auto cost = semaphore.admission_cost(new_reader_base_cost);
+        BOOST_REQUIRE_LT(cost, size_t(new_reader_base_cost));
+        BOOST_REQUIRE_GE(cost, size_t(1024));
+
+        REQUIRE_EVENTUALLY_EQUAL(new_reader_base_cost, semaphore.available_resources().memory);
+    });
+}
+
 SEASTAR_TEST_CASE(reader_concurrency_semaphore_max_queue_length) {
     return async([&] () {
         reader_concurrency_semaphore semaphore(1, new_reader_base_cost, get_name(), 2);
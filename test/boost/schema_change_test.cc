@@ -214,9 +214,9 @@ SEASTAR_TEST_CASE(test_column_is_dropped) {
             e.execute_cql("alter table tests.table1 add s1 int;").get();
 
             schema_ptr s = e.db().local().find_schema("tests", "table1");
-            BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c1")));
-            BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c2")));
-            BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s1")));
+            BOOST_REQUIRE(s->get_column_definition(to_bytes("c1")));
+            BOOST_REQUIRE(!s->get_column_definition(to_bytes("c2")));
+            BOOST_REQUIRE(s->get_column_definition(to_bytes("s1")));
         });
     });
 }
@@ -229,15 +229,15 @@ SEASTAR_TEST_CASE(test_static_column_is_dropped) {
         e.execute_cql("alter table tests.table1 drop c2;").get();
         e.execute_cql("alter table tests.table1 add s1 int static;").get();
         schema_ptr s = e.db().local().find_schema("tests", "table1");
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c1")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c2")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s1")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("c1")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c2")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s1")));
 
         e.execute_cql("alter table tests.table1 drop s1;").get();
         s = e.db().local().find_schema("tests", "table1");
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c1")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c2")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("s1")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("c1")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c2")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("s1")));
     });
 }
 
@@ -249,20 +249,20 @@ SEASTAR_TEST_CASE(test_multiple_columns_add_and_drop) {
         e.execute_cql("alter table tests.table1 drop (c2);").get();
         e.execute_cql("alter table tests.table1 add (s1 int);").get();
         schema_ptr s = e.db().local().find_schema("tests", "table1");
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c1")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c2")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c3")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s1")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("c1")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c2")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("c3")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s1")));
 
         e.execute_cql("alter table tests.table1 drop (c1, c3);").get();
         e.execute_cql("alter table tests.table1 add (s2 int, s3 int);").get();
         s = e.db().local().find_schema("tests", "table1");
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c1")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c2")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c3")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s1")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s2")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s3")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c1")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c2")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c3")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s1")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s2")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s3")));
     });
 }
 
@@ -274,20 +274,20 @@ SEASTAR_TEST_CASE(test_multiple_static_columns_add_and_drop) {
         e.execute_cql("alter table tests.table1 drop (c2);").get();
         e.execute_cql("alter table tests.table1 add (s1 int static);").get();
         schema_ptr s = e.db().local().find_schema("tests", "table1");
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c1")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c2")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c3")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s1")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("c1")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c2")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("c3")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s1")));
 
         e.execute_cql("alter table tests.table1 drop (c3, s1);").get();
         e.execute_cql("alter table tests.table1 add (s2 int, s3 int static);").get();
         s = e.db().local().find_schema("tests", "table1");
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("c1")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c2")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("c3")));
-        BOOST_REQUIRE(!s->columns_by_name().contains(to_bytes("s1")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s2")));
-        BOOST_REQUIRE(s->columns_by_name().contains(to_bytes("s3")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("c1")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c2")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("c3")));
+        BOOST_REQUIRE(!s->get_column_definition(to_bytes("s1")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s2")));
+        BOOST_REQUIRE(s->get_column_definition(to_bytes("s3")));
     });
 }
 
@@ -5234,7 +5234,7 @@ struct large_row_handler : public db::large_data_handler {
 
     large_row_handler(uint64_t large_rows_threshold, uint64_t rows_count_threshold, callback_t callback)
         : large_data_handler(std::numeric_limits<uint64_t>::max(), large_rows_threshold, std::numeric_limits<uint64_t>::max(),
-            rows_count_threshold)
+            rows_count_threshold, std::numeric_limits<uint64_t>::max())
         , callback(std::move(callback)) {
         start();
     }
@@ -5266,6 +5266,10 @@ struct large_row_handler : public db::large_data_handler {
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view) const override {
         return make_ready_future<>();
     }
+
+    virtual future<> record_large_read(const read_info& info) const override {
+        return make_ready_future<>();
+    }
 };
 }
 
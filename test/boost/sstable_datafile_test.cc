@@ -4707,6 +4707,52 @@ SEASTAR_TEST_CASE(sstable_tombstone_histogram_test) {
     });
 }
 
+SEASTAR_TEST_CASE(sstable_tombstone_density_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        for (auto version : all_sstable_versions) {
+            auto builder = schema_builder("tests", "tombstone_density_test")
+                    .with_column("id", utf8_type, column_kind::partition_key)
+                    .with_column("value", int32_type);
+            auto s = builder.build();
+
+            auto tmp = tmpdir();
+            auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1), version]() mutable {
+                return env.make_sstable(s, tmp.path().string(), (*gen)++, version, big);
+            };
+
+            auto next_timestamp = [] {
+                static thread_local api::timestamp_type next = 1;
+                return next++;
+            };
+
+            std::vector<mutation> mutations;
+            constexpr auto tombstones = 100;
+            for (auto i = 0; i < tombstones; i++) {
+                auto key = partition_key::from_exploded(*s, {to_bytes("key" + to_sstring(i))});
+                mutation m(s, key);
+                m.partition().apply(tombstone(next_timestamp(), gc_clock::now()));
+                mutations.push_back(std::move(m));
+            }
+            auto sst = make_sstable_containing(sst_gen, mutations);
+            sst = env.reusable_sst(s, tmp.path().string(), sst->generation(), version).get0();
+
+            auto* density = sst->get_tombstone_density();
+            BOOST_REQUIRE(density != nullptr);
+            BOOST_REQUIRE(density->buckets.elements.size() == sstables::TOMBSTONE_DENSITY_BUCKET_COUNT);
+            auto total = boost::accumulate(density->buckets.elements, uint64_t(0));
+            BOOST_REQUIRE(total == tombstones);
+
+            // An sstable without tombstones carries no density histogram.
+            auto key = partition_key::from_exploded(*s, {to_bytes("key")});
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), next_timestamp());
+            auto live_sst = make_sstable_containing(sst_gen, {std::move(m)});
+            live_sst = env.reusable_sst(s, tmp.path().string(), live_sst->generation(), version).get0();
+            BOOST_REQUIRE(live_sst->get_tombstone_density() == nullptr);
+        }
+    });
+}
+
 SEASTAR_TEST_CASE(sstable_bad_tombstone_histogram_test) {
     return test_env::do_with_async([] (test_env& env) {
         auto builder = schema_builder("tests", "tombstone_histogram_test")
@@ -23,6 +23,7 @@
 #include <seastar/testing/thread_test_case.hh>
 #include <seastar/testing/test_case.hh>
 #include <seastar/core/sstring.hh>
+#include <seastar/core/fstream.hh>
 #include "sstables/sstable_directory.hh"
 #include "distributed_loader.hh"
 #include "test/lib/sstable_utils.hh"
@@ -412,6 +413,76 @@ SEASTAR_THREAD_TEST_CASE(sstable_directory_unshared_sstables_sanity_unmatched_ge
   }).get();
 }
 
+// Test that an ownership manifest left by a previous processing round routes misplaced
+// SSTables straight to their owner shards, and that a manifest written under a different
+// shard count is ignored.
+SEASTAR_THREAD_TEST_CASE(sstable_directory_unshared_sstables_ownership_manifest) {
+  sstables::test_env::do_with_sharded_async([] (sharded<test_env>& env) {
+    auto dir = tmpdir();
+    for (shard_id i = 0; i < smp::count; ++i) {
+        env.invoke_on(i, [dir = dir.path(), i] (sstables::test_env& env) {
+            // this is why it is annoying for the internal functions in the test infrastructure to
+            // assume threaded execution
+            return seastar::async([dir, i, &env] {
+                make_sstable_for_this_shard(std::bind(new_sstable, std::ref(env), dir, i + 1));
+            });
+        }).get();
+    }
+
+   with_sstable_directory(dir.path(), 1,
+            sstable_directory::need_mutate_level::no,
+            sstable_directory::lack_of_toc_fatal::yes,
+            sstable_directory::enable_dangerous_direct_import_of_cassandra_counters::no,
+            sstable_directory::allow_loading_materialized_view::no,
+            sstable_from_existing_file(env),
+            [] (sharded<sstables::sstable_directory>& sstdir) {
+    distributed_loader::process_sstable_dir(sstdir).get();
+    using manifest_entries = std::vector<sstable_directory::manifest_entry>;
+    auto entries = sstdir.map_reduce0(std::mem_fn(&sstable_directory::local_ownership_entries),
+            manifest_entries(), [] (manifest_entries a, manifest_entries b) {
+        std::move(b.begin(), b.end(), std::back_inserter(a));
+        return a;
+    }).get0();
+    BOOST_REQUIRE_EQUAL(entries.size(), smp::count);
+    sstdir.local().store_ownership_manifest(std::move(entries)).get();
+   });
+
+   // Reprocess with the manifest in place. The generation numbers don't match the
+   // shard-assignments, so every SSTable takes the manifest-routed path.
+   with_sstable_directory(dir.path(), 1,
+            sstable_directory::need_mutate_level::no,
+            sstable_directory::lack_of_toc_fatal::yes,
+            sstable_directory::enable_dangerous_direct_import_of_cassandra_counters::no,
+            sstable_directory::allow_loading_materialized_view::no,
+            sstable_from_existing_file(env),
+            [] (sharded<sstables::sstable_directory>& sstdir) {
+    distributed_loader::process_sstable_dir(sstdir).get();
+    verify_that_all_sstables_are_local(sstdir, smp::count).get();
+   });
+
+    // Overwrite the manifest with one claiming a different shard count. It must be
+    // ignored, and processing should still sort every SSTable correctly.
+    auto manifest = dir.path() / fs::path(sstable_directory::ownership_manifest_basename());
+    auto f = open_file_dma(manifest.native(), open_flags::wo | open_flags::create | open_flags::truncate).get0();
+    auto out = make_file_output_stream(std::move(f)).get0();
+    auto bogus = format("1 {}\n1 0\n", smp::count + 1);
+    out.write(bogus.c_str(), bogus.size()).get();
+    out.flush().get();
+    out.close().get();
+
+   with_sstable_directory(dir.path(), 1,
+            sstable_directory::need_mutate_level::no,
+            sstable_directory::lack_of_toc_fatal::yes,
+            sstable_directory::enable_dangerous_direct_import_of_cassandra_counters::no,
+            sstable_directory::allow_loading_materialized_view::no,
+            sstable_from_existing_file(env),
+            [] (sharded<sstables::sstable_directory>& sstdir) {
+    distributed_loader::process_sstable_dir(sstdir).get();
+    verify_that_all_sstables_are_local(sstdir, smp::count).get();
+   });
+  }).get();
+}
+
 // Test that the sstable_dir object can keep the table alive against a drop
 SEASTAR_TEST_CASE(sstable_directory_test_table_lock_works) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
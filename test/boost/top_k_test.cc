@@ -146,6 +146,82 @@ struct hash<bad_boy>
 };
 }
 
+using decayed_t = utils::decayed_top_k<unsigned>;
+
+vector<unsigned> count(const decayed_t::results& res) {
+    vector<unsigned> v;
+    for (auto& c : res) {
+        v.push_back(c.count);
+    }
+    return v;
+}
+
+BOOST_AUTO_TEST_CASE(test_decayed_top_k_straight_insertion) {
+    decayed_t top(32);
+
+    for (unsigned i = 0; i < freq.size(); ++i) {
+        for (unsigned j = 0; j < freq[i]; ++j) {
+            top.append(i);
+        }
+    }
+
+    vector<unsigned> res = count(top.top(10));
+    BOOST_REQUIRE_EQUAL(res, exp_results());
+}
+
+BOOST_AUTO_TEST_CASE(test_decayed_top_k_eviction) {
+    decayed_t top(4);
+
+    // The heavy keys must displace the earlier light ones from the
+    // size-4 exact table.
+    for (unsigned i = 0; i < 64; ++i) {
+        top.append(i);
+    }
+    for (unsigned j = 0; j < 100; ++j) {
+        for (unsigned i = 100; i < 104; ++i) {
+            top.append(i);
+        }
+    }
+
+    auto res = top.top(4);
+    BOOST_REQUIRE_EQUAL(res.size(), 4);
+    for (auto& r : res) {
+        BOOST_REQUIRE(r.item >= 100 && r.item < 104);
+        BOOST_REQUIRE(r.count >= 100); // estimates never underestimate
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_decayed_top_k_decay) {
+    decayed_t top(8);
+
+    for (unsigned j = 0; j < 64; ++j) {
+        top.append(1);
+    }
+    top.append(2);
+
+    top.decay();
+    top.decay();
+
+    // 1 retains a quarter of its weight, 2 decays to zero and is dropped.
+    auto res = top.top(8);
+    BOOST_REQUIRE_EQUAL(res.size(), 1);
+    BOOST_REQUIRE_EQUAL(res[0].item, 1);
+    BOOST_REQUIRE_EQUAL(res[0].count, 16);
+
+    // A decayed old key loses to fresh traffic.
+    for (unsigned j = 0; j < 100; ++j) {
+        top.append(3);
+    }
+    res = top.top(1);
+    BOOST_REQUIRE_EQUAL(res[0].item, 3);
+
+    top.clear();
+    BOOST_REQUIRE_EQUAL(top.size(), 0);
+    BOOST_REQUIRE(top.top(8).empty());
+}
+
+//---------------------------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_CASE(test_top_k_fail) {
     utils::space_saving_top_k<bad_boy> top(32);
 
@@ -26,6 +26,8 @@
 #include "test/lib/mutation_source_test.hh"
 
 #include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/util/closeable.hh>
 
 class memtable_filling_test_vt : public db::memtable_filling_virtual_table {
     std::vector<mutation> _mutations;
@@ -47,3 +49,30 @@ SEASTAR_THREAD_TEST_CASE(test_memtable_filling_vt_as_mutation_source) {
         return table->as_mutation_source();
     });
 }
+
+class streaming_test_vt : public db::streaming_virtual_table {
+    std::vector<mutation> _mutations;
+public:
+    streaming_test_vt(schema_ptr s, std::vector<mutation> mutations)
+            : streaming_virtual_table(s)
+            , _mutations(std::move(mutations)) {
+        _shard_aware = true;
+    }
+
+    future<> execute(reader_permit permit, db::result_collector& result, const db::query_restrictions&) override {
+        auto rd = flat_mutation_reader_from_mutations(std::move(permit), _mutations);
+        auto close_rd = deferred_close(rd);
+        co_await rd.consume_pausable([&result] (mutation_fragment mf) {
+            return result.take(std::move(mf)).then([] { return stop_iteration::no; });
+        }, db::no_timeout);
+    }
+};
+
+SEASTAR_THREAD_TEST_CASE(test_streaming_vt_as_mutation_source) {
+    std::unique_ptr<streaming_test_vt> table; // Used to prolong table's life
+
+    run_mutation_source_tests([&table] (schema_ptr s, const std::vector<mutation>& mutations, gc_clock::time_point) -> mutation_source {
+        table = std::make_unique<streaming_test_vt>(s, mutations);
+        return table->as_mutation_source();
+    });
+}
@@ -28,7 +28,7 @@
 #include "seastarx.hh"
 #include "utils/extremum_tracking.hh"
 #include "utils/estimated_histogram.hh"
-#include "linux-perf-event.hh"
+#include "utils/linux-perf-event.hh"
 
 #include <chrono>
 #include <iosfwd>
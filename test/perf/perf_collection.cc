@@ -200,6 +200,65 @@ public:
     virtual ~radix_tester() { clear(); }
 };
 
+/*
+ * Same as radix_tester, but keyed on the full 64-bit space the way the
+ * partition tokens are. The keys are spread with a fixed odd multiplier
+ * (a bijection), modelling the murmur-hashed token distribution that a
+ * token-keyed partition index would see.
+ */
+class radix64_tester : public collection_tester {
+public:
+    using test_tree = compact_radix_tree::tree<unsigned long, uint64_t>;
+
+private:
+    test_tree _t;
+
+    static uint64_t spread(per_key_t k) noexcept {
+        return (uint64_t)k * 0x9e3779b97f4a7c15ull;
+    }
+
+public:
+    radix64_tester() : _t() {}
+    virtual void insert(per_key_t k) override { _t.emplace(spread(k), 0); }
+    virtual void lower_bound(per_key_t k) override {
+        auto i = _t.get(spread(k));
+        assert(i != nullptr);
+    }
+    virtual void scan(int batch) override {
+        scan_collection(_t, batch);
+    }
+    virtual void erase(per_key_t k) override { _t.erase(spread(k)); }
+    virtual void drain(int batch) override {
+        int x = 0;
+        while (!_t.empty()) {
+            _t.erase(_t.begin().key());
+            if (++x % batch == 0) {
+                seastar::thread::yield();
+            }
+        }
+    }
+    virtual void clear() override { _t.clear(); }
+    virtual void clone() override {
+        test_tree ct;
+        ct.clone_from(_t, [] (uint64_t, const unsigned long& data) { return data; });
+    }
+    virtual void insert_and_erase(per_key_t k) override {
+        _t.emplace(spread(k), 0);
+        _t.erase(spread(k));
+    }
+    void show_node_stats(std::string typ, typename test_tree::stats::node_stats& st) {
+        fmt::print("{}: indirect: {}/{}/{}/{}  direct: static {} dynamic {}\n", typ,
+                st.indirect_tiny, st.indirect_small, st.indirect_medium, st.indirect_large,
+                st.direct_static, st.direct_dynamic);
+    }
+    virtual void show_stats() {
+        test_tree::stats st = _t.get_stats();
+        show_node_stats("inner", st.inners);
+        show_node_stats(" leaf", st.leaves);
+    }
+    virtual ~radix64_tester() { clear(); }
+};
+
 #include "intrusive_set_external_comparator.hh"
 
 class isec_tester : public collection_tester {
@@ -419,6 +478,8 @@ int main(int argc, char **argv) {
                 c = std::make_unique<isec_tester>();
             } else if (col == "radix") {
                 c = std::make_unique<radix_tester>();
+            } else if (col == "radix64") {
+                c = std::make_unique<radix64_tester>();
             } else {
                 fmt::print("Unknown collection\n");
                 return;
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <seastar/core/distributed.hh>
+#include <seastar/core/app-template.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/core/reactor.hh>
+
+#include <deque>
+
+#include "utils/managed_bytes.hh"
+#include "utils/logalloc.hh"
+#include "row_cache.hh"
+#include "partition_slice_builder.hh"
+#include "schema_builder.hh"
+#include "memtable.hh"
+#include "test/lib/memtable_snapshot_source.hh"
+#include "test/perf/perf.hh"
+#include "test/lib/reader_permit.hh"
+#include "test/lib/random_utils.hh"
+#include "test/lib/simple_schema.hh"
+
+/// Stresses the row cache with the three ingredients of our production
+/// cache pathologies at once: memtable updates racing with point reads,
+/// long-lived readers pinning partition_snapshots (stand-ins for repair
+/// readers), and sustained eviction pressure. perf_row_cache_reads and
+/// perf_row_cache_update each exercise one of these in isolation; the
+/// interesting degradations only show up when the MVCC version chains
+/// deepened by the pinned snapshots have to be walked by reads and
+/// squashed by updates while LSA is simultaneously compacting and
+/// evicting.
+///
+/// Watch the "comp bw" column (logalloc compaction bandwidth during the
+/// update) and the read throughput; both collapsing together while
+/// "snapshots" is non-zero is the signature we are after.
+
+static const int cell_size = 128;
+static const auto MB = 1024 * 1024;
+static bool cancelled = false;
+
+static unsigned update_iterations = 8;
+static unsigned held_snapshots = 4;
+static size_t cache_limit = 0;
+static size_t memtable_size = 0;
+
+void test_mixed_load_with_pinned_snapshots() {
+    simple_schema ss;
+    auto s = ss.schema();
+
+    cache_tracker tracker;
+    memtable_snapshot_source mss(s);
+    row_cache cache(s, snapshot_source([&] { return mss(); }), tracker, is_continuous::yes);
+
+    auto pk = ss.make_pkey(0);
+    auto pr = dht::partition_range::make_singular(pk);
+    auto val = sstring(sstring::initialized_later(), cell_size);
+    uint32_t ck_index = 0;
+
+    // Readers parked mid-partition. Each one pins a partition_snapshot, so
+    // every update while it lives adds another version to the entry's MVCC
+    // chain, just like repair readers do on busy tables.
+    std::deque<flat_mutation_reader> snapshots;
+    auto hold_snapshot = [&] {
+        auto rd = cache.make_reader(s, tests::make_permit(), pr);
+        rd.set_max_buffer_size(1);
+        rd.fill_buffer(db::no_timeout).get();
+        snapshots.push_back(std::move(rd));
+        while (snapshots.size() > held_snapshots) {
+            snapshots.front().close().get();
+            snapshots.pop_front();
+        }
+    };
+
+    auto evict_to_limit = [&] {
+        uint64_t evicted = 0;
+        while (tracker.region().occupancy().total_space() > cache_limit
+                && tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something) {
+            evicted++;
+        }
+        return evicted;
+    };
+
+    auto read_one = [&] {
+        auto ck = ss.make_ckey(tests::random::get_int<uint32_t>(ck_index ? ck_index - 1 : 0));
+        auto slice = partition_slice_builder(*s)
+                .with_range(query::clustering_range::make_singular(ck))
+                .build();
+        auto rd = cache.make_reader(s, tests::make_permit(), pr, slice);
+        auto close_rd = deferred_close(rd);
+        rd.consume_pausable([] (mutation_fragment) {
+            return stop_iteration::no;
+        }, db::no_timeout).get();
+    };
+
+    for (unsigned i = 0; i < update_iterations && !cancelled; ++i) {
+        auto mt = make_lw_shared<memtable>(s);
+        while (mt->occupancy().total_space() < memtable_size) {
+            mutation m(s, pk);
+            ss.add_row(m, ss.make_ckey(ck_index++), val);
+            mt->apply(m);
+            if (cancelled) {
+                return;
+            }
+        }
+
+        if (held_snapshots) {
+            hold_snapshot();
+        }
+
+        auto prev_compacted = logalloc::memory_compacted();
+        auto prev_allocated = logalloc::memory_allocated();
+        auto prev_row_evictions = tracker.get_stats().row_evictions;
+
+        scheduling_latency_measurer slm;
+        slm.start();
+        uint64_t reads = 0;
+        uint64_t evictions = 0;
+        auto d = duration_in_seconds([&] {
+            auto update_done = cache.update(row_cache::external_updater([] {}), *mt);
+            while (!update_done.available()) {
+                read_one();
+                reads++;
+                evictions += evict_to_limit();
+            }
+            update_done.get();
+        });
+        slm.stop();
+
+        mt = {};
+
+        auto compacted = logalloc::memory_compacted() - prev_compacted;
+        auto allocated = logalloc::memory_allocated() - prev_allocated;
+
+        std::cout << format("update: {:.6f} [ms], reads: {:.0f}/s, preemption: {}, snapshots: {:d}, cache: {:d}/{:d} [MB], "
+                            "alloc/comp: {:d}/{:d} [MB] (amp: {:.3f}), comp bw: {:.1f} [MB/s], evictions: {:d} ({:d} rows)\n",
+            d.count() * 1000,
+            reads / d.count(),
+            slm,
+            snapshots.size(),
+            tracker.region().occupancy().used_space() / MB,
+            tracker.region().occupancy().total_space() / MB,
+            allocated / MB,
+            compacted / MB,
+            allocated ? float(compacted) / allocated : 0.f,
+            compacted / MB / d.count(),
+            evictions,
+            tracker.get_stats().row_evictions - prev_row_evictions);
+    }
+
+    for (auto& rd : snapshots) {
+        rd.close().get();
+    }
+    snapshots.clear();
+
+    // Clean gently to avoid reactor stalls in destructors
+    cache.invalidate(row_cache::external_updater([]{})).get();
+    tracker.cleaner().drain().get();
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("iterations", bpo::value<unsigned>()->default_value(8), "number of memtable updates to run")
+        ("snapshots", bpo::value<unsigned>()->default_value(4), "number of concurrently pinned partition snapshots")
+        ("cache-size-mb", bpo::value<unsigned>()->default_value(0), "evict down to this cache size between operations; 0 uses a quarter of memory");
+
+    return app.run(argc, argv, [&app] {
+        return seastar::async([&] {
+            engine().at_exit([] {
+                cancelled = true;
+                return make_ready_future();
+            });
+            update_iterations = app.configuration()["iterations"].as<unsigned>();
+            held_snapshots = app.configuration()["snapshots"].as<unsigned>();
+            cache_limit = size_t(app.configuration()["cache-size-mb"].as<unsigned>()) * MB;
+            if (!cache_limit) {
+                cache_limit = seastar::memory::stats().total_memory() / 4;
+            }
+            memtable_size = seastar::memory::stats().total_memory() / 16;
+            logalloc::prime_segment_pool(memory::stats().total_memory(), memory::min_free_memory()).get();
+            test_mixed_load_with_pinned_snapshots();
+        });
+    });
+}
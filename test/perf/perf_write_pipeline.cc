@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/range/irange.hpp>
+
+#include "test/lib/cql_test_env.hh"
+#include "test/perf/perf.hh"
+#include <seastar/core/app-template.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/test_runner.hh>
+#include "test/lib/random_utils.hh"
+
+#include "db/config.hh"
+#include "schema_builder.hh"
+#include "utils/estimated_histogram.hh"
+
+// Measures the integrated write path: CQL statement execution through
+// storage_proxy, commitlog, memtable and - when enabled - periodic memtable
+// flushes, all in one run. perf_simple_query and perf_mutation each exercise
+// a slice of this pipeline; regressions that only show up when the stages
+// compete with each other (e.g. commitlog flushes against memtable inserts)
+// need the whole thing running at once.
+
+static const sstring table_name = "cf";
+
+struct test_config {
+    unsigned partitions;
+    unsigned concurrency;
+    unsigned duration_in_seconds;
+    unsigned operations_per_shard = 0;
+    unsigned value_size_min;
+    unsigned value_size_max;
+    unsigned rows_per_op;
+    double ttl_fraction;
+    double lwt_fraction;
+    unsigned flush_period_ms;
+    bool unprepared;
+};
+
+std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
+    return os << "{partitions=" << cfg.partitions
+           << ", concurrency=" << cfg.concurrency
+           << ", value_size=" << cfg.value_size_min << ".." << cfg.value_size_max
+           << ", rows_per_op=" << cfg.rows_per_op
+           << ", ttl_fraction=" << cfg.ttl_fraction
+           << ", lwt_fraction=" << cfg.lwt_fraction
+           << ", flush_period_ms=" << cfg.flush_period_ms
+           << ", unprepared=" << (cfg.unprepared ? "yes" : "no")
+           << "}";
+}
+
+// Per-shard, merged after the run. The histogram holds client-observed
+// latencies of individual operations, in microseconds.
+static thread_local utils::estimated_histogram latency_hist(128);
+
+static int64_t make_random_pk(const test_config& cfg) {
+    return tests::random::get_int<uint64_t>(cfg.partitions - 1);
+}
+
+static unsigned make_value_size(const test_config& cfg) {
+    if (cfg.value_size_min == cfg.value_size_max) {
+        return cfg.value_size_min;
+    }
+    return tests::random::get_int<unsigned>(cfg.value_size_min, cfg.value_size_max);
+}
+
+static bool with_probability(double fraction) {
+    return fraction > 0 && tests::random::get_real<double>(0, 1) < fraction;
+}
+
+// Returns the four prepared variants of the single-row insert: with and
+// without TTL, with and without LWT. The TTL and LWT mix is then a matter of
+// picking the right one per operation.
+struct prepared_inserts {
+    cql3::prepared_cache_key_type plain;
+    cql3::prepared_cache_key_type ttl;
+    cql3::prepared_cache_key_type lwt;
+    cql3::prepared_cache_key_type lwt_ttl;
+};
+
+static prepared_inserts prepare_inserts(cql_test_env& env) {
+    prepared_inserts p;
+    p.plain = env.prepare("INSERT INTO cf (pk, ck, v) VALUES (?, ?, ?)").get0();
+    p.ttl = env.prepare("INSERT INTO cf (pk, ck, v) VALUES (?, ?, ?) USING TTL 3600").get0();
+    p.lwt = env.prepare("INSERT INTO cf (pk, ck, v) VALUES (?, ?, ?) IF NOT EXISTS").get0();
+    p.lwt_ttl = env.prepare("INSERT INTO cf (pk, ck, v) VALUES (?, ?, ?) IF NOT EXISTS USING TTL 3600").get0();
+    return p;
+}
+
+static future<> execute_single_row(cql_test_env& env, const prepared_inserts& prepared, const test_config& cfg) {
+    const auto use_ttl = with_probability(cfg.ttl_fraction);
+    const auto use_lwt = with_probability(cfg.lwt_fraction);
+
+    auto pk = make_random_pk(cfg);
+    auto ck = tests::random::get_int<int64_t>();
+    auto value = tests::random::get_bytes(make_value_size(cfg));
+
+    if (cfg.unprepared) {
+        // Unprepared execution includes the statement parse stage, like a
+        // driver that doesn't prepare its statements.
+        auto query = format("INSERT INTO cf (pk, ck, v) VALUES ({}, {}, 0x{}){}{}",
+                pk, ck, to_hex(value),
+                use_lwt ? " IF NOT EXISTS" : "",
+                use_ttl ? " USING TTL 3600" : "");
+        return env.execute_cql(std::move(query)).discard_result();
+    }
+
+    const auto& id = use_lwt
+            ? (use_ttl ? prepared.lwt_ttl : prepared.lwt)
+            : (use_ttl ? prepared.ttl : prepared.plain);
+    return env.execute_prepared(id, {
+            cql3::raw_value::make_value(long_type->decompose(pk)),
+            cql3::raw_value::make_value(long_type->decompose(ck)),
+            cql3::raw_value::make_value(std::move(value))}).discard_result();
+}
+
+static future<> execute_batch(cql_test_env& env, const test_config& cfg) {
+    // Batches are built as text so that every operation goes through the
+    // parser, like the batch-heavy ingest pipelines this benchmark models.
+    const auto use_ttl = with_probability(cfg.ttl_fraction);
+    auto pk = make_random_pk(cfg);
+    sstring query = "BEGIN UNLOGGED BATCH ";
+    for (unsigned i = 0; i < cfg.rows_per_op; ++i) {
+        query += format("INSERT INTO cf (pk, ck, v) VALUES ({}, {}, 0x{}){}; ",
+                pk, tests::random::get_int<int64_t>(), to_hex(tests::random::get_bytes(make_value_size(cfg))),
+                use_ttl ? " USING TTL 3600" : "");
+    }
+    query += "APPLY BATCH;";
+    return env.execute_cql(std::move(query)).discard_result();
+}
+
+static std::vector<perf_result> test_write_pipeline(cql_test_env& env, const test_config& cfg) {
+    auto prepared = prepare_inserts(env);
+
+    return time_parallel([&env, prepared, &cfg] {
+        auto start = std::chrono::steady_clock::now();
+        auto f = cfg.rows_per_op > 1 ? execute_batch(env, cfg) : execute_single_row(env, prepared, cfg);
+        return f.then([start] {
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            latency_hist.add(us);
+        });
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+}
+
+static utils::estimated_histogram merge_latency_histograms() {
+    utils::estimated_histogram merged(128);
+    for (unsigned shard = 0; shard < smp::count; ++shard) {
+        auto hist = smp::submit_to(shard, [] {
+            return std::exchange(latency_hist, utils::estimated_histogram(128));
+        }).get0();
+        merged.merge(hist);
+    }
+    return merged;
+}
+
+// Keeps flushing the memtables at the configured period for as long as the
+// workload runs, so that the measurement includes the flush stage and its
+// interference with the foreground writes.
+class periodic_flusher {
+    cql_test_env& _env;
+    std::chrono::milliseconds _period;
+    bool _stop = false;
+    unsigned _flushes = 0;
+    std::chrono::duration<double> _total_flush_time{0};
+    future<> _done = make_ready_future<>();
+public:
+    periodic_flusher(cql_test_env& env, unsigned period_ms)
+            : _env(env), _period(period_ms) {
+    }
+    void start() {
+        _done = do_until([this] { return _stop; }, [this] {
+            return seastar::sleep(_period).then([this] {
+                if (_stop) {
+                    return make_ready_future<>();
+                }
+                auto start = std::chrono::steady_clock::now();
+                return _env.db().invoke_on_all(&database::flush_all_memtables).then([this, start] {
+                    ++_flushes;
+                    _total_flush_time += std::chrono::steady_clock::now() - start;
+                });
+            });
+        });
+    }
+    // Called from a seastar thread.
+    void stop() {
+        _stop = true;
+        _done.get();
+    }
+    unsigned flushes() const { return _flushes; }
+    std::chrono::duration<double> total_flush_time() const { return _total_flush_time; }
+};
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("random-seed", bpo::value<unsigned>(), "Random number generator seed")
+        ("partitions", bpo::value<unsigned>()->default_value(10000), "number of partitions")
+        ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
+        ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
+        ("value-size-min", bpo::value<unsigned>()->default_value(64), "minimum size of the value blob in bytes")
+        ("value-size-max", bpo::value<unsigned>()->default_value(64), "maximum size of the value blob in bytes; sizes are drawn uniformly from [min, max]")
+        ("rows-per-op", bpo::value<unsigned>()->default_value(1), "rows written per operation; values > 1 use an unlogged batch built as text, so the parse stage is included")
+        ("ttl-fraction", bpo::value<double>()->default_value(0.0), "fraction of operations written with a TTL")
+        ("lwt-fraction", bpo::value<double>()->default_value(0.0), "fraction of single-row operations written with IF NOT EXISTS")
+        ("flush-period-ms", bpo::value<unsigned>()->default_value(0), "flush all memtables at this period during the run; 0 disables flushing")
+        ("unprepared", "execute single-row inserts as text instead of prepared statements, to include the parse stage")
+        ;
+
+    set_abort_on_internal_error(true);
+
+    return app.run(argc, argv, [&app] {
+        auto conf_seed = app.configuration()["random-seed"];
+        auto seed = conf_seed.empty() ? std::random_device()() : conf_seed.as<unsigned>();
+        std::cout << "random-seed=" << seed << '\n';
+        return smp::invoke_on_all([seed] {
+            seastar::testing::local_random_engine.seed(seed + this_shard_id());
+        }).then([&app] {
+          return do_with_cql_env_thread([&app] (cql_test_env& env) {
+            auto cfg = test_config();
+            cfg.partitions = app.configuration()["partitions"].as<unsigned>();
+            cfg.duration_in_seconds = app.configuration()["duration"].as<unsigned>();
+            cfg.concurrency = app.configuration()["concurrency"].as<unsigned>();
+            cfg.value_size_min = app.configuration()["value-size-min"].as<unsigned>();
+            cfg.value_size_max = app.configuration()["value-size-max"].as<unsigned>();
+            cfg.rows_per_op = std::max(1u, app.configuration()["rows-per-op"].as<unsigned>());
+            cfg.ttl_fraction = app.configuration()["ttl-fraction"].as<double>();
+            cfg.lwt_fraction = app.configuration()["lwt-fraction"].as<double>();
+            cfg.flush_period_ms = app.configuration()["flush-period-ms"].as<unsigned>();
+            cfg.unprepared = app.configuration().contains("unprepared");
+            if (app.configuration().contains("operations-per-shard")) {
+                cfg.operations_per_shard = app.configuration()["operations-per-shard"].as<unsigned>();
+            }
+            if (cfg.value_size_min > cfg.value_size_max) {
+                throw std::invalid_argument("error: value-size-min is larger than value-size-max");
+            }
+
+            std::cout << "Running test with config: " << cfg << std::endl;
+            env.create_table([] (auto ks_name) {
+                return *schema_builder(ks_name, table_name)
+                        .with_column("pk", long_type, column_kind::partition_key)
+                        .with_column("ck", long_type, column_kind::clustering_key)
+                        .with_column("v", bytes_type)
+                        .build();
+            }).get();
+
+            std::optional<periodic_flusher> flusher;
+            if (cfg.flush_period_ms) {
+                flusher.emplace(env, cfg.flush_period_ms);
+                flusher->start();
+            }
+
+            auto results = test_write_pipeline(env, cfg);
+
+            if (flusher) {
+                flusher->stop();
+            }
+            // Always end with a timed flush, so that the data written in the
+            // last iterations also passes through the flush stage.
+            auto final_flush = duration_in_seconds([&] {
+                env.db().invoke_on_all(&database::flush_all_memtables).get();
+            });
+
+            auto compare_throughput = [] (perf_result a, perf_result b) { return a.throughput < b.throughput; };
+            std::sort(results.begin(), results.end(), compare_throughput);
+            auto median_result = results[results.size() / 2];
+            std::cout << format("\nmedian {}\n", median_result);
+
+            auto hist = merge_latency_histograms();
+            std::cout << format("op latency: p50 {}us p90 {}us p99 {}us max {}us\n",
+                    hist.percentile(0.5), hist.percentile(0.9), hist.percentile(0.99), hist.max());
+            if (flusher) {
+                auto mean_flush = flusher->flushes() ? flusher->total_flush_time().count() / flusher->flushes() : 0.;
+                std::cout << format("flush: {} periodic flushes, {:.3f}s mean\n", flusher->flushes(), mean_flush);
+            }
+            std::cout << format("final flush: {:.3f}s\n", final_flush.count());
+          });
+        });
+    });
+}
@@ -624,6 +624,10 @@ public:
             co_return;
         }
 
+        // A leader change may replace a suffix of the persisted log; remove
+        // it atomically with storing the new entries.
+        _stored_entries.erase(find(entries.front()->idx), _stored_entries.end());
+
         // The raft server is supposed to provide entries in strictly increasing order,
         // hence the following assertions.
         if (_stored_entries.empty()) {
@@ -645,11 +649,6 @@ public:
         co_return _stored_entries;
     }
 
-    virtual future<> truncate_log(raft::index_t idx) override {
-        _stored_entries.erase(find(idx), _stored_entries.end());
-        co_return;
-    }
-
     virtual future<> abort() override {
         // There are no yields anywhere in our methods so no need to wait for anything.
         // We assume that our methods won't be called after `abort()`.
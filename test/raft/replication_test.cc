@@ -229,7 +229,6 @@ public:
         }
         return make_ready_future<raft::log_entries>(std::move(log));
     }
-    virtual future<> truncate_log(raft::index_t idx) { return make_ready_future<>(); }
     virtual future<> abort() { return make_ready_future<>(); }
 };
 
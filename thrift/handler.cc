@@ -1861,19 +1861,38 @@ private:
                 !end_bound || end_bound->is_inclusive() ? bound_kind::incl_end : bound_kind::excl_end,
                 std::move(tomb)};
     }
+    // Thrift addresses cells by column name, and batches repeat a small,
+    // fixed set of names across many rows. Resolving a name against the
+    // schema costs a bytes allocation plus a hash lookup per cell; this
+    // cache makes each distinct name pay that once per operation. The
+    // string_view keys point into the thrift request structures, which
+    // outlive the cache - just don't move them around while it's in use.
+    class column_name_cache {
+        const schema& _s;
+        std::unordered_map<std::string_view, const column_definition*> _defs;
+    public:
+        explicit column_name_cache(const schema& s) : _s(s) {}
+        const column_definition* resolve(const std::string& name) {
+            auto [it, added] = _defs.try_emplace(std::string_view(name), nullptr);
+            if (added) {
+                it->second = _s.get_column_definition(to_bytes(name));
+            }
+            return it->second;
+        }
+    };
     static void delete_cell(const column_definition& def, api::timestamp_type timestamp, gc_clock::time_point deletion_time, mutation& m_to_apply) {
         if (def.is_atomic()) {
             auto dead_cell = atomic_cell::make_dead(timestamp, deletion_time);
             m_to_apply.set_clustered_cell(clustering_key_prefix::make_empty(), def, std::move(dead_cell));
         }
     }
-    static void delete_column(const schema& s, const sstring& column_name, api::timestamp_type timestamp, gc_clock::time_point deletion_time, mutation& m_to_apply) {
-        auto&& def = s.get_column_definition(to_bytes(column_name));
+    static void delete_column(const schema& s, const std::string& column_name, api::timestamp_type timestamp, gc_clock::time_point deletion_time, mutation& m_to_apply, column_name_cache& columns) {
+        auto&& def = columns.resolve(column_name);
         if (def) {
             delete_cell(*def, timestamp, deletion_time, m_to_apply);
         }
     }
-    static void apply_delete(const schema& s, const SlicePredicate& predicate, api::timestamp_type timestamp, mutation& m_to_apply) {
+    static void apply_delete(const schema& s, const SlicePredicate& predicate, api::timestamp_type timestamp, mutation& m_to_apply, column_name_cache& columns) {
         auto deletion_time = gc_clock::now();
         if (predicate.__isset.column_names) {
             thrift_validation::validate_column_names(predicate.column_names);
@@ -1884,7 +1903,7 @@ private:
                 }
             } else {
                 for (auto&& name : predicate.column_names) {
-                    delete_column(s, name, timestamp, deletion_time, m_to_apply);
+                    delete_column(s, name, timestamp, deletion_time, m_to_apply, columns);
                 }
             }
         } else if (predicate.__isset.slice_range) {
@@ -1911,13 +1930,13 @@ private:
         auto cell = atomic_cell::make_live_counter_update(api::new_timestamp(), col.value);
         m_to_apply.set_clustered_cell(std::move(ckey), def, std::move(cell));
     }
-    static void add_to_mutation(const schema& s, const CounterColumn& col, mutation& m_to_apply) {
+    static void add_to_mutation(const schema& s, const CounterColumn& col, mutation& m_to_apply, column_name_cache& columns) {
         thrift_validation::validate_column_name(col.name);
         if (s.thrift().is_dynamic()) {
             auto&& value_col = s.regular_begin();
             add_live_cell(s, col, *value_col, make_clustering_prefix(s, to_bytes_view(col.name)), m_to_apply);
         } else {
-            auto def = s.get_column_definition(to_bytes(col.name));
+            auto def = columns.resolve(col.name);
             if (def) {
                 if (def->kind != column_kind::regular_column) {
                     throw make_exception<InvalidRequestException>("Column %s is not settable", col.name);
@@ -1928,13 +1947,13 @@ private:
             }
         }
     }
-    static void add_to_mutation(const schema& s, const Column& col, mutation& m_to_apply) {
+    static void add_to_mutation(const schema& s, const Column& col, mutation& m_to_apply, column_name_cache& columns) {
         thrift_validation::validate_column_name(col.name);
         if (s.thrift().is_dynamic()) {
             auto&& value_col = s.regular_begin();
             add_live_cell(s, col, *value_col, make_clustering_prefix(s, to_bytes_view(col.name)), m_to_apply);
         } else {
-            auto def = s.get_column_definition(to_bytes(col.name));
+            auto def = columns.resolve(col.name);
             if (def) {
                 if (def->kind != column_kind::regular_column) {
                     throw make_exception<InvalidRequestException>("Column %s is not settable", col.name);
@@ -1945,7 +1964,21 @@ private:
             }
         }
     }
+    // Convenience overloads for the single-cell operations (insert, add,
+    // remove), where there is nothing to reuse across cells.
+    static void add_to_mutation(const schema& s, const Column& col, mutation& m_to_apply) {
+        column_name_cache columns(s);
+        add_to_mutation(s, col, m_to_apply, columns);
+    }
+    static void add_to_mutation(const schema& s, const CounterColumn& col, mutation& m_to_apply) {
+        column_name_cache columns(s);
+        add_to_mutation(s, col, m_to_apply, columns);
+    }
     static void add_to_mutation(const schema& s, const Mutation& m, mutation& m_to_apply) {
+        column_name_cache columns(s);
+        add_to_mutation(s, m, m_to_apply, columns);
+    }
+    static void add_to_mutation(const schema& s, const Mutation& m, mutation& m_to_apply, column_name_cache& columns) {
         if (m.__isset.column_or_supercolumn) {
             if (m.__isset.deletion) {
                 throw make_exception<InvalidRequestException>("Mutation must have one and only one of column_or_supercolumn or deletion");
@@ -1955,11 +1988,11 @@ private:
                 throw make_exception<InvalidRequestException>("ColumnOrSuperColumn must have one (and only one) of column, super_column, counter and counter_super_column");
             }
             if (cosc.__isset.column) {
-                add_to_mutation(s, cosc.column, m_to_apply);
+                add_to_mutation(s, cosc.column, m_to_apply, columns);
             } else if (cosc.__isset.super_column) {
                 fail(unimplemented::cause::SUPER);
             } else if (cosc.__isset.counter_column) {
-                add_to_mutation(s, cosc.counter_column, m_to_apply);
+                add_to_mutation(s, cosc.counter_column, m_to_apply, columns);
             } else if (cosc.__isset.counter_super_column) {
                 fail(unimplemented::cause::SUPER);
             }
@@ -1968,7 +2001,7 @@ private:
             if (del.__isset.super_column) {
                 fail(unimplemented::cause::SUPER);
             } else if (del.__isset.predicate) {
-                apply_delete(s, del.predicate, del.timestamp, m_to_apply);
+                apply_delete(s, del.predicate, del.timestamp, m_to_apply, columns);
             } else {
                 m_to_apply.partition().apply(tombstone(del.timestamp, gc_clock::now()));
             }
@@ -1998,10 +2031,13 @@ private:
                 throw make_exception<InvalidRequestException>("Cannot modify Materialized Views directly");
             }
             schemas.emplace_back(schema);
+            // One name resolution cache per column family: a batch usually
+            // writes the same columns for every key.
+            column_name_cache columns(*schema);
             for (auto&& key_mutations : cf_key.second) {
                 mutation m_to_apply(schema, key_from_thrift(*schema, to_bytes_view(key_mutations.first)));
                 for (auto&& m : key_mutations.second) {
-                    add_to_mutation(*schema, m, m_to_apply);
+                    add_to_mutation(*schema, m, m_to_apply, columns);
                 }
                 muts.emplace_back(std::move(m_to_apply));
             }
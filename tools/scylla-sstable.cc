@@ -0,0 +1,447 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <boost/range/irange.hpp>
+#include <seastar/core/app-template.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/log.hh>
+#include <seastar/util/closeable.hh>
+
+#include "schema_builder.hh"
+#include "db/marshal/type_parser.hh"
+#include "db/large_data_handler.hh"
+#include "db/config.hh"
+#include "gms/feature_service.hh"
+#include "sstables/sstables.hh"
+#include "sstables/open_info.hh"
+#include "sstables/sstables_manager.hh"
+#include "flat_mutation_reader.hh"
+#include "reader_concurrency_semaphore.hh"
+
+using namespace seastar;
+
+namespace {
+
+const auto app_name = "scylla-sstable";
+
+logging::logger stlog(app_name);
+
+// Each shard processes its own subset of the SSTables, so all the machinery
+// required to open them has to exist on every shard.
+thread_local db::nop_large_data_handler large_data_handler;
+thread_local reader_concurrency_semaphore rcs_sem(reader_concurrency_semaphore::no_limits{}, app_name);
+
+enum class operation {
+    validate,
+    stats,
+    tombstone_census,
+    dump,
+};
+
+operation parse_operation(const sstring& name) {
+    if (name == "validate") {
+        return operation::validate;
+    } else if (name == "stats") {
+        return operation::stats;
+    } else if (name == "tombstone-census") {
+        return operation::tombstone_census;
+    } else if (name == "dump") {
+        return operation::dump;
+    }
+    throw std::invalid_argument(fmt::format("error: unknown operation {}, expected one of: validate, stats, tombstone-census, dump", name));
+}
+
+// The schema is described on the command line, so it has to be rebuilt on
+// every shard from the raw type strings.
+struct schema_spec {
+    std::vector<sstring> partition_key_types;
+    std::vector<sstring> clustering_key_types;
+    std::vector<sstring> static_columns;
+    std::vector<sstring> regular_columns;
+};
+
+std::pair<sstring, data_type> parse_column_spec(const sstring& spec) {
+    auto pos = spec.find('=');
+    if (pos == sstring::npos || pos == 0 || pos == spec.size() - 1) {
+        throw std::invalid_argument(fmt::format("error: invalid column specification {}, expected name=TypeClass", spec));
+    }
+    return {spec.substr(0, pos), db::marshal::type_parser::parse(sstring_view(spec).substr(pos + 1))};
+}
+
+schema_ptr make_schema_from_spec(const schema_spec& spec) {
+    schema_builder builder("ks", "cf");
+    unsigned i = 0;
+    for (const auto& type_name : spec.partition_key_types) {
+        builder.with_column(to_bytes(format("pk{}", i++)), db::marshal::type_parser::parse(type_name), column_kind::partition_key);
+    }
+    i = 0;
+    for (const auto& type_name : spec.clustering_key_types) {
+        builder.with_column(to_bytes(format("ck{}", i++)), db::marshal::type_parser::parse(type_name), column_kind::clustering_key);
+    }
+    for (const auto& column_spec : spec.static_columns) {
+        auto [name, type] = parse_column_spec(column_spec);
+        builder.with_column(to_bytes(name), type, column_kind::static_column);
+    }
+    for (const auto& column_spec : spec.regular_columns) {
+        auto [name, type] = parse_column_spec(column_spec);
+        builder.with_column(to_bytes(name), type, column_kind::regular_column);
+    }
+    if (spec.static_columns.empty() && spec.regular_columns.empty()) {
+        // A schema without any value column still allows looking at keys and
+        // metadata, same as scylla-sstable-index does.
+        builder.with_column("dummy", utf8_type, column_kind::regular_column);
+    }
+    return builder.build();
+}
+
+// Counters accumulated over a full scan of one or more SSTables. Shards merge
+// their instances before the totals are printed.
+struct scan_stats {
+    uint64_t sstables = 0;
+    uint64_t partitions = 0;
+    uint64_t static_rows = 0;
+    uint64_t clustering_rows = 0;
+    uint64_t partition_tombstones = 0;
+    uint64_t range_tombstones = 0;
+    uint64_t row_tombstones = 0;
+    uint64_t collection_tombstones = 0;
+    uint64_t dead_cells = 0;
+    uint64_t expiring_cells = 0;
+
+    scan_stats& operator+=(const scan_stats& o) {
+        sstables += o.sstables;
+        partitions += o.partitions;
+        static_rows += o.static_rows;
+        clustering_rows += o.clustering_rows;
+        partition_tombstones += o.partition_tombstones;
+        range_tombstones += o.range_tombstones;
+        row_tombstones += o.row_tombstones;
+        collection_tombstones += o.collection_tombstones;
+        dead_cells += o.dead_cells;
+        expiring_cells += o.expiring_cells;
+        return *this;
+    }
+};
+
+void account_cells(const schema& s, column_kind kind, const row& cells, scan_stats& stats) {
+    cells.for_each_cell([&] (column_id id, const atomic_cell_or_collection& cell) {
+        auto& def = s.column_at(kind, id);
+        if (def.is_atomic()) {
+            auto ac = cell.as_atomic_cell(def);
+            if (!ac.is_live()) {
+                ++stats.dead_cells;
+            } else if (ac.is_live_and_has_ttl()) {
+                ++stats.expiring_cells;
+            }
+        } else if (def.type->is_collection() || def.type->is_user_type()) {
+            cell.as_collection_mutation().with_deserialized(*def.type, [&] (collection_mutation_view_description mv) {
+                if (mv.tomb) {
+                    ++stats.collection_tombstones;
+                }
+                for (const auto& [key, ac] : mv.cells) {
+                    if (!ac.is_live()) {
+                        ++stats.dead_cells;
+                    } else if (ac.is_live_and_has_ttl()) {
+                        ++stats.expiring_cells;
+                    }
+                }
+            });
+        }
+    });
+}
+
+// Consumes the whole SSTable through a full-range reader. Any parse or
+// checksum error on the way surfaces as an exception, which makes this
+// double as the validation pass.
+scan_stats scan_sstable(schema_ptr s, sstables::shared_sstable sst, operation op) {
+    scan_stats stats;
+    stats.sstables = 1;
+    auto permit = rcs_sem.make_permit(s.get(), "scan");
+    auto rd = sst->make_reader(s, std::move(permit), query::full_partition_range, s->full_slice());
+
+    std::exception_ptr ex;
+    try {
+        while (auto mf_opt = rd(db::no_timeout).get0()) {
+            auto& mf = *mf_opt;
+            switch (mf.mutation_fragment_kind()) {
+            case mutation_fragment::kind::partition_start:
+                ++stats.partitions;
+                if (mf.as_partition_start().partition_tombstone()) {
+                    ++stats.partition_tombstones;
+                }
+                break;
+            case mutation_fragment::kind::static_row:
+                ++stats.static_rows;
+                if (op == operation::tombstone_census) {
+                    account_cells(*s, column_kind::static_column, mf.as_static_row().cells(), stats);
+                }
+                break;
+            case mutation_fragment::kind::clustering_row: {
+                auto& cr = mf.as_clustering_row();
+                ++stats.clustering_rows;
+                if (cr.tomb()) {
+                    ++stats.row_tombstones;
+                }
+                if (op == operation::tombstone_census) {
+                    account_cells(*s, column_kind::regular_column, cr.cells(), stats);
+                }
+                break;
+            }
+            case mutation_fragment::kind::range_tombstone:
+                ++stats.range_tombstones;
+                break;
+            case mutation_fragment::kind::partition_end:
+                break;
+            }
+            if (op == operation::dump) {
+                fmt::print("{}: {}\n", sst->get_filename(), mutation_fragment::printer(*s, mf));
+            }
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    rd.close().get();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    return stats;
+}
+
+void print_sstable_stats(const sstables::shared_sstable& sst) {
+    const auto& stats = sst->get_stats_metadata();
+    fmt::print(
+            "{}:\n"
+            "  generation: {}\n"
+            "  size on disk: {}\n"
+            "  uncompressed data size: {}\n"
+            "  compression ratio: {:.4f}\n"
+            "  estimated partitions: {}\n"
+            "  sstable level: {}\n"
+            "  min timestamp: {}\n"
+            "  max timestamp: {}\n"
+            "  min local deletion time: {}\n"
+            "  max local deletion time: {}\n",
+            sst->get_filename(),
+            sst->generation(),
+            sst->bytes_on_disk(),
+            sst->data_size(),
+            sst->get_compression_ratio(),
+            sst->get_estimated_key_count(),
+            sst->get_sstable_level(),
+            stats.min_timestamp,
+            stats.max_timestamp,
+            stats.min_local_deletion_time,
+            stats.max_local_deletion_time);
+}
+
+void print_census(const sstring& name, const scan_stats& stats) {
+    fmt::print(
+            "{}: partitions={} rows={} partition_tombstones={} range_tombstones={} row_tombstones={} collection_tombstones={} dead_cells={} expiring_cells={}\n",
+            name,
+            stats.partitions,
+            stats.clustering_rows,
+            stats.partition_tombstones,
+            stats.range_tombstones,
+            stats.row_tombstones,
+            stats.collection_tombstones,
+            stats.dead_cells,
+            stats.expiring_cells);
+}
+
+// Processes every num_shards'th SSTable from the list, starting at this
+// shard's index. Called in a seastar thread.
+scan_stats process_sstables_on_this_shard(const std::vector<std::string>& sstable_paths, const schema_spec& spec, operation op) {
+    auto s = make_schema_from_spec(spec);
+
+    db::config dbcfg;
+    gms::feature_service feature_service(gms::feature_config_from_db_config(dbcfg));
+    sstables::sstables_manager sst_man(large_data_handler, dbcfg, feature_service);
+    auto close_sst_man = deferred_close(sst_man);
+
+    scan_stats total;
+    for (size_t i = this_shard_id(); i < sstable_paths.size(); i += smp::count) {
+        const auto sst_path = std::filesystem::path(sstable_paths[i]);
+        const auto dir_path = std::filesystem::path(sst_path).remove_filename();
+        const auto sst_filename = sst_path.filename();
+
+        auto ed = sstables::entry_descriptor::make_descriptor(dir_path.c_str(), sst_filename.c_str());
+        auto sst = sst_man.make_sstable(s, dir_path.c_str(), ed.generation, ed.version, ed.format);
+
+        sst->load().get();
+
+        switch (op) {
+        case operation::stats:
+            print_sstable_stats(sst);
+            total.sstables += 1;
+            break;
+        case operation::validate: {
+            auto stats = scan_sstable(s, sst, op);
+            fmt::print("{}: OK ({} partitions, {} rows)\n", sst->get_filename(), stats.partitions, stats.clustering_rows);
+            total += stats;
+            break;
+        }
+        case operation::tombstone_census: {
+            auto stats = scan_sstable(s, sst, op);
+            print_census(sst->get_filename(), stats);
+            total += stats;
+            break;
+        }
+        case operation::dump:
+            total += scan_sstable(s, sst, op);
+            break;
+        }
+
+        sst = {};
+    }
+    return total;
+}
+
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+
+    app_template::config app_cfg;
+    app_cfg.name = app_name;
+    app_cfg.description =
+R"(scylla-sstable - a command-line tool to examine sstables offline.
+
+The tool reads the given sstables with the same readers a running node
+uses, distributing them across all available cores, so a snapshot of a
+large table can be processed without a running node and at full disk
+bandwidth. The operation to run is selected with `--operation|-o`:
+
+* validate: read through every partition of every sstable; any parse or
+  checksum error is reported and fails the run.
+* stats: print the size, compression and timestamp metadata of each
+  sstable, without reading the data file.
+* tombstone-census: count partition, range, row, collection tombstones
+  and dead or expiring cells in each sstable, with a combined total.
+* dump: print every mutation fragment of every sstable, prefixed by the
+  name of the sstable it came from. With more than one core the output
+  of different sstables may interleave; use `--smp=1` if strict ordering
+  is needed.
+
+The schema of the sstables has to be described on the command line. The
+types making up the partition key are given with `--type|-t` and the
+types making up the clustering key with `--clustering-type`, in order,
+using the Cassandra type class name notation (the
+`org.apache.cassandra.db.marshal.` prefix can be omitted). Static and
+regular columns are given as `name=TypeClass` pairs with
+`--static-column` and `--column` respectively, and must match the
+columns present in the sstables for the scanning operations. E.g. for:
+
+    CREATE TABLE my_keyspace.my_table (
+        id1 int,
+        id2 text,
+        value text,
+        PRIMARY KEY ((id1, id2))
+    );
+
+the tool has to be invoked with:
+
+    ./scylla-sstable -o dump --type=Int32Type --type=UTF8Type \
+        --column=value=UTF8Type $sstable_path...
+
+See https://github.com/scylladb/scylla/blob/master/docs/design-notes/cql3-type-mapping.md
+for a mapping of cql3 types to Cassandra type class names.
+
+Note: UDT is not supported for now.
+)";
+
+    app_template app(std::move(app_cfg));
+
+    app.add_options()
+        ("operation,o", bpo::value<sstring>()->default_value("validate"), "operation to run: validate, stats, tombstone-census or dump")
+        ("type,t", bpo::value<std::vector<sstring>>(), "the types making up the partition key, if the partition key is compound, list all types"
+                " in it in order; types have to be specified in Cassandra class notation, see description for more details")
+        ("clustering-type", bpo::value<std::vector<sstring>>(), "the types making up the clustering key, in order, in Cassandra class notation")
+        ("static-column", bpo::value<std::vector<sstring>>(), "a static column of the table, as a name=TypeClass pair")
+        ("column", bpo::value<std::vector<sstring>>(), "a regular column of the table, as a name=TypeClass pair")
+        ;
+
+    app.add_positional_options({
+        {"sstables", bpo::value<std::vector<std::string>>(), "sstable data files to examine, can be given as positional arguments", -1}
+    });
+
+    //FIXME: this exposes all core options, which we are not interested in.
+    return app.run(argc, argv, [&app] {
+        return async([&app] {
+            if (!app.configuration().contains("sstables")) {
+                throw std::invalid_argument("error: missing mandatory positional argument 'sstables'");
+            }
+            if (!app.configuration().contains("type")) {
+                throw std::invalid_argument("error: missing mandatory argument 'type'");
+            }
+            const auto op = parse_operation(app.configuration()["operation"].as<sstring>());
+            const auto sstable_paths = app.configuration()["sstables"].as<std::vector<std::string>>();
+
+            for (const auto& path : sstable_paths) {
+                const auto ftype_opt = file_type(path, follow_symlink::yes).get0();
+                if (!ftype_opt) {
+                    throw std::invalid_argument(fmt::format("error: failed to determine type of file pointed to by provided sstable path {}", path));
+                }
+                if (*ftype_opt != directory_entry_type::regular) {
+                    throw std::invalid_argument(fmt::format("error: file pointed to by provided sstable path {} is not a regular file", path));
+                }
+            }
+
+            schema_spec spec;
+            spec.partition_key_types = app.configuration()["type"].as<std::vector<sstring>>();
+            if (app.configuration().contains("clustering-type")) {
+                spec.clustering_key_types = app.configuration()["clustering-type"].as<std::vector<sstring>>();
+            }
+            if (app.configuration().contains("static-column")) {
+                spec.static_columns = app.configuration()["static-column"].as<std::vector<sstring>>();
+            }
+            if (app.configuration().contains("column")) {
+                spec.regular_columns = app.configuration()["column"].as<std::vector<sstring>>();
+            }
+            // Fail fast on a bad schema description, before the shards start.
+            make_schema_from_spec(spec);
+
+            scan_stats total;
+            parallel_for_each(boost::irange(0u, smp::count), [&] (unsigned shard) {
+                return smp::submit_to(shard, [&] {
+                    return async([&] {
+                        return process_sstables_on_this_shard(sstable_paths, spec, op);
+                    });
+                }).then([&total] (scan_stats stats) {
+                    total += stats;
+                });
+            }).get();
+
+            switch (op) {
+            case operation::validate:
+                fmt::print("validated {} sstables: {} partitions, {} rows\n", total.sstables, total.partitions, total.clustering_rows);
+                break;
+            case operation::tombstone_census:
+                print_census("total", total);
+                break;
+            default:
+                break;
+            }
+        });
+    });
+}
@@ -440,6 +440,37 @@ private:
      */
     void trace_internal(sstring msg);
 
+    /**
+     * Checks if a new record may be admitted, and accounts a dropped
+     * record otherwise.
+     *
+     * Split out of trace_internal() so that the printf-like trace() can
+     * check the budget before paying for message formatting: when
+     * records are being dropped the formatting work is pure waste, and
+     * that is exactly when tracing overhead matters most.
+     *
+     * @return TRUE if there is a budget for one more record
+     */
+    bool may_record() noexcept {
+        // We don't want the total amount of pending, active and flushing records to
+        // bypass two times the maximum number of pending records.
+        //
+        // If either records are being created too fast or a backend doesn't
+        // keep up we want to start dropping records.
+        // In any case, this should be rare, therefore we don't try to optimize this
+        // flow.
+        if (!_local_tracing_ptr->have_records_budget()) {
+            tracing_logger.trace("{}: Maximum number of traces is reached. Some traces are going to be dropped", session_id());
+            if ((++_local_tracing_ptr->stats.dropped_records) % tracing::log_warning_period == 1) {
+                tracing_logger.warn("Maximum records limit is hit {} times", _local_tracing_ptr->stats.dropped_records);
+            }
+
+            return false;
+        }
+
+        return true;
+    }
+
     /**
      * Add a single trace entry - a special case for a simple string.
      *
@@ -534,19 +565,7 @@ inline void trace_state::trace_internal(sstring message) {
         throw std::logic_error("trying to use a trace() before begin() for \"" + message + "\" tracepoint");
     }
 
-    // We don't want the total amount of pending, active and flushing records to
-    // bypass two times the maximum number of pending records.
-    //
-    // If either records are being created too fast or a backend doesn't
-    // keep up we want to start dropping records.
-    // In any case, this should be rare, therefore we don't try to optimize this
-    // flow.
-    if (!_local_tracing_ptr->have_records_budget()) {
-        tracing_logger.trace("{}: Maximum number of traces is reached. Some traces are going to be dropped", session_id());
-        if ((++_local_tracing_ptr->stats.dropped_records) % tracing::log_warning_period == 1) {
-            tracing_logger.warn("Maximum records limit is hit {} times", _local_tracing_ptr->stats.dropped_records);
-        }
-
+    if (!may_record()) {
         return;
     }
 
@@ -577,7 +596,13 @@ inline void trace_state::trace_internal(sstring message) {
 template <typename... A>
 void trace_state::trace(const char* fmt, A&&... a) noexcept {
     try {
-        trace_internal(seastar::format(fmt, std::forward<A>(a)...));
+        // Check the records budget before formatting the message, so
+        // that a record which is going to be dropped anyway doesn't pay
+        // for rendering it. The inactive check stays in
+        // trace_internal() - it needs the message for its error.
+        if (is_in_state(state::inactive) || may_record()) {
+            trace_internal(seastar::format(fmt, std::forward<A>(a)...));
+        }
     } catch (...) {
         // Bump up an error counter and ignore
         ++_local_tracing_ptr->stats.trace_errors;
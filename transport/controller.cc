@@ -212,6 +212,17 @@ future<bool> controller::is_server_running() {
     });
 }
 
+future<> controller::update_timeout_config(const ::timeout_config& tc) {
+    return smp::submit_to(0, [this, tc] {
+        if (!_server) {
+            return make_ready_future<>();
+        }
+        return _server->invoke_on_all([tc] (cql_server& server) {
+            server.update_timeout_config(tc);
+        });
+    });
+}
+
 future<> controller::set_cql_ready(bool ready) {
     return _gossiper.add_local_application_state(gms::application_state::RPC_READY, gms::versioned_value::cql_ready(ready));
 }
@@ -29,6 +29,7 @@ using namespace seastar;
 
 namespace cql_transport { class cql_server; }
 class database;
+struct timeout_config;
 namespace auth { class service; }
 namespace service {
     class migration_notifier;
@@ -63,6 +64,7 @@ public:
     future<> stop_server();
     future<> stop();
     future<bool> is_server_running();
+    future<> update_timeout_config(const ::timeout_config&);
 };
 
 } // namespace cql_transport
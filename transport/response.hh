@@ -102,6 +102,7 @@ public:
         return _body.size();
     }
 private:
+    bytes_ostream::value_type* start_value_with_one_allocation(int32_t size);
     void compress(cql_compression compression);
     void compress_lz4();
     void compress_snappy();
@@ -158,6 +158,7 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
     , _config(config)
     , _max_request_size(config.max_request_size)
     , _max_concurrent_requests(db.get_config().max_concurrent_requests_per_shard)
+    , _batch_workload_admission_fraction(db.get_config().batch_workload_admission_fraction)
     , _memory_available(ml.get_semaphore())
     , _notifier(std::make_unique<event_notifier>(mn))
     , _auth_service(auth_service)
@@ -216,7 +217,11 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_gauge("requests_memory_available", [this] { return _memory_available.current(); },
                         sm::description(
                             seastar::format("Holds the amount of available memory for admitting new requests (max is {}B)."
-                                            "Zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"CQL transport\" component.", _max_request_size)))
+                                            "Zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"CQL transport\" component.", _max_request_size))),
+        sm::make_gauge("batch_workload_requests_serving", _stats.batch_workload_requests_serving,
+                        sm::description("Holds a number of requests from batch-workload service levels that are being processed right now (capped via batch_workload_admission_fraction).")),
+        sm::make_gauge("batch_workload_request_memory", _stats.batch_workload_request_memory,
+                        sm::description("Holds the summed memory estimates of in-flight requests from batch-workload service levels (capped via batch_workload_admission_fraction)."))
     };
 
     std::vector<sm::metric_definition> transport_metrics;
@@ -619,6 +624,30 @@ future<> cql_server::connection::process_request() {
             });
         }
 
+        // Per-service-level admission control: a service level marks its
+        // connections with a workload type, and batch workloads get a
+        // bounded share of the shard's request slots and request memory.
+        // A misbehaving batch tenant then queues against its own budget
+        // and is shed with a cheap error - before the frame is even
+        // parsed - instead of starving interactive co-tenants.
+        if (_client_state.get_workload_type() == service::client_state::workload_type::batch) {
+            const double admission_fraction = _server._batch_workload_admission_fraction;
+            if (admission_fraction < 1.0) {
+                const auto max_requests = uint32_t(_server._max_concurrent_requests.get() * admission_fraction);
+                const auto max_memory = size_t(_server._max_request_size * admission_fraction);
+                if (_server._stats.batch_workload_requests_serving >= max_requests
+                        || _server._stats.batch_workload_request_memory + mem_estimate > max_memory) {
+                    ++_server._stats.requests_shed;
+                    return _read_buf.skip(f.length).then([this, stream = f.stream] {
+                        write_response(make_error(stream, exceptions::exception_code::OVERLOADED,
+                                "batch workload over its admission cap (configured via batch_workload_admission_fraction)",
+                                tracing::trace_state_ptr()));
+                        return make_ready_future<>();
+                    });
+                }
+            }
+        }
+
         const auto shedding_timeout = std::chrono::milliseconds(50);
         auto fut = allow_shedding
                 ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
@@ -642,20 +671,32 @@ future<> cql_server::connection::process_request() {
             ++_server._stats.requests_blocked_memory;
         }
 
-        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
+        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested, mem_estimate] (auto mem_permit_fut) {
           if (mem_permit_fut.failed()) {
               // Ignore semaphore errors - they are expected if load shedding took place
               mem_permit_fut.ignore_ready_future();
               return make_ready_future<>();
           }
           semaphore_units<> mem_permit = mem_permit_fut.get0();
-          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_estimate, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
 
             ++_server._stats.requests_served;
             ++_server._stats.requests_serving;
+            // Snapshot the workload type: it is re-evaluated when a STARTUP
+            // or AUTH message completes, and the release below must undo
+            // exactly what was accounted here.
+            const bool batch_workload = _client_state.get_workload_type() == service::client_state::workload_type::batch;
+            if (batch_workload) {
+                ++_server._stats.batch_workload_requests_serving;
+                _server._stats.batch_workload_request_memory += mem_estimate;
+            }
 
             _pending_requests_gate.enter();
-            auto leave = defer([this] {
+            auto leave = defer([this, batch_workload, mem_estimate] {
+                if (batch_workload) {
+                    --_server._stats.batch_workload_requests_serving;
+                    _server._stats.batch_workload_request_memory -= mem_estimate;
+                }
                 _shedding_timer.cancel();
                 _shed_incoming_requests = false;
                 _pending_requests_gate.leave();
@@ -1467,17 +1508,28 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
+    ++_pending_response_writes;
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
         auto message = response->make_message(_version, compression);
         message.on_delete([response = std::move(response)] { });
         return _write_buf.write(std::move(message)).then([this] {
-            return _write_buf.flush();
+            // Flush only when no further responses are queued behind this
+            // one, so a burst of pipelined requests pays for a single flush.
+            if (--_pending_response_writes == 0) {
+                return _write_buf.flush();
+            }
+            return make_ready_future<>();
         });
     });
 }
 
 scattered_message<char> cql_server::response::make_message(uint8_t version, cql_compression compression) {
-    if (compression != cql_compression::none) {
+    // The compression flag is per frame, so we are free to leave small
+    // responses (READY, void RESULTs, short errors) uncompressed - the
+    // algorithm framing alone would eat any saving, and every driver
+    // checks the flag before decompressing.
+    static constexpr size_t compression_threshold = 64;
+    if (compression != cql_compression::none && _body.size() >= compression_threshold) {
         compress(compression);
     }
     scattered_message<char> msg;
@@ -1721,7 +1773,14 @@ void cql_server::response::write_value(bytes_opt value)
         return;
     }
 
-    write_int(value->size());
+    auto size = value->size();
+    if (size <= bytes_ostream::max_chunk_size() - sizeof(int32_t)) {
+        auto* p = start_value_with_one_allocation(size);
+        std::copy_n(value->data(), size, p);
+        return;
+    }
+
+    write_int(size);
     _body.write(*value);
 }
 
@@ -1732,13 +1791,37 @@ void cql_server::response::write_value(std::optional<query::result_bytes_view> v
         return;
     }
 
-    write_int(value->size_bytes());
+    auto size = value->size_bytes();
+    if (size <= bytes_ostream::max_chunk_size() - sizeof(int32_t)) {
+        auto* p = start_value_with_one_allocation(size);
+        for (bytes_view fragment : *value) {
+            p = std::copy_n(fragment.data(), fragment.size(), p);
+        }
+        return;
+    }
+
+    write_int(size);
     using boost::range::for_each;
     for_each(*value, [&] (bytes_view fragment) {
         _body.write(fragment);
     });
 }
 
+// Makes room for the length prefix and the payload of a [value] with a single
+// allocation, writes the prefix and returns a pointer to where the payload
+// goes. Response cells are almost always much smaller than a body chunk, so
+// this replaces two rounds of bounds checks per cell with one. The payload
+// must fit in one chunk, i.e. the caller checked the size against
+// bytes_ostream::max_chunk_size().
+bytes_ostream::value_type* cql_server::response::start_value_with_one_allocation(int32_t size)
+{
+    auto* p = _body.write_place_holder(sizeof(int32_t) + size);
+    auto u = htonl(size);
+    auto* s = reinterpret_cast<const int8_t*>(&u);
+    std::copy_n(s, sizeof(u), p);
+    return p + sizeof(int32_t);
+}
+
 class type_codec {
 private:
     enum class type_id : int16_t {
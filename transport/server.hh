@@ -134,6 +134,12 @@ private:
         uint64_t requests_blocked_memory;
         uint64_t requests_shed;
 
+        // In-flight requests from connections whose service level
+        // declares a batch workload type, for enforcing
+        // batch_workload_admission_fraction at frame-dispatch time.
+        uint32_t batch_workload_requests_serving;
+        uint64_t batch_workload_request_memory;
+
         // cql message stats
         uint64_t startups;
         uint64_t auth_responses;
@@ -155,6 +161,7 @@ private:
     cql_server_config _config;
     size_t _max_request_size;
     utils::updateable_value<uint32_t> _max_concurrent_requests;
+    utils::updateable_value<double> _batch_workload_admission_fraction;
     semaphore& _memory_available;
     seastar::metrics::metric_groups _metrics;
     std::unique_ptr<event_notifier> _notifier;
@@ -169,6 +176,13 @@ public:
             qos::service_level_controller& sl_controller);
 public:
     using response = cql_transport::response;
+
+    // Applies reloaded timeout settings. Takes effect for connections
+    // established from now on; existing connections keep the timeout
+    // configuration they were created with.
+    void update_timeout_config(const ::timeout_config& tc) {
+        _config.timeout_config = tc;
+    }
 private:
     class fmt_visitor;
     friend class connection;
@@ -187,6 +201,10 @@ private:
         timer<lowres_clock> _shedding_timer;
         bool _shed_incoming_requests = false;
         unsigned _request_cpu = 0;
+        // Responses queued on _ready_to_respond but not yet written out.
+        // Lets write_response() coalesce output flushes: in a burst of
+        // pipelined requests only the last response flushes the socket.
+        size_t _pending_response_writes = 0;
 
         enum class tracing_request_type : uint8_t {
             not_requested,
@@ -853,6 +853,17 @@ struct is_byte_order_equal_visitor {
 
 bool abstract_type::is_byte_order_equal() const { return visit(*this, is_byte_order_equal_visitor{}); }
 
+namespace {
+struct is_byte_order_comparable_visitor {
+    bool operator()(const abstract_type&) { return false; }
+    bool operator()(const string_type_impl&) { return true; }
+    bool operator()(const bytes_type_impl&) { return true; }
+    bool operator()(const boolean_type_impl&) { return true; }
+};
+}
+
+bool abstract_type::is_byte_order_comparable() const { return visit(*this, is_byte_order_comparable_visitor{}); }
+
 static bool
 check_compatibility(const tuple_type_impl &t, const abstract_type& previous, bool (abstract_type::*predicate)(const abstract_type&) const);
 
@@ -2321,6 +2332,22 @@ struct compare_visitor {
     }
     int32_t operator()(const reversed_type_impl& r) { return r.underlying_type()->compare(v2, v1); }
 };
+
+// Resolves the compare_visitor case for the type's kind to a plain function,
+// so that callers which compare many values of the same type can dispatch on
+// the kind once instead of on every comparison.
+struct compare_fn_resolving_visitor {
+    template <typename T>
+    abstract_type::tri_compare_fn operator()(const T&) {
+        return [] (const abstract_type& t, managed_bytes_view v1, managed_bytes_view v2) -> int32_t {
+            try {
+                return compare_visitor{v1, v2}(static_cast<const T&>(t));
+            } catch (const marshal_exception&) {
+                on_types_internal_error(std::current_exception());
+            }
+        };
+    }
+};
 }
 
 int32_t abstract_type::compare(bytes_view v1, bytes_view v2) const {
@@ -2335,6 +2362,10 @@ int32_t abstract_type::compare(managed_bytes_view v1, managed_bytes_view v2) con
     }
 }
 
+abstract_type::tri_compare_fn abstract_type::compare_fn() const {
+    return visit(*this, compare_fn_resolving_visitor{});
+}
+
 bool abstract_type::equal(bytes_view v1, bytes_view v2) const {
     return ::visit(*this, [&](const auto& t) {
         if (is_byte_order_equal_visitor{}(t)) {
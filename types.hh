@@ -506,6 +506,13 @@ public:
     int32_t compare(bytes_view v1, bytes_view v2) const;
     int32_t compare(managed_bytes_view v1, managed_bytes_view v2) const;
 
+    // compare() resolved to a plain function for this type's kind. Compound
+    // key comparators fetch it once per component at construction time, so
+    // that tree comparisons don't re-dispatch on the kind for every component
+    // of every key (see compound_type::compare_fns()).
+    using tri_compare_fn = int32_t (*)(const abstract_type&, managed_bytes_view, managed_bytes_view);
+    tri_compare_fn compare_fn() const;
+
 private:
     // Explicitly instantiated in .cc
     template <FragmentedView View> data_value deserialize_impl(View v) const;
@@ -572,6 +579,18 @@ public:
      * When returns false, nothing can be inferred.
      */
     bool is_byte_order_equal() const;
+
+    /**
+     * When returns true then comparing serialized values lexicographically, as
+     * unsigned bytes, gives the same order as compare(). A stronger property
+     * than is_byte_order_equal(): the fixed-size signed integers, for example,
+     * are byte-order equal but not byte-order comparable, since two's
+     * complement puts negative values above positive ones in unsigned byte
+     * order.
+     *
+     * When returns false, nothing can be inferred.
+     */
+    bool is_byte_order_comparable() const;
     sstring get_string(const bytes& b) const;
     sstring to_string(bytes_view bv) const {
         return to_string_impl(deserialize(bv));
@@ -106,13 +106,38 @@ arch_target("avx2") int array_search_gt_impl(int64_t val, const int64_t* array,
      *    but ...  AVX2 instructions set doesn't have the PCMPGE
      *
      *    SSE* set (predecessor) has cmpge, but eats 2 keys in one go
-     *    AVX-512 (successor) has it back, and even eats 8 keys, but is
-     *    not widely available
+     *    AVX-512 (successor) has it back, and even eats 8 keys -- the
+     *    variant below uses it where available
      *   </grumble>
      */
     return size - cnt;
 }
 
+/*
+ * The AVX-512 version gets the PCMPGT result as a bit-mask directly, so
+ * there's no movemask dance, and a comparison eats 8 keys in one go. The
+ * tail that's smaller than a full vector (capacity is only promised to be
+ * a multiple of 4) is done with a masked load, which doesn't fault on the
+ * lanes it skips, and a masked compare, which doesn't count them.
+ */
+arch_target("avx512f") int array_search_gt_impl(int64_t val, const int64_t* array, const int capacity, const int size) {
+    int cnt = 0;
+    int i = 0;
+
+    __m512i k = _mm512_set1_epi64(val);
+    for (; i + 8 <= capacity; i += 8) {
+        cnt += _mm_popcnt_u32(_mm512_cmpgt_epi64_mask(_mm512_loadu_si512((const void*)&array[i]), k));
+    }
+    if (i < capacity) {
+        __mmask8 m = (1 << (capacity - i)) - 1;
+        cnt += _mm_popcnt_u32(_mm512_mask_cmpgt_epi64_mask(m, _mm512_maskz_loadu_epi64(m, &array[i]), k));
+    }
+
+    // Unused elements are < k for sure, so count from the tail of the
+    // used part, like the AVX2 version does.
+    return size - cnt;
+}
+
 /*
  * SSE4 version of searching in array for an exact match.
  */
@@ -92,6 +92,13 @@ bool bloom_filter::is_present(hashed_key key) {
     return result;
 }
 
+void bloom_filter::prefetch(hashed_key key) {
+    for_each_index(key, _hash_count, _bitset.size(), _format, [this] (auto i) {
+        _bitset.prefetch(i);
+        return stop_iteration::no;
+    });
+}
+
 void bloom_filter::add(const bytes_view& key) {
     for_each_index(make_hashed_key(key), _hash_count, _bitset.size(), _format, [this] (auto i) {
         _bitset.set(i);
@@ -103,12 +110,62 @@ bool bloom_filter::is_present(const bytes_view& key) {
     return is_present(make_hashed_key(key));
 }
 
-filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format) {
+template<typename Func>
+void blocked_bloom_filter::for_each_block_index(hashed_key hk, Func&& func) {
+    auto h = hk.hash();
+    uint64_t block = (h[0] % static_cast<uint64_t>(nr_blocks())) * block_bits;
+    uint64_t base = h[1];
+    uint64_t inc = h[0] | 1; // Odd increment, so successive probes walk all slots of the block.
+    for (int i = 0; i < num_hashes(); i++) {
+        if (func(block + (base & (block_bits - 1))) == stop_iteration::yes) {
+            break;
+        }
+        base += inc;
+    }
+}
+
+bool blocked_bloom_filter::is_present(hashed_key key) {
+    bool result = true;
+    for_each_block_index(key, [this, &result] (auto i) {
+        if (!bits().test(i)) {
+            result = false;
+            return stop_iteration::yes;
+        }
+        return stop_iteration::no;
+    });
+    return result;
+}
+
+bool blocked_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+void blocked_bloom_filter::add(const bytes_view& key) {
+    for_each_block_index(make_hashed_key(key), [this] (auto i) {
+        bits().set(i);
+        return stop_iteration::no;
+    });
+}
+
+void blocked_bloom_filter::prefetch(hashed_key key) {
+    // All bits of the key live in one cache line.
+    auto h = key.hash();
+    bits().prefetch((h[0] % static_cast<uint64_t>(nr_blocks())) * block_bits);
+}
+
+filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format, bloom_filter_mode mode) {
+    if (mode == bloom_filter_mode::blocked) {
+        return std::make_unique<blocked_bloom_filter>(hash, std::move(bitset), format);
+    }
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
 
-filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format) {
+filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format, bloom_filter_mode mode) {
     int64_t num_bits = (num_elements * buckets_per) + bloom_calculations::EXCESS;
+    if (mode == bloom_filter_mode::blocked) {
+        num_bits = align_up<int64_t>(std::max(num_bits, int64_t(blocked_bloom_filter::block_bits)), blocked_bloom_filter::block_bits);
+        return std::make_unique<blocked_bloom_filter>(hash, large_bitset(num_bits), format);
+    }
     num_bits = align_up<int64_t>(num_bits, 64);  // Seems to be implied in origin
     large_bitset bitset(num_bits);
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
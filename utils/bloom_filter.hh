@@ -78,6 +78,8 @@ public:
 
     virtual bool is_present(hashed_key key) override;
 
+    virtual void prefetch(hashed_key key) override;
+
     virtual void clear() override {
         _bitset.clear();
     }
@@ -100,6 +102,32 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// Cache-line-blocked variant: every key maps to one 512-bit block of the
+// bitmap and all its k bits live inside that block, so a negative lookup
+// touches a single cache line. See bloom_filter_mode.
+class blocked_bloom_filter: public bloom_filter {
+public:
+    static constexpr size_t block_bits = 512; // One 64-byte cache line.
+private:
+    int64_t nr_blocks() {
+        return bits().size() / block_bits;
+    }
+    template<typename Func>
+    void for_each_block_index(hashed_key key, Func&& func);
+public:
+    blocked_bloom_filter(int hashes, bitmap&& bs, filter_format format)
+        : bloom_filter(hashes, std::move(bs), format)
+    {}
+
+    virtual void add(const bytes_view& key) override;
+    virtual bool is_present(hashed_key key) override;
+    virtual bool is_present(const bytes_view& key) override;
+    virtual void prefetch(hashed_key key) override;
+    virtual bloom_filter_mode mode() const override {
+        return bloom_filter_mode::blocked;
+    }
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -121,7 +149,7 @@ struct always_present_filter: public i_filter {
     }
 };
 
-filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format);
-filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
+filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format, bloom_filter_mode mode = bloom_filter_mode::partitioned);
+filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format, bloom_filter_mode mode = bloom_filter_mode::partitioned);
 }
 }
@@ -319,6 +319,13 @@ private:
         return iterator(const_cast<const tree*>(this)->get_bound(k, upper, match));
     }
 
+    // The key of the element the (non-end) iterator points at. The
+    // iterator dereferences to the value, so peek at the leaf's keys.
+    static const Key& iterator_key(iterator& it) noexcept {
+        node* leaf = it.revalidate();
+        return leaf->_keys[it._idx - 1].v;
+    }
+
 public:
 
     tree(const tree& other) = delete;
@@ -447,6 +454,61 @@ public:
         return std::pair(iterator(d, i + 1), true);
     }
 
+    /*
+     * Appends the key known to go after all the existing ones. The
+     * insertion goes directly into the rightmost leaf, skipping the
+     * descent from the root, so bulk-loading a sorted stream costs
+     * O(1) amortized per element. On top of that the overflowing
+     * right-edge leaf first pushes keys to its left sibling (see
+     * node::insert_into_full), so the loaded tree comes out with
+     * packed leaves instead of the half-filled ones the regular
+     * splits would leave behind.
+     *
+     * The key _MUST_ be greater than all the existing ones, this
+     * is only checked in debug mode.
+     */
+    template <typename... Args>
+    iterator append(Key k, Args&&... args) {
+        if (Debug == with_debug::yes && !empty()) {
+            assert(_less(_right->_keys[_right->_num_keys - 1].v, k));
+        }
+        return end().emplace_before(std::move(k), _less, std::forward<Args>(args)...);
+    }
+
+    /*
+     * Emplaces the key right before the hint if it fits there, i.e.
+     * prev(hint) < k < hint, again skipping the descent from the root,
+     * and falls back to the regular emplace() if it doesn't. Merging a
+     * sorted batch with the iterator of the previous insertion carried
+     * over as the hint thus costs k+N instead of k*logN.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace_before_hint(iterator hint, Key k, Args&&... args) {
+        if (hint != end()) {
+            const Key& next = iterator_key(hint);
+            if (!_less(k, next)) {
+                if (!_less(next, k)) {
+                    return std::pair(hint, false);
+                }
+                return emplace(std::move(k), std::forward<Args>(args)...);
+            }
+        }
+
+        if (hint != begin()) {
+            iterator prev = hint;
+            prev--;
+            const Key& pk = iterator_key(prev);
+            if (!_less(pk, k)) {
+                if (!_less(k, pk)) {
+                    return std::pair(prev, false);
+                }
+                return emplace(std::move(k), std::forward<Args>(args)...);
+            }
+        }
+
+        return std::pair(hint.emplace_before(std::move(k), _less, std::forward<Args>(args)...), true);
+    }
+
     template <typename Func>
     requires Disposer<Func, T>
     iterator erase_and_dispose(const Key& k, Func&& disp) noexcept {
@@ -28,7 +28,6 @@
 
 #include "utils/small_vector.hh"
 
-#include <boost/range/algorithm/equal.hpp>
 #include <boost/algorithm/clamp.hpp>
 #include <boost/version.hpp>
 #include <memory>
@@ -36,6 +35,7 @@
 #include <iterator>
 #include <utility>
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace utils {
@@ -177,6 +177,24 @@ public:
     size_t memory_size() const {
         return _capacity * sizeof(T);
     }
+
+    // Invokes func(pointer, count) on the contiguous element ranges covering
+    // the whole vector, in order. Sequential scans over this are faster than
+    // iterator loops, since the chunk-boundary handling is hoisted out of the
+    // element loop, and bulk operations (memcpy et al.) become possible for
+    // trivially copyable value types.
+    template <typename Func>
+    void for_each_chunk(Func&& func) {
+        for (size_t i = 0; i < _size; i += max_chunk_capacity()) {
+            func(addr(i), std::min(_size - i, max_chunk_capacity()));
+        }
+    }
+    template <typename Func>
+    void for_each_chunk(Func&& func) const {
+        for (size_t i = 0; i < _size; i += max_chunk_capacity()) {
+            func(const_cast<const T*>(addr(i)), std::min(_size - i, max_chunk_capacity()));
+        }
+    }
 public:
     template <class ValueType>
     class iterator_type {
@@ -284,7 +302,18 @@ public:
     std::reverse_iterator<const_iterator> crend() const { return std::reverse_iterator(cbegin()); }
 public:
     bool operator==(const chunked_vector& x) const {
-        return boost::equal(*this, x);
+        if (_size != x._size) {
+            return false;
+        }
+        // Chunk layout is a deterministic function of size, so the chunks of
+        // equally-sized vectors are congruent and can be compared pairwise.
+        for (size_t i = 0; i < _size; i += max_chunk_capacity()) {
+            auto n = std::min(_size - i, max_chunk_capacity());
+            if (!std::equal(addr(i), addr(i) + n, x.addr(i))) {
+                return false;
+            }
+        }
+        return true;
     }
     bool operator!=(const chunked_vector& x) const {
         return !operator==(x);
@@ -296,7 +325,16 @@ template <typename T, size_t max_contiguous_allocation>
 chunked_vector<T, max_contiguous_allocation>::chunked_vector(const chunked_vector& x)
         : chunked_vector() {
     reserve(x.size());
-    std::copy(x.begin(), x.end(), std::back_inserter(*this));
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // reserve() made our chunk boundaries line up with x's, so the copy
+        // can proceed a chunk at a time.
+        x.for_each_chunk([this] (const T* p, size_t n) {
+            std::memcpy(addr(_size), p, n * sizeof(T));
+            _size += n;
+        });
+    } else {
+        std::copy(x.begin(), x.end(), std::back_inserter(*this));
+    }
 }
 
 template <typename T, size_t max_contiguous_allocation>
@@ -428,12 +466,17 @@ template <typename T, size_t max_contiguous_allocation>
 void
 chunked_vector<T, max_contiguous_allocation>::resize(size_t n) {
     reserve(n);
-    // FIXME: construct whole chunks at once
-    while (_size > n) {
-        pop_back();
+    if constexpr (std::is_trivially_destructible_v<T>) {
+        _size = std::min(_size, n);
+    } else {
+        while (_size > n) {
+            pop_back();
+        }
     }
     while (_size < n) {
-        push_back(T{});
+        auto now = std::min(n - _size, max_chunk_capacity() - _size % max_chunk_capacity());
+        std::uninitialized_value_construct_n(addr(_size), now);
+        _size += now;
     }
     shrink_to_fit();
 }
@@ -463,8 +506,12 @@ chunked_vector<T, max_contiguous_allocation>::shrink_to_fit() {
 template <typename T, size_t max_contiguous_allocation>
 void
 chunked_vector<T, max_contiguous_allocation>::clear() {
-    while (_size > 0) {
-        pop_back();
+    if constexpr (std::is_trivially_destructible_v<T>) {
+        _size = 0;
+    } else {
+        while (_size > 0) {
+            pop_back();
+        }
     }
     shrink_to_fit();
 }
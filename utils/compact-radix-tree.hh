@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <bit>
 #include <bitset>
 #include <fmt/core.h>
 #include "utils/allocation_strategy.hh"
@@ -201,10 +202,11 @@ private:
         static constexpr unsigned trailing_bits = (8 * sizeof(key_t)) % radix_bits;
         static constexpr unsigned round_up_delta = trailing_bits == 0 ? 0 : radix_bits - trailing_bits;
         /*
-         * This won't work if k1 == k2 (clz is undefined for full
-         * zeroes value), but we don't get here in this case
+         * The k1 == k2 case would give a misleading result (countl_zero
+         * of zero is the full type width), but we don't get here in
+         * this case
          */
-        return (__builtin_clz(k1 ^ k2) + round_up_delta) / radix_bits;
+        return (std::countl_zero(key_t(k1 ^ k2)) + round_up_delta) / radix_bits;
     }
 
     /*
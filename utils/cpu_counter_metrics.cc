@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/cpu_counter_metrics.hh"
+
+#include <seastar/core/metrics.hh>
+
+namespace utils {
+
+cpu_counter_metrics::cpu_counter_metrics()
+        : _cycles(linux_perf_event::cpu_cycles())
+        , _instructions(linux_perf_event::instructions_retired())
+        , _cache_misses(linux_perf_event::cache_misses()) {
+    _cycles.enable();
+    _instructions.enable();
+    _cache_misses.enable();
+
+    namespace sm = seastar::metrics;
+
+    _metrics.add_group("cpu_counters", {
+        sm::make_derive("cycles", [this] { return _cycles.read(); },
+                sm::description("CPU cycles spent by this shard's reactor thread. "
+                                "Dividing the instructions counter by this one gives the shard's IPC.")),
+
+        sm::make_derive("instructions", [this] { return _instructions.read(); },
+                sm::description("Instructions retired by this shard's reactor thread.")),
+
+        sm::make_derive("cache_misses", [this] { return _cache_misses.read(); },
+                sm::description("Last-level cache misses of this shard's reactor thread.")),
+    });
+}
+
+}
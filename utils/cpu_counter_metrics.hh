@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
+
+#include "utils/linux-perf-event.hh"
+#include "seastarx.hh"
+
+namespace utils {
+
+// Publishes the shard's hardware counters - cycles, instructions and
+// cache misses of the reactor thread - as metrics, so that a latency
+// regression can be attributed to IPC collapse or cache thrashing as
+// opposed to queueing or I/O without attaching perf(1) to a production
+// node. The counters cover the whole reactor thread; in environments
+// where perf_event_open() is unavailable (e.g. some containers) the
+// metrics stay at zero, matching the wrapper's behavior.
+class cpu_counter_metrics {
+    linux_perf_event _cycles;
+    linux_perf_event _instructions;
+    linux_perf_event _cache_misses;
+    seastar::metrics::metric_groups _metrics;
+public:
+    cpu_counter_metrics();
+    future<> stop() {
+        return make_ready_future<>();
+    }
+};
+
+}
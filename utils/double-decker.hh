@@ -46,8 +46,29 @@ public:
     using outer_iterator = typename outer_tree::iterator;
     using outer_const_iterator = typename outer_tree::const_iterator;
 
+public:
+    /*
+     * The inner array is fully rebuilt every time a key collision makes
+     * an element join an existing bucket. This is by-design cheap for
+     * the expected rare-collisions case, but degrades quadratically on
+     * duplicate-heavy keys, so the rebuilds are counted to make the
+     * cost observable.
+     */
+    struct stats {
+        uint64_t bucket_rebuilds = 0;
+        uint64_t elements_moved = 0;
+        size_t max_bucket_size = 0;
+    };
+
 private:
     outer_tree  _tree;
+    stats _stats;
+
+    void account_rebuild(size_t old_size) noexcept {
+        _stats.bucket_rebuilds++;
+        _stats.elements_moved += old_size;
+        _stats.max_bucket_size = std::max(_stats.max_bucket_size, old_size + 1);
+    }
 
 public:
     template <bool Const>
@@ -188,7 +209,7 @@ public:
     explicit double_decker(Less less) noexcept : _tree(less) { }
 
     double_decker(const double_decker& other) = delete;
-    double_decker(double_decker&& other) noexcept : _tree(std::move(other._tree)) {}
+    double_decker(double_decker&& other) noexcept : _tree(std::move(other._tree)), _stats(other._stats) {}
 
     iterator insert(Key k, T value, Compare cmp) {
         std::pair<outer_iterator, bool> oip = _tree.emplace(std::move(k), std::move(value));
@@ -201,6 +222,7 @@ public:
              * must not have been moved by emplace() above.
              */
             idx = bkt->index_of(bkt->lower_bound(value, cmp));
+            account_rebuild(bkt->size());
             size_t new_size = (bkt->size() + 1) * sizeof(T);
             bkt.reconstruct(new_size, *bkt,
                     typename inner_array::grow_tag{idx}, std::move(value));
@@ -242,6 +264,7 @@ public:
             idx = bucket->index_of(bucket->end());
         }
 
+        account_rebuild(bucket->size());
         size_t new_size = (bucket->size() + 1) * sizeof(T);
         bucket.reconstruct(new_size, *bucket,
                 typename inner_array::grow_tag{idx}, std::forward<Args>(args)...);
@@ -401,6 +424,8 @@ public:
 
     bool empty() const noexcept { return _tree.empty(); }
 
+    const stats& get_stats() const noexcept { return _stats; }
+
     static size_t estimated_object_memory_size_in_allocator(allocation_strategy& allocator, const T* obj) noexcept {
         /*
          * The T-s are merged together in array, so getting any run-time
@@ -19,6 +19,9 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <bit>
+
 #include <seastar/core/bitops.hh>
 #include <seastar/core/align.hh>
 #include <boost/range/adaptor/reversed.hpp>
@@ -30,6 +33,7 @@
 namespace utils {
 
 void dynamic_bitset::set(size_t n) {
+    _block_rank.clear();
     for (auto& level : _bits) {
         auto idx = n / bits_per_int;
         auto old = level[idx];
@@ -42,6 +46,7 @@ void dynamic_bitset::set(size_t n) {
 }
 
 void dynamic_bitset::clear(size_t n) {
+    _block_rank.clear();
     for (auto& level : _bits) {
         auto idx = n / bits_per_int;
         auto old = level[idx];
@@ -119,6 +124,62 @@ size_t dynamic_bitset::find_last_set() const
     return pos;
 }
 
+void dynamic_bitset::ensure_block_rank() const {
+    if (!_block_rank.empty()) {
+        return;
+    }
+    auto& words = _bits[0];
+    auto nr_blocks = (words.size() + rank_block_words - 1) / rank_block_words;
+    _block_rank.reserve(nr_blocks + 1);
+    size_t total = 0;
+    _block_rank.push_back(0);
+    for (size_t w = 0; w != words.size(); ++w) {
+        total += std::popcount(words[w]);
+        if ((w + 1) % rank_block_words == 0 || w + 1 == words.size()) {
+            _block_rank.push_back(total);
+        }
+    }
+}
+
+size_t dynamic_bitset::rank(size_t n) const {
+    ensure_block_rank();
+    auto word = n / bits_per_int;
+    auto& words = _bits[0];
+    if (word >= words.size()) {
+        return _block_rank.back();
+    }
+    auto block = word / rank_block_words;
+    size_t r = _block_rank[block];
+    for (auto w = block * rank_block_words; w != word; ++w) {
+        r += std::popcount(words[w]);
+    }
+    return r + std::popcount(words[word] & mask_lower_bits(n % bits_per_int));
+}
+
+size_t dynamic_bitset::select(size_t k) const {
+    ensure_block_rank();
+    if (k >= _block_rank.back()) {
+        return npos;
+    }
+    // First block whose cumulative count exceeds k holds the k-th set bit.
+    auto it = std::upper_bound(_block_rank.begin(), _block_rank.end(), k);
+    auto block = size_t(it - _block_rank.begin()) - 1;
+    auto r = k - _block_rank[block];
+    auto& words = _bits[0];
+    for (auto w = block * rank_block_words; ; ++w) {
+        auto v = words[w];
+        size_t bits = std::popcount(v);
+        if (r < bits) {
+            // Peel off r set bits, the next one is the answer.
+            while (r--) {
+                v &= v - 1;
+            }
+            return w * bits_per_int + count_trailing_zeros(v);
+        }
+        r -= bits;
+    }
+}
+
 dynamic_bitset::dynamic_bitset(size_t nr_bits)
     : _bits_count(nr_bits)
 {
@@ -35,9 +35,15 @@ class dynamic_bitset {
     static constexpr int_type all_set = std::numeric_limits<int_type>::max();
     static constexpr unsigned level_shift = seastar::log2ceil(bits_per_int);
 private:
+    // Words per rank directory block; 512 bits, one cache line of payload.
+    static constexpr size_t rank_block_words = 8;
+
     std::vector<std::vector<int_type>> _bits; // level n+1 = 64:1 summary of level n
     size_t _bits_count = 0;
     unsigned _nlevels = 0;
+    // Cumulative count of set bits before each rank_block_words block of
+    // level 0, built lazily by rank()/select() and dropped on modification.
+    mutable std::vector<size_t> _block_rank;
 private:
     // For n in range 0..(bits_per_int-1), produces a mask with all bits < n set
     static int_type mask_lower_bits(size_t n) {
@@ -56,6 +62,7 @@ private:
         return (n >> (level * level_shift)) & (bits_per_int - 1);
     }
     void do_resize(size_t n, bool set);
+    void ensure_block_rank() const;
 public:
     enum : size_t {
         npos = std::numeric_limits<size_t>::max()
@@ -75,6 +82,16 @@ public:
     size_t find_first_set() const;
     size_t find_next_set(size_t n) const;
     size_t find_last_set() const;
+
+    // Number of set bits in [0, n). The first call after a modification
+    // builds the rank directory in O(size), subsequent calls are O(1).
+    size_t rank(size_t n) const;
+    // Total number of set bits.
+    size_t count() const { return rank(_bits_count); }
+    // Position of the k-th (0-based) set bit, npos if there are fewer
+    // than k+1 set bits. Same lazy directory as rank(), lookups are
+    // logarithmic in the number of blocks.
+    size_t select(size_t k) const;
 };
 
 }
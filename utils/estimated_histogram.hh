@@ -185,17 +185,17 @@ public:
      * \brief Find the bucket index for a given value
      * The position of a value that is lower or equal to Min will always be 0.
      * The position of a value that is higher or equal to MAX will always be NUM_BUCKETS - 1.
+     *
+     * Values at the edges are clamped rather than branched on: Min maps to
+     * index 0 and Max to NUM_BUCKETS - 1 through the same formula as
+     * everything in between, so the hot path is a clamp, a bit scan and
+     * some shifts.
      */
     uint16_t find_bucket_index(uint64_t val) const {
-        if (val >= Max) {
-            return NUM_BUCKETS - 1;
-        }
-        if (val <= Min) {
-            return 0;
-        }
+        val = std::clamp(val, Min, Max);
         uint16_t range = log2floor(val);
-        val >>= range - PRECISION_BITS; // leave the top most N+1 bits where N is the resolution.
-        return ((range - BASESHIFT) << PRECISION_BITS) + (val & LOWER_BITS_MASK);
+        // leave the top most N+1 bits where N is the resolution.
+        return ((range - BASESHIFT) << PRECISION_BITS) + ((val >> (range - PRECISION_BITS)) & LOWER_BITS_MASK);
     }
 
     /*!
@@ -210,7 +210,7 @@ public:
      * Increments the count of the bucket holding that value
      */
     void add(uint64_t n) {
-        _buckets.at(find_bucket_index(n))++;
+        _buckets[find_bucket_index(n)]++; // find_bucket_index() clamps to a valid index.
     }
 
     /*!
@@ -354,21 +354,24 @@ inline approx_exponential_histogram<Min, Max, NumBuckets> base_estimated_histogr
 /*!
  * \brief estimated histogram for duration values
  * time_estimated_histogram is used for short task timing.
- * It covers the range of 0.5ms to 33s with a precision of 4.
+ * It covers the range of 64us to 33s with a precision of 8, giving 8us
+ * resolution at the bottom of the range so that sub-millisecond tail
+ * quantiles are meaningful (anything faster than 64us lands in the first
+ * bucket).
  *
- * 512us, 640us, 768us, 896us, 1024us, 1280us, 1536us, 1792us...16s, 20s, 25s, 29s, 33s (33554432us)
+ * 64us, 72us, 80us, ..., 128us, 144us, 160us, ...25s, 29s, 33s (33554432us)
  */
-class time_estimated_histogram : public approx_exponential_histogram<512, 33554432, 4> {
+class time_estimated_histogram : public approx_exponential_histogram<64, 33554432, 8> {
 public:
     using clock = std::chrono::steady_clock;
     using duration = clock::duration;
     time_estimated_histogram& merge(const time_estimated_histogram& b) {
-        approx_exponential_histogram<512, 33554432, 4>::merge(b);
+        approx_exponential_histogram<64, 33554432, 8>::merge(b);
         return *this;
     }
 
     void add_micro(uint64_t n) {
-        approx_exponential_histogram<512, 33554432, 4>::add(n);
+        approx_exponential_histogram<64, 33554432, 8>::add(n);
     }
 
     void add(const duration& latency) {
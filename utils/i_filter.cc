@@ -44,6 +44,31 @@ filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_proba
     return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat);
 }
 
+filter_ptr i_filter::get_filter(int64_t num_elements, double max_false_pos_probability, filter_format fformat, bloom_filter_mode mode) {
+    if (mode == bloom_filter_mode::partitioned) {
+        return get_filter(num_elements, max_false_pos_probability, fformat);
+    }
+    assert(seastar::thread::running_in_thread());
+
+    if (max_false_pos_probability > 1.0) {
+        throw std::invalid_argument(format("Invalid probability {:f}: must be lower than 1.0", max_false_pos_probability));
+    }
+
+    if (max_false_pos_probability == 1.0) {
+        return std::make_unique<filter::always_present_filter>();
+    }
+
+    int max_buckets_per_element = bloom_calculations::max_buckets_per_element(num_elements);
+    auto spec = bloom_calculations::compute_bloom_spec(max_buckets_per_element, max_false_pos_probability);
+    // Confining all bits of a key to one block raises the false positive
+    // rate; spend roughly one extra bit per key to compensate, when the
+    // budget allows it.
+    if (spec.buckets_per_element < max_buckets_per_element) {
+        spec.buckets_per_element++;
+    }
+    return filter::create_filter(spec.K, num_elements, spec.buckets_per_element, fformat, mode);
+}
+
 hashed_key make_hashed_key(bytes_view b) {
     std::array<uint64_t, 2> h;
     utils::murmur_hash::hash3_x64_128(b, 0, h);
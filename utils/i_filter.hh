@@ -53,6 +53,18 @@ enum class filter_format {
     m_format,
 };
 
+// Memory layout of the filter's bitmap.
+//
+// `partitioned` is the classic bloom filter: the k probed bits are spread
+// over the whole bitmap, costing up to k cache misses per negative lookup.
+// `blocked` confines all k bits of a key to a single 64-byte block, so a
+// negative lookup costs one cache miss, at the price of a slightly higher
+// false positive rate for the same number of bits.
+enum class bloom_filter_mode {
+    partitioned,
+    blocked,
+};
+
 class hashed_key {
 private:
     std::array<uint64_t, 2> _hash;
@@ -71,11 +83,21 @@ struct i_filter {
     virtual void add(const bytes_view& key) = 0;
     virtual bool is_present(const bytes_view& key) = 0;
     virtual bool is_present(hashed_key) = 0;
+
+    // Issues software prefetch for the cache lines which is_present(hashed_key)
+    // will touch, so that probes of many filters can be batched: prefetch all,
+    // then probe all, overlapping the memory latency instead of paying a cache
+    // miss per probe.
+    virtual void prefetch(hashed_key) {}
     virtual void clear() = 0;
     virtual void close() = 0;
 
     virtual size_t memory_size() = 0;
 
+    virtual bloom_filter_mode mode() const {
+        return bloom_filter_mode::partitioned;
+    }
+
     /**
      * @return The smallest bloom_filter that can provide the given false
      *         positive probability rate for the given number of elements.
@@ -84,5 +106,6 @@ struct i_filter {
      *         filter.
      */
     static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format);
+    static filter_ptr get_filter(int64_t num_elements, double max_false_pos_prob, filter_format format, bloom_filter_mode mode);
 };
 }
@@ -466,6 +466,31 @@ public:
         return it.insert_before(std::move(kptr));
     }
 
+    /*
+     * Merges a sorted batch of keys into the tree in one forward pass.
+     * The position hint is carried from one insertion to the next and
+     * only ever moves right, so merging k keys costs one scan over the
+     * overlapped part of the tree plus O(1) amortized per key, instead
+     * of k descents from the root. The batch _MUST_ be sorted wrt the
+     * cmp, this is not checked.
+     *
+     * Keys that are already in the tree are skipped, i.e. -- their
+     * pointers are not released, so owning ones drop the key (just
+     * like with a conflicting insert()).
+     */
+    template <typename PointerRange>
+    void merge_sorted(PointerRange&& batch, Compare cmp) {
+        iterator hint = begin();
+
+        for (auto&& kptr : batch) {
+            while (hint != end() && cmp(*hint, *kptr) < 0) {
+                hint++;
+            }
+            hint = insert_before_hint(hint, std::move(kptr), cmp).first;
+            hint++;
+        }
+    }
+
     template <typename K>
     requires Comparable<K, Key, Compare>
     const_iterator find(const K& k, Compare cmp) const {
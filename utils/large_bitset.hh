@@ -56,6 +56,10 @@ public:
         return _storage.memory_size();
     }
 
+    // Hints the CPU to load the word holding the given bit into cache.
+    void prefetch(size_t idx) const {
+        __builtin_prefetch(&_storage[idx / bits_per_int()], 0, 0);
+    }
     bool test(size_t idx) const {
         auto idx1 = idx / bits_per_int();
         idx %= bits_per_int();
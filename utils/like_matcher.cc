@@ -23,100 +23,179 @@
 
 #include "like_matcher.hh"
 
-#include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
-#include <string>
+#include <cstring>
+#include <limits>
+#include <vector>
 
 namespace {
 
-using std::wstring;
+// A pattern is compiled once into a flat program of the three LIKE
+// constructs. Literal runs are stored as byte strings so that matching a row
+// is memcmp()/memchr() over the text rather than a regex engine walk; since
+// UTF-8 lead and continuation bytes are disjoint, byte-wise comparison of
+// literal runs is exact for UTF-8 text.
+struct token {
+    enum class kind { literal, one_char, any_string };
+    kind k;
+    bytes lit; // Only used by kind::literal.
+};
 
-/// Processes a new pattern character, extending re with the equivalent regex pattern.
-void process_char(wchar_t c, wstring& re, bool& escaping) {
-    if (c == L'\\' && !escaping) {
-        escaping = true;
-        return;
+// Length of the UTF-8 sequence whose lead byte is b. Returns 1 for bytes
+// that cannot start a sequence, so malformed text advances instead of
+// wedging the matcher.
+size_t utf8_len(uint8_t b) {
+    if (b < 0x80) {
+        return 1;
+    } else if ((b & 0xe0) == 0xc0) {
+        return 2;
+    } else if ((b & 0xf0) == 0xe0) {
+        return 3;
+    } else if ((b & 0xf8) == 0xf0) {
+        return 4;
     }
-    switch (c) {
-    case L'.':
-    case L'[':
-    case L'\\':
-    case L'*':
-    case L'^':
-    case L'$':
-        // These are meant to match verbatim in LIKE, but they'd be special characters in regex --
-        // must escape them.
-        re.push_back(L'\\');
-        re.push_back(c);
-        break;
-    case L'_':
-    case L'%':
+    return 1;
+}
+
+std::vector<token> compile(bytes_view pattern) {
+    // Reject patterns that are not valid UTF-8, as the regex-based matcher
+    // used to; utf_to_utf(stop) throws on the first malformed sequence.
+    boost::locale::conv::utf_to_utf<wchar_t>(pattern.begin(), pattern.end(), boost::locale::conv::stop);
+    std::vector<token> prog;
+    auto append_literal_byte = [&prog] (int8_t b) {
+        if (prog.empty() || prog.back().k != token::kind::literal) {
+            prog.push_back(token{token::kind::literal, {}});
+        }
+        prog.back().lit.push_back(b);
+    };
+    bool escaping = false;
+    for (int8_t b : pattern) {
         if (escaping) {
-            re.push_back(c);
-        } else { // LIKE wildcard.
-            re.push_back(L'.');
-            if (c == L'%') {
-                re.push_back(L'*');
+            append_literal_byte(b);
+            escaping = false;
+            continue;
+        }
+        switch (b) {
+        case '\\':
+            escaping = true;
+            break;
+        case '_':
+            // '_' and '%' commute ("%_" matches exactly what "_%" does), so
+            // keep '_' in front of an open '%': the matcher then only sees
+            // wildcard runs of the form "___%", and the token following a
+            // '%' is a literal whenever the pattern allows it.
+            if (!prog.empty() && prog.back().k == token::kind::any_string) {
+                prog.back().k = token::kind::one_char;
+                prog.push_back(token{token::kind::any_string, {}});
+            } else {
+                prog.push_back(token{token::kind::one_char, {}});
+            }
+            break;
+        case '%':
+            if (prog.empty() || prog.back().k != token::kind::any_string) {
+                prog.push_back(token{token::kind::any_string, {}});
             }
+            break;
+        default:
+            append_literal_byte(b);
+            break;
         }
-        break;
-    default:
-        re.push_back(c);
-        break;
     }
-    escaping = false;
+    if (escaping) {
+        // An unescaped trailing backslash matches a literal backslash.
+        append_literal_byte('\\');
+    }
+    return prog;
 }
 
-/// Returns a regex string matching the given LIKE pattern.
-wstring regex_from_pattern(bytes_view pattern) {
-    if (pattern.empty()) {
-        return L"^$"; // Like SQL, empty pattern matches only empty text.
-    }
-    using namespace boost::locale::conv;
-    wstring wpattern = utf_to_utf<wchar_t>(pattern.begin(), pattern.end(), stop);
-    if (wpattern.back() == L'\\') {
-        // Add an extra backslash, in case that last character is unescaped.  (If it is escaped, the
-        // extra backslash will be ignored.)
-        wpattern += L'\\';
-    }
-    wstring re;
-    re.reserve(wpattern.size() * 2); // Worst case: every element is a special character and must be escaped.
-    bool escaping = false;
-    for (const wchar_t c : wpattern) {
-        process_char(c, re, escaping);
+// Greedy glob matching with single-level backtracking: on a mismatch, resume
+// from the most recent '%' with its match extended. This is the classic
+// linear-space wildcard algorithm; '%' never needs more than the last
+// backtrack point to be complete.
+bool match(bytes_view text, const std::vector<token>& prog) {
+    const uint8_t* t = reinterpret_cast<const uint8_t*>(text.data());
+    const size_t len = text.size();
+    constexpr size_t npos = std::numeric_limits<size_t>::max();
+    size_t ti = 0;
+    size_t pi = 0;
+    size_t star_pi = npos;
+    size_t star_ti = 0;
+    while (true) {
+        if (pi == prog.size()) {
+            if (ti == len) {
+                return true;
+            }
+        } else {
+            const token& tok = prog[pi];
+            switch (tok.k) {
+            case token::kind::any_string:
+                star_pi = pi++;
+                star_ti = ti;
+                if (pi == prog.size()) {
+                    return true; // Trailing '%' matches whatever remains.
+                }
+                continue;
+            case token::kind::one_char:
+                if (ti < len) {
+                    auto adv = utf8_len(t[ti]);
+                    if (ti + adv <= len) {
+                        ti += adv;
+                        ++pi;
+                        continue;
+                    }
+                }
+                break;
+            case token::kind::literal:
+                if (len - ti >= tok.lit.size() && std::memcmp(t + ti, tok.lit.data(), tok.lit.size()) == 0) {
+                    ti += tok.lit.size();
+                    ++pi;
+                    continue;
+                }
+                break;
+            }
+        }
+        // Mismatch: extend the last '%' and retry from the token after it.
+        if (star_pi == npos || star_ti >= len) {
+            return false;
+        }
+        const token& next = prog[star_pi + 1];
+        if (next.k == token::kind::literal) {
+            // Skip straight to the next place the literal can possibly
+            // start. A hit is always a character boundary, because a
+            // literal's first byte is never a continuation byte.
+            auto* p = std::memchr(t + star_ti + 1, uint8_t(next.lit[0]), len - star_ti - 1);
+            if (!p) {
+                return false;
+            }
+            star_ti = static_cast<const uint8_t*>(p) - t;
+        } else {
+            star_ti += utf8_len(t[star_ti]);
+        }
+        ti = star_ti;
+        pi = star_pi + 1;
     }
-    return re;
 }
 
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
-    boost::u32regex _re; // Performs pattern matching.
+    std::vector<token> _prog;
   public:
-    explicit impl(bytes_view pattern);
-    bool operator()(bytes_view text) const;
-    void reset(bytes_view pattern);
-  private:
-    void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+    explicit impl(bytes_view pattern)
+            : _pattern(pattern)
+            , _prog(compile(_pattern)) {
     }
-};
-
-like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
-    init_re();
-}
-
-bool like_matcher::impl::operator()(bytes_view text) const {
-    return boost::u32regex_match(text.begin(), text.end(), _re);
-}
-
-void like_matcher::impl::reset(bytes_view pattern) {
-    if (pattern != _pattern) {
-        _pattern = bytes(pattern);
-        init_re();
+    bool operator()(bytes_view text) const {
+        return match(text, _prog);
     }
-}
+    void reset(bytes_view pattern) {
+        if (pattern != _pattern) {
+            _pattern = bytes(pattern);
+            _prog = compile(_pattern);
+        }
+    }
+};
 
 like_matcher::like_matcher(bytes_view pattern)
         : _impl(std::make_unique<impl>(pattern)) {
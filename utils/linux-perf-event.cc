@@ -88,3 +88,36 @@ linux_perf_event::user_instructions_retired() {
             .exclude_hv = 1,
             }, 0, -1, -1, 0);
 }
+
+linux_perf_event
+linux_perf_event::cpu_cycles() {
+    return linux_perf_event(perf_event_attr{
+            .type = PERF_TYPE_HARDWARE,
+            .size = sizeof(struct perf_event_attr),
+            .config = PERF_COUNT_HW_CPU_CYCLES,
+            .disabled = 1,
+            .exclude_hv = 1,
+            }, 0, -1, -1, 0);
+}
+
+linux_perf_event
+linux_perf_event::instructions_retired() {
+    return linux_perf_event(perf_event_attr{
+            .type = PERF_TYPE_HARDWARE,
+            .size = sizeof(struct perf_event_attr),
+            .config = PERF_COUNT_HW_INSTRUCTIONS,
+            .disabled = 1,
+            .exclude_hv = 1,
+            }, 0, -1, -1, 0);
+}
+
+linux_perf_event
+linux_perf_event::cache_misses() {
+    return linux_perf_event(perf_event_attr{
+            .type = PERF_TYPE_HARDWARE,
+            .size = sizeof(struct perf_event_attr),
+            .config = PERF_COUNT_HW_CACHE_MISSES,
+            .disabled = 1,
+            .exclude_hv = 1,
+            }, 0, -1, -1, 0);
+}
@@ -40,5 +40,10 @@ public:
     void disable();
 public:
     static linux_perf_event user_instructions_retired();
+    // The factories below count user and kernel mode alike, for whole-thread
+    // accounting (e.g. per-shard IPC metrics) rather than benchmarking.
+    static linux_perf_event cpu_cycles();
+    static linux_perf_event instructions_retired();
+    static linux_perf_event cache_misses();
 };
 
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <unordered_map>
+#include <utility>
 
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/unordered_set.hpp>
@@ -163,6 +164,7 @@ private:
     timestamped_val_ptr _ts_val_ptr;
     lru_list_type& _lru_list;
     size_t& _cache_size;
+    bool _recently_used = false;
 
 public:
     lru_entry(timestamped_val_ptr ts_val, lru_list_type& lru_list, size_t& cache_size)
@@ -172,6 +174,7 @@ public:
     {
         _ts_val_ptr->set_anchor_back_reference(this);
         _cache_size += _ts_val_ptr->size();
+        _lru_list.push_front(*this);
     }
 
     ~lru_entry() {
@@ -186,13 +189,20 @@ public:
         return _cache_size;
     }
 
-    /// Set this item as the most recently used item.
-    /// The MRU item is going to be at the front of the _lru_list, the LRU item - at the back.
+    /// Mark this item as recently used.
+    /// Instead of splicing the entry to the front of the _lru_list on every
+    /// cache hit, only a flag is raised here and the entry gets a second
+    /// chance when shrink() considers it for eviction, the way the hand of
+    /// the CLOCK algorithm sweeps past referenced pages. This keeps the hit
+    /// path free of list manipulation at the price of making the eviction
+    /// order an approximation of LRU.
     void touch() noexcept {
-        if (safe_link_list_hook::is_linked()) {
-            _lru_list.erase(_lru_list.iterator_to(*this));
-        }
-        _lru_list.push_front(*this);
+        _recently_used = true;
+    }
+
+    /// Returns whether the item was used since the last call and lowers the flag.
+    bool test_and_clear_recently_used() noexcept {
+        return std::exchange(_recently_used, false);
     }
 
     const Key& key() const noexcept {
@@ -346,9 +356,9 @@ public:
                 }
 
                 ts_value_lru_entry* new_lru_entry = Alloc().allocate(1);
+                // The lru_entry constructor adds the entry to the LRU list - we must do this before the shrink() call.
                 new(new_lru_entry) ts_value_lru_entry(std::move(ts_val_ptr), _lru_list, _current_size);
 
-                // This will "touch" the entry and add it to the LRU list - we must do this before the shrink() call.
                 value_ptr vp(new_lru_entry->timestamped_value_ptr());
 
                 // Remove the least recently used items if map is too big.
@@ -546,11 +556,20 @@ private:
         });
     }
 
-    // Shrink the cache to the _max_size discarding the least recently used items
+    // Shrink the cache to the _max_size discarding approximately the least
+    // recently used items. An entry which was touched since we last looked at
+    // it gets a second chance: its flag is lowered and it is moved to the
+    // front of the list. Every inspection lowers a flag, so in the worst case
+    // an eviction completes after one full rotation over the list.
     void shrink() {
         while (_current_size > _max_size) {
             using namespace std::chrono;
             ts_value_lru_entry& lru_entry = *_lru_list.rbegin();
+            if (lru_entry.test_and_clear_recently_used()) {
+                _lru_list.erase(_lru_list.iterator_to(lru_entry));
+                _lru_list.push_front(lru_entry);
+                continue;
+            }
             _logger.trace("shrink(): {}: dropping the entry: ms since last_read {}", lru_entry.key(), duration_cast<milliseconds>(loading_cache_clock_type::now() - lru_entry.timestamped_value().last_read()).count());
             loading_cache::destroy_ts_value(&lru_entry);
         }
@@ -484,6 +484,7 @@ public:
     void full_compaction();
     void reclaim_all_free_segments();
     occupancy_stats region_occupancy();
+    std::unordered_map<sstring, occupancy_stats> region_occupancy_by_label();
     occupancy_stats occupancy();
     size_t non_lsa_used_space();
     // Set the minimum number of segments reclaimed during single reclamation cycle.
@@ -530,6 +531,10 @@ occupancy_stats tracker::region_occupancy() {
     return _impl->region_occupancy();
 }
 
+std::unordered_map<sstring, occupancy_stats> tracker::region_occupancy_by_label() {
+    return _impl->region_occupancy_by_label();
+}
+
 occupancy_stats tracker::occupancy() {
     return _impl->occupancy();
 }
@@ -587,6 +592,15 @@ static constexpr size_t min_free_space_for_compaction = segment_size - max_used_
 static_assert(min_free_space_for_compaction >= max_managed_object_size,
     "Segments which cannot fit max_managed_object_size must not be considered compactible for the sake of forward progress of compaction");
 
+// Bound on the amount of live data a single preemptible (background) reclaim
+// pass may migrate. Compacting sparsest segments first already makes every
+// copied byte release as much memory as possible, but when many segments sit
+// just below max_used_space_ratio_for_compaction a single pass can still copy
+// hundreds of megabytes, starving foreground work of memory bandwidth.
+// Synchronous (non-preemptible) reclaim is never capped because its caller
+// needs the memory to make forward progress.
+static constexpr size_t max_memory_compacted_per_pass = segment_size * 32;
+
 // Since we only compact if there's >= min_free_space_for_compaction of free space,
 // we use min_free_space_for_compaction as the histogram's minimum size and put
 // everything below that value in the same bucket.
@@ -1239,6 +1253,14 @@ private:
     region_group* _group = nullptr;
     segment* _active = nullptr;
     size_t _active_offset;
+    // Separate allocation target for objects relocated by segment compaction.
+    // Compaction survivors have already proven to live longer than their
+    // segment neighbours, so mixing them with fresh allocations in _active
+    // would recreate half-live segments and keep compaction busy forever on
+    // churn-heavy (e.g. cache eviction) workloads. Segregating them lets
+    // churny segments drain completely and get freed without copying.
+    segment* _survivor = nullptr;
+    size_t _survivor_offset = 0;
     segment_descriptor_hist _segment_descs; // Contains only closed segments
     occupancy_stats _closed_occupancy;
     occupancy_stats _non_lsa_occupancy;
@@ -1273,33 +1295,42 @@ private:
         }
     };
 
-    void* alloc_small(const object_descriptor& desc, segment::size_type size, size_t alignment) {
-        if (!_active) {
-            _active = new_segment();
-            _active_offset = 0;
+    void* alloc_small(segment*& seg, size_t& seg_offset, const object_descriptor& desc, segment::size_type size, size_t alignment) {
+        if (!seg) {
+            seg = new_segment();
+            seg_offset = 0;
         }
 
         auto desc_encoded_size = desc.encoded_size();
 
-        size_t obj_offset = align_up_for_asan(align_up(_active_offset + desc_encoded_size, alignment));
+        size_t obj_offset = align_up_for_asan(align_up(seg_offset + desc_encoded_size, alignment));
         if (obj_offset + size > segment::size) {
-            close_and_open();
-            return alloc_small(desc, size, alignment);
+            // Open the new segment before closing the old one so that on
+            // allocation failure the region is left with an open segment.
+            segment* new_seg = new_segment();
+            close(seg, seg_offset);
+            seg = new_seg;
+            seg_offset = 0;
+            return alloc_small(seg, seg_offset, desc, size, alignment);
         }
 
-        auto old_active_offset = _active_offset;
-        auto pos = _active->at<char>(_active_offset);
+        auto old_offset = seg_offset;
+        auto pos = seg->at<char>(seg_offset);
         // Use non-canonical encoding to allow for alignment pad
-        desc.encode(pos, obj_offset - _active_offset);
+        desc.encode(pos, obj_offset - seg_offset);
         unpoison(pos, size);
-        _active_offset = obj_offset + size;
+        seg_offset = obj_offset + size;
 
         // Align the end of the value so that the next descriptor is aligned
-        _active_offset = align_up_for_asan(_active_offset);
-        _active->record_alloc(_active_offset - old_active_offset);
+        seg_offset = align_up_for_asan(seg_offset);
+        seg->record_alloc(seg_offset - old_offset);
         return pos;
     }
 
+    void* alloc_small(const object_descriptor& desc, segment::size_type size, size_t alignment) {
+        return alloc_small(_active, _active_offset, desc, size, alignment);
+    }
+
     template<typename Func>
     void for_each_live(segment* seg, Func&& func) {
         // scylla-gdb.py:scylla_lsa_segment is coupled with this implementation.
@@ -1321,20 +1352,28 @@ private:
         }
     }
 
-    void close_active() {
-        if (!_active) {
+    void close(segment*& seg, size_t offset) {
+        if (!seg) {
             return;
         }
-        if (_active_offset < segment::size) {
-            auto desc = object_descriptor::make_dead(segment::size - _active_offset);
-            auto pos =_active->at<char>(_active_offset);
+        if (offset < segment::size) {
+            auto desc = object_descriptor::make_dead(segment::size - offset);
+            auto pos = seg->at<char>(offset);
             desc.encode(pos);
         }
-        llogger.trace("Closing segment {}, used={}, waste={} [B]", fmt::ptr(_active), _active->occupancy(), segment::size - _active_offset);
-        _closed_occupancy += _active->occupancy();
+        llogger.trace("Closing segment {}, used={}, waste={} [B]", fmt::ptr(seg), seg->occupancy(), segment::size - offset);
+        _closed_occupancy += seg->occupancy();
 
-        _segment_descs.push(shard_segment_pool.descriptor(_active));
-        _active = nullptr;
+        _segment_descs.push(shard_segment_pool.descriptor(seg));
+        seg = nullptr;
+    }
+
+    void close_active() {
+        close(_active, _active_offset);
+    }
+
+    void close_survivor() {
+        close(_survivor, _survivor_offset);
     }
 
     void free_segment(segment_descriptor& desc) noexcept {
@@ -1369,7 +1408,7 @@ private:
         ++_invalidate_counter;
 
         for_each_live(seg, [this] (const object_descriptor* desc, void* obj, size_t size) {
-            auto dst = alloc_small(*desc, size, desc->alignment());
+            auto dst = alloc_small(_survivor, _survivor_offset, *desc, size, desc->alignment());
             _sanitizer.on_migrate(obj, size, dst);
             desc->migrator()->migrate(obj, dst, size);
         });
@@ -1438,6 +1477,11 @@ public:
             free_segment(_active);
             _active = nullptr;
         }
+        if (_survivor) {
+            assert(_survivor->is_empty());
+            free_segment(_survivor);
+            _survivor = nullptr;
+        }
         if (_group) {
             _group->del(this);
         }
@@ -1456,6 +1500,9 @@ public:
         if (_active) {
             total += _active->occupancy();
         }
+        if (_survivor) {
+            total += _survivor->occupancy();
+        }
         return total;
     }
 
@@ -1566,13 +1613,15 @@ public:
         desc.encode(npos);
         poison(pos, dead_size);
 
-        if (seg != _active) {
+        bool closed = seg != _active && seg != _survivor;
+
+        if (closed) {
             _closed_occupancy -= seg->occupancy();
         }
 
         seg_desc.record_free(dead_size);
 
-        if (seg != _active) {
+        if (closed) {
             if (seg_desc.is_empty()) {
                 _segment_descs.erase(seg_desc);
                 free_segment(seg, seg_desc);
@@ -1624,6 +1673,21 @@ public:
             other.close_active();
         }
 
+        if (_survivor && _survivor->is_empty()) {
+            shard_segment_pool.free_segment(_survivor);
+            _survivor = nullptr;
+        }
+        if (!_survivor) {
+            _survivor = other._survivor;
+            other._survivor = nullptr;
+            _survivor_offset = other._survivor_offset;
+            if (_survivor) {
+                shard_segment_pool.set_region(_survivor, this);
+            }
+        } else {
+            other.close_survivor();
+        }
+
         for (auto& desc : other._segment_descs) {
             shard_segment_pool.set_region(desc, this);
         }
@@ -1666,6 +1730,7 @@ public:
         compaction_lock _(*this);
         llogger.debug("Full compaction, {}", occupancy());
         close_and_open();
+        close_survivor();
         segment_descriptor_hist all;
         std::swap(all, _segment_descs);
         _closed_occupancy = {};
@@ -1682,6 +1747,9 @@ public:
         if (_active == seg) {
             close_active();
         }
+        if (_survivor == seg) {
+            close_survivor();
+        }
         _segment_descs.erase(desc);
         _closed_occupancy -= desc.occupancy();
         compact_segment_locked(seg, desc);
@@ -1869,6 +1937,16 @@ occupancy_stats tracker::impl::region_occupancy() {
     return total;
 }
 
+std::unordered_map<sstring, occupancy_stats> tracker::impl::region_occupancy_by_label() {
+    reclaiming_lock _(*this);
+    std::unordered_map<sstring, occupancy_stats> result;
+    for (auto&& r: _regions) {
+        auto& label = r->label();
+        result[label.empty() ? "(unlabelled)" : label] += r->occupancy();
+    }
+    return result;
+}
+
 occupancy_stats tracker::impl::occupancy() {
     reclaiming_lock _(*this);
     auto occ = region_occupancy();
@@ -1909,7 +1987,8 @@ void tracker::impl::full_compaction() {
     llogger.debug("Compaction done, {}", region_occupancy());
 }
 
-static void reclaim_from_evictable(region::impl& r, size_t target_mem_in_use, is_preemptible preempt) {
+static void reclaim_from_evictable(region::impl& r, size_t target_mem_in_use, uint64_t max_memory_compacted, is_preemptible preempt) {
+    auto base_memory_compacted = shard_segment_pool.statistics().memory_compacted;
     llogger.debug("reclaim_from_evictable: total_memory_in_use={} target={}", shard_segment_pool.total_memory_in_use(), target_mem_in_use);
 
     // Before attempting segment compaction, try to evict at least deficit and one segment more so that
@@ -1955,6 +2034,10 @@ static void reclaim_from_evictable(region::impl& r, size_t target_mem_in_use, is
         }
         llogger.debug("Compacting after evicting {} bytes", used - r.occupancy().used_space());
         r.compact();
+        if (preempt && shard_segment_pool.statistics().memory_compacted - base_memory_compacted >= max_memory_compacted) {
+            llogger.debug("reclaim_from_evictable: compaction budget exhausted");
+            return;
+        }
     }
 }
 
@@ -2116,7 +2199,15 @@ size_t tracker::impl::compact_and_evict_locked(size_t reserve_segments, size_t m
         }
     }
 
+    const auto base_memory_compacted = shard_segment_pool.statistics().memory_compacted;
+
     while (shard_segment_pool.total_memory_in_use() > target_mem) {
+        auto compacted_this_pass = shard_segment_pool.statistics().memory_compacted - base_memory_compacted;
+        if (preempt && compacted_this_pass >= max_memory_compacted_per_pass) {
+            llogger.debug("Compaction pass copied {} bytes, deferring the rest to the next pass", compacted_this_pass);
+            break;
+        }
+
         boost::range::pop_heap(_regions, cmp);
         region::impl* r = _regions.back();
 
@@ -2130,7 +2221,7 @@ size_t tracker::impl::compact_and_evict_locked(size_t reserve_segments, size_t m
         // we can reclaim memory by eviction only. In some cases the cost of compaction on allocation
         // would be higher than the cost of repopulating the region with evicted items.
         if (r->is_evictable() && r->occupancy().used_space() >= max_used_space_ratio_for_compaction * r->occupancy().total_space()) {
-            reclaim_from_evictable(*r, target_mem, preempt);
+            reclaim_from_evictable(*r, target_mem, max_memory_compacted_per_pass - compacted_this_pass, preempt);
         } else {
             r->compact();
         }
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <seastar/core/memory.hh>
 #include <seastar/core/idle_cpu_handler.hh>
 #include <seastar/core/condition-variable.hh>
@@ -486,6 +487,12 @@ public:
     // Returns aggregate statistics for all pools.
     occupancy_stats region_occupancy();
 
+    // Returns per-label aggregated statistics for all pools, so that LSA
+    // growth can be attributed to the subsystem or table which owns the
+    // memory. Regions which were never labelled with region::set_label()
+    // are grouped under "(unlabelled)".
+    std::unordered_map<sstring, occupancy_stats> region_occupancy_by_label();
+
     // Returns statistics for all segments allocated by LSA on this shard.
     occupancy_stats occupancy();
 
@@ -569,6 +576,7 @@ class basic_region_impl : public allocation_strategy {
 protected:
     bool _reclaiming_enabled = true;
     seastar::shard_id _cpu = this_shard_id();
+    sstring _label;
 public:
     void set_reclaiming_enabled(bool enabled) {
         assert(this_shard_id() == _cpu);
@@ -578,6 +586,14 @@ public:
     bool reclaiming_enabled() const {
         return _reclaiming_enabled;
     }
+
+    void set_label(sstring label) {
+        _label = std::move(label);
+    }
+
+    const sstring& label() const {
+        return _label;
+    }
 };
 
 //
@@ -641,6 +657,14 @@ public:
     // Returns the reclaimability state of this region.
     bool reclaiming_enabled() const { return _impl->reclaiming_enabled(); }
 
+    // Tags this region with the subsystem (and optionally the table) whose
+    // data it holds, for memory attribution. Purely diagnostic; see
+    // tracker::region_occupancy_by_label().
+    void set_label(sstring label) { _impl->set_label(std::move(label)); }
+
+    // Returns the label set with set_label(), or an empty string.
+    const sstring& label() const { return _impl->label(); }
+
     // Returns a value which is increased when this region is either compacted or
     // evicted from, which invalidates references into the region.
     // When the value returned by this method doesn't change, references remain valid.
@@ -85,7 +85,12 @@ struct blob_storage {
 
 // A managed version of "bytes" (can be used with LSA).
 class managed_bytes {
-    static constexpr size_t max_inline_size = 15;
+    // Covers the serialized forms of live cells of all fixed-size types
+    // without a TTL (1 byte of flags + 8 bytes of timestamp + up to 8 bytes
+    // of value) as well as dead cells (17 bytes), so typical numeric cells
+    // don't need a blob_storage allocation and a pointer chase. Must stay
+    // below 127 since the size shares an int8_t with the external marker.
+    static constexpr size_t max_inline_size = 23;
     struct small_blob {
         bytes_view::value_type data[max_inline_size];
         int8_t size; // -1 -> use blob_storage
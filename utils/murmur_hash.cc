@@ -37,6 +37,8 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "murmur_hash.hh"
 
 namespace utils {
@@ -246,5 +248,110 @@ void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result
     result[1] = h2;
 }
 
+// Runs the hash3_x64_128() body loop for four keys at once, with one
+// independent (h1, h2) state per lane. A single murmur3 state is a long
+// serial chain of multiplies and rotates; interleaving four of them lets
+// the CPU overlap those chains. Lanes whose key is exhausted simply skip
+// block iterations, so keys of different lengths can share a group.
+static void hash3_x64_128_x4(const bytes_view* keys, uint64_t seed, std::array<uint64_t,2>* results)
+{
+    constexpr unsigned lanes = 4;
+
+    uint64_t c1 = 0x87c37b91114253d5L;
+    uint64_t c2 = 0x4cf5ad432745937fL;
+
+    uint64_t h1[lanes];
+    uint64_t h2[lanes];
+    uint32_t nblocks[lanes];
+    uint32_t max_blocks = 0;
+
+    for (unsigned l = 0; l < lanes; l++) {
+        h1[l] = seed;
+        h2[l] = seed;
+        nblocks[l] = keys[l].size() >> 4; // Process as 128-bit blocks.
+        max_blocks = std::max(max_blocks, nblocks[l]);
+    }
+
+    //----------
+    // body, interleaved
+
+    for (uint32_t i = 0; i < max_blocks; i++)
+    {
+        for (unsigned l = 0; l < lanes; l++) {
+            if (i >= nblocks[l]) {
+                continue;
+            }
+            uint64_t k1 = getblock(keys[l], i*2+0);
+            uint64_t k2 = getblock(keys[l], i*2+1);
+
+            k1 *= c1; k1 = rotl64(k1,31); k1 *= c2; h1[l] ^= k1;
+
+            h1[l] = rotl64(h1[l],27); h1[l] += h2[l]; h1[l] = h1[l]*5+0x52dce729;
+
+            k2 *= c2; k2  = rotl64(k2,33); k2 *= c1; h2[l] ^= k2;
+
+            h2[l] = rotl64(h2[l],31); h2[l] += h1[l]; h2[l] = h2[l]*5+0x38495ab5;
+        }
+    }
+
+    //----------
+    // tail and finalization, per lane
+
+    for (unsigned l = 0; l < lanes; l++) {
+        uint32_t length = keys[l].size();
+        auto key = keys[l];
+        key.remove_prefix(nblocks[l] * 16);
+
+        uint64_t k1 = 0;
+        uint64_t k2 = 0;
+
+        switch (length & 15)
+        {
+        case 15: k2 ^= ((uint64_t) key[14]) << 48;
+        case 14: k2 ^= ((uint64_t) key[13]) << 40;
+        case 13: k2 ^= ((uint64_t) key[12]) << 32;
+        case 12: k2 ^= ((uint64_t) key[11]) << 24;
+        case 11: k2 ^= ((uint64_t) key[10]) << 16;
+        case 10: k2 ^= ((uint64_t) key[9]) << 8;
+        case  9: k2 ^= ((uint64_t) key[8]) << 0;
+            k2 *= c2; k2  = rotl64(k2,33); k2 *= c1; h2[l] ^= k2;
+        case  8: k1 ^= ((uint64_t) key[7]) << 56;
+        case  7: k1 ^= ((uint64_t) key[6]) << 48;
+        case  6: k1 ^= ((uint64_t) key[5]) << 40;
+        case  5: k1 ^= ((uint64_t) key[4]) << 32;
+        case  4: k1 ^= ((uint64_t) key[3]) << 24;
+        case  3: k1 ^= ((uint64_t) key[2]) << 16;
+        case  2: k1 ^= ((uint64_t) key[1]) << 8;
+        case  1: k1 ^= ((uint64_t) key[0]);
+            k1 *= c1; k1  = rotl64(k1,31); k1 *= c2; h1[l] ^= k1;
+        };
+
+        h1[l] ^= length; h2[l] ^= length;
+
+        h1[l] += h2[l];
+        h2[l] += h1[l];
+
+        h1[l] = fmix(h1[l]);
+        h2[l] = fmix(h2[l]);
+
+        h1[l] += h2[l];
+        h2[l] += h1[l];
+
+        results[l][0] = h1[l];
+        results[l][1] = h2[l];
+    }
+}
+
+void hash3_x64_128_batch(const bytes_view* keys, size_t n, uint64_t seed, std::array<uint64_t,2>* results)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        hash3_x64_128_x4(keys + i, seed, results + i);
+    }
+    for (; i < n; i++) {
+        hash3_x64_128(keys[i], seed, results[i]);
+    }
+}
+
 } // namespace murmur_hash
 } // namespace utils
@@ -167,6 +167,13 @@ void hash3_x64_128(InputIterator in, uint32_t length, uint64_t seed, std::array<
 
 void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t, 2>& result);
 
+// Hashes `n` keys, producing the same digests as n calls to hash3_x64_128()
+// above. Keys are processed in interleaved lanes so that the multiply/rotate
+// dependency chains of several independent hash states overlap, which makes
+// hashing a batch of small keys (large IN lists, batch statements) noticeably
+// cheaper than hashing them one by one.
+void hash3_x64_128_batch(const bytes_view* keys, size_t n, uint64_t seed, std::array<uint64_t, 2>* results);
+
 } // namespace murmur_hash
 
 } // namespace utils
@@ -19,6 +19,8 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <seastar/core/sleep.hh>
+
 #include "rate_limiter.hh"
 
 utils::rate_limiter::rate_limiter(size_t rate)
@@ -48,3 +50,73 @@ future<> utils::rate_limiter::reserve(size_t u) {
         return reserve(r);
     });
 }
+
+void utils::token_bucket::refill() noexcept {
+    auto now = clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _last).count();
+    if (elapsed <= 0) {
+        return;
+    }
+    uint64_t add = (unsigned __int128)elapsed * _rate / 1'000'000'000;
+    if (add >= _burst - _tokens) {
+        _tokens = _burst;
+        _last = now;
+    } else if (add > 0) {
+        _tokens += add;
+        // Advance _last only by the time the added tokens account for, so
+        // the sub-token remainder of a low-resolution clock tick carries
+        // over to the next refill instead of being dropped.
+        _last += std::chrono::duration_cast<clock::duration>(
+                std::chrono::nanoseconds(uint64_t((unsigned __int128)add * 1'000'000'000 / _rate)));
+    }
+}
+
+utils::token_bucket::clock::duration utils::token_bucket::time_for(uint64_t units) const noexcept {
+    return std::chrono::duration_cast<clock::duration>(
+            std::chrono::nanoseconds(uint64_t((unsigned __int128)units * 1'000'000'000 / _rate)) +
+            std::chrono::nanoseconds(1));
+}
+
+void utils::token_bucket::update_rate(uint64_t rate, uint64_t burst) noexcept {
+    refill();
+    _rate = rate;
+    _burst = burst ? burst : rate;
+    _tokens = std::min(_tokens, _burst);
+    _last = clock::now();
+}
+
+bool utils::token_bucket::try_reserve(uint64_t units) noexcept {
+    if (_rate == 0) {
+        return !_parent || _parent->try_reserve(units);
+    }
+    refill();
+    if (_tokens < units) {
+        return false;
+    }
+    if (_parent && !_parent->try_reserve(units)) {
+        return false;
+    }
+    _tokens -= units;
+    return true;
+}
+
+future<> utils::token_bucket::reserve(uint64_t units) {
+    if (_rate == 0) {
+        return _parent ? _parent->reserve(units) : make_ready_future<>();
+    }
+    if (units > _burst) {
+        // Larger than the bucket can ever hold: take it in burst-sized bites.
+        auto n = _burst;
+        return reserve(n).then([this, r = units - n] {
+            return reserve(r);
+        });
+    }
+    refill();
+    if (_tokens >= units) {
+        _tokens -= units;
+        return _parent ? _parent->reserve(units) : make_ready_future<>();
+    }
+    return seastar::sleep(time_for(units - _tokens)).then([this, units] {
+        return reserve(units);
+    });
+}
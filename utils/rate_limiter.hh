@@ -24,6 +24,7 @@
 #include <seastar/core/timer.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/seastar.hh>
+#include <seastar/core/lowres_clock.hh>
 #include "seastarx.hh"
 
 namespace utils {
@@ -45,4 +46,61 @@ public:
     future<> reserve(size_t u);
 };
 
+/**
+ * Token-bucket rate limiter with lazy refill.
+ *
+ * Unlike rate_limiter above there is no timer: the bucket is topped up
+ * on every reserve() from the time elapsed since the previous one, so an
+ * idle limiter costs nothing and an uncontended reserve() is a clock read
+ * and a little arithmetic. Tokens accumulate while the bucket is idle up
+ * to the configured burst, allowing short spikes at full speed while
+ * holding the long-term rate.
+ *
+ * Buckets form a hierarchy: a bucket constructed with a parent takes
+ * units from every level, so e.g. a per-table bucket can live under a
+ * per-node one and both limits hold. A rate of zero means unlimited at
+ * that level (the parent still applies).
+ *
+ * Waiters are not queued: concurrent reserve() calls that have to sleep
+ * re-check on wakeup, so strict FIFO fairness between fibers is not
+ * guaranteed.
+ */
+class token_bucket {
+public:
+    using clock = lowres_clock;
+private:
+    token_bucket* _parent;
+    uint64_t _rate; // units per second, 0 means unlimited
+    uint64_t _burst;
+    uint64_t _tokens;
+    clock::time_point _last;
+
+    void refill() noexcept;
+    clock::duration time_for(uint64_t units) const noexcept;
+public:
+    /// rate: units per second (0 - unlimited); burst: maximum accumulated
+    /// units, defaults to one second's worth.
+    explicit token_bucket(uint64_t rate = 0, uint64_t burst = 0, token_bucket* parent = nullptr) noexcept
+        : _parent(parent)
+        , _rate(rate)
+        , _burst(burst ? burst : rate)
+        , _tokens(_burst)
+        , _last(clock::now())
+    {}
+
+    uint64_t rate() const noexcept { return _rate; }
+
+    // Takes effect on the next reserve; accumulated tokens are clamped
+    // to the new burst.
+    void update_rate(uint64_t rate, uint64_t burst = 0) noexcept;
+
+    // Takes units from every level of the hierarchy if they are all
+    // available right now, otherwise takes nothing.
+    bool try_reserve(uint64_t units) noexcept;
+
+    // Resolves once units have been taken from every level of the
+    // hierarchy, sleeping out any deficit.
+    future<> reserve(uint64_t units);
+};
+
 }
@@ -109,7 +109,8 @@ public:
     using handler_base = Handler;
 
     explicit guarded_yieldable_json_handler(size_t max_nested_level) : _max_nested_level(max_nested_level) {}
-    guarded_yieldable_json_handler(string_buffer& buf, size_t max_nested_level)
+    template<typename Buffer>
+    guarded_yieldable_json_handler(Buffer& buf, size_t max_nested_level)
             : handler_base(buf), _max_nested_level(max_nested_level) {}
 
     // Parse any stream fitting https://rapidjson.org/classrapidjson_1_1_stream.html
@@ -236,6 +237,50 @@ std::string print(const rjson::value& value, size_t max_nested_level) {
     return std::string(buffer.GetString());
 }
 
+// A rapidjson output stream over a seastar output_stream. Fills a small
+// fixed chunk and sends each full chunk down the seastar stream, blocking
+// (we run in a seastar thread) until it drains, so the serialized JSON is
+// never held in memory in its entirety.
+class output_stream_buffer {
+    static constexpr size_t chunk_size = 8192;
+    seastar::output_stream<char>& _os;
+    temporary_buffer<char> _buf = temporary_buffer<char>(chunk_size);
+    size_t _pos = 0;
+public:
+    using Ch = char;
+    explicit output_stream_buffer(seastar::output_stream<char>& os) : _os(os) {}
+    void Put(Ch c) {
+        if (_pos == _buf.size()) {
+            Flush();
+        }
+        *(_buf.get_write() + _pos) = c;
+        ++_pos;
+    }
+    void Flush() {
+        if (_pos == 0) {
+            return;
+        }
+        if (_pos == _buf.size()) {
+            // Happy path: pass the full chunk to the stream without copy.
+            _os.write(std::move(_buf)).get();
+            _buf = temporary_buffer<char>(chunk_size);
+        } else {
+            _os.write(_buf.get(), _pos).get();
+        }
+        _pos = 0;
+    }
+};
+
+future<> print(const rjson::value& value, seastar::output_stream<char>& os, size_t max_nested_level) {
+    return seastar::async([&value, &os, max_nested_level] {
+        output_stream_buffer buf(os);
+        using streaming_writer = rapidjson::Writer<output_stream_buffer, encoding, encoding, allocator>;
+        guarded_yieldable_json_handler<streaming_writer, true> writer(buf, max_nested_level);
+        value.Accept(writer);
+        buf.Flush();
+    });
+}
+
 rjson::malformed_value::malformed_value(std::string_view name, const rjson::value& value)
     : malformed_value(name, print(value))
 {}
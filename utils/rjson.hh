@@ -68,6 +68,8 @@ public:
 #include <rapidjson/error/en.h>
 #include <rapidjson/allocators.h>
 #include <seastar/core/sstring.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/iostream.hh>
 #include "seastarx.hh"
 
 namespace rjson {
@@ -144,6 +146,13 @@ inline rjson::value empty_string() {
 // The representation is dense - without any redundant indentation.
 std::string print(const rjson::value& value, size_t max_nested_level = default_max_nested_level);
 
+// Similar to print(value) above, but instead of materializing the entire
+// JSON representation in one contiguous string, writes it to the given
+// output_stream in chunks, waiting for each chunk to drain. This keeps
+// memory use bounded regardless of the size of the value, and yields to
+// the scheduler while serializing. The stream is not closed.
+seastar::future<> print(const rjson::value& value, seastar::output_stream<char>& os, size_t max_nested_level = default_max_nested_level);
+
 // Returns a string_view to the string held in a JSON value (which is
 // assumed to hold a string, i.e., v.IsString() == true). This is a view
 // to the existing data - no copying is done.
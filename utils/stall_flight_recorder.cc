@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/stall_flight_recorder.hh"
+
+#include <seastar/core/print.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/util/backtrace.hh>
+
+#include "log.hh"
+
+static logging::logger sfrlog("stall_flight_recorder");
+
+namespace utils {
+
+using namespace std::chrono_literals;
+
+stall_flight_recorder::stall_flight_recorder() {
+    engine().set_stall_detector_report_function([this] {
+        record();
+    });
+    _log_timer.set_callback([this] {
+        log_new_entries();
+    });
+    _log_timer.arm_periodic(1s);
+}
+
+stall_flight_recorder::~stall_flight_recorder() {
+    engine().set_stall_detector_report_function({});
+}
+
+future<> stall_flight_recorder::stop() {
+    // Restore the default report right away - the instance itself is only
+    // destroyed when the sharded<> wrapper goes out of scope, much later.
+    engine().set_stall_detector_report_function({});
+    _log_timer.cancel();
+    log_new_entries();
+    return make_ready_future<>();
+}
+
+void stall_flight_recorder::record() noexcept {
+    auto idx = _head.load(std::memory_order_relaxed);
+    entry& e = _ring[idx % ring_size];
+    e.when = std::chrono::system_clock::now();
+    e.sg = current_scheduling_group();
+    e.nr_frames = 0;
+    backtrace([&e] (frame f) {
+        if (e.nr_frames < max_frames) {
+            e.frames[e.nr_frames++] = f.addr;
+        }
+    });
+    _head.store(idx + 1, std::memory_order_release);
+}
+
+std::vector<stall_flight_recorder::entry> stall_flight_recorder::entries() const {
+    std::vector<entry> res;
+    auto head = _head.load(std::memory_order_acquire);
+    auto first = head > ring_size ? head - ring_size : 0;
+    res.reserve(head - first);
+    for (auto i = head; i-- > first;) {
+        entry e = _ring[i % ring_size];
+        // The signal handler may have overwritten the slot while we copied
+        // it. It writes index i + ring_size into this slot while _head is
+        // still at i + ring_size, so anything at or above that means the
+        // copy cannot be trusted - and neither can the older entries.
+        if (_head.load(std::memory_order_acquire) >= i + ring_size) {
+            break;
+        }
+        res.push_back(std::move(e));
+    }
+    return res;
+}
+
+void stall_flight_recorder::log_new_entries() {
+    auto head = _head.load(std::memory_order_acquire);
+    if (head == _logged) {
+        return;
+    }
+    if (head - _logged > ring_size) {
+        sfrlog.warn("{} reactor stalls were pushed out of the ring before they could be logged", head - ring_size - _logged);
+        _logged = head - ring_size;
+    }
+    for (; _logged != head; ++_logged) {
+        entry e = _ring[_logged % ring_size];
+        if (_head.load(std::memory_order_acquire) >= _logged + ring_size) {
+            continue; // overwritten while copying, already counted above on the next run
+        }
+        sstring bt;
+        for (size_t i = 0; i < e.nr_frames; ++i) {
+            bt += format(" 0x{:x}", e.frames[i]);
+        }
+        sfrlog.warn("Reactor stalled in scheduling group \"{}\". Backtrace:{}", e.sg.name(), bt);
+    }
+}
+
+} // namespace utils
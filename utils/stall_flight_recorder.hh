@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/timer.hh>
+
+#include "seastarx.hh"
+
+namespace utils {
+
+// Flight recorder for reactor stalls.
+//
+// The reactor's stall detector lets the application install a report function
+// which runs from a signal handler on the stalled reactor thread. The default
+// report writes a backtrace to the log and nothing else, so correlating a
+// stall with what the shard was doing at the time means reproducing the stall
+// under gdb. This recorder instead captures the stack together with the
+// scheduling group that was running into a preallocated per-shard ring: the
+// report function only walks the stack and writes into memory that is already
+// there, which keeps it signal-safe and makes the steady-state cost zero.
+//
+// The ring is served by the /system/reactor_stalls REST endpoint; new entries
+// are also written to the log from a timer, preserving the log-based workflow
+// the default report supported. The stall duration is not passed to the
+// report function, so entries record only when and where the stall happened;
+// the detection threshold is blocked_reactor_notify_ms as usual.
+class stall_flight_recorder {
+public:
+    static constexpr size_t max_frames = 32;
+    static constexpr size_t ring_size = 128; // must cover ring arithmetic below
+
+    struct entry {
+        std::chrono::system_clock::time_point when;
+        scheduling_group sg;
+        std::array<uintptr_t, max_frames> frames;
+        size_t nr_frames;
+    };
+
+private:
+    std::array<entry, ring_size> _ring;
+    // Index of the next entry to write. Only the signal handler writes it,
+    // and only this shard reads it, but the handler can interrupt a reader
+    // half-way through the ring - hence the atomic and the release/acquire
+    // pairing with the entry writes.
+    std::atomic<uint64_t> _head{0};
+    uint64_t _logged = 0; // entries below this index were written to the log
+    timer<lowres_clock> _log_timer;
+
+public:
+    stall_flight_recorder();
+    ~stall_flight_recorder();
+
+    future<> stop();
+
+    // Called from the stall detector's signal handler. Must not allocate,
+    // lock or otherwise leave async-signal-safe territory.
+    void record() noexcept;
+
+    // Copies out the recorded entries, newest first. An entry overwritten by
+    // the signal handler while being copied is dropped, along with everything
+    // older.
+    std::vector<entry> entries() const;
+
+    // Total number of stalls recorded since start, including ones that have
+    // been pushed out of the ring.
+    uint64_t total_recorded() const {
+        return _head.load(std::memory_order_relaxed);
+    }
+
+private:
+    void log_new_entries();
+};
+
+} // namespace utils
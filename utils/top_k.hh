@@ -57,8 +57,12 @@
 */
 
 #include <cstdio>
+#include <algorithm>
+#include <bit>
+#include <limits>
 #include <list>
 #include <unordered_map>
+#include <vector>
 #include <memory>
 #include <tuple>
 #include <assert.h>
@@ -257,6 +261,29 @@ public:
         }
     }
 
+    // Halves all counts and error estimates, dropping items whose count reaches zero.
+    // Calling this periodically turns a long-lived sketch into an exponentially
+    // decayed view of the stream, so it tracks recent traffic rather than
+    // all-time totals.
+    void decay() {
+        if (!_valid) {
+            return;
+        }
+        try {
+            results res = top(_counters_map.size());
+            _counters_map.clear();
+            _buckets.clear();
+            for (auto& r: res) {
+                if (r.count / 2 > 0) {
+                    append(r.item, r.count / 2, r.error / 2);
+                }
+            }
+        } catch (...) {
+            _valid = false;
+            std::rethrow_exception(std::current_exception());
+        }
+    }
+
     //-----------------------------------------------------------------------------------------
     // Diagnostics
 public:
@@ -272,6 +299,178 @@ public:
 
 //---------------------------------------------------------------------------------------------
 
+/// Decayed top-k tracker cheap enough to run on every request.
+///
+/// space_saving_top_k above maintains an ordered bucket list and a hash map
+/// entry per tracked key on every append, which is fine for on-demand
+/// diagnostics but too heavy for always-on hot-key detection. This variant
+/// absorbs the stream into a count-min sketch: a fixed matrix of counters
+/// where each key hashes to one counter per row and its frequency estimate
+/// is the minimum over its counters. An update is one hash plus depth
+/// counter probes into a power-of-two-sized table, with no allocation and
+/// no ordering work; the rows are probed via double hashing derived from
+/// the single key hash. Updates are conservative: only counters below the
+/// new estimate are raised, which tightens the overestimate under skew.
+///
+/// On top of the sketch sits a small exact table of the current heaviest
+/// keys. A key enters the table only when its sketch estimate exceeds the
+/// smallest tracked count, so the common case for a cold key is one compare.
+///
+/// decay() halves every counter in place, turning the sketch into an
+/// exponentially decayed view of the stream when called periodically --
+/// a key's weight fades with age rather than accumulating forever.
+///
+/// Estimates can only overestimate (hash collisions add counts), never
+/// underestimate, so the table can contain falsely promoted keys under
+/// heavy collision load; widen the sketch if that matters.
+template <class T, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>>
+class decayed_top_k {
+public:
+    struct result {
+        T item;
+        uint64_t count;
+    };
+
+    using results = std::vector<result>;
+
+private:
+    static constexpr unsigned depth = 4;
+
+    struct entry {
+        T item;
+        uint64_t count;
+    };
+
+    size_t _width_mask; // sketch row size - 1, row size is a power of two
+    std::vector<uint32_t> _counters; // depth rows of (_width_mask + 1) counters
+    std::vector<entry> _heavy; // unordered, at most _capacity entries
+    std::unordered_map<T, size_t, Hash, KeyEqual> _heavy_map; // item -> index in _heavy
+    size_t _capacity;
+    // Lower bound on the smallest count in a full _heavy table. Grows stale
+    // (too low) as tracked keys gain weight, costing only an extra scan.
+    uint64_t _min_count = 0;
+
+public:
+    /// capacity: number of keys tracked exactly; width: counters per sketch
+    /// row, rounded up to a power of two. Memory is ~16 bytes per counter
+    /// row entry times four rows plus the exact table.
+    explicit decayed_top_k(size_t capacity = 8, size_t width = 1024)
+            : _width_mask(std::bit_ceil(width) - 1)
+            , _counters(depth * (_width_mask + 1))
+            , _capacity(capacity) {
+        _heavy.reserve(capacity);
+    }
+
+    size_t capacity() const { return _capacity; }
+    size_t size() const { return _heavy.size(); }
+
+    void append(const T& item, uint32_t inc = 1) {
+        uint64_t h = Hash{}(item);
+        // Double hashing: two halves of one hash generate all row probes.
+        // The odd step makes the probe sequences distinct for h2 == 0 keys.
+        uint64_t h2 = (h >> 32) | 1;
+
+        uint32_t* cells[depth];
+        uint32_t est = std::numeric_limits<uint32_t>::max();
+        for (unsigned d = 0; d < depth; ++d) {
+            cells[d] = &_counters[d * (_width_mask + 1) + ((h + d * h2) & _width_mask)];
+            est = std::min(est, *cells[d]);
+        }
+        uint64_t count = uint64_t(est) + inc;
+        uint32_t capped = count > std::numeric_limits<uint32_t>::max()
+                ? std::numeric_limits<uint32_t>::max() : uint32_t(count);
+        for (unsigned d = 0; d < depth; ++d) {
+            if (*cells[d] < capped) {
+                *cells[d] = capped;
+            }
+        }
+
+        auto it = _heavy_map.find(item);
+        if (it != _heavy_map.end()) {
+            auto& e = _heavy[it->second];
+            if (count > e.count) {
+                e.count = count;
+            }
+            return;
+        }
+        if (_heavy.size() < _capacity) {
+            _heavy.push_back(entry{item, count});
+            _heavy_map.emplace(item, _heavy.size() - 1);
+            return;
+        }
+        if (count <= _min_count) {
+            return; // cold key fast path
+        }
+        size_t min_idx = 0;
+        for (size_t i = 1; i < _heavy.size(); ++i) {
+            if (_heavy[i].count < _heavy[min_idx].count) {
+                min_idx = i;
+            }
+        }
+        if (count <= _heavy[min_idx].count) {
+            _min_count = _heavy[min_idx].count; // refresh the stale bound
+            return;
+        }
+        _heavy_map.erase(_heavy[min_idx].item);
+        _heavy[min_idx] = entry{item, count};
+        _heavy_map.emplace(item, min_idx);
+        _min_count = _heavy[min_idx].count;
+        for (auto& e : _heavy) {
+            _min_count = std::min(_min_count, e.count);
+        }
+    }
+
+    // Halves all counts, dropping tracked keys that reach zero. Calling this
+    // periodically makes the tracker follow recent traffic; the half-life is
+    // the decay period times log2 of a key's weight.
+    void decay() {
+        for (auto& c : _counters) {
+            c >>= 1;
+        }
+        size_t i = 0;
+        while (i < _heavy.size()) {
+            _heavy[i].count >>= 1;
+            if (_heavy[i].count == 0) {
+                _heavy_map.erase(_heavy[i].item);
+                if (i != _heavy.size() - 1) {
+                    _heavy[i] = std::move(_heavy.back());
+                    _heavy_map[_heavy[i].item] = i;
+                }
+                _heavy.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        _min_count >>= 1;
+    }
+
+    // The tracked keys, heaviest first. Counts are sketch estimates and may
+    // overestimate, but their order reflects the decayed stream.
+    results top(size_t k) const {
+        results res;
+        res.reserve(std::min(k, _heavy.size()));
+        for (auto& e : _heavy) {
+            res.push_back(result{e.item, e.count});
+        }
+        std::sort(res.begin(), res.end(), [] (const result& a, const result& b) {
+            return a.count > b.count;
+        });
+        if (res.size() > k) {
+            res.resize(k);
+        }
+        return res;
+    }
+
+    void clear() {
+        std::fill(_counters.begin(), _counters.end(), 0);
+        _heavy.clear();
+        _heavy_map.clear();
+        _min_count = 0;
+    }
+};
+
+//---------------------------------------------------------------------------------------------
+
 template <class T>
 std::ostream& operator<<(std::ostream& out, const typename space_saving_top_k<T>::counter& c) {
     out << c.item << " " << c.count << "/" << c.error << " " << &*c.bucket_it;
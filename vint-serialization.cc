@@ -172,6 +172,19 @@ uint64_t unsigned_vint::deserialize(bytes_view v) {
     return result;
 }
 
+size_t unsigned_vint::deserialize_run(const int8_t* src, size_t len, uint64_t* dest, size_t count) {
+    size_t pos = 0;
+    // Decoding the fields back-to-back keeps the length detection and the
+    // overreading 64-bit loads of deserialize() in one tight loop, instead
+    // of paying a round trip through the caller's state machine per field.
+    for (size_t i = 0; i < count; ++i) {
+        const auto size = serialized_size_from_first_byte(src[pos]);
+        dest[i] = deserialize(bytes_view(src + pos, len - pos));
+        pos += size;
+    }
+    return pos;
+}
+
 vint_size_type unsigned_vint::serialized_size_from_first_byte(bytes::value_type first_byte) {
     int8_t first_byte_casted = first_byte;
     return 1 + (first_byte_casted >= 0 ? 0 : count_extra_bytes(first_byte_casted));
@@ -62,6 +62,12 @@ struct unsigned_vint final {
 
     static value_type deserialize(bytes_view v);
 
+    // Decodes `count` consecutive vints from `src` into `dest` and returns
+    // the number of bytes consumed. The caller must guarantee that the
+    // buffer contains `count` complete encodings; staying at least
+    // `count * max_vint_length` bytes long is the easy way to ensure that.
+    static size_t deserialize_run(const int8_t* src, size_t len, uint64_t* dest, size_t count);
+
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
 };
 
@@ -74,3 +74,45 @@ class legacy_xx_hasher_without_null_digest : public xx_hasher {
 public:
     explicit legacy_xx_hasher_without_null_digest(uint64_t seed = 0) noexcept : xx_hasher(seed) {}
 };
+
+// XXH3-based hasher, considerably faster than xx_hasher, especially for
+// large inputs. Produces different digests than xx_hasher, so it can only
+// be used for query digests once the whole cluster understands them (see
+// gms::features::XXHASH3_DIGEST).
+class xx3_hasher {
+    static constexpr size_t digest_size = 16;
+    XXH3_state_t _state;
+
+public:
+    explicit xx3_hasher(uint64_t seed = 0) noexcept {
+        XXH3_INITSTATE(&_state);
+        XXH3_64bits_reset_withSeed(&_state, seed);
+    }
+
+    void update(const char* ptr, size_t length) noexcept {
+        XXH3_64bits_update(&_state, ptr, length);
+    }
+
+    bytes finalize() {
+        bytes digest{bytes::initialized_later(), digest_size};
+        serialize_to(digest.begin());
+        return digest;
+    }
+
+    std::array<uint8_t, digest_size> finalize_array() {
+        std::array<uint8_t, digest_size> digest;
+        serialize_to(digest.begin());
+        return digest;
+    }
+
+    uint64_t finalize_uint64() {
+        return XXH3_64bits_digest(&_state);
+    }
+
+private:
+    template<typename OutIterator>
+    void serialize_to(OutIterator&& out) {
+        serialize_int64(out, 0);
+        serialize_int64(out, finalize_uint64());
+    }
+};
@@ -25,6 +25,7 @@
 // which are available only when the library is linked statically.
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
+#include "zdict.h"
 
 #include "compress.hh"
 #include "utils/class_registrator.hh"
@@ -53,10 +54,40 @@ public:
                     size_t output_len) const override;
     size_t compress_max_size(size_t input_len) const override;
 
+    bool supports_dictionaries() const override;
+    bytes train_dictionary(const std::vector<bytes>& samples, size_t max_dict_size) const override;
+    dict_ptr make_dictionary(bytes_view raw) const override;
+    size_t uncompress(const char* input, size_t input_len, char* output,
+                    size_t output_len, const dict&) const override;
+    size_t compress(const char* input, size_t input_len, char* output,
+                    size_t output_len, const dict&) const override;
+
     std::set<sstring> option_names() const override;
     std::map<sstring, sstring> options() const override;
 };
 
+// Digested forms of a raw dictionary, reusable across chunks of an sstable.
+class zstd_dict : public compressor::dict {
+    ZSTD_CDict* _cdict;
+    ZSTD_DDict* _ddict;
+public:
+    zstd_dict(bytes_view raw, int compression_level)
+        : _cdict(ZSTD_createCDict(raw.data(), raw.size(), compression_level))
+        , _ddict(ZSTD_createDDict(raw.data(), raw.size())) {
+        if (!_cdict || !_ddict) {
+            ZSTD_freeCDict(_cdict);
+            ZSTD_freeDDict(_ddict);
+            throw std::runtime_error("Unable to digest ZSTD dictionary");
+        }
+    }
+    ~zstd_dict() {
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
+    const ZSTD_CDict* cdict() const { return _cdict; }
+    const ZSTD_DDict* ddict() const { return _ddict; }
+};
+
 zstd_processor::zstd_processor(const opt_getter& opts)
     : compressor(COMPRESSOR_NAME) {
     auto level = opts(COMPRESSION_LEVEL);
@@ -124,6 +155,53 @@ size_t zstd_processor::compress_max_size(size_t input_len) const {
     return ZSTD_compressBound(input_len);
 }
 
+bool zstd_processor::supports_dictionaries() const {
+    return true;
+}
+
+bytes zstd_processor::train_dictionary(const std::vector<bytes>& samples, size_t max_dict_size) const {
+    bytes blob;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& s : samples) {
+        blob += s;
+        sizes.push_back(s.size());
+    }
+    bytes dict(bytes::initialized_later(), max_dict_size);
+    auto ret = ZDICT_trainFromBuffer(dict.data(), max_dict_size, blob.data(), sizes.data(), sizes.size());
+    if (ZDICT_isError(ret)) {
+        // Too few or too uniform samples. Not an error; the caller falls
+        // back to dictionary-less compression.
+        return {};
+    }
+    dict.resize(ret);
+    return dict;
+}
+
+compressor::dict_ptr zstd_processor::make_dictionary(bytes_view raw) const {
+    return make_shared<zstd_dict>(raw, _compression_level);
+}
+
+size_t zstd_processor::uncompress(const char* input, size_t input_len, char* output,
+        size_t output_len, const dict& d) const {
+    auto ret = ZSTD_decompress_usingDDict(_dctx, output, output_len, input, input_len,
+            static_cast<const zstd_dict&>(d).ddict());
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error( format("ZSTD dictionary decompression failure: {}", ZSTD_getErrorName(ret)));
+    }
+    return ret;
+}
+
+size_t zstd_processor::compress(const char* input, size_t input_len, char* output,
+        size_t output_len, const dict& d) const {
+    auto ret = ZSTD_compress_usingCDict(_cctx, output, output_len, input, input_len,
+            static_cast<const zstd_dict&>(d).cdict());
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error( format("ZSTD dictionary compression failure: {}", ZSTD_getErrorName(ret)));
+    }
+    return ret;
+}
+
 std::set<sstring> zstd_processor::option_names() const {
     return {COMPRESSION_LEVEL};
 }